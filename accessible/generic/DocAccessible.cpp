@@ -439,6 +439,21 @@ void DocAccessible::QueueCacheUpdate(LocalAccessible* aAcc, uint64_t aNewDomain,
   Controller()->ScheduleProcessing();
 }
 
+uint64_t DocAccessible::StealQueuedCacheDomains(LocalAccessible* aAcc,
+                                                uint64_t aDomains) {
+  if (auto entry = mQueuedCacheUpdatesHash.Lookup(aAcc)) {
+    auto& [arrayAcc, domain] = mQueuedCacheUpdatesArray[entry.Data()];
+    MOZ_ASSERT(arrayAcc == aAcc);
+    const uint64_t stolenDomains = domain & aDomains;
+    // Leave the array entry in place with the stolen bits cleared; the flush
+    // in ProcessQueuedCacheUpdates skips entries whose bundled fields are
+    // empty.
+    domain &= ~stolenDomains;
+    return stolenDomains;
+  }
+  return CacheDomain::None;
+}
+
 void DocAccessible::QueueCacheUpdateForDependentRelations(
     LocalAccessible* aAcc) {
   if (!mIPCDoc || !aAcc || !aAcc->IsInDocument() || aAcc->IsDefunct()) {
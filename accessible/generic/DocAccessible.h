@@ -122,6 +122,15 @@ class DocAccessible : public HyperTextAccessible,
   void QueueCacheUpdate(LocalAccessible* aAcc, uint64_t aNewDomain,
                         bool aBypassActiveDomains = false);
 
+  /**
+   * Clears and returns the subset of aDomains queued for aAcc by
+   * QueueCacheUpdate(). Used by eager cache pushes (which must precede their
+   * associated events) to fold pending updates for the same accessible into
+   * the message being sent, so the tick-end flush doesn't send a second
+   * message for domains that are already up to date in the parent process.
+   */
+  uint64_t StealQueuedCacheDomains(LocalAccessible* aAcc, uint64_t aDomains);
+
   /**
    * Walks the dependent ids and elements maps for the given accessible and
    * queues a CacheDomain::Relations cache update fore each related acc.
@@ -3354,7 +3354,7 @@ void LocalAccessible::SendCache(uint64_t aCacheDomain,
   }
 
   // Only send cache updates for domains that are active.
-  const uint64_t domainsToSend =
+  uint64_t domainsToSend =
       nsAccessibilityService::GetActiveCacheDomains() & aCacheDomain;
 
   // Avoid sending cache updates if we have no domains to update.
@@ -3371,6 +3371,12 @@ void LocalAccessible::SendCache(uint64_t aCacheDomain,
     return;
   }
 
+  // This eager push makes any active-domain updates already queued for this
+  // accessible redundant, and they might be stale by comparison.  Fold them
+  // into this message so the tick-end flush doesn't send a second one.
+  domainsToSend |= mDoc->StealQueuedCacheDomains(
+      this, nsAccessibilityService::GetActiveCacheDomains());
+
   RefPtr<AccAttributes> fields =
       BundleFieldsForCache(domainsToSend, aUpdateType);
   if (!fields->Count()) {
@@ -1166,7 +1166,10 @@ void BrowsingContext::SetOpener(BrowsingContext* aOpener) {
   MOZ_DIAGNOSTIC_ASSERT(!aOpener || aOpener->Group() == Group());
   MOZ_DIAGNOSTIC_ASSERT(!aOpener || aOpener->mType == mType);
 
-  MOZ_ALWAYS_SUCCEEDS(SetOpenerId(aOpener ? aOpener->Id() : 0));
+  // Update opener-related fields in a shared transaction so that we only
+  // broadcast a single sync message to other processes.
+  Transaction txn;
+  txn.SetOpenerId(aOpener ? aOpener->Id() : 0);
 
   if (IsChrome() && IsTop() && aOpener) {
     // Inherit color scheme overrides from parent window. This is to inherit the
@@ -1174,9 +1177,11 @@ void BrowsingContext::SetOpener(BrowsingContext* aOpener) {
     // windows.
     auto openerOverride = aOpener->Top()->PrefersColorSchemeOverride();
     if (openerOverride != PrefersColorSchemeOverride()) {
-      MOZ_ALWAYS_SUCCEEDS(SetPrefersColorSchemeOverride(openerOverride));
+      txn.SetPrefersColorSchemeOverride(openerOverride);
     }
   }
+
+  MOZ_ALWAYS_SUCCEEDS(txn.Commit(this));
 }
 
 bool BrowsingContext::HasOpener() const {
@@ -291,6 +291,10 @@ nsresult AttrArray::EnsureCapacityToClone(const AttrArray& aOther) {
 bool AttrArray::GrowBy(uint32_t aGrowSize) {
   const uint32_t kLinearThreshold = 16;
   const uint32_t kLinearGrowSize = 4;
+  // Most elements carry only one or two attributes, so the first allocation
+  // starts small rather than using the linear grow size; elements with more
+  // attributes catch up with the old policy on the first regrowth.
+  const uint32_t kInitialCapacity = 2;
 
   CheckedUint32 capacity = mImpl ? mImpl->mCapacity : 0;
   CheckedUint32 minCapacity = capacity;
@@ -300,12 +304,15 @@ bool AttrArray::GrowBy(uint32_t aGrowSize) {
   }
 
   if (capacity.value() <= kLinearThreshold) {
-    do {
+    if (!capacity.value()) {
+      capacity = kInitialCapacity;
+    }
+    while (capacity.value() < minCapacity.value()) {
       capacity += kLinearGrowSize;
       if (!capacity.isValid()) {
         return false;
       }
-    } while (capacity.value() < minCapacity.value());
+    }
   } else {
     uint32_t shift = mozilla::CeilingLog2(minCapacity.value());
     if (shift >= 32) {
@@ -732,13 +732,54 @@ IntersectionInput DOMIntersectionObserver::ComputeInput(
           remoteDocumentVisibleRect};
 }
 
+// Equivalent to nsLayoutUtils::IsAncestorFrameCrossDocInProcess for the root
+// frame, but memoizes the answer for every frame on the walked chain, so that
+// targets sharing ancestors (items of the same virtualized list, say) pay for
+// the walk only once per update pass.
+static bool RootIsAncestorFrame(const IntersectionInput& aInput,
+                                const nsIFrame* aFrame,
+                                IntersectionUpdateCache* aCache) {
+  if (!aCache) {
+    return nsLayoutUtils::IsAncestorFrameCrossDocInProcess(aInput.mRootFrame,
+                                                           aFrame);
+  }
+  AutoTArray<const nsIFrame*, 32> chain;
+  bool result = false;
+  for (const nsIFrame* f = aFrame; f;
+       f = nsLayoutUtils::GetCrossDocParentFrameInProcess(f)) {
+    if (f == aInput.mRootFrame) {
+      result = true;
+      break;
+    }
+    if (Maybe<bool> cached = aCache->mRootIsAncestor.MaybeGet(f)) {
+      result = *cached;
+      break;
+    }
+    chain.AppendElement(f);
+  }
+  for (const nsIFrame* f : chain) {
+    aCache->mRootIsAncestor.InsertOrUpdate(f, result);
+  }
+  return result;
+}
+
 // https://w3c.github.io/IntersectionObserver/#update-intersection-observations-algo
 // (steps 2.1 - 2.5)
 IntersectionOutput DOMIntersectionObserver::Intersect(
     const IntersectionInput& aInput, const Element& aTarget, BoxToUse aBoxToUse,
-    IsForProximityToViewport aIsForProximityToViewport) {
-  const bool isSimilarOrigin = SimilarOrigin(aTarget, aInput.mRootNode) ==
-                               BrowsingContextOrigin::Similar;
+    IsForProximityToViewport aIsForProximityToViewport,
+    IntersectionUpdateCache* aCache) {
+  const bool isSimilarOrigin = [&] {
+    auto compute = [&] {
+      return SimilarOrigin(aTarget, aInput.mRootNode) ==
+             BrowsingContextOrigin::Similar;
+    };
+    if (aCache) {
+      return aCache->mSimilarOrigin.LookupOrInsertWith(aTarget.OwnerDoc(),
+                                                       compute);
+    }
+    return compute();
+  }();
   nsIFrame* targetFrame = aTarget.GetPrimaryFrame();
   if (!targetFrame || !aInput.mRootFrame) {
     return {isSimilarOrigin};
@@ -772,8 +813,7 @@ IntersectionOutput DOMIntersectionObserver::Intersect(
   // clarification in
   // https://github.com/w3c/IntersectionObserver/issues/456.
   if (aInput.mRootFrame == targetFrame ||
-      !nsLayoutUtils::IsAncestorFrameCrossDocInProcess(aInput.mRootFrame,
-                                                       targetFrame)) {
+      !RootIsAncestorFrame(aInput, targetFrame, aCache)) {
     return {isSimilarOrigin};
   }
 
@@ -846,12 +886,14 @@ IntersectionOutput DOMIntersectionObserver::Intersect(
 void DOMIntersectionObserver::Update(Document& aDocument,
                                      DOMHighResTimeStamp time) {
   auto input = ComputeInput(aDocument, mRoot, &mRootMargin, &mScrollMargin);
+  IntersectionUpdateCache cache;
 
   // 2. For each target in observer’s internal [[ObservationTargets]] slot,
   // processed in the same order that observe() was called on each target:
   for (Element* target : mObservationTargets) {
     // 2.1 - 2.4.
-    IntersectionOutput output = Intersect(input, *target);
+    IntersectionOutput output = Intersect(input, *target, BoxToUse::Border,
+                                          IsForProximityToViewport::No, &cache);
 
     // 2.5. Let targetArea be targetRect’s area.
     int64_t targetArea = (int64_t)output.mTargetRect.Width() *
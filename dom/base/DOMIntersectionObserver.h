@@ -13,8 +13,11 @@
 #include "mozilla/Variant.h"
 #include "nsDOMNavigationTiming.h"
 #include "nsTArray.h"
+#include "nsTHashMap.h"
 #include "nsTHashSet.h"
 
+class nsIFrame;
+
 namespace mozilla::dom {
 
 class DOMIntersectionObserver;
@@ -106,6 +109,17 @@ struct IntersectionOutput {
   bool Intersects() const { return mIntersectionRect.isSome(); }
 };
 
+// Mutable memoization shared by all the targets intersected against a single
+// IntersectionInput. Batched targets typically live in the same document and
+// share most of their ancestor chains, so without this the per-target origin
+// and ancestry checks keep repeating the same walks.
+struct IntersectionUpdateCache {
+  // Target document -> whether it is similar-origin with the root.
+  nsTHashMap<nsPtrHashKey<const Document>, bool> mSimilarOrigin;
+  // Frame -> whether the root frame is a cross-doc ancestor of it.
+  nsTHashMap<nsPtrHashKey<const nsIFrame>, bool> mRootIsAncestor;
+};
+
 class DOMIntersectionObserver final : public nsISupports,
                                       public nsWrapperCache {
   virtual ~DOMIntersectionObserver() { Disconnect(); }
@@ -166,7 +180,8 @@ class DOMIntersectionObserver final : public nsISupports,
   };
   static IntersectionOutput Intersect(
       const IntersectionInput&, const Element&, BoxToUse = BoxToUse::Border,
-      IsForProximityToViewport = IsForProximityToViewport::No);
+      IsForProximityToViewport = IsForProximityToViewport::No,
+      IntersectionUpdateCache* = nullptr);
   // Intersects with a given rect, already relative to the root frame.
   static IntersectionOutput Intersect(const IntersectionInput&, const nsRect&);
 
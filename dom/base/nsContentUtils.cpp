@@ -10076,41 +10076,29 @@ static_assert(sizeof(StringBuilder) <= StringBuilder::TARGET_SIZE,
 
 }  // namespace
 
+// Count the characters of aData which have to be replaced by a character
+// reference when serializing. The loop is written branchlessly so that
+// compilers can vectorize it; most text nodes contain nothing to escape, and
+// this pre-scan dominates the serialization cost of large text-heavy trees.
+template <class T>
+static uint32_t CountEncodableChars(const T* aData, uint32_t aLen) {
+  uint32_t numEncodedChars = 0;
+  for (uint32_t i = 0; i < aLen; ++i) {
+    const T c = aData[i];
+    numEncodedChars += uint32_t(c == T('<')) + uint32_t(c == T('>')) +
+                       uint32_t(c == T('&')) + uint32_t(c == T(0x00A0));
+  }
+  return numEncodedChars;
+}
+
 static void AppendEncodedCharacters(const nsTextFragment* aText,
                                     StringBuilder& aBuilder) {
-  uint32_t numEncodedChars = 0;
   uint32_t len = aText->GetLength();
-  if (aText->Is2b()) {
-    const char16_t* data = aText->Get2b();
-    for (uint32_t i = 0; i < len; ++i) {
-      const char16_t c = data[i];
-      switch (c) {
-        case '<':
-        case '>':
-        case '&':
-        case 0x00A0:
-          ++numEncodedChars;
-          break;
-        default:
-          break;
-      }
-    }
-  } else {
-    const char* data = aText->Get1b();
-    for (uint32_t i = 0; i < len; ++i) {
-      const unsigned char c = data[i];
-      switch (c) {
-        case '<':
-        case '>':
-        case '&':
-        case 0x00A0:
-          ++numEncodedChars;
-          break;
-        default:
-          break;
-      }
-    }
-  }
+  uint32_t numEncodedChars =
+      aText->Is2b()
+          ? CountEncodableChars(aText->Get2b(), len)
+          : CountEncodableChars(
+                reinterpret_cast<const unsigned char*>(aText->Get1b()), len);
 
   if (numEncodedChars) {
     // For simplicity, conservatively estimate the size of the string after
@@ -10133,23 +10121,16 @@ static void AppendEncodedCharacters(const nsTextFragment* aText,
 
 static CheckedInt<uint32_t> ExtraSpaceNeededForAttrEncoding(
     const nsAString& aValue) {
-  const char16_t* c = aValue.BeginReading();
-  const char16_t* end = aValue.EndReading();
+  // As in CountEncodableChars, branchless so that the scan can vectorize.
+  const char16_t* data = aValue.BeginReading();
+  uint32_t len = aValue.Length();
 
   uint32_t numEncodedChars = 0;
-  while (c < end) {
-    switch (*c) {
-      case '"':
-      case '&':
-      case 0x00A0:  // NO-BREAK SPACE
-      case '<':
-      case '>':
-        ++numEncodedChars;
-        break;
-      default:
-        break;
-    }
-    ++c;
+  for (uint32_t i = 0; i < len; ++i) {
+    const char16_t c = data[i];
+    numEncodedChars += uint32_t(c == u'"') + uint32_t(c == u'&') +
+                       uint32_t(c == char16_t(0x00A0)) + uint32_t(c == u'<') +
+                       uint32_t(c == u'>');
   }
 
   if (!numEncodedChars) {
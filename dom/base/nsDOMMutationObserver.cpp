@@ -710,8 +710,10 @@ void nsDOMMutationObserver::TakeRecords(
   for (uint32_t i = 0; i < mPendingMutationCount; ++i) {
     RefPtr<nsDOMMutationRecord> next;
     current->mNext.swap(next);
-    if (!mMergeAttributeRecords ||
-        !MergeableAttributeRecord(aRetVal.SafeLastElement(nullptr), current)) {
+    nsDOMMutationRecord* last = aRetVal.SafeLastElement(nullptr);
+    if ((!mMergeAttributeRecords ||
+         !MergeableAttributeRecord(last, current)) &&
+        (!mMergeChildListRecords || !MergeChildListRecord(last, current))) {
       *aRetVal.AppendElement() = std::move(current);
     }
     current.swap(next);
@@ -773,6 +775,51 @@ bool nsDOMMutationObserver::MergeableAttributeRecord(
          aOldRecord->mAttrNamespace.Equals(aRecord->mAttrNamespace);
 }
 
+bool nsDOMMutationObserver::MergeChildListRecord(
+    nsDOMMutationRecord* aOldRecord, nsDOMMutationRecord* aRecord) {
+  MOZ_ASSERT(mMergeChildListRecords);
+  if (!aOldRecord || aOldRecord->mType != nsGkAtoms::childList ||
+      aRecord->mType != nsGkAtoms::childList ||
+      aOldRecord->mTarget != aRecord->mTarget) {
+    return false;
+  }
+
+  auto hasNodes = [](const RefPtr<nsSimpleContentList>& aList) {
+    return aList && aList->Length();
+  };
+  const bool oldAdds = hasNodes(aOldRecord->mAddedNodes);
+  const bool oldRemovals = hasNodes(aOldRecord->mRemovedNodes);
+  const bool newAdds = hasNodes(aRecord->mAddedNodes);
+  const bool newRemovals = hasNodes(aRecord->mRemovedNodes);
+
+  // A run of insertions continues the old record if the new nodes were
+  // inserted right after the nodes the old record already describes.
+  if (oldAdds && !oldRemovals && newAdds && !newRemovals &&
+      aRecord->mPreviousSibling ==
+          aOldRecord->mAddedNodes->Item(aOldRecord->mAddedNodes->Length() -
+                                        1)) {
+    for (uint32_t i = 0; i < aRecord->mAddedNodes->Length(); ++i) {
+      aOldRecord->mAddedNodes->AppendElement(aRecord->mAddedNodes->Item(i));
+    }
+    aOldRecord->mNextSibling = aRecord->mNextSibling;
+    return true;
+  }
+
+  // A run of removals continues the old record if the new nodes were removed
+  // from the same position, i.e. right after the old record's previous
+  // sibling.
+  if (oldRemovals && !oldAdds && newRemovals && !newAdds &&
+      aRecord->mPreviousSibling == aOldRecord->mPreviousSibling) {
+    for (uint32_t i = 0; i < aRecord->mRemovedNodes->Length(); ++i) {
+      aOldRecord->mRemovedNodes->AppendElement(aRecord->mRemovedNodes->Item(i));
+    }
+    aOldRecord->mNextSibling = aRecord->mNextSibling;
+    return true;
+  }
+
+  return false;
+}
+
 void nsDOMMutationObserver::HandleMutation() {
   NS_ASSERTION(nsContentUtils::IsSafeToRunScript(), "Whaat!");
   NS_ASSERTION(mCurrentMutations.IsEmpty(),
@@ -801,10 +848,11 @@ void nsDOMMutationObserver::HandleMutation() {
     for (uint32_t i = 0; i < mPendingMutationCount; ++i) {
       RefPtr<nsDOMMutationRecord> next;
       current->mNext.swap(next);
-      if (!mMergeAttributeRecords ||
-          !MergeableAttributeRecord(
-              mutations.Length() ? mutations.LastElement().get() : nullptr,
-              current)) {
+      nsDOMMutationRecord* last =
+          mutations.Length() ? mutations.LastElement().get() : nullptr;
+      if ((!mMergeAttributeRecords ||
+           !MergeableAttributeRecord(last, current)) &&
+          (!mMergeChildListRecords || !MergeChildListRecord(last, current))) {
         *mutations.AppendElement(mozilla::fallible) = current;
       }
       current.swap(next);
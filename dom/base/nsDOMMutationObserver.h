@@ -415,6 +415,7 @@ class nsDOMMutationObserver final : public nsISupports, public nsWrapperCache {
         mCallback(&aCb),
         mWaitingForRun(false),
         mMergeAttributeRecords(false),
+        mMergeChildListRecords(false),
         mId(++sCount) {}
   NS_DECL_CYCLE_COLLECTING_ISUPPORTS
   NS_DECL_CYCLE_COLLECTION_SCRIPT_HOLDER_CLASS(nsDOMMutationObserver)
@@ -457,6 +458,17 @@ class nsDOMMutationObserver final : public nsISupports, public nsWrapperCache {
   bool MergeableAttributeRecord(nsDOMMutationRecord* aOldRecord,
                                 nsDOMMutationRecord* aRecord);
 
+  bool MergeChildListRecords() { return mMergeChildListRecords; }
+
+  void SetMergeChildListRecords(bool aVal) { mMergeChildListRecords = aVal; }
+
+  // If both records are 'childList' records for the same target and aRecord
+  // continues the run of pure insertions or pure removals which aOldRecord
+  // describes, folds aRecord's nodes into aOldRecord and returns true, in
+  // which case the newer record can be skipped.
+  bool MergeChildListRecord(nsDOMMutationRecord* aOldRecord,
+                            nsDOMMutationRecord* aRecord);
+
   void AppendMutationRecord(already_AddRefed<nsDOMMutationRecord> aRecord) {
     RefPtr<nsDOMMutationRecord> record = aRecord;
     MOZ_ASSERT(record);
@@ -555,6 +567,7 @@ class nsDOMMutationObserver final : public nsISupports, public nsWrapperCache {
 
   bool mWaitingForRun;
   bool mMergeAttributeRecords;
+  bool mMergeChildListRecords;
 
   uint64_t mId;
 
@@ -30,6 +30,7 @@
 #include "mozilla/TextControlElement.h"
 #include "mozilla/TextControlState.h"
 #include "mozilla/TextEditor.h"
+#include "mozilla/TextUtils.h"
 #include "mozilla/TimeStamp.h"
 #include "mozilla/dom/BindContext.h"
 #include "mozilla/dom/CharacterData.h"
@@ -3256,11 +3257,71 @@ inline static Element* FindMatchingElementWithId(
   return nullptr;
 }
 
+// If aSelector is a bare id selector ("#id") whose identifier needs no
+// unescaping, copies the id into aId and returns true.
+static bool IsSimpleIdSelector(const nsACString& aSelector, nsAString& aId) {
+  if (aSelector.Length() < 2 || aSelector.First() != '#') {
+    return false;
+  }
+  const char* cur = aSelector.BeginReading() + 1;
+  const char* end = aSelector.EndReading();
+  // Only handle ASCII identifiers, and reject identifiers which would need a
+  // leading escape ("#1foo", "#-1foo", "#-"); anything else takes the regular
+  // parsing path.
+  if (mozilla::IsAsciiDigit(*cur) ||
+      (*cur == '-' &&
+       (cur + 1 == end || mozilla::IsAsciiDigit(*(cur + 1))))) {
+    return false;
+  }
+  for (const char* c = cur; c != end; ++c) {
+    if (!mozilla::IsAsciiAlphanumeric(*c) && *c != '-' && *c != '_') {
+      return false;
+    }
+  }
+  CopyASCIItoUTF16(Substring(aSelector, 1), aId);
+  return true;
+}
+
+// Fast path for querySelector("#id"), which routes to the live id table
+// instead of running the selector machinery. Returns Nothing() if the query
+// can't be answered from the table (no table for the subtree, or quirks mode,
+// where id selectors match case-insensitively but the table is exact-match).
+static Maybe<Element*> TryQuerySelectorById(nsINode& aRoot,
+                                            const nsAString& aId) {
+  if (aRoot.OwnerDoc()->GetCompatibilityMode() == eCompatibility_NavQuirks) {
+    return Nothing();
+  }
+  if (aRoot.IsDocument()) {
+    return Some(aRoot.AsDocument()->GetElementById(aId));
+  }
+  if (ShadowRoot* root = ShadowRoot::FromNode(aRoot)) {
+    return Some(root->GetElementById(aId));
+  }
+  if (aRoot.IsElement()) {
+    if (aRoot.IsInUncomposedDoc()) {
+      return Some(
+          FindMatchingElementWithId(aId, *aRoot.AsElement(), *aRoot.OwnerDoc()));
+    }
+    if (ShadowRoot* shadow = aRoot.AsContent()->GetContainingShadow()) {
+      return Some(FindMatchingElementWithId(aId, *aRoot.AsElement(), *shadow));
+    }
+  }
+  // Disconnected subtrees have no id table.
+  return Nothing();
+}
+
 Element* nsINode::QuerySelector(const nsACString& aSelector,
                                 ErrorResult& aResult) {
   AUTO_PROFILER_LABEL_DYNAMIC_NSCSTRING_RELEVANT_FOR_JS(
       "querySelector", LAYOUT_SelectorQuery, aSelector);
 
+  nsAutoString id;
+  if (IsSimpleIdSelector(aSelector, id)) {
+    if (Maybe<Element*> result = TryQuerySelectorById(*this, id)) {
+      return *result;
+    }
+  }
+
   const StyleSelectorList* list = ParseSelectorList(aSelector, aResult);
   if (!list) {
     return nullptr;
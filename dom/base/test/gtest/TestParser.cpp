@@ -50,3 +50,42 @@ TEST(TestParser, TestParserMain)
 
   EXPECT_TRUE(allTestsPassed);
 }
+
+// The tokenizer's data state skips over plain-text runs with SIMD scans.
+// Make sure markup coming after a text run longer than any vector stride is
+// still dispatched on and produces elements rather than character data.
+TEST(TestParser, MarkupAfterLongTextRun)
+{
+  nsString longRun;
+  for (int i = 0; i < 300; ++i) {
+    longRun.Append(u'a');
+  }
+  nsString htmlInput;
+  htmlInput.AppendLiteral(u"<html><head></head><body>");
+  htmlInput.Append(longRun);
+  htmlInput.AppendLiteral(u"<b>bold</b>");
+  htmlInput.Append(longRun);
+  htmlInput.AppendLiteral(u"</body></html>");
+
+  mozilla::IgnoredErrorResult rv2;
+  RefPtr<mozilla::dom::DOMParser> parser =
+      mozilla::dom::DOMParser::CreateWithoutGlobal(rv2);
+  ASSERT_FALSE(rv2.Failed());
+  nsCOMPtr<mozilla::dom::Document> document = parser->ParseFromStringInternal(
+      htmlInput, mozilla::dom::SupportedType::Text_html, rv2);
+  ASSERT_FALSE(rv2.Failed());
+
+  nsCOMPtr<nsIDocumentEncoder> encoder = do_createDocumentEncoder("text/html");
+  ASSERT_TRUE(encoder);
+  nsresult rv =
+      encoder->Init(document, u"text/html"_ns, nsIDocumentEncoder::OutputRaw);
+  ASSERT_TRUE(NS_SUCCEEDED(rv));
+  nsString parsed;
+  rv = encoder->EncodeToString(parsed);
+  ASSERT_TRUE(NS_SUCCEEDED(rv));
+
+  // If the scan mistakenly consumed the '<' as character data, no <b>
+  // element exists and the serialization contains no tag for it.
+  EXPECT_TRUE(parsed.Equals(htmlInput));
+  EXPECT_NE(parsed.Find(u"<b>bold</b>"), kNotFound);
+}
@@ -2902,8 +2902,8 @@ class MOZ_STACK_CLASS BindingJSObjectCreator {
     options.setClass(aClass);
     options.setLazyProto(aLazyProto);
 
-    aReflector.set(
-        js::NewProxyObject(aCx, aHandler, aExpandoValue, aProto, options));
+    aReflector.set(js::NewProxyObjectWithUseAllocSite(
+        aCx, aHandler, aExpandoValue, aProto, options));
     if (aReflector) {
       js::SetProxyReservedSlot(aReflector, DOM_OBJECT_SLOT,
                                JS::PrivateValue(aNative));
@@ -143,6 +143,7 @@ ClientManagerService::ClientManagerService() : mShutdown(false) {
 ClientManagerService::~ClientManagerService() {
   AssertIsOnBackgroundThread();
   MOZ_DIAGNOSTIC_ASSERT(mSourceTable.Count() == 0);
+  MOZ_DIAGNOSTIC_ASSERT(mSourcesByOrigin.Count() == 0);
   MOZ_DIAGNOSTIC_ASSERT(mManagerList.IsEmpty());
 
   MOZ_DIAGNOSTIC_ASSERT(sClientManagerServiceInstance == this);
@@ -210,6 +211,60 @@ ClientSourceParent* ClientManagerService::FindExistingSource(
   return source;
 }
 
+// static
+bool ClientManagerService::GetOriginIndexKey(
+    const PrincipalInfo& aPrincipalInfo, nsACString& aKey) {
+  switch (aPrincipalInfo.type()) {
+    case PrincipalInfo::TContentPrincipalInfo: {
+      const mozilla::ipc::ContentPrincipalInfo& content =
+          aPrincipalInfo.get_ContentPrincipalInfo();
+      aKey = content.originNoSuffix();
+      nsAutoCString suffix;
+      content.attrs().CreateSuffix(suffix);
+      aKey.Append(suffix);
+      return true;
+    }
+    case PrincipalInfo::TSystemPrincipalInfo: {
+      // System principals match each other regardless of origin, so they all
+      // share a single bucket.  A content origin always contains a scheme,
+      // so this key cannot collide with one.
+      aKey.AssignLiteral("[System Principal]");
+      return true;
+    }
+    default: {
+      // Null principals never match any other principal, so sources with
+      // them can never be returned from a principal-filtered walk.
+      return false;
+    }
+  }
+}
+
+void ClientManagerService::AddSourceToOriginIndex(ClientSourceParent* aSource) {
+  AssertIsOnBackgroundThread();
+
+  nsAutoCString key;
+  if (GetOriginIndexKey(aSource->Info().PrincipalInfo(), key)) {
+    mSourcesByOrigin.LookupOrInsert(key).AppendElement(aSource);
+  }
+}
+
+void ClientManagerService::RemoveSourceFromOriginIndex(
+    ClientSourceParent* aSource) {
+  AssertIsOnBackgroundThread();
+
+  nsAutoCString key;
+  if (!GetOriginIndexKey(aSource->Info().PrincipalInfo(), key)) {
+    return;
+  }
+
+  if (auto entry = mSourcesByOrigin.Lookup(key)) {
+    entry.Data().RemoveElement(aSource);
+    if (entry.Data().IsEmpty()) {
+      entry.Remove();
+    }
+  }
+}
+
 // static
 already_AddRefed<ClientManagerService>
 ClientManagerService::GetOrCreateInstance() {
@@ -278,6 +333,7 @@ bool ClientManagerService::AddSource(ClientSourceParent* aSource) {
 
     placeHolder.ResolvePromiseIfExists();
     *entry = AsVariant(aSource);
+    AddSourceToOriginIndex(aSource);
     return true;
   }
   if (!mSourceTable.WithEntryHandle(aSource->Info().Id(),
@@ -290,6 +346,7 @@ bool ClientManagerService::AddSource(ClientSourceParent* aSource) {
                                     })) {
     return false;
   }
+  AddSourceToOriginIndex(aSource);
   return true;
 }
 
@@ -300,6 +357,10 @@ bool ClientManagerService::RemoveSource(ClientSourceParent* aSource) {
   if (NS_WARN_IF(!entry)) {
     return false;
   }
+  if (entry.Data().is<ClientSourceParent*>()) {
+    MOZ_ASSERT(entry.Data().as<ClientSourceParent*>() == aSource);
+    RemoveSourceFromOriginIndex(aSource);
+  }
   entry.Remove();
   return true;
 }
@@ -532,38 +593,42 @@ RefPtr<ClientOpPromise> ClientManagerService::MatchAll(
 
   RefPtr<PromiseListHolder> promiseList = new PromiseListHolder();
 
-  for (const auto& entry : mSourceTable) {
-    ClientSourceParent* source = MaybeUnwrapAsExistingSource(entry.GetData());
-
-    if (!source || source->IsFrozen() || !source->ExecutionReady()) {
-      continue;
-    }
+  // Only clients with a matching principal can be returned, and the origin
+  // index keeps those together, so there is no need to walk every client in
+  // the browser for each matchAll() call.
+  nsAutoCString originKey;
+  if (GetOriginIndexKey(principalInfo, originKey)) {
+    if (auto index = mSourcesByOrigin.Lookup(originKey)) {
+      for (ClientSourceParent* source : index.Data()) {
+        MOZ_ASSERT(ClientMatchPrincipalInfo(source->Info().PrincipalInfo(),
+                                            principalInfo));
+
+        if (source->IsFrozen() || !source->ExecutionReady()) {
+          continue;
+        }
 
-    if (aArgs.type() != ClientType::All &&
-        source->Info().Type() != aArgs.type()) {
-      continue;
-    }
+        if (aArgs.type() != ClientType::All &&
+            source->Info().Type() != aArgs.type()) {
+          continue;
+        }
 
-    if (!ClientMatchPrincipalInfo(source->Info().PrincipalInfo(),
-                                  principalInfo)) {
-      continue;
-    }
+        if (!aArgs.includeUncontrolled()) {
+          const Maybe<ServiceWorkerDescriptor>& controller =
+              source->GetController();
+          if (controller.isNothing()) {
+            continue;
+          }
 
-    if (!aArgs.includeUncontrolled()) {
-      const Maybe<ServiceWorkerDescriptor>& controller =
-          source->GetController();
-      if (controller.isNothing()) {
-        continue;
-      }
+          if (controller.ref().Id() != swd.Id() ||
+              controller.ref().Scope() != swd.Scope()) {
+            continue;
+          }
+        }
 
-      if (controller.ref().Id() != swd.Id() ||
-          controller.ref().Scope() != swd.Scope()) {
-        continue;
+        promiseList->AddPromise(source->StartOp(ClientGetInfoAndStateArgs(
+            source->Info().Id(), source->Info().PrincipalInfo())));
       }
     }
-
-    promiseList->AddPromise(source->StartOp(ClientGetInfoAndStateArgs(
-        source->Info().Id(), source->Info().PrincipalInfo())));
   }
 
   // Maybe finish the promise now in case we didn't find any matching clients.
@@ -627,42 +692,42 @@ RefPtr<ClientOpPromise> ClientManagerService::Claim(
 
   RefPtr<PromiseListHolder> promiseList = new PromiseListHolder();
 
-  for (const auto& entry : mSourceTable) {
-    ClientSourceParent* source = MaybeUnwrapAsExistingSource(entry.GetData());
-
-    if (!source) {
-      continue;
-    }
-
-    if (!ClientMatchPrincipalInfo(source->Info().PrincipalInfo(),
-                                  principalInfo)) {
-      continue;
-    }
+  // As in MatchAll(), only same-origin clients can be claimed, so consult
+  // the origin index rather than every client in the browser.
+  nsAutoCString originKey;
+  if (GetOriginIndexKey(principalInfo, originKey)) {
+    if (auto index = mSourcesByOrigin.Lookup(originKey)) {
+      for (ClientSourceParent* source : index.Data()) {
+        MOZ_ASSERT(ClientMatchPrincipalInfo(source->Info().PrincipalInfo(),
+                                            principalInfo));
+
+        const Maybe<ServiceWorkerDescriptor>& controller =
+            source->GetController();
+        if (controller.isSome() &&
+            controller.ref().Scope() == serviceWorker.scope() &&
+            controller.ref().Id() == serviceWorker.id()) {
+          continue;
+        }
 
-    const Maybe<ServiceWorkerDescriptor>& controller = source->GetController();
-    if (controller.isSome() &&
-        controller.ref().Scope() == serviceWorker.scope() &&
-        controller.ref().Id() == serviceWorker.id()) {
-      continue;
-    }
+        // TODO: This logic to determine if a service worker should control
+        //       a particular client should be moved to the
+        //       ServiceWorkerManager.  This can't happen until the SWM is
+        //       moved to the parent process, though.
+        if (!source->ExecutionReady() ||
+            source->Info().Type() == ClientType::Serviceworker ||
+            source->Info().URL().Find(serviceWorker.scope()) != 0) {
+          continue;
+        }
 
-    // TODO: This logic to determine if a service worker should control
-    //       a particular client should be moved to the ServiceWorkerManager.
-    //       This can't happen until the SWM is moved to the parent process,
-    //       though.
-    if (!source->ExecutionReady() ||
-        source->Info().Type() == ClientType::Serviceworker ||
-        source->Info().URL().Find(serviceWorker.scope()) != 0) {
-      continue;
-    }
+        if (source->IsFrozen()) {
+          Unused << source->SendEvictFromBFCache();
+          continue;
+        }
 
-    if (source->IsFrozen()) {
-      Unused << source->SendEvictFromBFCache();
-      continue;
+        promiseList->AddPromise(ClaimOnMainThread(
+            source->Info(), ServiceWorkerDescriptor(serviceWorker)));
+      }
     }
-
-    promiseList->AddPromise(ClaimOnMainThread(
-        source->Info(), ServiceWorkerDescriptor(serviceWorker)));
   }
 
   // Maybe finish the promise now in case we didn't find any matching clients.
@@ -87,6 +87,15 @@ class ClientManagerService final {
   // optimize for insertion, removal, and lookup by UUID.
   nsTHashMap<nsIDHashKey, SourceTableEntry> mSourceTable;
 
+  // Secondary index over mSourceTable keyed by origin.  MatchAll() and
+  // Claim() only ever return clients matching the service worker's principal,
+  // and a busy origin may call clients.matchAll() per push message, so we keep
+  // same-origin sources together instead of walking every client in the
+  // browser on each call.  The index is maintained incrementally by
+  // AddSource() and RemoveSource(); only real ClientSourceParent objects are
+  // indexed, not future sources.
+  nsTHashMap<nsCStringHashKey, nsTArray<ClientSourceParent*>> mSourcesByOrigin;
+
   nsTArray<ClientManagerParent*> mManagerList;
 
   bool mShutdown;
@@ -101,6 +110,16 @@ class ClientManagerService final {
   ClientSourceParent* MaybeUnwrapAsExistingSource(
       const SourceTableEntry& aEntry) const;
 
+  // Computes the key a source with the given principal is indexed under in
+  // mSourcesByOrigin.  Returns false for principals that can never match
+  // another principal (e.g. null principals); such sources are not indexed.
+  static bool GetOriginIndexKey(
+      const mozilla::ipc::PrincipalInfo& aPrincipalInfo, nsACString& aKey);
+
+  void AddSourceToOriginIndex(ClientSourceParent* aSource);
+
+  void RemoveSourceFromOriginIndex(ClientSourceParent* aSource);
+
  public:
   static already_AddRefed<ClientManagerService> GetOrCreateInstance();
 
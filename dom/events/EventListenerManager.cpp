@@ -189,6 +189,7 @@ void EventListenerManager::RemoveAllListenersSilently() {
   }
   mClearingListeners = true;
   mListenerMap.Clear();
+  mListenedTypeBits = 0;
   mClearingListeners = false;
 }
 
@@ -305,6 +306,8 @@ void EventListenerManager::AddEventListenerInternal(
 
   ClearNoListenersForEvents();
   mNoListenerForEventAtom = nullptr;
+  // "All events" listeners match any type, so set every bit in the filter.
+  mListenedTypeBits |= aAllEvents ? ~uint64_t(0) : ListenedTypeBit(aTypeAtom);
 
   Listener* listener = listeners->AppendElement();
   listener->mFlags = aFlags;
@@ -818,6 +821,19 @@ void EventListenerManager::DisableDevice(nsAtom* aTypeAtom) {
   NS_WARNING("Disabling an unknown device sensor.");
 }
 
+void EventListenerManager::RecomputeListenedTypeBits() {
+  uint64_t bits = 0;
+  for (const auto& entry : mListenerMap.mEntries) {
+    if (!entry.mTypeAtom) {
+      // An "all events" entry matches any type.
+      bits = ~uint64_t(0);
+      break;
+    }
+    bits |= ListenedTypeBit(entry.mTypeAtom);
+  }
+  mListenedTypeBits = bits;
+}
+
 void EventListenerManager::NotifyEventListenerRemoved(nsAtom* aUserType) {
   // If the following code is changed, other callsites of EventListenerRemoved
   // and NotifyAboutMainThreadListenerChange should be changed too.
@@ -867,6 +883,7 @@ void EventListenerManager::RemoveEventListenerInternal(
   listenerArray.RemoveElementAt(*listenerIndex);
   if (listenerArray.IsEmpty()) {
     mListenerMap.mEntries.RemoveElementAt(*entryIndex);
+    RecomputeListenedTypeBits();
   }
 
   RefPtr<EventListenerManager> kungFuDeathGrip(this);
@@ -1129,6 +1146,7 @@ void EventListenerManager::RemoveEventHandler(nsAtom* aName) {
   listenerArray.RemoveElementAt(*listenerIndex);
   if (listenerArray.IsEmpty()) {
     mListenerMap.mEntries.RemoveElementAt(*entryIndex);
+    RecomputeListenedTypeBits();
   }
 
   RefPtr<EventListenerManager> kungFuDeathGrip(this);
@@ -1693,6 +1711,7 @@ bool EventListenerManager::HandleEventWithListenerArray(
       mListenerMap.mEntries.RemoveElementsBy([](EventListenerMapEntry& entry) {
         return entry.mListeners->IsEmpty();
       });
+      RecomputeListenedTypeBits();
     }
     if (newLength < oldLength) {
       // Call NotifyEventListenerRemoved once for every removed listener.
@@ -2334,6 +2353,7 @@ void EventListenerManager::RemoveAllListeners() {
       DisableDevice(type);
     }
   }
+  mListenedTypeBits = 0;
 }
 
 already_AddRefed<nsIScriptGlobalObject>
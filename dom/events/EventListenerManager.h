@@ -453,6 +453,16 @@ class EventListenerManager final : public EventListenerManagerBase {
       if (mNoListenerForEventAtom == aEvent->mSpecifiedEventType) {
         return;
       }
+      // mNoListenerForEventAtom only remembers a single type, which is not
+      // enough when several different synthetic event types are being
+      // dispatched at the target. Consult the bloom filter of listened types
+      // too; if the bit for this type is clear, there is definitely no
+      // listener for it.
+      if (aEvent->mSpecifiedEventType &&
+          !(mListenedTypeBits &
+            ListenedTypeBit(aEvent->mSpecifiedEventType))) {
+        return;
+      }
     } else if (mNoListenerForEvents[0] == aEvent->mMessage ||
                mNoListenerForEvents[1] == aEvent->mMessage ||
                mNoListenerForEvents[2] == aEvent->mMessage) {
@@ -758,6 +768,20 @@ class EventListenerManager final : public EventListenerManagerBase {
   bool ListenerCanHandle(const Listener* aListener,
                          const WidgetEvent* aEvent) const;
 
+  /**
+   * The bit in mListenedTypeBits which represents listeners for aTypeAtom.
+   */
+  static uint64_t ListenedTypeBit(nsAtom* aTypeAtom) {
+    return uint64_t(1) << (aTypeAtom->hash() & 63);
+  }
+
+  /**
+   * Recompute mListenedTypeBits from the listener map. Called when an entry
+   * is removed from the map, since individual bits cannot be unset in a bloom
+   * filter.
+   */
+  void RecomputeListenedTypeBits();
+
   // BE AWARE, a lot of instances of EventListenerManager will be created.
   // Therefor, we need to keep this class compact.  When you add integer
   // members, please add them to EventListenerManagerBase and check the size
@@ -771,6 +795,10 @@ class EventListenerManager final : public EventListenerManagerBase {
   EventListenerMap mListenerMap;
   dom::EventTarget* MOZ_NON_OWNING_REF mTarget;
   RefPtr<nsAtom> mNoListenerForEventAtom;
+  // A bloom filter over the type atoms in mListenerMap, with one bit per hash
+  // bucket. A clear bit proves there is no listener for a type without having
+  // to search the map; a set bit proves nothing.
+  uint64_t mListenedTypeBits = 0;
 
   friend class ELMCreationDetector;
   static uint32_t sMainThreadCreatedCount;
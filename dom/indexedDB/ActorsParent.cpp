@@ -4263,6 +4263,17 @@ class CursorBase : public PBackgroundIDBCursorParent {
 
   const int32_t mMaxExtraCount;
 
+  // The initial preload window, also used again after a seek.
+  static constexpr uint32_t kInitialExtraCount = 4;
+
+  // The number of extra records the next open/continue operation attempts to
+  // preload. It starts small and grows geometrically up to mMaxExtraCount
+  // while the consumer keeps iterating sequentially, and is reset on an
+  // explicit continue-to-key, which discards the preloaded records on the
+  // child side. Only accessed on the connection thread, where the operations
+  // of a cursor are strictly serialized.
+  uint32_t mCurrentExtraCount;
+
   const bool mIsSameProcessActor;
 
   struct ConstructFromTransactionBase {};
@@ -11440,6 +11451,8 @@ CursorBase::CursorBase(SafeRefPtr<TransactionBase> aTransaction,
       mObjectStoreId((*mObjectStoreMetadata)->mCommonMetadata.id()),
       mDirection(aDirection),
       mMaxExtraCount(IndexedDatabaseManager::MaxPreloadExtraRecords()),
+      mCurrentExtraCount(
+          std::min(static_cast<uint32_t>(mMaxExtraCount), kInitialExtraCount)),
       mIsSameProcessActor(!BackgroundParent::IsOtherProcessActor(
           mTransaction->GetBackgroundParent())) {
   AssertIsOnBackgroundThread();
@@ -20498,11 +20511,10 @@ nsresult CommonOpenOpHelper<CursorType>::ProcessStatementSteps(
 
   // The degree to which extra responses on OpenOp can actually be used depends
   // on the parameters of subsequent ContinueOp operations, see also comment in
-  // ContinueOp::DoDatabaseWork.
-  //
-  // TODO: We should somehow evaluate the effects of this. Maybe use a smaller
-  // extra count than for ContinueOp?
-  PopulateExtraResponses(aStmt, GetCursor().mMaxExtraCount, responseSize,
+  // ContinueOp::DoDatabaseWork. For that reason, OpenOp uses the initial
+  // (small) preload window; it only grows while ContinueOp operations keep
+  // iterating sequentially.
+  PopulateExtraResponses(aStmt, GetCursor().mCurrentExtraCount, responseSize,
                          "OpenOp"_ns, optPreviousKey);
 
   return NS_OK;
@@ -20534,7 +20546,7 @@ nsresult OpenOpHelper<IDBCursorType::ObjectStore>::DoDatabaseWork(
   // require changes to CursorOpBase::PopulateResponseFromStatement.
   const nsCString firstQuery = queryStart + keyRangeClause + directionClause +
                                kOpenLimit +
-                               IntToCString(1 + GetCursor().mMaxExtraCount);
+                               IntToCString(1 + GetCursor().mCurrentExtraCount);
 
   QM_TRY_INSPECT(const auto& stmt,
                  aConnection->BorrowCachedStatement(firstQuery));
@@ -20662,7 +20674,7 @@ nsresult OpenOpHelper<IDBCursorType::Index>::DoDatabaseWork(
   // require changes to CursorOpBase::PopulateResponseFromStatement.
   const nsCString firstQuery = queryStart + keyRangeClause + directionClause +
                                kOpenLimit +
-                               IntToCString(1 + GetCursor().mMaxExtraCount);
+                               IntToCString(1 + GetCursor().mCurrentExtraCount);
 
   QM_TRY_INSPECT(const auto& stmt,
                  aConnection->BorrowCachedStatement(firstQuery));
@@ -20892,7 +20904,22 @@ nsresult Cursor<CursorType>::ContinueOp::DoDatabaseWork(
   // preload only for an assumed basic operation. Other operations would require
   // more work on the client side for invalidation, and may not make any sense
   // at all.
-  const uint32_t maxExtraCount = hasContinueKey ? 0 : mCursor->mMaxExtraCount;
+  //
+  // Adapt the preload window: grow it geometrically while the consumer keeps
+  // iterating sequentially, so that long scans settle on mMaxExtraCount, and
+  // reset it on an explicit continue-to-key, which discarded any preloaded
+  // records on the child side.
+  if (hasContinueKey) {
+    mCursor->mCurrentExtraCount =
+        std::min(static_cast<uint32_t>(mCursor->mMaxExtraCount),
+                 CursorBase::kInitialExtraCount);
+  } else {
+    mCursor->mCurrentExtraCount =
+        std::min(static_cast<uint32_t>(mCursor->mMaxExtraCount),
+                 mCursor->mCurrentExtraCount * 2);
+  }
+  const uint32_t maxExtraCount =
+      hasContinueKey ? 0 : mCursor->mCurrentExtraCount;
 
   QM_TRY_INSPECT(const auto& stmt,
                  aConnection->BorrowCachedStatement(
@@ -20900,8 +20927,7 @@ nsresult Cursor<CursorType>::ContinueOp::DoDatabaseWork(
                          hasContinueKey, hasContinuePrimaryKey)));
 
   QM_TRY(MOZ_TO_RESULT(stmt->BindUTF8StringByName(
-      kStmtParamNameLimit,
-      IntToCString(advanceCount + mCursor->mMaxExtraCount))));
+      kStmtParamNameLimit, IntToCString(advanceCount + maxExtraCount))));
 
   QM_TRY(MOZ_TO_RESULT(stmt->BindInt64ByName(kStmtParamNameId, mCursor->Id())));
 
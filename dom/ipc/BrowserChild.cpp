@@ -317,10 +317,9 @@ BrowserChild::BrowserChild(ContentChild* aManager, const TabId& aTabId,
                NestedBrowserChildMap().end());
     NestedBrowserChildMap()[mUniqueId] = this;
   }
-  mCoalesceMouseMoveEvents = StaticPrefs::dom_events_coalesce_mousemove();
-  if (mCoalesceMouseMoveEvents) {
-    mCoalescedMouseEventFlusher = new CoalescedMouseMoveFlusher(this);
-  }
+  // mCoalescedMouseEventFlusher is created lazily in
+  // ShouldCoalesceMouseMoveEvents() so that toggling
+  // dom.events.coalesce.mousemove at runtime takes effect for existing tabs.
 
   if (StaticPrefs::dom_events_coalesce_touchmove()) {
     mCoalescedTouchMoveEventFlusher = new CoalescedTouchMoveFlusher(this);
@@ -1459,8 +1458,8 @@ void BrowserChild::ProcessPendingCoalescedTouchData() {
 }
 
 void BrowserChild::ProcessPendingCoalescedMouseDataAndDispatchEvents() {
-  if (!mCoalesceMouseMoveEvents || !mCoalescedMouseEventFlusher) {
-    // We don't enable mouse coalescing or we are destroying BrowserChild.
+  if (!mCoalescedMouseEventFlusher) {
+    // We never enabled mouse coalescing or we are destroying BrowserChild.
     return;
   }
 
@@ -1518,8 +1517,20 @@ Maybe<ScreenRect> BrowserChild::GetTopLevelViewportVisibleRectInBrowserCoords()
   return Some(mTopLevelViewportVisibleRectInBrowserCoords);
 }
 
+bool BrowserChild::ShouldCoalesceMouseMoveEvents() {
+  // Consult the pref dynamically, rather than latching it at construction, so
+  // that flipping it affects tabs which already exist.
+  if (mDestroyed || !StaticPrefs::dom_events_coalesce_mousemove()) {
+    return false;
+  }
+  if (!mCoalescedMouseEventFlusher) {
+    mCoalescedMouseEventFlusher = new CoalescedMouseMoveFlusher(this);
+  }
+  return true;
+}
+
 void BrowserChild::FlushAllCoalescedMouseData() {
-  MOZ_ASSERT(mCoalesceMouseMoveEvents);
+  MOZ_ASSERT(mCoalescedMouseEventFlusher);
 
   // Move all entries from mCoalescedMouseData to mToBeDispatchedMouseData.
   for (const auto& data : mCoalescedMouseData.Values()) {
@@ -1538,7 +1549,7 @@ void BrowserChild::FlushAllCoalescedMouseData() {
 mozilla::ipc::IPCResult BrowserChild::RecvRealMouseMoveEvent(
     const WidgetMouseEvent& aEvent, const ScrollableLayerGuid& aGuid,
     const uint64_t& aInputBlockId) {
-  if (mCoalesceMouseMoveEvents && mCoalescedMouseEventFlusher) {
+  if (ShouldCoalesceMouseMoveEvents()) {
     CoalescedMouseData* data =
         mCoalescedMouseData.GetOrInsertNew(aEvent.pointerId);
     MOZ_ASSERT(data);
@@ -1651,8 +1662,10 @@ mozilla::ipc::IPCResult BrowserChild::RecvNormalPrioritySynthMouseMoveEvent(
 mozilla::ipc::IPCResult BrowserChild::RecvRealMouseButtonEvent(
     const WidgetMouseEvent& aEvent, const ScrollableLayerGuid& aGuid,
     const uint64_t& aInputBlockId) {
-  if (mCoalesceMouseMoveEvents && mCoalescedMouseEventFlusher &&
-      aEvent.mMessage != eMouseMove) {
+  // Key off the flusher rather than the pref here: if the pref was just
+  // turned off, any already-coalesced mousemove events still have to be
+  // dispatched before this event to preserve ordering.
+  if (mCoalescedMouseEventFlusher && aEvent.mMessage != eMouseMove) {
     // When receiving a mouse event other than mousemove, we have to dispatch
     // all coalesced events before it. However, we can't dispatch all pending
     // coalesced events directly because we may reentry the event loop while
@@ -640,6 +640,11 @@ class BrowserChild final : public nsMessageManagerScriptExecutor,
   // called when dispatching some mouse events other than mousemove.
   void FlushAllCoalescedMouseData();
 
+  // Returns true if incoming mousemove events should go through the
+  // coalescing queue, consulting dom.events.coalesce.mousemove dynamically
+  // and creating mCoalescedMouseEventFlusher on first use.
+  bool ShouldCoalesceMouseMoveEvents();
+
   void ProcessPendingCoalescedMouseDataAndDispatchEvents();
 
   void ProcessPendingCoalescedTouchData();
@@ -892,8 +897,6 @@ class BrowserChild final : public nsMessageManagerScriptExecutor,
 
   bool mSkipKeyPress : 1;
 
-  bool mCoalesceMouseMoveEvents : 1;
-
   bool mShouldSendWebProgressEventsToParent : 1;
 
   // Whether we are rendering to the compositor or not.
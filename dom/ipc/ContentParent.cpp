@@ -42,6 +42,7 @@
 #include "mozilla/ipc/URIUtils.h"
 #include "gfxPlatform.h"
 #include "gfxPlatformFontList.h"
+#include "SharedShapedWordCache.h"
 #include "nsDNSService2.h"
 #include "nsPIDNSService.h"
 #include "mozilla/AntiTrackingUtils.h"
@@ -5598,6 +5599,14 @@ mozilla::ipc::IPCResult ContentParent::RecvGetFontListShmBlock(
   return IPC_OK();
 }
 
+mozilla::ipc::IPCResult ContentParent::RecvGetSharedShapedWordCache(
+    ReadOnlySharedMemoryHandle* aOut) {
+  if (auto* cache = SharedShapedWordCache::Get()) {
+    *aOut = cache->CloneHandle();
+  }
+  return IPC_OK();
+}
+
 mozilla::ipc::IPCResult ContentParent::RecvInitializeFamily(
     const uint32_t& aGeneration, const uint32_t& aFamilyIndex,
     const bool& aLoadCmaps) {
@@ -1124,6 +1124,9 @@ class ContentParent final : public PContentParent,
       const uint32_t& aGeneration, const uint32_t& aIndex,
       mozilla::ipc::ReadOnlySharedMemoryHandle* aOut);
 
+  mozilla::ipc::IPCResult RecvGetSharedShapedWordCache(
+      mozilla::ipc::ReadOnlySharedMemoryHandle* aOut);
+
   mozilla::ipc::IPCResult RecvInitializeFamily(const uint32_t& aGeneration,
                                                const uint32_t& aFamilyIndex,
                                                const bool& aLoadCmaps);
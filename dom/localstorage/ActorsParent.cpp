@@ -49,6 +49,7 @@
 #include "mozilla/StaticPrefs_dom.h"
 #include "mozilla/StaticPtr.h"
 #include "mozilla/StoragePrincipalHelper.h"
+#include "mozilla/TimeStamp.h"
 #include "mozilla/UniquePtr.h"
 #include "mozilla/Unused.h"
 #include "mozilla/Utf8.h"
@@ -278,6 +279,18 @@ static const uint32_t kUsageFileCookie = 0x420a420a;
  */
 const uint32_t kFlushTimeoutMs = 5000;
 
+/**
+ * How long the flush timer waits for the current write burst to go idle
+ * before actually flushing.  Each update batch that arrives while a flush is
+ * pending re-arms the timer with this timeout, so a burst of writes is
+ * coalesced into a single transaction that is committed shortly after the
+ * burst ends rather than sitting unflushed for the full kFlushTimeoutMs.
+ * kFlushTimeoutMs still acts as a hard deadline relative to the first
+ * unflushed write, so content that writes continuously cannot postpone the
+ * flush indefinitely.
+ */
+const uint32_t kFlushIdleTimeoutMs = 500;
+
 const bool kDefaultShadowWrites = false;
 const uint32_t kDefaultSnapshotPrefill = 16384;
 const uint32_t kDefaultSnapshotGradualPrefill = 4096;
@@ -1270,6 +1283,12 @@ class Connection final : public CachingDatabaseConnection {
   const bool mDatabaseWasNotAvailable;
   bool mHasCreatedDatabase;
   bool mFlushScheduled;
+  /**
+   * The latest time at which the currently scheduled flush may fire, set when
+   * the flush is first scheduled.  PostponeFlush never re-arms the flush timer
+   * past this point.
+   */
+  TimeStamp mFlushDeadline;
 #ifdef DEBUG
   bool mInUpdateBatch;
   bool mFinished;
@@ -1355,6 +1374,8 @@ class Connection final : public CachingDatabaseConnection {
 
   void ScheduleFlush();
 
+  void PostponeFlush();
+
   void Flush();
 
   static void FlushTimerCallback(nsITimer* aTimer, void* aClosure);
@@ -4063,8 +4084,12 @@ void Connection::EndUpdateBatch() {
   AssertIsOnOwningThread();
   MOZ_ASSERT(mInUpdateBatch);
 
-  if (mWriteOptimizer.HasWrites() && !mFlushScheduled) {
-    ScheduleFlush();
+  if (mWriteOptimizer.HasWrites()) {
+    if (!mFlushScheduled) {
+      ScheduleFlush();
+    } else {
+      PostponeFlush();
+    }
   }
 
 #ifdef DEBUG
@@ -4227,13 +4252,39 @@ void Connection::ScheduleFlush() {
     MOZ_ASSERT(mFlushTimer);
   }
 
+  mFlushDeadline =
+      TimeStamp::Now() + TimeDuration::FromMilliseconds(kFlushTimeoutMs);
+
   MOZ_ALWAYS_SUCCEEDS(mFlushTimer->InitWithNamedFuncCallback(
-      FlushTimerCallback, this, kFlushTimeoutMs, nsITimer::TYPE_ONE_SHOT,
+      FlushTimerCallback, this, kFlushIdleTimeoutMs, nsITimer::TYPE_ONE_SHOT,
       "Connection::FlushTimerCallback"));
 
   mFlushScheduled = true;
 }
 
+void Connection::PostponeFlush() {
+  AssertIsOnOwningThread();
+  MOZ_ASSERT(mWriteOptimizer.HasWrites());
+  MOZ_ASSERT(mFlushScheduled);
+  MOZ_ASSERT(mFlushTimer);
+
+  // The write burst is still in progress, so postpone the flush until the
+  // burst goes idle.  If the deadline is too close to fit another full idle
+  // timeout, just let the already armed timer fire (every arming of the timer
+  // keeps the firing time at or before mFlushDeadline, so the deadline can't
+  // be exceeded).
+  const TimeDuration remaining = mFlushDeadline - TimeStamp::Now();
+  if (remaining.ToMilliseconds() <= kFlushIdleTimeoutMs) {
+    return;
+  }
+
+  MOZ_ALWAYS_SUCCEEDS(mFlushTimer->Cancel());
+
+  MOZ_ALWAYS_SUCCEEDS(mFlushTimer->InitWithNamedFuncCallback(
+      FlushTimerCallback, this, kFlushIdleTimeoutMs, nsITimer::TYPE_ONE_SHOT,
+      "Connection::FlushTimerCallback"));
+}
+
 void Connection::Flush() {
   AssertIsOnOwningThread();
   MOZ_ASSERT(mFlushScheduled);
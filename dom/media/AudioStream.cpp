@@ -460,6 +460,26 @@ int64_t AudioStream::GetPositionInFramesUnlocked() {
   if (rv != CUBEB_OK) {
     return -1;
   }
+
+#ifdef MOZ_REAL_TIME_TRACING
+  // While we're here, off the real-time thread, record the device-reported
+  // output latency alongside the position query, so profiles taken for
+  // glitch reports show what the backend claimed the latency was at the
+  // time of the glitch.
+  if (gAudioCallbackTraceLogger.Enabled()) {
+    uint32_t latencyFrames = 0;
+#  ifndef XP_MACOSX
+    int latencyRv = InvokeCubeb(cubeb_stream_get_latency, &latencyFrames);
+#  else
+    int latencyRv =
+        cubeb_stream_get_latency(mCubebStream.get(), &latencyFrames);
+#  endif
+    if (latencyRv == CUBEB_OK) {
+      TRACE_COMMENT("AudioStream::DeviceLatency", "%u frames", latencyFrames);
+    }
+  }
+#endif
+
   return static_cast<int64_t>(std::min<uint64_t>(position, INT64_MAX));
 }
 
@@ -31,6 +31,7 @@
 #include "prio.h"
 #include "VideoUtils.h"
 #include <algorithm>
+#include <limits>
 
 namespace mozilla {
 
@@ -1532,6 +1533,12 @@ void MediaCache::DetermineActionsForStreams(AutoLock& aLock,
         // Don't read ahead more than this much
         LOG("Stream %p throttling to avoid reading ahead too far", stream);
         enableReading = false;
+      } else if (predictedNewDataUse.ToSeconds() >
+                 stream->AdaptiveReadaheadSeconds(aNow)) {
+        // This stream has been seeking frequently, so its readahead is
+        // likely to be discarded by the next seek before it is played.
+        LOG("Stream %p throttling readahead after frequent seeks", stream);
+        enableReading = false;
       } else if (aFreeBlockCount > 0) {
         // Free blocks in the cache, so keep reading
         LOG("Stream %p reading since there are free blocks", stream);
@@ -2411,11 +2418,38 @@ nsresult MediaCacheStream::Seek(AutoLock& aLock, int64_t aOffset) {
   int64_t oldOffset = mStreamOffset;
   mStreamOffset = aOffset;
   LOG("Stream %p Seek to %" PRId64, this, mStreamOffset);
+
+  // Track how often this stream seeks so the cache can adapt its readahead.
+  TimeStamp now = TimeStamp::Now();
+  if (!mLastSeekTime.IsNull()) {
+    double interval = (now - mLastSeekTime).ToSeconds();
+    mAverageSeekInterval = mAverageSeekInterval == 0.0
+                               ? interval
+                               : 0.7 * mAverageSeekInterval + 0.3 * interval;
+  }
+  mLastSeekTime = now;
+
   mMediaCache->NoteSeek(aLock, this, oldOffset);
   mMediaCache->QueueUpdate(aLock);
   return NS_OK;
 }
 
+double MediaCacheStream::AdaptiveReadaheadSeconds(const TimeStamp& aNow) const {
+  // A stream being seeked frequently rarely plays through its readahead
+  // before the next seek discards it, so there is little point reading ahead
+  // much further than the typical interval between its seeks - doing so just
+  // evicts blocks that steadily-playing streams are about to use.  Once the
+  // stream goes unseeked for longer than that interval, the cap lapses and
+  // the global readahead policy applies again.
+  if (mAverageSeekInterval == 0.0 || mLastSeekTime.IsNull() ||
+      (aNow - mLastSeekTime).ToSeconds() > mAverageSeekInterval) {
+    return std::numeric_limits<double>::infinity();
+  }
+  // Keep a couple of seconds of runway so playback right after a seek isn't
+  // starved.
+  return std::max(2.0, mAverageSeekInterval);
+}
+
 void MediaCacheStream::ThrottleReadahead(bool bThrottle) {
   MOZ_ASSERT(NS_IsMainThread());
 
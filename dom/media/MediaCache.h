@@ -11,6 +11,7 @@
 #include "Intervals.h"
 #include "mozilla/Monitor.h"
 #include "mozilla/Result.h"
+#include "mozilla/TimeStamp.h"
 #include "mozilla/UniquePtr.h"
 #include "mozilla/dom/MediaDebugInfoBinding.h"
 #include "nsCOMPtr.h"
@@ -533,6 +534,19 @@ class MediaCacheStream : public DecoderDoctorLifeLogger<MediaCacheStream> {
 
   bool mThrottleReadahead = false;
 
+  // How many seconds of readahead this stream is currently worth, given its
+  // recent seek behaviour.  Returns infinity when the stream isn't seeking
+  // frequently, in which case the global readahead policy applies unchanged.
+  // Must be called with the cache monitor held.
+  double AdaptiveReadaheadSeconds(const TimeStamp& aNow) const;
+
+  // Time of the most recent Seek() call.  Null until the first seek.
+  // Protected by the cache monitor.
+  TimeStamp mLastSeekTime;
+  // Exponential moving average of the interval between seeks, in seconds.
+  // Zero until the second seek.  Protected by the cache monitor.
+  double mAverageSeekInterval = 0.0;
+
   // Data received for the block containing mChannelOffset. Data needs
   // to wait here so we can write back a complete block. The first
   // mChannelOffset%BLOCK_SIZE bytes have been filled in with good data,
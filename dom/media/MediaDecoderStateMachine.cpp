@@ -7,6 +7,7 @@
 #include "MediaDecoderStateMachine.h"
 
 #include <algorithm>
+#include <cmath>
 #include <stdint.h>
 #include <utility>
 
@@ -143,6 +144,15 @@ static const uint32_t HW_VIDEO_QUEUE_SIZE = 3;
 #endif
 static const uint32_t VIDEO_QUEUE_SEND_TO_COMPOSITOR_SIZE = 9999;
 
+// Bounds for the adaptive decode-ahead multiplier applied to
+// GetAmpleVideoFrames(). The multiplier is grown when the worst-case video
+// decode latency estimate approaches the duration of a frame, so that
+// playback can ride out CPU-spiky periods, and shrunk back towards the
+// minimum when decode is consistently fast, to give memory back. See
+// UpdateVideoDecodeAhead.
+static const double MIN_DECODE_AHEAD_SCALE = 0.5;
+static const double MAX_DECODE_AHEAD_SCALE = 3.0;
+
 static uint32_t sVideoQueueDefaultSize = MAX_VIDEO_QUEUE_SIZE;
 static uint32_t sVideoQueueHWAccelSize = HW_VIDEO_QUEUE_SIZE;
 static uint32_t sVideoQueueSendToCompositorSize =
@@ -4014,7 +4024,8 @@ void MediaDecoderStateMachine::RequestVideoData(
           mBypassingSkipToNextKeyFrameCheck ? false : aRequestNextKeyFrame)
       ->Then(
           OwnerThread(), __func__,
-          [this, self, perfRecorder(std::move(perfRecorder))](
+          [this, self, perfRecorder(std::move(perfRecorder)),
+           requestTime = TimeStamp::Now()](
               const RefPtr<VideoData>& aVideo) mutable {
             perfRecorder.Record();
             AUTO_PROFILER_LABEL(
@@ -4022,6 +4033,8 @@ void MediaDecoderStateMachine::RequestVideoData(
                 MEDIA_PLAYBACK);
             MOZ_ASSERT(aVideo);
             mVideoDataRequest.Complete();
+            UpdateVideoDecodeAhead(TimeStamp::Now() - requestTime,
+                                   aVideo->mDuration);
             // Handle abnormal or negative timestamps.
             mDecodedVideoEndTime =
                 std::max(mDecodedVideoEndTime, aVideo->GetEndTime());
@@ -4656,9 +4669,69 @@ void MediaDecoderStateMachine::OnMediaSinkAudioError(nsresult aResult) {
 
 uint32_t MediaDecoderStateMachine::GetAmpleVideoFrames() const {
   MOZ_ASSERT(OnTaskQueue());
-  return mReader->VideoIsHardwareAccelerated()
-             ? std::max<uint32_t>(sVideoQueueHWAccelSize, MIN_VIDEO_QUEUE_SIZE)
-             : std::max<uint32_t>(sVideoQueueDefaultSize, MIN_VIDEO_QUEUE_SIZE);
+  const uint32_t ample =
+      mReader->VideoIsHardwareAccelerated()
+          ? std::max<uint32_t>(sVideoQueueHWAccelSize, MIN_VIDEO_QUEUE_SIZE)
+          : std::max<uint32_t>(sVideoQueueDefaultSize, MIN_VIDEO_QUEUE_SIZE);
+  return std::max<uint32_t>(static_cast<uint32_t>(ample * mDecodeAheadScale),
+                            MIN_VIDEO_QUEUE_SIZE);
+}
+
+void MediaDecoderStateMachine::UpdateVideoDecodeAhead(
+    TimeDuration aDecodeTime, const media::TimeUnit& aFrameDuration) {
+  MOZ_ASSERT(OnTaskQueue());
+  // The time budget to decode a frame in, to keep up with playback.
+  const double budgetMs =
+      aFrameDuration.ToSeconds() * 1000.0 / (mPlaybackRate ? mPlaybackRate : 1);
+  if (budgetMs <= 0.0) {
+    return;
+  }
+
+  // Smooth the latency and its deviation in the style of an RTT estimator, so
+  // that a single slow frame doesn't thrash the queue size, while a spiky
+  // period does register through the deviation term.
+  const double latencyMs = aDecodeTime.ToMilliseconds();
+  mVideoDecodeLatencyAvgMs += (latencyMs - mVideoDecodeLatencyAvgMs) / 8.0;
+  mVideoDecodeLatencyDevMs +=
+      (std::abs(latencyMs - mVideoDecodeLatencyAvgMs) -
+       mVideoDecodeLatencyDevMs) /
+      8.0;
+
+  // Worst-case estimate of the time the next decode may take.
+  const double worstCaseMs =
+      mVideoDecodeLatencyAvgMs + 4.0 * mVideoDecodeLatencyDevMs;
+
+  double scale = mDecodeAheadScale;
+  if (worstCaseMs >= budgetMs) {
+    // A decode spike could outrun playback, keep more frames ahead so that
+    // the queue can absorb it. Grow quickly, a stall is worse than the extra
+    // memory.
+    scale = std::min(scale * 1.25, MAX_DECODE_AHEAD_SCALE);
+  } else if (worstCaseMs < budgetMs / 4.0) {
+    // Decode is consistently much faster than playback, slowly give the
+    // extra frames back.
+    scale = std::max(scale * 0.95, MIN_DECODE_AHEAD_SCALE);
+  }
+  if (scale == mDecodeAheadScale) {
+    return;
+  }
+
+  const uint32_t ampleBefore = GetAmpleVideoFrames();
+  mDecodeAheadScale = scale;
+  const uint32_t ampleAfter = GetAmpleVideoFrames();
+  if (ampleBefore != ampleAfter) {
+    LOG("Adaptive decode-ahead: scale=%.2f ample video frames %u -> %u "
+        "(latency=%.1fms dev=%.1fms budget=%.1fms)",
+        mDecodeAheadScale, ampleBefore, ampleAfter, mVideoDecodeLatencyAvgMs,
+        mVideoDecodeLatencyDevMs, budgetMs);
+    PROFILER_MARKER_TEXT(
+        "MDSM::DecodeAheadScale", MEDIA_PLAYBACK, {},
+        nsPrintfCString("scale=%.2f ample=%u latency=%.1fms dev=%.1fms "
+                        "budget=%.1fms",
+                        mDecodeAheadScale, ampleAfter,
+                        mVideoDecodeLatencyAvgMs, mVideoDecodeLatencyDevMs,
+                        budgetMs));
+  }
 }
 
 void MediaDecoderStateMachine::GetDebugInfo(
@@ -454,6 +454,22 @@ class MediaDecoderStateMachine
   // Must hold monitor.
   uint32_t GetAmpleVideoFrames() const;
 
+  // Adjusts mDecodeAheadScale from the observed decode latency of a video
+  // sample versus the time budget its duration allows at the current playback
+  // rate.
+  void UpdateVideoDecodeAhead(TimeDuration aDecodeTime,
+                              const media::TimeUnit& aFrameDuration);
+
+  // Multiplier applied to the video queue target in GetAmpleVideoFrames().
+  // Grown when the worst-case decode latency estimate approaches the frame
+  // duration, shrunk back when decode is consistently fast.
+  double mDecodeAheadScale = 1.0;
+
+  // Smoothed video decode latency and its mean absolute deviation, in
+  // milliseconds, maintained in the style of an RTT estimator.
+  double mVideoDecodeLatencyAvgMs = 0.0;
+  double mVideoDecodeLatencyDevMs = 0.0;
+
   // Our "ample" audio threshold. Once we've this much audio decoded, we
   // pause decoding.
   media::TimeUnit mAmpleAudioThreshold;
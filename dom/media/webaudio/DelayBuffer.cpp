@@ -156,13 +156,84 @@ void DelayBuffer::ReadChannels(const float aPerFrameDelays[WEBAUDIO_BLOCK_SIZE],
 
 void DelayBuffer::Read(float aDelayTicks, AudioBlock* aOutputChunk,
                        ChannelInterpretation aChannelInterpretation) {
-  float computedDelay[WEBAUDIO_BLOCK_SIZE];
+  int chunkCount = mChunks.Length();
+  if (!chunkCount) {
+    aOutputChunk->SetNull(WEBAUDIO_BLOCK_SIZE);
+    return;
+  }
 
-  for (unsigned i = 0; i < WEBAUDIO_BLOCK_SIZE; ++i) {
-    computedDelay[i] = aDelayTicks;
+  MOZ_ASSERT(aDelayTicks >= 0.0f);
+  MOZ_ASSERT(aDelayTicks <= (chunkCount - 1) * WEBAUDIO_BLOCK_SIZE);
+
+  // With a constant delay the read position advances in lockstep with the
+  // write position, so each interpolation tap reads a contiguous range of the
+  // circular buffer.  That lets the taps be added with the vectorized buffer
+  // helpers instead of the per-frame chunk arithmetic in ReadChannels.
+  int floorDelay = int(aDelayTicks);
+  float interpolationFactor = aDelayTicks - floorDelay;
+
+  // Determine the output channel count from the chunks touched by the two
+  // taps, as Read(const float[]) does for the general case.
+  int oldestChunk =
+      ChunkForDelay(floorDelay + (interpolationFactor != 0.0f ? 1 : 0));
+  int youngestChunk = ChunkForDelay(floorDelay - (WEBAUDIO_BLOCK_SIZE - 1));
+
+  uint32_t channelCount = 0;
+  for (int i = oldestChunk; true; i = (i + 1) % chunkCount) {
+    channelCount =
+        GetAudioChannelsSuperset(channelCount, mChunks[i].ChannelCount());
+    if (i == youngestChunk) {
+      break;
+    }
   }
 
-  Read(computedDelay, aOutputChunk, aChannelInterpretation);
+  if (!channelCount) {
+    aOutputChunk->SetNull(WEBAUDIO_BLOCK_SIZE);
+    return;
+  }
+
+  aOutputChunk->AllocateChannels(channelCount);
+  if (mUpmixChannels.Length() != channelCount) {
+    mLastReadChunk = -1;  // invalidate cache
+  }
+  for (uint32_t channel = 0; channel < channelCount; ++channel) {
+    PodZero(aOutputChunk->ChannelFloatsForWrite(channel), WEBAUDIO_BLOCK_SIZE);
+  }
+
+  // As in ReadChannels, the older tap (with the larger delay) comes first and
+  // is weighted by the fractional part of the delay.
+  int tapPositions[2];
+  tapPositions[1] = PositionForDelay(floorDelay);
+  tapPositions[0] = tapPositions[1] - 1;
+
+  for (unsigned tick = 0; tick < std::size(tapPositions);
+       ++tick, interpolationFactor = 1.0f - interpolationFactor) {
+    // Skip the older tap entirely for integer delays; its position may be
+    // outside the range considered for determining channelCount.
+    if (interpolationFactor == 0.0f) {
+      continue;
+    }
+
+    // A block-sized span crosses at most one chunk boundary, because chunks
+    // are block-sized and writes are block-aligned.
+    uint32_t done = 0;
+    while (done < WEBAUDIO_BLOCK_SIZE) {
+      int readChunk = ChunkForPosition(tapPositions[tick] + done);
+      int readOffset = OffsetForPosition(tapPositions[tick] + done);
+      uint32_t count = std::min<uint32_t>(WEBAUDIO_BLOCK_SIZE - done,
+                                          WEBAUDIO_BLOCK_SIZE - readOffset);
+      if (!mChunks[readChunk].IsNull()) {
+        UpdateUpmixChannels(readChunk, channelCount, aChannelInterpretation);
+        float multiplier = interpolationFactor * mChunks[readChunk].mVolume;
+        for (uint32_t channel = 0; channel < channelCount; ++channel) {
+          AudioBufferAddWithScale(
+              mUpmixChannels[channel] + readOffset, multiplier,
+              aOutputChunk->ChannelFloatsForWrite(channel) + done, count);
+        }
+      }
+      done += count;
+    }
+  }
 }
 
 bool DelayBuffer::EnsureBuffer() {
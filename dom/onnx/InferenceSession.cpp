@@ -5,6 +5,8 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 #include "mozilla/dom/InferenceSession.h"
 #include <prlink.h>
+#include <prsystem.h>
+#include <algorithm>
 #include "mozilla/ScopeExit.h"
 #include "mozilla/Logging.h"
 #include <thread>
@@ -109,8 +111,8 @@ OrtSessionOptions* ToOrtSessionOption(
 
   LOGD("Inter op num threads: {}", aOptions.mInterOpNumThreads);
   CALL_API(SetInterOpNumThreads, aOptions.mInterOpNumThreads);
-  LOGD("Inter op num threads: {}", aOptions.mIntraOpNumThreads);
-  CALL_API(SetInterOpNumThreads, aOptions.mIntraOpNumThreads);
+  LOGD("Intra op num threads: {}", aOptions.mIntraOpNumThreads);
+  CALL_API(SetIntraOpNumThreads, aOptions.mIntraOpNumThreads);
   CALL_API(SetSessionLogId, aOptions.mLogId.get());
   CALL_API(SetSessionLogSeverityLevel, aOptions.mLogSeverityLevel);
   CALL_API(SetSessionLogVerbosityLevel, aOptions.mLogVerbosityLevel);
@@ -273,6 +275,20 @@ void WrapProfilerUnregister(OrtCustomThreadHandle thread) {
   delete t;
 }
 
+// Gecko sizes its own helper thread pools (GC, JIT compilation, media
+// decoding) from the core count, so give the shared onnxruntime pools the
+// remaining budget instead of letting both sides assume they own the
+// machine. Inference runs concurrently with page work and oversubscription
+// shows up as latency, not throughput.
+static int ClampToHelperThreadBudget(int64_t aRequested) {
+  int cores = std::max<int>(PR_GetNumberOfProcessors(), 1);
+  int budget = std::max(cores - 2, 1);
+  if (aRequested <= 0) {
+    return budget;
+  }
+  return std::min(AssertedCast<int>(aRequested), budget);
+}
+
 RefPtr<Promise> InferenceSession::Create(
     GlobalObject& aGlobal, const UTF8StringOrUint8Array& aUriOrBuffer,
     const InferenceSessionSessionOptions& aOptions, ErrorResult& aRv) {
@@ -322,7 +338,8 @@ void InferenceSession::Init(const RefPtr<Promise>& aPromise,
     }
 
     status = sAPI->SetGlobalInterOpNumThreads(
-        threadingOptions, AssertedCast<int>(aOptions.mInterOpNumThreads));
+        threadingOptions,
+        ClampToHelperThreadBudget(aOptions.mInterOpNumThreads));
     if (status) {
       LOGD("SetGlobalInterOpNumThreads error");
       aPromise->MaybeRejectWithUndefined();
@@ -330,7 +347,8 @@ void InferenceSession::Init(const RefPtr<Promise>& aPromise,
     }
 
     status = sAPI->SetGlobalIntraOpNumThreads(
-        threadingOptions, AssertedCast<int>(aOptions.mIntraOpNumThreads));
+        threadingOptions,
+        ClampToHelperThreadBudget(aOptions.mIntraOpNumThreads));
     if (status) {
       LOGD("SetGlobalIntraOpNumThreads error");
       aPromise->MaybeRejectWithUndefined();
@@ -473,6 +491,7 @@ already_AddRefed<Promise> InferenceSession::Run(
   }
   OrtValue** ptr = outputs.Elements();
 
+  TimeStamp runStart = TimeStamp::Now();
   {
     AUTO_PROFILER_MARKER_UNTYPED("Ort::Run", ML_INFERENCE, {});
     status = sAPI->Run(mSession,
@@ -481,6 +500,11 @@ already_AddRefed<Promise> InferenceSession::Run(
                        inputNamesPtrs.Length(), outputNamesPtrs.Elements(),
                        outputNamesPtrs.Length(), ptr);
   }
+  TimeDuration runTime = TimeStamp::Now() - runStart;
+  mRunCount++;
+  mTotalRunTime += runTime;
+  LOGD("Run #{} took {:.3f}ms (average over session: {:.3f}ms)", mRunCount,
+       runTime.ToMilliseconds(), mTotalRunTime.ToMilliseconds() / mRunCount);
   if (status) {
     LOGD("Session Run failed: {}", status.Message());
     p->MaybeReject(NS_ERROR_UNEXPECTED);
@@ -552,9 +576,9 @@ already_AddRefed<Promise> InferenceSession::Run(
     }
 
     // TODO skip this copy by using CreateTensorWithDataAsOrtValue
-    nsTArray<uint8_t> output;
-    output.AppendElements(outputData,
-                          outputSize * Tensor::DataTypeSize(outputTensorType));
+    size_t outputBytes = outputSize * Tensor::DataTypeSize(outputTensorType);
+    nsTArray<uint8_t> output = Tensor::TakeRecycledBuffer(outputBytes);
+    output.AppendElements(outputData, outputBytes);
     GlobalObject global(mCtx, GetParentObject()->GetGlobalJSObject());
     auto outputTensor = MakeRefPtr<Tensor>(global, outputTensorType,
                                            std::move(output), std::move(dims));
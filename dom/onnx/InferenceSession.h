@@ -15,6 +15,7 @@
 #include "mozilla/dom/IOUtilsBinding.h"
 #include "mozilla/dom/ONNXBinding.h"
 #include "mozilla/dom/onnxruntime_c_api.h"
+#include "mozilla/TimeStamp.h"
 #include "nsISupports.h"
 #include "nsCycleCollectionParticipant.h"
 #include "nsWrapperCache.h"
@@ -87,6 +88,10 @@ class InferenceSession final : public nsISupports, public nsWrapperCache {
   JSContext* mCtx;
   OrtSessionOptions* mOptions = nullptr;
   OrtSession* mSession = nullptr;
+  // Per-run latency accounting, reported through MOZ_LOG next to the
+  // profiler markers emitted by Run().
+  uint32_t mRunCount = 0;
+  TimeDuration mTotalRunTime;
 };
 
 }  // namespace mozilla::dom
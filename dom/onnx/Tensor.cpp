@@ -10,7 +10,9 @@
 #include "js/BigInt.h"
 #include "js/Value.h"
 #include "mozilla/Assertions.h"
+#include "mozilla/ClearOnShutdown.h"
 #include "mozilla/Logging.h"
+#include "mozilla/StaticPtr.h"
 #include "mozilla/RefPtr.h"
 #include "mozilla/dom/ONNXBinding.h"
 #include "mozilla/dom/ScriptSettings.h"
@@ -19,6 +21,7 @@
 #include "mozilla/dom/Promise.h"
 #include "nsStringFwd.h"
 #include "nsTArray.h"
+#include "nsThreadUtils.h"
 #include "mozilla/dom/ToJSValue.h"
 
 extern mozilla::LazyLogModule gONNXLog;
@@ -35,6 +38,58 @@ NS_INTERFACE_MAP_BEGIN_CYCLE_COLLECTION(Tensor)
   NS_INTERFACE_MAP_ENTRY(nsISupports)
 NS_INTERFACE_MAP_END
 
+// Buffers donated by disposed tensors, waiting to be reused. The pool is
+// intentionally tiny: a model has a handful of outputs and the buffers of
+// one run are recycled before the next run allocates.
+static constexpr size_t kMaxRecycledBuffers = 8;
+static StaticAutoPtr<nsTArray<nsTArray<uint8_t>>> sRecycledBuffers;
+
+/* static */
+nsTArray<uint8_t> Tensor::TakeRecycledBuffer(size_t aByteLength) {
+  MOZ_ASSERT(NS_IsMainThread());
+  nsTArray<uint8_t> buffer;
+  if (!sRecycledBuffers || !aByteLength) {
+    return buffer;
+  }
+  // Pick the smallest buffer that fits so that large buffers stay
+  // available for the tensors which actually need them.
+  size_t best = nsTArray<nsTArray<uint8_t>>::NoIndex;
+  for (size_t i = 0; i < sRecycledBuffers->Length(); i++) {
+    const nsTArray<uint8_t>& candidate = (*sRecycledBuffers)[i];
+    if (candidate.Capacity() < aByteLength) {
+      continue;
+    }
+    if (best == nsTArray<nsTArray<uint8_t>>::NoIndex ||
+        candidate.Capacity() < (*sRecycledBuffers)[best].Capacity()) {
+      best = i;
+    }
+  }
+  if (best != nsTArray<nsTArray<uint8_t>>::NoIndex) {
+    buffer = std::move((*sRecycledBuffers)[best]);
+    sRecycledBuffers->RemoveElementAt(best);
+    LOGD("Reusing a recycled tensor buffer of {} bytes for {} bytes",
+         buffer.Capacity(), aByteLength);
+  }
+  return buffer;
+}
+
+/* static */
+void Tensor::RecycleBuffer(nsTArray<uint8_t>&& aBuffer) {
+  MOZ_ASSERT(NS_IsMainThread());
+  if (!aBuffer.Capacity()) {
+    return;
+  }
+  if (!sRecycledBuffers) {
+    sRecycledBuffers = new nsTArray<nsTArray<uint8_t>>();
+    ClearOnShutdown(&sRecycledBuffers);
+  }
+  if (sRecycledBuffers->Length() >= kMaxRecycledBuffers) {
+    return;
+  }
+  aBuffer.ClearAndRetainStorage();
+  sRecycledBuffers->AppendElement(std::move(aBuffer));
+}
+
 Tensor::Tensor(const GlobalObject& aGlobal, const nsACString& aType,
                const ArrayBufferView& aData, const Sequence<int32_t>& aDims)
     : mType(aType) {
@@ -171,7 +226,7 @@ already_AddRefed<Tensor> Tensor::Constructor(
 #undef CASE
 #undef CASE_BIGINT
 
-void Tensor::Dispose() { mData.Clear(); }
+void Tensor::Dispose() { RecycleBuffer(std::move(mData)); }
 
 void Tensor::SetDims(const nsTArray<int32_t>& aVal) {
   mDims.Clear();
@@ -253,7 +308,7 @@ already_AddRefed<Promise> Tensor::GetData(const Optional<bool>& releaseData) {
                                             std::move(tensorData)));
     JS::Rooted<JS::Value> value(ctx, JS::ObjectValue(*data));
     p->MaybeResolve(value);
-    mData.Clear();
+    RecycleBuffer(std::move(mData));
   } else {
     size_t lengthBytes = mData.Length();
     UniquePtr<uint8_t[], JS::FreePolicy> tensorData(
@@ -68,6 +68,13 @@ class Tensor final : public nsISupports, public nsWrapperCache {
       const nsACString& aString);
   static size_t DataTypeSize(ONNXTensorElementDataType aType);
 
+  // Tensor buffer recycling. Consecutive runs of the same model produce
+  // tensors of identical shapes, so disposed tensor buffers are kept in a
+  // small pool and handed back to later allocations of a matching size
+  // instead of going through the allocator on every run.
+  static nsTArray<uint8_t> TakeRecycledBuffer(size_t aByteLength);
+  static void RecycleBuffer(nsTArray<uint8_t>&& aBuffer);
+
  private:
   nsCOMPtr<nsIGlobalObject> mGlobal;
   nsCString mType;
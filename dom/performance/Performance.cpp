@@ -175,9 +175,31 @@ JSObject* Performance::WrapObject(JSContext* aCx,
 }
 
 void Performance::GetEntries(nsTArray<RefPtr<PerformanceEntry>>& aRetval) {
-  aRetval = mResourceEntries.Clone();
-  aRetval.AppendElements(mUserEntries);
-  aRetval.Sort(PerformanceEntryComparator());
+  // Both entry arrays are kept sorted by start time, so a linear merge
+  // produces a sorted result; re-sorting here would cost O(n log n)
+  // comparator calls per getEntries() call on mark/measure-heavy pages.
+  aRetval.Clear();
+  aRetval.SetCapacity(mResourceEntries.Length() + mUserEntries.Length());
+
+  size_t resourceEntriesIdx = 0, userEntriesIdx = 0;
+  PerformanceEntryComparator comparator;
+
+  while (resourceEntriesIdx < mResourceEntries.Length() &&
+         userEntriesIdx < mUserEntries.Length()) {
+    if (comparator.LessThan(mResourceEntries[resourceEntriesIdx],
+                            mUserEntries[userEntriesIdx])) {
+      aRetval.AppendElement(mResourceEntries[resourceEntriesIdx]);
+      ++resourceEntriesIdx;
+    } else {
+      aRetval.AppendElement(mUserEntries[userEntriesIdx]);
+      ++userEntriesIdx;
+    }
+  }
+
+  aRetval.AppendElements(mResourceEntries.Elements() + resourceEntriesIdx,
+                         mResourceEntries.Length() - resourceEntriesIdx);
+  aRetval.AppendElements(mUserEntries.Elements() + userEntriesIdx,
+                         mUserEntries.Length() - userEntriesIdx);
 }
 
 void Performance::GetEntriesByType(
@@ -562,17 +562,17 @@ uint64_t PerformanceMainThread::InteractionCount() {
 
 void PerformanceMainThread::GetEntries(
     nsTArray<RefPtr<PerformanceEntry>>& aRetval) {
-  aRetval = mResourceEntries.Clone();
-  aRetval.AppendElements(mUserEntries);
+  // The base class merges the already-sorted entry arrays; only the two
+  // singleton entries need a sorted insertion afterwards.
+  Performance::GetEntries(aRetval);
 
   if (mDocEntry) {
-    aRetval.AppendElement(mDocEntry);
+    aRetval.InsertElementSorted(mDocEntry, PerformanceEntryComparator());
   }
 
   if (mFCPTiming) {
-    aRetval.AppendElement(mFCPTiming);
+    aRetval.InsertElementSorted(mFCPTiming, PerformanceEntryComparator());
   }
-  aRetval.Sort(PerformanceEntryComparator());
 }
 
 void PerformanceMainThread::GetEntriesByType(
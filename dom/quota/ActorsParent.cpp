@@ -3729,6 +3729,15 @@ Result<bool, nsresult> QuotaManager::DoesClientDirectoryExist(
 }
 
 template <typename OriginFunc>
+// Note that the origin directories are scanned serially on purpose: all of
+// quota manager's I/O is funnelled through the single QM I/O thread, and the
+// per-client InitOrigin implementations assert that invariant as well.
+// Profiles which would suffer from the full scan are expected to be covered
+// by the quota cache instead (see LoadQuota/UnloadQuota): a clean shutdown
+// persists the per-origin usage into storage.sqlite, so the next startup only
+// re-scans origins which were actually accessed during the previous session.
+// In addition, initialization of individual origins can be deferred entirely
+// until first use (see QuotaPrefs::LazyOriginInitializationEnabled).
 nsresult QuotaManager::InitializeRepository(PersistenceType aPersistenceType,
                                             OriginFunc&& aOriginFunc) {
   AssertIsOnIOThread();
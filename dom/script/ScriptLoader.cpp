@@ -3457,6 +3457,12 @@ void ScriptLoader::EncodeBytecode() {
   }
 
   AutoEntryScript aes(globalObject, "encode bytecode", true);
+
+  // Encoding every script of a large page in a single event could keep the
+  // main thread busy past the idle period; drain the queue incrementally and
+  // yield back to the event loop once the budget is consumed.
+  TimeStamp deadline = TimeStamp::Now() + TimeDuration::FromMilliseconds(5);
+
   RefPtr<ScriptLoadRequest> request;
   while (!mBytecodeEncodingQueue.isEmpty()) {
     request = mBytecodeEncodingQueue.StealFirst();
@@ -3465,9 +3471,79 @@ void ScriptLoader::EncodeBytecode() {
     EncodeRequestBytecode(aes.cx(), request);
     request->DropBytecode();
     request->DropBytecodeCacheReferences();
+
+    if (!mBytecodeEncodingQueue.isEmpty() && TimeStamp::Now() >= deadline) {
+      LOG(("ScriptLoader (%p): Yield bytecode encoding after budget.", this));
+      nsCOMPtr<nsIRunnable> encoder = NewRunnableMethod(
+          "ScriptLoader::EncodeBytecode", this, &ScriptLoader::EncodeBytecode);
+      if (NS_FAILED(NS_DispatchToCurrentThreadQueue(
+              encoder.forget(), EventQueuePriority::Idle))) {
+        GiveUpBytecodeEncoding();
+      }
+      return;
+    }
   }
 }
 
+// Completion step of the bytecode encoding: write the compressed bytecode of
+// |aRequest| to the cache entry alternate data storage. The compression runs
+// on a background task, and this is dispatched back to the main thread, where
+// the output stream has to be used.
+static void WriteRequestBytecode(ScriptLoadRequest* aRequest,
+                                 nsICacheInfoChannel* aCacheInfo,
+                                 const nsCString& aMimeType,
+                                 Vector<uint8_t>& aCompressedBytecode) {
+  MOZ_ASSERT(NS_IsMainThread());
+  nsresult rv = NS_OK;
+  auto bytecodeFailed = mozilla::MakeScopeExit(
+      [&]() { TRACE_FOR_TEST_NONE(aRequest, "scriptloader_bytecode_failed"); });
+
+  if (aCompressedBytecode.length() >= UINT32_MAX) {
+    LOG(
+        ("ScriptLoadRequest (%p): Bytecode cache is too large to be decoded "
+         "correctly.",
+         aRequest));
+    return;
+  }
+
+  // Open the output stream to the cache entry alternate data storage. This
+  // might fail if the stream is already open by another request, in which
+  // case, we just ignore the current one.
+  nsCOMPtr<nsIAsyncOutputStream> output;
+  rv = aCacheInfo->OpenAlternativeOutputStream(
+      aMimeType, static_cast<int64_t>(aCompressedBytecode.length()),
+      getter_AddRefs(output));
+  if (NS_FAILED(rv)) {
+    LOG(
+        ("ScriptLoadRequest (%p): Cannot open bytecode cache (rv = %X, output "
+         "= %p)",
+         aRequest, unsigned(rv), output.get()));
+    return;
+  }
+  MOZ_ASSERT(output);
+
+  auto closeOutStream = mozilla::MakeScopeExit([&]() {
+    rv = output->CloseWithStatus(rv);
+    LOG(("ScriptLoadRequest (%p): Closing (rv = %X)", aRequest, unsigned(rv)));
+  });
+
+  uint32_t n;
+  rv = output->Write(reinterpret_cast<char*>(aCompressedBytecode.begin()),
+                     aCompressedBytecode.length(), &n);
+  LOG(
+      ("ScriptLoadRequest (%p): Write bytecode cache (rv = %X, length = %u, "
+       "written = %u)",
+       aRequest, unsigned(rv), unsigned(aCompressedBytecode.length()), n));
+  if (NS_FAILED(rv)) {
+    return;
+  }
+
+  MOZ_RELEASE_ASSERT(aCompressedBytecode.length() == n);
+
+  bytecodeFailed.release();
+  TRACE_FOR_TEST_NONE(aRequest, "scriptloader_bytecode_saved");
+}
+
 void ScriptLoader::EncodeRequestBytecode(JSContext* aCx,
                                          ScriptLoadRequest* aRequest) {
   using namespace mozilla::Telemetry;
@@ -3511,58 +3587,46 @@ void ScriptLoader::EncodeRequestBytecode(JSContext* aCx,
     return;
   }
 
-  Vector<uint8_t> compressedBytecode;
-  // TODO probably need to move this to a helper thread
-  if (!ScriptBytecodeCompress(aRequest->SRIAndBytecode(),
-                              aRequest->GetSRILength(), compressedBytecode)) {
-    return;
-  }
-
-  if (compressedBytecode.length() >= UINT32_MAX) {
-    LOG(
-        ("ScriptLoadRequest (%p): Bytecode cache is too large to be decoded "
-         "correctly.",
-         aRequest));
-    return;
-  }
-
-  // Open the output stream to the cache entry alternate data storage. This
-  // might fail if the stream is already open by another request, in which
-  // case, we just ignore the current one.
-  nsCOMPtr<nsIAsyncOutputStream> output;
-  rv = aRequest->mCacheInfo->OpenAlternativeOutputStream(
-      BytecodeMimeTypeFor(aRequest),
-      static_cast<int64_t>(compressedBytecode.length()),
-      getter_AddRefs(output));
-  if (NS_FAILED(rv)) {
-    LOG(
-        ("ScriptLoadRequest (%p): Cannot open bytecode cache (rv = %X, output "
-         "= %p)",
-         aRequest, unsigned(rv), output.get()));
-    return;
-  }
-  MOZ_ASSERT(output);
-
-  auto closeOutStream = mozilla::MakeScopeExit([&]() {
-    rv = output->CloseWithStatus(rv);
-    LOG(("ScriptLoadRequest (%p): Closing (rv = %X)", aRequest, unsigned(rv)));
-  });
-
-  uint32_t n;
-  rv = output->Write(reinterpret_cast<char*>(compressedBytecode.begin()),
-                     compressedBytecode.length(), &n);
-  LOG(
-      ("ScriptLoadRequest (%p): Write bytecode cache (rv = %X, length = %u, "
-       "written = %u)",
-       aRequest, unsigned(rv), unsigned(compressedBytecode.length()), n));
+  // The compression is pure CPU work which does not need the JSContext;
+  // perform it on a background task so that it does not compete with the
+  // page. The alternate data output stream has to be used from the main
+  // thread, so the write is bounced back here once the compression is done.
+  nsMainThreadPtrHandle<ScriptLoadRequest> request(
+      new nsMainThreadPtrHolder<ScriptLoadRequest>(
+          "ScriptLoader::EncodeRequestBytecode::request", aRequest));
+  nsMainThreadPtrHandle<nsICacheInfoChannel> cacheInfo(
+      new nsMainThreadPtrHolder<nsICacheInfoChannel>(
+          "ScriptLoader::EncodeRequestBytecode::cacheInfo",
+          aRequest->mCacheInfo));
+  rv = NS_DispatchBackgroundTask(NS_NewRunnableFunction(
+      "ScriptLoader::CompressRequestBytecode",
+      [request, cacheInfo, mimeType = BytecodeMimeTypeFor(aRequest),
+       bytecode = std::move(aRequest->SRIAndBytecode()),
+       sriLength = aRequest->GetSRILength()]() mutable {
+        Vector<uint8_t> compressedBytecode;
+        bool compressed =
+            ScriptBytecodeCompress(bytecode, sriLength, compressedBytecode);
+        NS_DispatchToMainThread(NS_NewRunnableFunction(
+            "ScriptLoader::WriteRequestBytecode",
+            [request, cacheInfo, mimeType, compressed,
+             compressedBytecode = std::move(compressedBytecode)]() mutable {
+              if (!compressed) {
+                TRACE_FOR_TEST_NONE(request.get(),
+                                    "scriptloader_bytecode_failed");
+                return;
+              }
+              WriteRequestBytecode(request.get(), cacheInfo.get(), mimeType,
+                                   compressedBytecode);
+            }));
+      }));
   if (NS_FAILED(rv)) {
     return;
   }
 
-  MOZ_RELEASE_ASSERT(compressedBytecode.length() == n);
-
+  // From now on the "scriptloader_bytecode_saved" and
+  // "scriptloader_bytecode_failed" traces are emitted by the completion
+  // runnable.
   bytecodeFailed.release();
-  TRACE_FOR_TEST_NONE(aRequest, "scriptloader_bytecode_saved");
 }
 
 void ScriptLoader::GiveUpBytecodeEncoding() {
@@ -282,9 +282,11 @@ void SMILAnimationController::DoSample(bool aSkipUnchangedContainers) {
   // Parts (i) and (ii) are not functionally related but we combine them here to
   // save iterating over the animation elements twice.
 
-  // Create the compositor table
-  UniquePtr<SMILCompositorTable> currentCompositorTable(
-      new SMILCompositorTable(0));
+  // Create the compositor table. The number of animated targets rarely
+  // changes between samples, so size it like the previous sample's table to
+  // avoid rehashing while it's (re)populated on every tick.
+  UniquePtr<SMILCompositorTable> currentCompositorTable(new SMILCompositorTable(
+      mLastCompositorTable ? mLastCompositorTable->Count() : 0));
   nsTArray<RefPtr<SVGAnimationElement>> animElems(
       mAnimationElementTable.Count());
 
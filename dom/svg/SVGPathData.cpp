@@ -8,13 +8,17 @@
 
 #include "gfx2DGlue.h"
 #include "gfxPlatform.h"
+#include "MainThreadUtils.h"
+#include "mozilla/ClearOnShutdown.h"
 #include "mozilla/dom/SVGPathSegment.h"
 #include "mozilla/gfx/2D.h"
 #include "mozilla/gfx/Types.h"
 #include "mozilla/gfx/Point.h"
 #include "mozilla/RefPtr.h"
+#include "mozilla/StaticPtr.h"
 #include "nsError.h"
 #include "nsString.h"
+#include "nsTHashMap.h"
 #include "SVGArcConverter.h"
 #include "nsStyleConsts.h"
 #include "SVGContentUtils.h"
@@ -26,11 +30,43 @@ using namespace mozilla::gfx;
 
 namespace mozilla {
 
+// Cache of parsed path data keyed by the source string. Icon sprites and
+// similar content repeat the same `d` string across many elements, so a hit
+// replaces a full re-parse with an Arc clone of the already parsed (and
+// shared) command list. The cache is cleared rather than evicted when full;
+// keeping it bounded matters more than hit rate at the boundary, and a flush
+// of repeated content repopulates it within one parse per unique string.
+static constexpr uint32_t kMaxCachedPathStrings = 256;
+static constexpr uint32_t kMaxCachedPathStringLength = 4096;
+
+static StaticAutoPtr<nsTHashMap<nsCStringHashKey, StyleSVGPathData>>
+    sCachedPathData;
+
 nsresult SVGPathData::SetValueFromString(const nsACString& aValue) {
+  // The cache is main-thread only; the style system parses the `d` property
+  // on its own threads through Servo and doesn't come through here.
+  if (NS_IsMainThread() && aValue.Length() <= kMaxCachedPathStringLength) {
+    if (!sCachedPathData) {
+      sCachedPathData = new nsTHashMap<nsCStringHashKey, StyleSVGPathData>();
+      ClearOnShutdown(&sCachedPathData);
+    }
+    if (auto entry = sCachedPathData->Lookup(aValue)) {
+      mData = *entry;
+      return NS_OK;
+    }
+  }
+
   // We don't use a temp variable since the spec says to parse everything up to
   // the first error. We still return any error though so that callers know if
   // there's a problem.
   bool ok = Servo_SVGPathData_Parse(&aValue, &mData);
+  if (ok && sCachedPathData && NS_IsMainThread() &&
+      aValue.Length() <= kMaxCachedPathStringLength) {
+    if (sCachedPathData->Count() >= kMaxCachedPathStrings) {
+      sCachedPathData->Clear();
+    }
+    sCachedPathData->InsertOrUpdate(aValue, mData);
+  }
   return ok ? NS_OK : NS_ERROR_DOM_SYNTAX_ERR;
 }
 
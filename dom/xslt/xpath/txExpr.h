@@ -378,6 +378,11 @@ class txNameTest : public txNodeTest {
 
   NodeTestType getType() override;
 
+  /**
+   * Returns the type of node this test can match.
+   */
+  uint16_t getNodeType() const { return mNodeType; }
+
   TX_DECL_NODE_TEST
 
   RefPtr<nsAtom> mPrefix;
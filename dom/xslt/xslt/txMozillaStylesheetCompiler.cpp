@@ -30,10 +30,14 @@
 #include "nsComponentManagerUtils.h"
 #include "nsIScriptError.h"
 #include "nsError.h"
+#include "nsTArray.h"
 #include "mozilla/Attributes.h"
+#include "mozilla/ClearOnShutdown.h"
 #include "mozilla/dom/Element.h"
 #include "mozilla/dom/Text.h"
 #include "mozilla/Encoding.h"
+#include "mozilla/StaticPtr.h"
+#include "mozilla/TimeStamp.h"
 #include "mozilla/UniquePtr.h"
 #include "ReferrerInfo.h"
 
@@ -327,10 +331,95 @@ txStylesheetSink::GetInterface(const nsIID& aIID, void** aResult) {
   return NS_ERROR_NO_INTERFACE;
 }
 
+/**
+ * A small process-wide cache of stylesheets compiled through TX_LoadSheet.
+ * Transforming many documents which reference the same stylesheet (the common
+ * shape for generated reports and feeds) would otherwise reload and recompile
+ * the sheet once per document.  A txStylesheet is immutable once compiling has
+ * finished, so a cached sheet can be handed to any number of transforms
+ * without copying.
+ *
+ * Entries are keyed on the stylesheet URI, the principal of the loading
+ * document and the referrer policy the sheet was loaded with; a hit therefore
+ * repeats the CORS decision the original channel made.  The per-document
+ * content policy (and thus CSP) check runs in the caller before TX_LoadSheet
+ * is reached, so it is not bypassed by a hit.  Entries expire after a few
+ * minutes so that server-side stylesheet updates are still picked up.
+ */
+struct txCachedStylesheet {
+  nsCOMPtr<nsIURI> mURI;
+  nsCOMPtr<nsIPrincipal> mLoaderPrincipal;
+  ReferrerPolicy mReferrerPolicy;
+  RefPtr<txStylesheet> mStylesheet;
+  TimeStamp mExpirationTime;
+};
+
+static StaticAutoPtr<nsTArray<txCachedStylesheet>> sCompiledStylesheetCache;
+
+static const uint32_t kCompiledStylesheetCacheMaxEntries = 16;
+static const uint32_t kCompiledStylesheetCacheTimeoutSeconds = 300;
+
+static txStylesheet* TX_GetCachedStylesheet(nsIURI* aUri,
+                                            nsIPrincipal* aLoaderPrincipal,
+                                            ReferrerPolicy aReferrerPolicy) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (!sCompiledStylesheetCache) {
+    return nullptr;
+  }
+
+  TimeStamp now = TimeStamp::Now();
+  for (uint32_t i = sCompiledStylesheetCache->Length(); i-- > 0;) {
+    txCachedStylesheet& entry = (*sCompiledStylesheetCache)[i];
+    if (now >= entry.mExpirationTime) {
+      sCompiledStylesheetCache->RemoveElementAt(i);
+      continue;
+    }
+
+    bool sameURI = false;
+    if (entry.mReferrerPolicy == aReferrerPolicy &&
+        NS_SUCCEEDED(entry.mURI->Equals(aUri, &sameURI)) && sameURI &&
+        entry.mLoaderPrincipal->Equals(aLoaderPrincipal)) {
+      return entry.mStylesheet;
+    }
+  }
+
+  return nullptr;
+}
+
+static void TX_CacheCompiledStylesheet(nsIURI* aUri,
+                                       nsIPrincipal* aLoaderPrincipal,
+                                       ReferrerPolicy aReferrerPolicy,
+                                       txStylesheet* aStylesheet) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (!sCompiledStylesheetCache) {
+    sCompiledStylesheetCache = new nsTArray<txCachedStylesheet>();
+    ClearOnShutdown(&sCompiledStylesheetCache);
+  }
+
+  // Evict the oldest entry to bound the cache.  Concurrent loads of the same
+  // sheet may insert duplicate keys; that just wastes a slot until they
+  // expire, and lookups are still correct.
+  if (sCompiledStylesheetCache->Length() >= kCompiledStylesheetCacheMaxEntries) {
+    sCompiledStylesheetCache->RemoveElementAt(0);
+  }
+
+  txCachedStylesheet* entry = sCompiledStylesheetCache->AppendElement();
+  entry->mURI = aUri;
+  entry->mLoaderPrincipal = aLoaderPrincipal;
+  entry->mReferrerPolicy = aReferrerPolicy;
+  entry->mStylesheet = aStylesheet;
+  entry->mExpirationTime =
+      TimeStamp::Now() +
+      TimeDuration::FromSeconds(kCompiledStylesheetCacheTimeoutSeconds);
+}
+
 class txCompileObserver final : public txACompileObserver {
  public:
   txCompileObserver(txMozillaXSLTProcessor* aProcessor,
-                    Document* aLoaderDocument);
+                    Document* aLoaderDocument, nsIURI* aStylesheetURI,
+                    ReferrerPolicy aReferrerPolicy);
 
   TX_DECL_ACOMPILEOBSERVER
   NS_INLINE_DECL_REFCOUNTING(txCompileObserver, override)
@@ -342,6 +431,11 @@ class txCompileObserver final : public txACompileObserver {
  private:
   RefPtr<txMozillaXSLTProcessor> mProcessor;
   nsCOMPtr<Document> mLoaderDocument;
+  // The URI and referrer policy of the toplevel stylesheet, used together
+  // with the loader document's principal as the compiled stylesheet cache
+  // key once compiling succeeds.
+  nsCOMPtr<nsIURI> mStylesheetURI;
+  ReferrerPolicy mReferrerPolicy;
 
   // This exists solely to suppress a warning from nsDerivedSafe
   txCompileObserver();
@@ -351,8 +445,13 @@ class txCompileObserver final : public txACompileObserver {
 };
 
 txCompileObserver::txCompileObserver(txMozillaXSLTProcessor* aProcessor,
-                                     Document* aLoaderDocument)
-    : mProcessor(aProcessor), mLoaderDocument(aLoaderDocument) {}
+                                     Document* aLoaderDocument,
+                                     nsIURI* aStylesheetURI,
+                                     ReferrerPolicy aReferrerPolicy)
+    : mProcessor(aProcessor),
+      mLoaderDocument(aLoaderDocument),
+      mStylesheetURI(aStylesheetURI),
+      mReferrerPolicy(aReferrerPolicy) {}
 
 nsresult txCompileObserver::loadURI(const nsAString& aUri,
                                     const nsAString& aReferrerUri,
@@ -383,7 +482,11 @@ void txCompileObserver::onDoneCompiling(txStylesheetCompiler* aCompiler,
                                         const char16_t* aErrorText,
                                         const char16_t* aParam) {
   if (NS_SUCCEEDED(aResult)) {
-    mProcessor->setStylesheet(aCompiler->getStylesheet());
+    RefPtr<txStylesheet> stylesheet = aCompiler->getStylesheet();
+    TX_CacheCompiledStylesheet(mStylesheetURI,
+                               mLoaderDocument->NodePrincipal(),
+                               mReferrerPolicy, stylesheet);
+    mProcessor->setStylesheet(stylesheet);
   } else {
     mProcessor->reportError(aResult, aErrorText, aParam);
   }
@@ -443,8 +546,19 @@ nsresult TX_LoadSheet(nsIURI* aUri, txMozillaXSLTProcessor* aProcessor,
   aUri->GetSpec(spec);
   MOZ_LOG(txLog::xslt, LogLevel::Info, ("TX_LoadSheet: %s\n", spec.get()));
 
+  // If another document with the same principal recently compiled this
+  // stylesheet, share the compiled sheet instead of reloading it.
+  // setStylesheet kicks off the (asynchronous) transform if the source has
+  // already been parsed.
+  if (RefPtr<txStylesheet> cachedStylesheet =
+          TX_GetCachedStylesheet(aUri, principal, aReferrerPolicy)) {
+    MOZ_LOG(txLog::xslt, LogLevel::Info,
+            ("TX_LoadSheet: reusing cached compiled stylesheet\n"));
+    return aProcessor->setStylesheet(cachedStylesheet);
+  }
+
   RefPtr<txCompileObserver> observer =
-      new txCompileObserver(aProcessor, aLoaderDocument);
+      new txCompileObserver(aProcessor, aLoaderDocument, aUri, aReferrerPolicy);
 
   RefPtr<txStylesheetCompiler> compiler = new txStylesheetCompiler(
       NS_ConvertUTF8toUTF16(spec), aReferrerPolicy, observer);
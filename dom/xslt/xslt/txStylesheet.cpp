@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "mozilla/FloatingPoint.h"
+#include "nsGkAtoms.h"
 #include "txExpr.h"
 #include "txInstructions.h"
 #include "txKey.h"
@@ -101,6 +102,8 @@ nsresult txStylesheet::findTemplate(const txXPathNode& aNode,
   ImportFrame* endFrame = nullptr;
   txListIterator frameIter(&mImportFrames);
 
+  const bool isElement = txXPathNodeUtils::isElement(aNode);
+
   if (aImportedBy) {
     ImportFrame* curr = static_cast<ImportFrame*>(frameIter.next());
     while (curr != aImportedBy) {
@@ -125,6 +128,16 @@ nsresult txStylesheet::findTemplate(const txXPathNode& aNode,
       uint32_t i, len = templates->Length();
       for (i = 0; i < len && !*aTemplate; ++i) {
         MatchableTemplate& templ = (*templates)[i];
+        // Reject name-test templates whose required element name doesn't
+        // match without running the full pattern.  This is the same
+        // local-name comparison txNameTest::matches ends with, so it is a
+        // necessary condition for a match.
+        if (templ.mRequiredElementLocalName &&
+            (!isElement ||
+             !txXPathNodeUtils::localNameEquals(
+                 aNode, templ.mRequiredElementLocalName))) {
+          continue;
+        }
         bool matched;
         nsresult rv = templ.mMatch->matches(aNode, aContext, matched);
         NS_ENSURE_SUCCESS(rv, rv);
@@ -386,10 +399,29 @@ nsresult txStylesheet::addTemplate(txTemplateItem* aTemplate,
       }
     }
 
+    // If the pattern is a plain name test on an element, record the name so
+    // that findTemplate can cheaply reject this template for nodes that
+    // cannot match it.  Stylesheets commonly have many element-named
+    // templates per mode, and without this every template's pattern runs
+    // against every source node.
+    nsAtom* requiredElementLocalName = nullptr;
+    if (simple->getType() == txPattern::STEP_PATTERN) {
+      txNodeTest* nodeTest =
+          static_cast<txStepPattern*>(simple.get())->getNodeTest();
+      if (nodeTest->getType() == txNodeTest::NAME_TEST) {
+        txNameTest* nameTest = static_cast<txNameTest*>(nodeTest);
+        if (nameTest->getNodeType() == txXPathNodeType::ELEMENT_NODE &&
+            nameTest->mLocalName != nsGkAtoms::_asterisk) {
+          requiredElementLocalName = nameTest->mLocalName;
+        }
+      }
+    }
+
     MatchableTemplate* nt = templates->InsertElementAt(i);
     nt->mFirstInstruction = instr;
     nt->mMatch = std::move(simple);
     nt->mPriority = priority;
+    nt->mRequiredElementLocalName = requiredElementLocalName;
 
     if (unionPattern) {
       simple = WrapUnique(unionPattern->getSubPatternAt(unionPos));
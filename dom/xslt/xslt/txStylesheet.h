@@ -68,6 +68,10 @@ class txStylesheet final {
     txInstruction* mFirstInstruction;
     mozilla::UniquePtr<txPattern> mMatch;
     double mPriority;
+    // If non-null, the local name any matching element must have.  Computed
+    // in addTemplate from simple name-test patterns and used by findTemplate
+    // to reject templates without running the full pattern match.
+    RefPtr<nsAtom> mRequiredElementLocalName;
   };
 
   /**
@@ -84,6 +84,7 @@ NS_IMPL_EDITTRANSACTIONBASE_GETASMETHODS(DeleteNodeTransaction)
 NS_IMPL_EDITTRANSACTIONBASE_GETASMETHODS(DeleteRangeTransaction)
 NS_IMPL_EDITTRANSACTIONBASE_GETASMETHODS(DeleteTextTransaction)
 NS_IMPL_EDITTRANSACTIONBASE_GETASMETHODS(EditAggregateTransaction)
+NS_IMPL_EDITTRANSACTIONBASE_GETASMETHODS(InsertFragmentTransaction)
 NS_IMPL_EDITTRANSACTIONBASE_GETASMETHODS(InsertNodeTransaction)
 NS_IMPL_EDITTRANSACTIONBASE_GETASMETHODS(InsertTextTransaction)
 NS_IMPL_EDITTRANSACTIONBASE_GETASMETHODS(JoinNodesTransaction)
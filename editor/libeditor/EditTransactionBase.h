@@ -57,6 +57,7 @@ class EditTransactionBase : public nsITransaction {
   NS_DECL_GETASTRANSACTION_BASE(DeleteRangeTransaction)
   NS_DECL_GETASTRANSACTION_BASE(DeleteTextTransaction)
   NS_DECL_GETASTRANSACTION_BASE(EditAggregateTransaction)
+  NS_DECL_GETASTRANSACTION_BASE(InsertFragmentTransaction)
   NS_DECL_GETASTRANSACTION_BASE(InsertNodeTransaction)
   NS_DECL_GETASTRANSACTION_BASE(InsertTextTransaction)
   NS_DECL_GETASTRANSACTION_BASE(JoinNodesTransaction)
@@ -114,6 +114,7 @@ class EditAggregateTransaction;           // EditAggregateTransaction.h
 class EditorEventListener;                // EditorEventListener.h
 class EditResult;                         // HTMLEditHelpers.h
 class HTMLEditorEventListener;            // HTMLEditorEventListener.h
+class InsertFragmentTransaction;          // InsertFragmentTransaction.h
 class InsertNodeTransaction;              // InsertNodeTransaction.h
 class InsertTextIntoTextNodeTransaction;  // InsertTextTransaction.h
 class InsertTextResult;                   // EditorUtils.h
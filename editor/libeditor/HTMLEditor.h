@@ -3398,6 +3398,23 @@ class HTMLEditor final : public EditorBase,
           NodeType& aContent, const EditorDOMPoint& aPointToInsert,
           SplitAtEdges aSplitAtEdges);
 
+  /**
+   * InsertFragmentChildrenWithTransaction() inserts all children of
+   * aFragmentToInsert at aPointToInsert with a single transaction, i.e., a
+   * single call of nsINode::InsertBefore().  The caller is responsible for
+   * checking that the container of aPointToInsert can contain every child
+   * as-is; unlike InsertNodeIntoProperAncestorWithTransaction(), this does
+   * not split ancestors.  Returns the last inserted child.
+   *
+   * @param aFragmentToInsert The fragment whose children will be inserted.
+   *                          Must have at least one child.
+   * @param aPointToInsert    Insertion point.
+   */
+  [[nodiscard]] MOZ_CAN_RUN_SCRIPT Result<CreateContentResult, nsresult>
+  InsertFragmentChildrenWithTransaction(
+      dom::DocumentFragment& aFragmentToInsert,
+      const EditorDOMPoint& aPointToInsert);
+
   /**
    * InsertTextWithQuotationsInternal() replaces selection with new content.
    * First, this method splits aStringToInsert to multiple chunks which start
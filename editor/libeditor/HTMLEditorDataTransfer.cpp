@@ -15,6 +15,7 @@
 #include "EditorUtils.h"
 #include "HTMLEditHelpers.h"
 #include "HTMLEditUtils.h"
+#include "InsertFragmentTransaction.h"
 #include "InternetCiter.h"
 #include "PendingStyles.h"
 #include "SelectionState.h"
@@ -981,6 +982,91 @@ HTMLEditor::HTMLWithContextInserter::InsertContents(
           : nullptr;
 
   EditorDOMPoint lastInsertedPoint;
+
+  // If pasting many top-most nodes whose destination is simply the container
+  // of the insertion point, move them into a document fragment and insert
+  // them with a single transaction.  That notifies the content observers
+  // once rather than once per node, which matters for large pastes.  The
+  // special handling below of table parts, lists and `<pre>` elements, and
+  // nodes which require splitting ancestors, keeps using the per-node path.
+  if (aArrayOfTopMostChildContents.Length() > 1) {
+    const bool canInsertAllWithSingleTransaction = [&]() {
+      for (const OwningNonNull<nsIContent>& content :
+           aArrayOfTopMostChildContents) {
+        if (content == aFragmentAsNode ||
+            content->IsHTMLElement(nsGkAtoms::body)) {
+          return false;  // Will be rejected by the loop below.
+        }
+        if (content->NodeType() == nsINode::DOCUMENT_TYPE_NODE ||
+            content->NodeType() == nsINode::PROCESSING_INSTRUCTION_NODE) {
+          return false;  // The per-node path does not insert these.
+        }
+        if (HTMLEditUtils::IsTableRow(content) &&
+            HTMLEditUtils::IsTableRow(pointToInsert.GetContainer()) &&
+            (HTMLEditUtils::IsTable(content) ||
+             HTMLEditUtils::IsTable(pointToInsert.GetContainer()))) {
+          return false;
+        }
+        if (HTMLEditUtils::IsAnyListElement(content) &&
+            (HTMLEditUtils::IsAnyListElement(pointToInsert.GetContainer()) ||
+             HTMLEditUtils::IsListItem(pointToInsert.GetContainer()))) {
+          return false;
+        }
+        if (HTMLEditUtils::IsPre(maybeNonEditableBlockElement) &&
+            HTMLEditUtils::IsPre(content)) {
+          return false;
+        }
+        if (!HTMLEditUtils::CanNodeContain(*pointToInsert.GetContainer(),
+                                           content)) {
+          return false;  // Would need to split ancestors.
+        }
+      }
+      return true;
+    }();
+    if (canInsertAllWithSingleTransaction) {
+      const RefPtr<DocumentFragment> fragmentToInsert =
+          pointToInsert.GetContainer()->OwnerDoc()->CreateDocumentFragment();
+      for (const OwningNonNull<nsIContent>& content :
+           aArrayOfTopMostChildContents) {
+        IgnoredErrorResult error;
+        fragmentToInsert->AppendChild(MOZ_KnownLive(*content), error);
+        if (NS_WARN_IF(error.Failed())) {
+          return Err(error.StealNSResult());
+        }
+      }
+      Result<CreateContentResult, nsresult> insertContentsResult =
+          mHTMLEditor.InsertFragmentChildrenWithTransaction(*fragmentToInsert,
+                                                            pointToInsert);
+      if (MOZ_UNLIKELY(insertContentsResult.isErr())) {
+        if (insertContentsResult.inspectErr() ==
+            NS_ERROR_EDITOR_UNEXPECTED_DOM_TREE) {
+          // Mutation event listeners moved or removed the inserted nodes.
+          // Give up on tracking the insertion point like the per-node path
+          // does in this case.
+          return lastInsertedPoint;
+        }
+        NS_WARNING(
+            "HTMLEditor::InsertFragmentChildrenWithTransaction() failed");
+        return insertContentsResult.propagateErr();
+      }
+      CreateContentResult unwrappedInsertContentsResult =
+          insertContentsResult.unwrap();
+      lastInsertedPoint.Set(unwrappedInsertContentsResult.GetNewNode());
+      nsresult rv = unwrappedInsertContentsResult.SuggestCaretPointTo(
+          mHTMLEditor, {SuggestCaret::OnlyIfHasSuggestion,
+                        SuggestCaret::OnlyIfTransactionsAllowedToDoIt,
+                        SuggestCaret::AndIgnoreTrivialError});
+      if (NS_FAILED(rv)) {
+        NS_WARNING("CreateContentResult::SuggestCaretPointTo() failed");
+        return Err(rv);
+      }
+      NS_WARNING_ASSERTION(
+          rv != NS_SUCCESS_EDITOR_BUT_IGNORED_TRIVIAL_ERROR,
+          "CreateContentResult::SuggestCaretPointTo() failed, but ignored");
+      return lastInsertedPoint;
+    }
+  }
+
   nsCOMPtr<nsIContent> insertedContextParentContent;
   for (OwningNonNull<nsIContent>& content : aArrayOfTopMostChildContents) {
     if (NS_WARN_IF(content == aFragmentAsNode) ||
@@ -1343,6 +1429,67 @@ HTMLEditor::HTMLWithContextInserter::InsertContents(
   return lastInsertedPoint;
 }
 
+Result<CreateContentResult, nsresult>
+HTMLEditor::InsertFragmentChildrenWithTransaction(
+    DocumentFragment& aFragmentToInsert,
+    const EditorDOMPoint& aPointToInsert) {
+  MOZ_ASSERT(IsEditActionDataAvailable());
+  MOZ_ASSERT(aFragmentToInsert.HasChildren());
+
+  if (NS_WARN_IF(!aPointToInsert.IsSet())) {
+    return Err(NS_ERROR_INVALID_ARG);
+  }
+  MOZ_ASSERT(aPointToInsert.IsSetAndValid());
+
+  IgnoredErrorResult ignoredError;
+  AutoEditSubActionNotifier startToHandleEditSubAction(
+      *this, EditSubAction::eInsertNode, nsIEditor::eNext, ignoredError);
+  if (NS_WARN_IF(ignoredError.ErrorCodeIs(NS_ERROR_EDITOR_DESTROYED))) {
+    return Err(ignoredError.StealNSResult());
+  }
+  NS_WARNING_ASSERTION(
+      !ignoredError.Failed(),
+      "HTMLEditor::OnStartToHandleTopLevelEditSubAction() failed, but ignored");
+
+  RefPtr<InsertFragmentTransaction> transaction =
+      InsertFragmentTransaction::Create(*this, aFragmentToInsert,
+                                        aPointToInsert);
+  nsresult rv = DoTransactionInternal(transaction);
+  NS_WARNING_ASSERTION(NS_SUCCEEDED(rv),
+                       "EditorBase::DoTransactionInternal() failed");
+
+  for (const nsCOMPtr<nsIContent>& insertedContent :
+       transaction->InsertedContentsRef()) {
+    DebugOnly<nsresult> rvIgnored =
+        RangeUpdaterRef().SelAdjInsertNode(EditorRawDOMPoint(insertedContent));
+    NS_WARNING_ASSERTION(
+        NS_SUCCEEDED(rvIgnored),
+        "RangeUpdater::SelAdjInsertNode() failed, but ignored");
+  }
+
+  if (NS_WARN_IF(Destroyed())) {
+    return Err(NS_ERROR_EDITOR_DESTROYED);
+  }
+  nsIContent* const lastInsertedContent = transaction->GetLastInsertedContent();
+  if (NS_WARN_IF(!lastInsertedContent) ||
+      NS_WARN_IF(lastInsertedContent->GetParentNode() !=
+                 aPointToInsert.GetContainer())) {
+    return Err(NS_ERROR_EDITOR_UNEXPECTED_DOM_TREE);
+  }
+  if (NS_FAILED(rv)) {
+    return Err(rv);
+  }
+
+  for (const nsCOMPtr<nsIContent>& insertedContent :
+       transaction->InsertedContentsRef()) {
+    TopLevelEditSubActionDataRef().DidInsertContent(*this, *insertedContent);
+  }
+
+  return CreateContentResult(
+      *lastInsertedContent,
+      transaction->SuggestPointToPutCaret<EditorDOMPoint>());
+}
+
 nsresult HTMLEditor::HTMLWithContextInserter::MoveCaretOutsideOfLink(
     Element& aLinkElement, const EditorDOMPoint& aPointToPutCaret) {
   MOZ_ASSERT(HTMLEditUtils::IsLink(&aLinkElement));
@@ -0,0 +1,199 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "InsertFragmentTransaction.h"
+
+#include "EditorBase.h"      // for EditorBase
+#include "EditorDOMPoint.h"  // for EditorDOMPoint
+
+#include "mozilla/Logging.h"
+#include "mozilla/OwningNonNull.h"
+#include "mozilla/ToString.h"
+
+#include "nsDebug.h"     // for NS_WARNING, etc.
+#include "nsError.h"     // for NS_ERROR_NULL_POINTER, etc.
+#include "nsIContent.h"  // for nsIContent
+
+namespace mozilla {
+
+using namespace dom;
+
+template already_AddRefed<InsertFragmentTransaction>
+InsertFragmentTransaction::Create(EditorBase& aEditorBase,
+                                  DocumentFragment& aFragmentToInsert,
+                                  const EditorDOMPoint& aPointToInsert);
+template already_AddRefed<InsertFragmentTransaction>
+InsertFragmentTransaction::Create(EditorBase& aEditorBase,
+                                  DocumentFragment& aFragmentToInsert,
+                                  const EditorRawDOMPoint& aPointToInsert);
+
+// static
+template <typename PT, typename CT>
+already_AddRefed<InsertFragmentTransaction> InsertFragmentTransaction::Create(
+    EditorBase& aEditorBase, DocumentFragment& aFragmentToInsert,
+    const EditorDOMPointBase<PT, CT>& aPointToInsert) {
+  RefPtr<InsertFragmentTransaction> transaction = new InsertFragmentTransaction(
+      aEditorBase, aFragmentToInsert, aPointToInsert);
+  return transaction.forget();
+}
+
+template <typename PT, typename CT>
+InsertFragmentTransaction::InsertFragmentTransaction(
+    EditorBase& aEditorBase, DocumentFragment& aFragmentToInsert,
+    const EditorDOMPointBase<PT, CT>& aPointToInsert)
+    : mFragmentToInsert(&aFragmentToInsert),
+      mPointToInsert(aPointToInsert.template To<EditorDOMPoint>()),
+      mEditorBase(&aEditorBase) {
+  MOZ_ASSERT(mFragmentToInsert->HasChildren());
+  MOZ_ASSERT(mPointToInsert.IsSetAndValid());
+  // Ensure mPointToInsert stores child at offset.
+  Unused << mPointToInsert.GetChild();
+}
+
+std::ostream& operator<<(std::ostream& aStream,
+                         const InsertFragmentTransaction& aTransaction) {
+  aStream << "{ mFragmentToInsert=" << aTransaction.mFragmentToInsert.get()
+          << ", mInsertedContents.Length()="
+          << aTransaction.mInsertedContents.Length()
+          << ", mPointToInsert=" << aTransaction.mPointToInsert
+          << ", mEditorBase=" << aTransaction.mEditorBase.get() << " }";
+  return aStream;
+}
+
+NS_IMPL_CYCLE_COLLECTION_INHERITED(InsertFragmentTransaction,
+                                   EditTransactionBase, mEditorBase,
+                                   mFragmentToInsert, mInsertedContents,
+                                   mPointToInsert)
+
+NS_IMPL_ADDREF_INHERITED(InsertFragmentTransaction, EditTransactionBase)
+NS_IMPL_RELEASE_INHERITED(InsertFragmentTransaction, EditTransactionBase)
+NS_INTERFACE_MAP_BEGIN_CYCLE_COLLECTION(InsertFragmentTransaction)
+NS_INTERFACE_MAP_END_INHERITING(EditTransactionBase)
+
+NS_IMETHODIMP InsertFragmentTransaction::DoTransaction() {
+  MOZ_LOG(GetLogModule(), LogLevel::Info,
+          ("%p InsertFragmentTransaction::%s this=%s", this, __FUNCTION__,
+           ToString(*this).c_str()));
+
+  if (NS_WARN_IF(!mEditorBase) || NS_WARN_IF(!mFragmentToInsert) ||
+      NS_WARN_IF(!mPointToInsert.IsSet())) {
+    return NS_ERROR_NOT_AVAILABLE;
+  }
+
+  if (NS_WARN_IF(!mFragmentToInsert->HasChildren())) {
+    return NS_ERROR_NOT_AVAILABLE;
+  }
+
+  if (!mPointToInsert.IsSetAndValid()) {
+    // It seems that DOM tree has been changed after first DoTransaction()
+    // and current RedoTranaction() call.
+    if (mPointToInsert.GetChild()) {
+      EditorDOMPoint newPointToInsert(mPointToInsert.GetChild());
+      if (!newPointToInsert.IsSet()) {
+        // The insertion point has been removed from the DOM tree.
+        // In this case, we should append the nodes to the container instead.
+        newPointToInsert.SetToEndOf(mPointToInsert.GetContainer());
+        if (NS_WARN_IF(!newPointToInsert.IsSet())) {
+          return NS_ERROR_FAILURE;
+        }
+      }
+      mPointToInsert = newPointToInsert;
+    } else {
+      mPointToInsert.SetToEndOf(mPointToInsert.GetContainer());
+      if (NS_WARN_IF(!mPointToInsert.IsSet())) {
+        return NS_ERROR_FAILURE;
+      }
+    }
+  }
+
+  // Inserting the fragment empties it, so remember the children now; undo
+  // needs them, and the editor needs them to adjust ranges and suggest the
+  // caret position.
+  mInsertedContents.Clear();
+  for (nsIContent* child = mFragmentToInsert->GetFirstChild(); child;
+       child = child->GetNextSibling()) {
+    mInsertedContents.AppendElement(child);
+  }
+
+  OwningNonNull<EditorBase> editorBase = *mEditorBase;
+  OwningNonNull<DocumentFragment> fragmentToInsert = *mFragmentToInsert;
+  OwningNonNull<nsINode> container = *mPointToInsert.GetContainer();
+  nsCOMPtr<nsIContent> refChild = mPointToInsert.GetChild();
+  for (const nsCOMPtr<nsIContent>& contentToInsert : mInsertedContents) {
+    if (contentToInsert->IsElement()) {
+      nsresult rv = editorBase->MarkElementDirty(
+          MOZ_KnownLive(*contentToInsert->AsElement()));
+      if (NS_WARN_IF(rv == NS_ERROR_EDITOR_DESTROYED)) {
+        return EditorBase::ToGenericNSResult(rv);
+      }
+      NS_WARNING_ASSERTION(NS_SUCCEEDED(rv),
+                           "EditorBase::MarkElementDirty() failed, but "
+                           "ignored");
+    }
+  }
+
+  IgnoredErrorResult error;
+  container->InsertBefore(fragmentToInsert, refChild, error);
+  // InsertBefore() may call MightThrowJSException() even if there is no
+  // error. We don't need the flag here.
+  error.WouldReportJSException();
+  if (error.Failed()) {
+    NS_WARNING("nsINode::InsertBefore() failed");
+    return error.StealNSResult();
+  }
+
+  return NS_OK;
+}
+
+NS_IMETHODIMP InsertFragmentTransaction::UndoTransaction() {
+  MOZ_LOG(GetLogModule(), LogLevel::Info,
+          ("%p InsertFragmentTransaction::%s this=%s", this, __FUNCTION__,
+           ToString(*this).c_str()));
+
+  if (NS_WARN_IF(!mEditorBase) || NS_WARN_IF(!mFragmentToInsert) ||
+      NS_WARN_IF(!mPointToInsert.IsSet())) {
+    return NS_ERROR_NOT_INITIALIZED;
+  }
+  // Move the children back into the fragment so that RedoTransaction() can
+  // insert them again; appending a node which is in the DOM tree removes it
+  // from its parent first.
+  // XXX If an inserted node has been moved to different container node or
+  //     just removed from the DOM tree, this always fails.
+  OwningNonNull<DocumentFragment> fragmentToInsert = *mFragmentToInsert;
+  for (const nsCOMPtr<nsIContent>& insertedContent : mInsertedContents) {
+    OwningNonNull<nsIContent> contentToRemove = *insertedContent;
+    ErrorResult error;
+    fragmentToInsert->AppendChild(contentToRemove, error);
+    if (error.Failed()) {
+      NS_WARNING("nsINode::AppendChild() failed");
+      return error.StealNSResult();
+    }
+  }
+  return NS_OK;
+}
+
+NS_IMETHODIMP InsertFragmentTransaction::RedoTransaction() {
+  MOZ_LOG(GetLogModule(), LogLevel::Info,
+          ("%p InsertFragmentTransaction::%s this=%s", this, __FUNCTION__,
+           ToString(*this).c_str()));
+  nsresult rv = DoTransaction();
+  if (MOZ_UNLIKELY(NS_FAILED(rv))) {
+    NS_WARNING("InsertFragmentTransaction::RedoTransaction() failed");
+    return rv;
+  }
+
+  if (!mEditorBase->AllowsTransactionsToChangeSelection()) {
+    return NS_OK;
+  }
+
+  OwningNonNull<EditorBase> editorBase(*mEditorBase);
+  rv = editorBase->CollapseSelectionTo(
+      SuggestPointToPutCaret<EditorRawDOMPoint>());
+  NS_WARNING_ASSERTION(NS_SUCCEEDED(rv),
+                       "EditorBase::CollapseSelectionTo() failed, but ignored");
+  return NS_OK;
+}
+
+}  // namespace mozilla
@@ -0,0 +1,119 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef InsertFragmentTransaction_h
+#define InsertFragmentTransaction_h
+
+#include "EditTransactionBase.h"  // for EditTransactionBase, etc.
+
+#include "EditorDOMPoint.h"  // for EditorDOMPoint
+#include "EditorForwards.h"
+
+#include "mozilla/dom/DocumentFragment.h"  // for DocumentFragment
+#include "nsCOMPtr.h"                      // for nsCOMPtr
+#include "nsCycleCollectionParticipant.h"
+#include "nsIContent.h"       // for nsIContent
+#include "nsISupportsImpl.h"  // for NS_DECL_ISUPPORTS_INHERITED
+#include "nsTArray.h"         // for nsTArray
+
+namespace mozilla {
+
+class EditorBase;
+
+/**
+ * A transaction that inserts all children of a document fragment with a
+ * single call of nsINode::InsertBefore() so that inserting many sibling
+ * nodes, e.g., when pasting a lot of paragraphs, notifies the content
+ * observers once instead of once per node.
+ */
+class InsertFragmentTransaction final : public EditTransactionBase {
+ protected:
+  template <typename PT, typename CT>
+  InsertFragmentTransaction(EditorBase& aEditorBase,
+                            dom::DocumentFragment& aFragmentToInsert,
+                            const EditorDOMPointBase<PT, CT>& aPointToInsert);
+
+ public:
+  /**
+   * Create a transaction for inserting all children of aFragmentToInsert
+   * before the child at aPointToInsert.
+   *
+   * @param aEditorBase         The editor which manages the transaction.
+   * @param aFragmentToInsert   The fragment whose children will be inserted.
+   *                            Must have at least one child.
+   * @param aPointToInsert      The insertion point of the children.  If this
+   *                            refers end of the container, the transaction
+   *                            will append the children to the container.
+   *                            Otherwise, will insert the children before
+   *                            child node referred by this.
+   * @return                    A InsertFragmentTransaction which was
+   *                            initialized with the arguments.
+   */
+  template <typename PT, typename CT>
+  static already_AddRefed<InsertFragmentTransaction> Create(
+      EditorBase& aEditorBase, dom::DocumentFragment& aFragmentToInsert,
+      const EditorDOMPointBase<PT, CT>& aPointToInsert);
+
+  NS_DECL_ISUPPORTS_INHERITED
+  NS_DECL_CYCLE_COLLECTION_CLASS_INHERITED(InsertFragmentTransaction,
+                                           EditTransactionBase)
+
+  NS_DECL_EDITTRANSACTIONBASE
+  NS_DECL_EDITTRANSACTIONBASE_GETASMETHODS_OVERRIDE(InsertFragmentTransaction)
+
+  MOZ_CAN_RUN_SCRIPT NS_IMETHOD RedoTransaction() override;
+
+  /**
+   * The children which DoTransaction() inserted, in document order.
+   */
+  const nsTArray<nsCOMPtr<nsIContent>>& InsertedContentsRef() const {
+    return mInsertedContents;
+  }
+
+  /**
+   * The last child which DoTransaction() inserted, or nullptr if the
+   * transaction has not been done yet.
+   */
+  nsIContent* GetLastInsertedContent() const {
+    return mInsertedContents.IsEmpty() ? nullptr
+                                       : mInsertedContents.LastElement().get();
+  }
+
+  /**
+   * SuggestPointToPutCaret() suggests a point after doing or redoing the
+   * transaction.
+   */
+  template <typename EditorDOMPointType>
+  EditorDOMPointType SuggestPointToPutCaret() const {
+    if (MOZ_UNLIKELY(mInsertedContents.IsEmpty())) {
+      return EditorDOMPointType();
+    }
+    return EditorDOMPointType::After(mInsertedContents.LastElement());
+  }
+
+  friend std::ostream& operator<<(
+      std::ostream& aStream, const InsertFragmentTransaction& aTransaction);
+
+ protected:
+  virtual ~InsertFragmentTransaction() = default;
+
+  // The fragment whose children to insert.  Empty after DoTransaction()
+  // because inserting the fragment moves the children out of it;
+  // UndoTransaction() moves them back.
+  RefPtr<dom::DocumentFragment> mFragmentToInsert;
+
+  // The children inserted by DoTransaction(), in document order.
+  nsTArray<nsCOMPtr<nsIContent>> mInsertedContents;
+
+  // The DOM point we will insert the children of mFragmentToInsert.
+  EditorDOMPoint mPointToInsert;
+
+  // The editor for this transaction.
+  RefPtr<EditorBase> mEditorBase;
+};
+
+}  // namespace mozilla
+
+#endif  // #ifndef InsertFragmentTransaction_h
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "CompositionTransaction.h"
+#include "InsertTextTransaction.h"
 #include "mozilla/EditorBase.h"
 #include "mozilla/Logging.h"
 #include "mozilla/ToString.h"
@@ -181,6 +182,24 @@ NS_IMETHODIMP PlaceholderTransaction::Merge(nsITransaction* aOtherTransaction,
           AppendChild(*otherCompositionTransaction);
         }
       }
+    } else if (InsertTextTransaction* otherInsertTextTransaction =
+                   otherTransactionBase->GetAsInsertTextTransaction()) {
+      // Similarly, merge runs of sequential text insertions into the last
+      // child so that a long typing run doesn't accumulate one child
+      // transaction per keystroke in the undo history.  Only the last child
+      // may absorb the new insertion because merging over an intervening
+      // transaction would break the undo order.
+      InsertTextTransaction* lastInsertTextTransaction =
+          mChildren.IsEmpty()
+              ? nullptr
+              : mChildren.LastElement()->GetAsInsertTextTransaction();
+      bool didMerge = false;
+      if (lastInsertTextTransaction) {
+        lastInsertTextTransaction->Merge(otherInsertTextTransaction, &didMerge);
+      }
+      if (!didMerge) {
+        AppendChild(*otherInsertTextTransaction);
+      }
     } else {
       PlaceholderTransaction* otherPlaceholderTransaction =
           otherTransactionBase->GetAsPlaceholderTransaction();
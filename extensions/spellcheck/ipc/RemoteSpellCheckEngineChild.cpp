@@ -25,6 +25,9 @@ RefPtr<GenericPromise> RemoteSpellcheckEngineChild::SetCurrentDictionaries(
       ->Then(
           GetMainThreadSerialEventTarget(), __func__,
           [spellChecker, dictionaries = aDictionaries.Clone()](bool&& aParam) {
+            // Any verdicts cached while the switch was in flight may have
+            // come from the previous dictionaries.
+            spellChecker->mCorrectWordCache.Clear();
             if (aParam) {
               spellChecker->mCurrentDictionaries = dictionaries.Clone();
               return GenericPromise::CreateAndResolve(true, __func__);
@@ -48,6 +51,9 @@ RemoteSpellcheckEngineChild::SetCurrentDictionaryFromList(
   return SendSetDictionaryFromList(aList)->Then(
       GetMainThreadSerialEventTarget(), __func__,
       [spellChecker](std::tuple<bool, nsCString>&& aParam) {
+        // Any verdicts cached while the switch was in flight may have come
+        // from the previous dictionaries.
+        spellChecker->mCorrectWordCache.Clear();
         if (!std::get<0>(aParam)) {
           spellChecker->mCurrentDictionaries.Clear();
           return GenericPromise::CreateAndReject(NS_ERROR_NOT_AVAILABLE,
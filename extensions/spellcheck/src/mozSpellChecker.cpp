@@ -25,6 +25,11 @@ using mozilla::dom::ContentChild;
 
 #define DEFAULT_SPELL_CHECKER "@mozilla.org/spellchecker/engine;1"
 
+// Cap for mCorrectWordCache so that it cannot grow without bound over a long
+// editing session. When the cap is hit the whole cache is dropped; it will
+// re-fill with the words the user is currently editing around.
+static const uint32_t kMaxCorrectWordCacheSize = 4096;
+
 static mozilla::LazyLogModule sSpellChecker("SpellChecker");
 
 NS_IMPL_CYCLE_COLLECTION(mozSpellChecker, mTextServicesDocument,
@@ -123,24 +128,71 @@ nsresult mozSpellChecker::NextMisspelledWord(nsAString& aWord,
 
 RefPtr<mozilla::CheckWordPromise> mozSpellChecker::CheckWords(
     const nsTArray<nsString>& aWords) {
+  // Serve words which an earlier call verified as correct from
+  // mCorrectWordCache, and only hand the remainder to the engine.
+  nsTArray<bool> misspells;
+  misspells.SetLength(aWords.Length());
+  nsTArray<nsString> unknownWords;
+  nsTArray<size_t> unknownIndexes;
+  for (size_t i = 0; i < aWords.Length(); i++) {
+    misspells[i] = false;
+    if (!mCorrectWordCache.Contains(aWords[i])) {
+      unknownWords.AppendElement(aWords[i]);
+      unknownIndexes.AppendElement(i);
+    }
+  }
+
+  if (unknownWords.IsEmpty()) {
+    return mozilla::CheckWordPromise::CreateAndResolve(std::move(misspells),
+                                                       __func__);
+  }
+
   if (XRE_IsContentProcess()) {
-    return mEngine->CheckWords(aWords);
+    RefPtr<mozSpellChecker> self = this;
+    return mEngine->CheckWords(unknownWords)
+        ->Then(
+            mozilla::GetMainThreadSerialEventTarget(), __func__,
+            [self, misspells = std::move(misspells),
+             unknownWords = std::move(unknownWords),
+             unknownIndexes = std::move(unknownIndexes)](
+                const nsTArray<bool>& aIsMisspelled) mutable {
+              MOZ_ASSERT(aIsMisspelled.Length() == unknownIndexes.Length());
+              for (size_t i = 0; i < aIsMisspelled.Length(); i++) {
+                misspells[unknownIndexes[i]] = aIsMisspelled[i];
+                if (!aIsMisspelled[i]) {
+                  self->RememberCorrectWord(unknownWords[i]);
+                }
+              }
+              return mozilla::CheckWordPromise::CreateAndResolve(
+                  std::move(misspells), __func__);
+            },
+            [](nsresult aRv) {
+              return mozilla::CheckWordPromise::CreateAndReject(aRv, __func__);
+            });
   }
 
-  nsTArray<bool> misspells;
-  misspells.SetCapacity(aWords.Length());
-  for (auto& word : aWords) {
+  for (size_t i = 0; i < unknownWords.Length(); i++) {
     bool misspelled;
-    nsresult rv = CheckWord(word, &misspelled, nullptr);
+    nsresult rv = CheckWord(unknownWords[i], &misspelled, nullptr);
     if (NS_WARN_IF(NS_FAILED(rv))) {
       return mozilla::CheckWordPromise::CreateAndReject(rv, __func__);
     }
-    misspells.AppendElement(misspelled);
+    misspells[unknownIndexes[i]] = misspelled;
+    if (!misspelled) {
+      RememberCorrectWord(unknownWords[i]);
+    }
   }
   return mozilla::CheckWordPromise::CreateAndResolve(std::move(misspells),
                                                      __func__);
 }
 
+void mozSpellChecker::RememberCorrectWord(const nsString& aWord) {
+  if (mCorrectWordCache.Count() >= kMaxCorrectWordCacheSize) {
+    mCorrectWordCache.Clear();
+  }
+  mCorrectWordCache.Insert(aWord);
+}
+
 nsresult mozSpellChecker::CheckWord(const nsAString& aWord, bool* aIsMisspelled,
                                     nsTArray<nsString>* aSuggestions) {
   if (XRE_IsContentProcess()) {
@@ -342,6 +394,8 @@ nsresult mozSpellChecker::RemoveWordFromPersonalDictionary(
     return NS_ERROR_NOT_INITIALIZED;
   }
   res = mPersonalDictionary->RemoveWord(aWord);
+  // The removed word may have been cached as correct.
+  mCorrectWordCache.Clear();
   return res;
 }
 
@@ -396,6 +450,8 @@ nsresult mozSpellChecker::GetCurrentDictionaries(
 }
 
 nsresult mozSpellChecker::SetCurrentDictionary(const nsACString& aDictionary) {
+  mCorrectWordCache.Clear();
+
   if (XRE_IsContentProcess()) {
     mCurrentDictionaries.Clear();
     bool isSuccess;
@@ -449,6 +505,8 @@ nsresult mozSpellChecker::SetCurrentDictionary(const nsACString& aDictionary) {
 
 RefPtr<GenericPromise> mozSpellChecker::SetCurrentDictionaries(
     const nsTArray<nsCString>& aDictionaries) {
+  mCorrectWordCache.Clear();
+
   if (XRE_IsContentProcess()) {
     if (!mEngine) {
       mCurrentDictionaries.Clear();
@@ -506,6 +564,8 @@ RefPtr<GenericPromise> mozSpellChecker::SetCurrentDictionaryFromList(
     return GenericPromise::CreateAndReject(NS_ERROR_INVALID_ARG, __func__);
   }
 
+  mCorrectWordCache.Clear();
+
   if (XRE_IsContentProcess()) {
     if (!mEngine) {
       mCurrentDictionaries.Clear();
@@ -14,6 +14,7 @@
 #include "mozISpellCheckingEngine.h"
 #include "nsClassHashtable.h"
 #include "nsTArray.h"
+#include "nsTHashSet.h"
 #include "nsCycleCollectionParticipant.h"
 
 class mozEnglishWordUtils;
@@ -174,6 +175,16 @@ class mozSpellChecker final {
 
   nsTArray<nsCString> mCurrentDictionaries;
 
+  // Words which CheckWords() has already verified as correctly spelled with
+  // the current dictionaries. Serving repeated checks from here avoids a
+  // round trip to the spellcheck engine for the common case of rechecking
+  // mostly-unchanged text after an edit. The cache must be cleared whenever
+  // a verdict could change, i.e. when the current dictionaries are switched
+  // or a word is removed from the personal dictionary.
+  nsTHashSet<nsString> mCorrectWordCache;
+
+  void RememberCorrectWord(const nsString& aWord);
+
   MOZ_CAN_RUN_SCRIPT
   nsresult SetupDoc(int32_t* outBlockOffset);
 
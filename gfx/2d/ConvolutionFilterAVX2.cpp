@@ -5,10 +5,135 @@
 // found in the gfx/skia/LICENSE file.
 
 #include "SkConvolver.h"
+#include "mozilla/Attributes.h"
 #include <immintrin.h>
 
 namespace skia {
 
+static MOZ_ALWAYS_INLINE void AccumRemainder(
+    const unsigned char* pixelsLeft,
+    const SkConvolutionFilter1D::ConvolutionFixed* filterValues, __m128i& accum,
+    int r) {
+  int remainder[4] = {0};
+  for (int i = 0; i < r; i++) {
+    SkConvolutionFilter1D::ConvolutionFixed coeff = filterValues[i];
+    remainder[0] += coeff * pixelsLeft[i * 4 + 0];
+    remainder[1] += coeff * pixelsLeft[i * 4 + 1];
+    remainder[2] += coeff * pixelsLeft[i * 4 + 2];
+    remainder[3] += coeff * pixelsLeft[i * 4 + 3];
+  }
+  __m128i t =
+      _mm_setr_epi32(remainder[0], remainder[1], remainder[2], remainder[3]);
+  accum = _mm_add_epi32(accum, t);
+}
+
+// Convolves horizontally along a single row. The row data is given in
+// |srcData| and continues for the numValues() of the filter. This is the
+// AVX2 counterpart of convolve_horizontally_sse2, consuming eight
+// coefficients (and thus eight source pixels) per iteration, which matters
+// for the large filter windows produced by heavy downscales.
+void convolve_horizontally_avx2(const unsigned char* srcData,
+                                const SkConvolutionFilter1D& filter,
+                                unsigned char* outRow, bool /*hasAlpha*/) {
+  // Output one pixel each iteration, calculating all channels (RGBA) together.
+  int numValues = filter.numValues();
+  for (int outX = 0; outX < numValues; outX++) {
+    // Get the filter that determines the current output pixel.
+    int filterOffset, filterLength;
+    const SkConvolutionFilter1D::ConvolutionFixed* filterValues =
+        filter.FilterForValue(outX, &filterOffset, &filterLength);
+
+    // Compute the first pixel in this row that the filter affects. It will
+    // touch |filterLength| pixels (4 bytes each) after this.
+    const unsigned char* rowToFilter = &srcData[filterOffset * 4];
+
+    __m256i zero = _mm256_setzero_si256();
+    // The accumulator's low 128-bit lane holds the 32-bit per-channel sums of
+    // the even pixel groups and the high lane those of the odd groups; the
+    // two lanes are added together once the filter has been consumed.
+    __m256i accum = _mm256_setzero_si256();
+
+    // We will load and accumulate with eight coefficients per iteration.
+    for (int filterX = 0; filterX < filterLength >> 3; filterX++) {
+      // Load 8 coefficients, then expand each quadruplicated coefficient into
+      // a 128-bit lane so the pairing matches the unpacked pixels below:
+      // coefficients 0/1 and 4/5 are applied to pixels 0/1 and 4/5, and
+      // coefficients 2/3 and 6/7 to pixels 2/3 and 6/7.
+      // [16] c7 c6 c5 c4 c3 c2 c1 c0
+      __m128i coeff =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(filterValues));
+      // [16] c7 c6 c5 c4 (moved down into the low half)
+      __m128i coeffHi = _mm_srli_si128(coeff, 8);
+      // [16] c1 c1 c1 c1 c0 c0 c0 c0
+      __m128i c01 = _mm_shufflelo_epi16(coeff, _MM_SHUFFLE(1, 1, 0, 0));
+      c01 = _mm_unpacklo_epi16(c01, c01);
+      // [16] c3 c3 c3 c3 c2 c2 c2 c2
+      __m128i c23 = _mm_shufflelo_epi16(coeff, _MM_SHUFFLE(3, 3, 2, 2));
+      c23 = _mm_unpacklo_epi16(c23, c23);
+      // [16] c5 c5 c5 c5 c4 c4 c4 c4
+      __m128i c45 = _mm_shufflelo_epi16(coeffHi, _MM_SHUFFLE(1, 1, 0, 0));
+      c45 = _mm_unpacklo_epi16(c45, c45);
+      // [16] c7 c7 c7 c7 c6 c6 c6 c6
+      __m128i c67 = _mm_shufflelo_epi16(coeffHi, _MM_SHUFFLE(3, 3, 2, 2));
+      c67 = _mm_unpacklo_epi16(c67, c67);
+
+      __m256i coeffA = _mm256_set_m128i(c45, c01);
+      __m256i coeffB = _mm256_set_m128i(c67, c23);
+
+      // Load eight pixels: 0-3 in the low 128-bit lane, 4-7 in the high one.
+      __m256i src8 =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rowToFilter));
+
+      // [16] a5 b5 g5 r5 a4 b4 g4 r4 | a1 b1 g1 r1 a0 b0 g0 r0
+      __m256i src16 = _mm256_unpacklo_epi8(src8, zero);
+      __m256i mul_hi = _mm256_mulhi_epi16(src16, coeffA);
+      __m256i mul_lo = _mm256_mullo_epi16(src16, coeffA);
+      // [32] a4*c4 b4*c4 g4*c4 r4*c4 | a0*c0 b0*c0 g0*c0 r0*c0
+      accum = _mm256_add_epi32(accum, _mm256_unpacklo_epi16(mul_lo, mul_hi));
+      // [32] a5*c5 ... | a1*c1 ...
+      accum = _mm256_add_epi32(accum, _mm256_unpackhi_epi16(mul_lo, mul_hi));
+
+      // [16] a7 b7 g7 r7 a6 b6 g6 r6 | a3 b3 g3 r3 a2 b2 g2 r2
+      src16 = _mm256_unpackhi_epi8(src8, zero);
+      mul_hi = _mm256_mulhi_epi16(src16, coeffB);
+      mul_lo = _mm256_mullo_epi16(src16, coeffB);
+      // [32] a6*c6 ... | a2*c2 ...
+      accum = _mm256_add_epi32(accum, _mm256_unpacklo_epi16(mul_lo, mul_hi));
+      // [32] a7*c7 ... | a3*c3 ...
+      accum = _mm256_add_epi32(accum, _mm256_unpackhi_epi16(mul_lo, mul_hi));
+
+      // Advance the pixel and coefficients pointers.
+      rowToFilter += 32;
+      filterValues += 8;
+    }
+
+    // Add the even and odd group sums together.
+    __m128i accum128 = _mm_add_epi32(_mm256_castsi256_si128(accum),
+                                     _mm256_extracti128_si256(accum, 1));
+
+    // When |filterLength| is not divisible by 8, we accumulate the last 1 - 7
+    // coefficients one at a time. With LANCZOS3 the filter only has a short
+    // tail once the downscale factor is large enough for AVX2 to matter.
+    int r = filterLength & 7;
+    if (r) {
+      int remainderOffset = (filterOffset + filterLength - r) * 4;
+      AccumRemainder(srcData + remainderOffset, filterValues, accum128, r);
+    }
+
+    // Shift right for fixed point implementation.
+    accum128 = _mm_srai_epi32(accum128, SkConvolutionFilter1D::kShiftBits);
+
+    // Packing 32 bits |accum128| to 16 bits per channel (signed saturation).
+    accum128 = _mm_packs_epi32(accum128, _mm_setzero_si128());
+    // Packing 16 bits |accum128| to 8 bits per channel (unsigned saturation).
+    accum128 = _mm_packus_epi16(accum128, _mm_setzero_si128());
+
+    // Store the pixel value of 32 bits.
+    *(reinterpret_cast<int*>(outRow)) = _mm_cvtsi128_si32(accum128);
+    outRow += 4;
+  }
+}
+
 void convolve_vertically_avx2(
     const SkConvolutionFilter1D::ConvolutionFixed* filter, int filterLen,
     unsigned char* const* srcRows, int width, unsigned char* out,
@@ -35,7 +35,13 @@
 #include "PathSkia.h"
 #include "Swizzle.h"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 #ifdef MOZ_WIDGET_COCOA
 #  include "BorrowedContext.h"
@@ -717,7 +723,11 @@ struct AutoPaintSetup {
   Float mAlpha;
 };
 
-void DrawTargetSkia::Flush() {}
+void DrawTargetSkia::Flush() {
+  // A frame's worth of drawing is done; any path storage the recycled
+  // builders have accumulated is no longer worth holding on to.
+  mPathBuilderPool.clear();
+}
 
 void DrawTargetSkia::DrawSurface(SourceSurface* aSurface, const Rect& aDest,
                                  const Rect& aSource,
@@ -885,6 +895,18 @@ void DrawTargetSkia::FillRect(const Rect& aRect, const Pattern& aPattern,
   mCanvas->drawRect(rect, paint.mPaint);
 }
 
+// A single path at least this complex is worth rasterizing in parallel on
+// its own; Fill and Stroke route such paths through a one-op PathBatch.
+static const int kMinBatchedVerbs = 512;
+
+static bool ShouldParallelRasterPath(const SkPath& aPath,
+                                     const Pattern& aPattern,
+                                     const DrawOptions& aOptions) {
+  return aPath.countVerbs() >= kMinBatchedVerbs &&
+         aPattern.GetType() != PatternType::SURFACE &&
+         IsOperatorBoundByMask(aOptions.mCompositionOp);
+}
+
 void DrawTargetSkia::Stroke(const Path* aPath, const Pattern& aPattern,
                             const StrokeOptions& aStrokeOptions,
                             const DrawOptions& aOptions) {
@@ -896,6 +918,14 @@ void DrawTargetSkia::Stroke(const Path* aPath, const Pattern& aPattern,
 
   const PathSkia* skiaPath = static_cast<const PathSkia*>(aPath);
 
+  if (ShouldParallelRasterPath(skiaPath->GetPath(), aPattern, aOptions)) {
+    // Complex enough to rasterize in parallel strips; the batch falls back
+    // to a plain serial draw when the target doesn't allow distribution.
+    PathBatch batch(this);
+    batch.Stroke(aPath, aPattern, aStrokeOptions, aOptions);
+    return;
+  }
+
   AutoPaintSetup paint(mCanvas, aOptions, aPattern);
   if (!StrokeOptionsToPaint(paint.mPaint, aStrokeOptions)) {
     return;
@@ -1022,6 +1052,14 @@ void DrawTargetSkia::Fill(const Path* aPath, const Pattern& aPattern,
 
   const PathSkia* skiaPath = static_cast<const PathSkia*>(aPath);
 
+  if (ShouldParallelRasterPath(skiaPath->GetPath(), aPattern, aOptions)) {
+    // Complex enough to rasterize in parallel strips; the batch falls back
+    // to a plain serial draw when the target doesn't allow distribution.
+    PathBatch batch(this);
+    batch.Fill(aPath, aPattern, aOptions);
+    return;
+  }
+
   AutoPaintSetup paint(mCanvas, aOptions, aPattern);
 
   if (!skiaPath->GetPath().isFinite()) {
@@ -1031,6 +1069,241 @@ void DrawTargetSkia::Fill(const Path* aPath, const Pattern& aPattern,
   mCanvas->drawPath(skiaPath->GetPath(), paint.mPaint);
 }
 
+// A small, lazily-created pool of rasterizer threads shared by all
+// DrawTargetSkia path batches. The pool is created on first use and
+// intentionally never destroyed; batches are serialized through RunParallel,
+// and the calling thread participates in the work alongside the workers.
+class PathRasterPool final {
+ public:
+  static PathRasterPool& Get() {
+    static PathRasterPool* pool = new PathRasterPool();
+    return *pool;
+  }
+
+  size_t WorkerCount() const { return mWorkers.size(); }
+
+  // Invoke aTask(index) for every index in [0, aCount), distributing the
+  // indices across the workers and the calling thread, and return once all
+  // invocations have completed.
+  void RunParallel(size_t aCount, const std::function<void(size_t)>& aTask) {
+    std::lock_guard<std::mutex> outer(mRunLock);
+    {
+      std::lock_guard<std::mutex> lock(mLock);
+      mTask = &aTask;
+      mTotal = aCount;
+      mPending = aCount;
+      mNextIndex = 0;
+    }
+    mWorkCV.notify_all();
+    Work();
+    std::unique_lock<std::mutex> lock(mLock);
+    mDoneCV.wait(lock, [&] { return mPending == 0; });
+    mTask = nullptr;
+    mTotal = 0;
+  }
+
+ private:
+  PathRasterPool() {
+    size_t hw = std::thread::hardware_concurrency();
+    size_t count = hw > 1 ? std::min<size_t>(hw - 1, 7) : 0;
+    for (size_t i = 0; i < count; ++i) {
+      mWorkers.emplace_back([this] { WorkerLoop(); });
+    }
+  }
+
+  void WorkerLoop() {
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mLock);
+        mWorkCV.wait(lock, [&] { return mTask && mNextIndex < mTotal; });
+      }
+      Work();
+    }
+  }
+
+  void Work() {
+    // The task pointer and the claimed index must come from the same lock
+    // hold: a worker that snapshots the task, gets preempted, and claims an
+    // index later could otherwise wake up in a subsequent job and invoke
+    // the previous caller's (destroyed) task, starve the new job of the
+    // claimed strip, and over-decrement its pending count.
+    std::unique_lock<std::mutex> lock(mLock);
+    while (mTask && mNextIndex < mTotal) {
+      const size_t index = mNextIndex++;
+      const std::function<void(size_t)>* task = mTask;
+      lock.unlock();
+      (*task)(index);
+      lock.lock();
+      // Our unfinished claim kept mPending above zero, so RunParallel
+      // cannot have returned or started another job in the meantime; the
+      // decrement below always belongs to the job we claimed from.
+      if (--mPending == 0) {
+        mDoneCV.notify_all();
+      }
+    }
+  }
+
+  std::vector<std::thread> mWorkers;
+  std::mutex mRunLock;
+  std::mutex mLock;
+  std::condition_variable mWorkCV;
+  std::condition_variable mDoneCV;
+  // All fields below are guarded by mLock.
+  const std::function<void(size_t)>* mTask = nullptr;
+  size_t mTotal = 0;
+  size_t mPending = 0;
+  size_t mNextIndex = 0;
+};
+
+// Batches smaller than this aren't worth distributing.
+static const size_t kMinBatchedOps = 8;
+// Minimum strip height, to keep per-strip replay overhead in proportion.
+static const int kMinStripHeight = 64;
+
+struct DrawTargetSkia::PathBatch::Op {
+  SkPath mPath;
+  SkPaint mPaint;
+  SkMatrix mMatrix;
+};
+
+DrawTargetSkia::PathBatch::PathBatch(DrawTargetSkia* aDT) : mDT(aDT) {}
+
+DrawTargetSkia::PathBatch::~PathBatch() { Flush(); }
+
+bool DrawTargetSkia::PathBatch::Record(const Path* aPath,
+                                       const Pattern& aPattern,
+                                       const StrokeOptions* aStrokeOptions,
+                                       const DrawOptions& aOptions) {
+  if (!aPath || aPath->GetBackendType() != BackendType::SKIA) {
+    return true;  // nothing to draw, matching Fill/Stroke
+  }
+  const SkPath& skPath = static_cast<const PathSkia*>(aPath)->GetPath();
+  if (!skPath.isFinite()) {
+    return true;
+  }
+  if (aPattern.GetType() == PatternType::SURFACE ||
+      !IsOperatorBoundByMask(aOptions.mCompositionOp)) {
+    // Surface patterns need their surface locked for the duration of the
+    // draw, and unbounded operators need a layer; neither can be replayed
+    // on the worker canvases.
+    return false;
+  }
+
+  Op op;
+  op.mPath = skPath;
+  op.mMatrix = mDT->mCanvas->getTotalMatrix();
+  op.mPaint.setBlendMode(GfxOpToSkiaOp(aOptions.mCompositionOp));
+  op.mPaint.setAntiAlias(aOptions.mAntialiasMode != AntialiasMode::NONE);
+  op.mPaint.setAlpha(ColorFloatToByte(aOptions.mAlpha));
+  Maybe<MutexAutoLock> lock;
+  SetPaintPattern(op.mPaint, aPattern, lock, aOptions.mAlpha);
+  MOZ_ASSERT(lock.isNothing(), "only surface patterns take the lock");
+  if (aStrokeOptions && !StrokeOptionsToPaint(op.mPaint, *aStrokeOptions)) {
+    return true;  // invalid stroke options draw nothing, matching Stroke
+  }
+  mOps.push_back(std::move(op));
+  return true;
+}
+
+void DrawTargetSkia::PathBatch::Fill(const Path* aPath, const Pattern& aPattern,
+                                     const DrawOptions& aOptions) {
+  if (!Record(aPath, aPattern, nullptr, aOptions)) {
+    // Not representable in the batch: flush what we have so the direct draw
+    // stays correctly ordered, then draw it immediately.
+    Flush();
+    mDT->Fill(aPath, aPattern, aOptions);
+  }
+}
+
+void DrawTargetSkia::PathBatch::Stroke(const Path* aPath,
+                                       const Pattern& aPattern,
+                                       const StrokeOptions& aStrokeOptions,
+                                       const DrawOptions& aOptions) {
+  if (!Record(aPath, aPattern, &aStrokeOptions, aOptions)) {
+    Flush();
+    mDT->Stroke(aPath, aPattern, aStrokeOptions, aOptions);
+  }
+}
+
+void DrawTargetSkia::PathBatch::ReplaySerial() {
+  for (const Op& op : mOps) {
+    mDT->mCanvas->save();
+    mDT->mCanvas->setMatrix(op.mMatrix);
+    mDT->mCanvas->drawPath(op.mPath, op.mPaint);
+    mDT->mCanvas->restore();
+  }
+}
+
+void DrawTargetSkia::PathBatch::Flush() {
+  if (mOps.empty()) {
+    return;
+  }
+  mDT->MarkChanged();
+
+  SkImageInfo info;
+  size_t rowBytes;
+  SkIPoint origin;
+  void* pixels =
+      mDT->mCanvas->accessTopLayerPixels(&info, &rowBytes, &origin);
+
+  PathRasterPool& pool = PathRasterPool::Get();
+  size_t stripCount = 0;
+  bool worthDistributing = mOps.size() >= kMinBatchedOps;
+  if (!worthDistributing) {
+    // Few operations, but a small batch of complex paths (or the single-op
+    // batches Fill and Stroke create) can still be worth distributing.
+    int verbs = 0;
+    for (const Op& op : mOps) {
+      verbs += op.mPath.countVerbs();
+    }
+    worthDistributing = verbs >= kMinBatchedVerbs;
+  }
+  if (pixels && origin.isZero() && pool.WorkerCount() > 0 &&
+      worthDistributing) {
+    SkIRect clipBounds;
+    // Only distribute when the clip covers the whole layer: the worker
+    // canvases replay with just their strip clip, so a caller-set clip
+    // (which may not even be rectangular) must take the serial path.
+    if (mDT->mCanvas->getDeviceClipBounds(&clipBounds) &&
+        clipBounds == SkIRect::MakeWH(info.width(), info.height())) {
+      stripCount = std::min(pool.WorkerCount() + 1,
+                            size_t(info.height() / kMinStripHeight));
+    }
+  }
+  if (stripCount < 2) {
+    ReplaySerial();
+    mOps.clear();
+    return;
+  }
+
+  // One canvas per strip over the same pixels; the strips partition the rows,
+  // so the workers never write to the same memory.
+  std::vector<std::unique_ptr<SkCanvas>> canvases;
+  for (size_t i = 0; i < stripCount; ++i) {
+    canvases.push_back(SkCanvas::MakeRasterDirect(info, pixels, rowBytes));
+    if (!canvases.back()) {
+      ReplaySerial();
+      mOps.clear();
+      return;
+    }
+  }
+
+  int stripHeight = (info.height() + int(stripCount) - 1) / int(stripCount);
+  pool.RunParallel(stripCount, [&](size_t aIndex) {
+    SkCanvas* canvas = canvases[aIndex].get();
+    int y0 = int(aIndex) * stripHeight;
+    int y1 = std::min(y0 + stripHeight, info.height());
+    canvas->clipRect(
+        SkRect::MakeLTRB(0, SkScalar(y0), SkScalar(info.width()),
+                         SkScalar(y1)));
+    for (const Op& op : mOps) {
+      canvas->setMatrix(op.mMatrix);
+      canvas->drawPath(op.mPath, op.mPaint);
+    }
+  });
+  mOps.clear();
+}
+
 #ifdef MOZ_WIDGET_COCOA
 static inline CGAffineTransform GfxMatrixToCGAffineTransform(const Matrix& m) {
   CGAffineTransform t;
@@ -1927,9 +2200,24 @@ void* DrawTargetSkia::GetNativeSurface(NativeSurfaceType aType) {
   return nullptr;
 }
 
+// The number of PathBuilders kept for recycling per draw target. Content that
+// has more builders live at once simply falls back to plain allocation.
+static const size_t kPathBuilderPoolSize = 4;
+
 already_AddRefed<PathBuilder> DrawTargetSkia::CreatePathBuilder(
     FillRule aFillRule) const {
-  return PathBuilderSkia::Create(aFillRule);
+  for (const RefPtr<PathBuilderSkia>& pooled : mPathBuilderPool) {
+    if (pooled->hasOneRef()) {
+      pooled->Reset(aFillRule);
+      return do_AddRef(pooled);
+    }
+  }
+
+  RefPtr<PathBuilderSkia> builder = new PathBuilderSkia(aFillRule);
+  if (mPathBuilderPool.size() < kPathBuilderPoolSize) {
+    mPathBuilderPool.push_back(builder);
+  }
+  return builder.forget();
 }
 
 void DrawTargetSkia::ClearRect(const Rect& aRect) {
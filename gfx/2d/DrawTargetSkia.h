@@ -31,6 +31,7 @@ class RefPtrTraits<SkSurface> {
 namespace gfx {
 
 class DataSourceSurface;
+class PathBuilderSkia;
 class SourceSurfaceSkia;
 class BorrowedCGContext;
 
@@ -84,6 +85,53 @@ class DrawTargetSkia : public DrawTarget {
   virtual void Fill(const Path* aPath, const Pattern& aPattern,
                     const DrawOptions& aOptions = DrawOptions()) override;
 
+  /**
+   * A batch of independent Fill/Stroke operations that Flush() rasterizes in
+   * parallel horizontal strips across a shared worker pool, each worker
+   * replaying every operation clipped to its own strip so per-pixel paint
+   * order is preserved. Intended for targets that receive large numbers of
+   * path operations, such as canvas-fallback and filter surfaces.
+   *
+   * Operations are recorded with the draw target's transform at the time of
+   * the call. Operations that cannot be replayed on the workers (surface
+   * patterns, composition ops not bound by their mask) flush the pending
+   * batch and are drawn directly, preserving order. Flush() falls back to
+   * serial replay when the target's pixels are not directly accessible, a
+   * clip is set on the target, or the batch is too small to be worth
+   * distributing.
+   *
+   * Fill() and Stroke() on the draw target itself route sufficiently
+   * complex paths through a single-operation batch automatically, so plain
+   * callers get parallel rasterization without adopting the batch API.
+   */
+  class PathBatch final {
+   public:
+    explicit PathBatch(DrawTargetSkia* aDT);
+    ~PathBatch();
+
+    void Fill(const Path* aPath, const Pattern& aPattern,
+              const DrawOptions& aOptions = DrawOptions());
+    void Stroke(const Path* aPath, const Pattern& aPattern,
+                const StrokeOptions& aStrokeOptions = StrokeOptions(),
+                const DrawOptions& aOptions = DrawOptions());
+
+    // Rasterize and composite all recorded operations into the target.
+    void Flush();
+
+   private:
+    struct Op;
+
+    // Returns false if the operation cannot be represented in the batch and
+    // must be drawn directly.
+    bool Record(const Path* aPath, const Pattern& aPattern,
+                const StrokeOptions* aStrokeOptions,
+                const DrawOptions& aOptions);
+    void ReplaySerial();
+
+    DrawTargetSkia* mDT;
+    std::vector<Op> mOps;
+  };
+
   virtual void FillGlyphs(ScaledFont* aFont, const GlyphBuffer& aBuffer,
                           const Pattern& aPattern,
                           const DrawOptions& aOptions = DrawOptions()) override;
@@ -189,6 +237,15 @@ class DrawTargetSkia : public DrawTarget {
   };
   std::vector<PushedLayer> mPushedLayers;
 
+  /**
+   * Idle PathBuilders recycled by CreatePathBuilder(). An entry whose only
+   * remaining reference is the pool's has been released by its creator and
+   * can be rewound and handed out again, sparing an allocation per path in
+   * canvas-heavy content. Flush() drops the pool, so it is scoped to roughly
+   * a frame's worth of drawing. Mutable because CreatePathBuilder() is const.
+   */
+  mutable std::vector<RefPtr<PathBuilderSkia>> mPathBuilderPool;
+
   IntSize mSize;
   RefPtr<SkSurface> mSurface;
   SkCanvas* mCanvas = nullptr;
@@ -28,6 +28,15 @@ PathBuilderSkia::PathBuilderSkia(SkPath&& aPath, FillRule aFillRule,
 
 PathBuilderSkia::PathBuilderSkia(FillRule aFillRule) { SetFillRule(aFillRule); }
 
+void PathBuilderSkia::Reset(FillRule aFillRule) {
+  // rewind() empties the path but keeps its verb and point storage, unlike
+  // reset(), so a recycled builder doesn't have to grow it all over again.
+  mPath.rewind();
+  SetFillRule(aFillRule);
+  SetCurrentPoint(Point());
+  SetBeginPoint(Point());
+}
+
 void PathBuilderSkia::SetFillRule(FillRule aFillRule) {
   mFillRule = aFillRule;
   if (mFillRule == FillRule::FILL_WINDING) {
@@ -35,6 +35,12 @@ class PathBuilderSkia : public PathBuilder {
 
   void AppendPath(const SkPath& aPath);
 
+  /** Return the builder to its freshly-constructed state so it can be handed
+   * out again, keeping any path storage it has already allocated. Only valid
+   * once every external reference to the builder has been dropped.
+   */
+  void Reset(FillRule aFillRule);
+
   BackendType GetBackendType() const override { return BackendType::SKIA; }
 
   bool IsActive() const override { return mPath.countPoints() > 0; }
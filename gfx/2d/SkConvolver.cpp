@@ -148,6 +148,9 @@ void ConvolveVertically(
 }
 
 #ifdef USE_SSE2
+void convolve_horizontally_avx2(const unsigned char* srcData,
+                                const SkConvolutionFilter1D& filter,
+                                unsigned char* outRow, bool hasAlpha);
 void convolve_vertically_avx2(const int16_t* filter, int filterLen,
                               uint8_t* const* srcRows, int width, uint8_t* out,
                               bool hasAlpha);
@@ -170,6 +173,10 @@ void convolve_horizontally(const unsigned char* srcData,
                            const SkConvolutionFilter1D& filter,
                            unsigned char* outRow, bool hasAlpha) {
 #ifdef USE_SSE2
+  if (mozilla::supports_avx2()) {
+    convolve_horizontally_avx2(srcData, filter, outRow, hasAlpha);
+    return;
+  }
   if (mozilla::supports_sse2()) {
     convolve_horizontally_sse2(srcData, filter, outRow, hasAlpha);
     return;
@@ -57,6 +57,8 @@ class gfxVarReceiver;
   _(WebRenderBlobTileSize, int32_t, 256)                           \
   _(WebRenderBatchedUploadThreshold, int32_t, 512 * 512)           \
   _(WebRenderSlowCpuFrameThreshold, float, 10.0)                   \
+  _(TouchResamplingPredictionMs, float, 0.0f)                      \
+  _(TouchResamplingMaxOvershootPx, float, 24.0f)                   \
   _(UseSoftwareWebRender, bool, false)                             \
   _(AllowSoftwareWebRenderD3D11, bool, false)                      \
   _(PrimaryScreenDepth, int32_t, 0)                                \
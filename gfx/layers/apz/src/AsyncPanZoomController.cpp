@@ -1414,6 +1414,7 @@ nsEventStatus AsyncPanZoomController::OnTouchStart(
     case NOTHING: {
       ParentLayerPoint point = GetFirstTouchPoint(aEvent);
       mLastTouch.mPosition = mStartTouch = GetFirstExternalTouchPoint(aEvent);
+      mTouchPredictionApplied = ParentLayerPoint();
       StartTouch(point, aEvent.mTimeStamp);
       if (RefPtr<GeckoContentController> controller =
               GetGeckoContentController()) {
@@ -1918,6 +1919,7 @@ nsEventStatus AsyncPanZoomController::OnScaleEnd(
       mLastTouch.mPosition = mStartTouch =
           ToExternalPoint(aEvent.mScreenOffset, aEvent.mFocusPoint);
       mLastTouch.mTimeStamp = mTouchStartTime = aEvent.mTimeStamp;
+      mTouchPredictionApplied = ParentLayerPoint();
       StartTouch(aEvent.mLocalFocusPoint, aEvent.mTimeStamp);
       SetState(TOUCHING);
     } else {
@@ -4371,13 +4373,35 @@ void AsyncPanZoomController::TrackTouch(const MultiTouchInput& aEvent) {
     mMinimumVelocityDuringPan = Some(velocity);
   }
 
-  if (prevTouchPoint != touchPoint) {
+  // If touch prediction is enabled, extrapolate the touch position along the
+  // current velocity to compensate for input-to-composite latency. The
+  // previous dispatch moved the scroll offset to prevTouchPoint plus the
+  // prediction applied at that time, so dispatching from there to the newly
+  // predicted position corrects the old prediction rather than accumulating
+  // it. When the finger slows down the velocity (and with it the prediction)
+  // decays, rolling any overshoot back toward the real touch position.
+  ParentLayerPoint prediction;
+  float predictionHorizonMs = gfx::gfxVars::TouchResamplingPredictionMs();
+  if (predictionHorizonMs > 0.0f) {
+    prediction = GetVelocityVector() * predictionHorizonMs;
+    float maxOvershootPx = gfx::gfxVars::TouchResamplingMaxOvershootPx();
+    float predictedDistance = prediction.Length();
+    if (predictedDistance > maxOvershootPx) {
+      prediction = prediction * (maxOvershootPx / predictedDistance);
+    }
+  }
+
+  ParentLayerPoint effectiveFrom = prevTouchPoint + mTouchPredictionApplied;
+  ParentLayerPoint effectiveTo = touchPoint + prediction;
+  mTouchPredictionApplied = prediction;
+
+  if (effectiveFrom != effectiveTo) {
     MOZ_ASSERT(GetCurrentTouchBlock());
     OverscrollHandoffState handoffState(
         *GetCurrentTouchBlock()->GetOverscrollHandoffChain(),
         PanVector(extPoint), ScrollSource::Touchscreen);
     RecordScrollPayload(aEvent.mTimeStamp);
-    CallDispatchScroll(prevTouchPoint, touchPoint, handoffState);
+    CallDispatchScroll(effectiveFrom, effectiveTo, handoffState);
   }
 }
 
@@ -1924,6 +1924,12 @@ class AsyncPanZoomController {
   // is in a panning state.
   TimeDuration mTouchStartRestingTimeBeforePan;
   Maybe<ParentLayerCoord> mMinimumVelocityDuringPan;
+  // The velocity-based touch prediction currently baked into the scroll
+  // offset, if gfxVars::TouchResamplingPredictionMs() is nonzero. Each
+  // touchmove dispatches its scroll relative to the previously predicted
+  // position, so prediction is corrected (not accumulated) as real samples
+  // arrive. Only accessed on the controller thread.
+  ParentLayerPoint mTouchPredictionApplied;
   // This variable needs to be protected by |mRecursiveMutex|.
   ScrollSnapTargetIds mLastSnapTargetIds;
   // Extra offset to add to the async scroll position for testing
@@ -22,6 +22,7 @@
 #include "mozilla/AutoRestore.h"      // for AutoRestore
 #include "mozilla/ClearOnShutdown.h"  // for ClearOnShutdown
 #include "mozilla/DebugOnly.h"        // for DebugOnly
+#include "mozilla/StaticMutex.h"
 #include "mozilla/StaticPrefs_gfx.h"
 #include "mozilla/StaticPrefs_layers.h"
 #include "mozilla/StaticPrefs_layout.h"
@@ -1970,5 +1971,37 @@ void RecordCompositionPayloadsPresented(
   }
 }
 
+// Ring buffer of the most recent frame timelines.  Written on the compositor
+// thread, readable from any thread, hence the lock; two vsyncs of records is
+// plenty to cover the frames around a missed deadline.
+static const size_t kFrameTimelineRingSize = 128;
+static StaticMutex sFrameTimelineLock;
+MOZ_RUNINIT static FrameTimelineRecord
+    sFrameTimelineRing[kFrameTimelineRingSize];
+static size_t sFrameTimelineNextIndex = 0;
+static size_t sFrameTimelineCount = 0;
+
+void RecordFrameTimeline(const FrameTimelineRecord& aRecord) {
+  StaticMutexAutoLock lock(sFrameTimelineLock);
+  sFrameTimelineRing[sFrameTimelineNextIndex] = aRecord;
+  sFrameTimelineNextIndex = (sFrameTimelineNextIndex + 1) %
+                            kFrameTimelineRingSize;
+  if (sFrameTimelineCount < kFrameTimelineRingSize) {
+    sFrameTimelineCount++;
+  }
+}
+
+void GetRecentFrameTimelines(nsTArray<FrameTimelineRecord>& aOutRecords) {
+  StaticMutexAutoLock lock(sFrameTimelineLock);
+  aOutRecords.SetCapacity(sFrameTimelineCount);
+  size_t start = (sFrameTimelineNextIndex + kFrameTimelineRingSize -
+                  sFrameTimelineCount) %
+                 kFrameTimelineRingSize;
+  for (size_t i = 0; i < sFrameTimelineCount; i++) {
+    aOutRecords.AppendElement(
+        sFrameTimelineRing[(start + i) % kFrameTimelineRingSize]);
+  }
+}
+
 }  // namespace layers
 }  // namespace mozilla
@@ -662,6 +662,36 @@ int32_t RecordContentFrameTime(
     const TimeDuration& aVsyncRate, bool aContainsSVGGroup,
     bool aRecordUploadStats, wr::RendererStats* aStats = nullptr);
 
+/**
+ * The timeline of one presented content transaction, from the content-side
+ * paint start through IPC, scene build and render to present.  The compositor
+ * process keeps the most recent records in a ring buffer so a snapshot of
+ * recent frame scheduling can be pulled out of a production build when a
+ * deadline is chronically missed.
+ */
+struct FrameTimelineRecord {
+  TransactionId mTransactionId;
+  // Content started preparing the transaction (refresh driver tick).
+  TimeStamp mTxnStartTime;
+  // Transaction was forwarded to the compositor.
+  TimeStamp mFwdTime;
+  // Scene build for the transaction finished.
+  TimeStamp mSceneBuiltTime;
+  // The composite that presented the transaction started.
+  TimeStamp mCompositeStartTime;
+  // The renderer started drawing.
+  TimeStamp mRenderStartTime;
+  // The frame was submitted for presentation.
+  TimeStamp mPresentTime;
+};
+
+// Appends a record to the process-wide frame timeline ring buffer.  Called on
+// the compositor thread for every presented content transaction.
+void RecordFrameTimeline(const FrameTimelineRecord& aRecord);
+
+// Copies the buffered records, oldest first.  Safe to call from any thread.
+void GetRecentFrameTimelines(nsTArray<FrameTimelineRecord>& aOutRecords);
+
 void RecordCompositionPayloadsPresented(
     const TimeStamp& aCompositionEndTime,
     const nsTArray<CompositionPayload>& aPayloads);
@@ -17,6 +17,7 @@ void IPDLParamTraits<mozilla::layers::DisplayListData>::Write(
   WriteIPDLParam(aWriter, aActor, aParam.mRect);
   WriteIPDLParam(aWriter, aActor, aParam.mCommands);
   WriteIPDLParam(aWriter, aActor, std::move(aParam.mDLItems));
+  WriteIPDLParam(aWriter, aActor, std::move(aParam.mDLItemsShmem));
   WriteIPDLParam(aWriter, aActor, std::move(aParam.mDLCache));
   WriteIPDLParam(aWriter, aActor, std::move(aParam.mDLSpatialTree));
   WriteIPDLParam(aWriter, aActor, aParam.mDLDesc);
@@ -32,6 +33,7 @@ bool IPDLParamTraits<mozilla::layers::DisplayListData>::Read(
       ReadIPDLParam(aReader, aActor, &aResult->mRect) &&
       ReadIPDLParam(aReader, aActor, &aResult->mCommands) &&
       ReadIPDLParam(aReader, aActor, &aResult->mDLItems) &&
+      ReadIPDLParam(aReader, aActor, &aResult->mDLItemsShmem) &&
       ReadIPDLParam(aReader, aActor, &aResult->mDLCache) &&
       ReadIPDLParam(aReader, aActor, &aResult->mDLSpatialTree) &&
       ReadIPDLParam(aReader, aActor, &aResult->mDLDesc) &&
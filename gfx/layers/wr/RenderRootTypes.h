@@ -21,6 +21,10 @@ struct DisplayListData {
   LayoutDeviceRect mRect;
   nsTArray<WebRenderParentCommand> mCommands;
   Maybe<mozilla::ipc::ByteBuf> mDLItems;
+  // A large item buffer is moved into its own shmem so that it crosses the
+  // channel as a handle transfer instead of message payload.  At most one of
+  // mDLItems and mDLItemsShmem is set.
+  Maybe<mozilla::ipc::Shmem> mDLItemsShmem;
   Maybe<mozilla::ipc::ByteBuf> mDLCache;
   Maybe<mozilla::ipc::ByteBuf> mDLSpatialTree;
   wr::BuiltDisplayListDescriptor mDLDesc;
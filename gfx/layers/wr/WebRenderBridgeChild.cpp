@@ -24,6 +24,11 @@ namespace layers {
 
 using namespace mozilla::gfx;
 
+// Display list item buffers at least this large are moved into a shmem and
+// sent as a handle transfer, instead of being pushed through the message
+// channel and re-assembled into a contiguous buffer on the compositor side.
+static const size_t kLargeDisplayListShmemThreshold = 1024 * 1024;
+
 WebRenderBridgeChild::WebRenderBridgeChild(const wr::PipelineId& aPipelineId)
     : mIsInTransaction(false),
       mIsInClearCachedResources(false),
@@ -117,6 +122,18 @@ bool WebRenderBridgeChild::EndTransaction(
   aDisplayListData.mCommands = std::move(mParentCommands);
   aDisplayListData.mIdNamespace = mIdNamespace;
 
+  if (aDisplayListData.mDLItems &&
+      aDisplayListData.mDLItems->mLen >= kLargeDisplayListShmemThreshold) {
+    ipc::Shmem shmem;
+    if (AllocUnsafeShmem(aDisplayListData.mDLItems->mLen, &shmem)) {
+      memcpy(shmem.get<uint8_t>(), aDisplayListData.mDLItems->mData,
+             aDisplayListData.mDLItems->mLen);
+      aDisplayListData.mDLItemsShmem.emplace(std::move(shmem));
+      aDisplayListData.mDLItems.reset();
+    }
+    // On allocation failure fall back to sending the ByteBuf in the message.
+  }
+
   nsTArray<CompositionPayload> payloads;
   if (mManager) {
     mManager->TakeCompositionPayloads(payloads);
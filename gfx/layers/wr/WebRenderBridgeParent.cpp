@@ -24,6 +24,7 @@
 #include "mozilla/gfx/gfxVars.h"
 #include "mozilla/gfx/GPUParent.h"
 #include "mozilla/glean/GfxMetrics.h"
+#include "mozilla/ipc/ByteBuf.h"
 #include "mozilla/layers/AnimationHelper.h"
 #include "mozilla/layers/APZSampler.h"
 #include "mozilla/layers/APZUpdater.h"
@@ -1212,6 +1213,19 @@ bool WebRenderBridgeParent::ProcessDisplayListData(
                              mRemoteTextureTxnScheduler, mFwdTransactionId);
   Maybe<wr::AutoTransactionSender> sender;
 
+  // A large item buffer arrives in its own shmem; reclaim it as a ByteBuf
+  // before any early return so the shmem is never leaked.
+  if (aDisplayList.mDLItemsShmem) {
+    ipc::Shmem& shmem = aDisplayList.mDLItemsShmem.ref();
+    ipc::ByteBuf items;
+    if (items.Allocate(shmem.Size<uint8_t>())) {
+      memcpy(items.mData, shmem.get<uint8_t>(), items.mLen);
+      aDisplayList.mDLItems.emplace(std::move(items));
+    }
+    DeallocShmem(shmem);
+    aDisplayList.mDLItemsShmem.reset();
+  }
+
   if (aDisplayList.mScrollData && !aDisplayList.mScrollData->Validate()) {
     // If the scroll data is invalid, the entire transaction needs to be dropped
     // because the scroll data and the display list cross-reference each other.
@@ -1270,6 +1284,10 @@ mozilla::ipc::IPCResult WebRenderBridgeParent::RecvSetDisplayList(
     }
     wr::IpcResourceUpdateQueue::ReleaseShmems(this, aDisplayList.mSmallShmems);
     wr::IpcResourceUpdateQueue::ReleaseShmems(this, aDisplayList.mLargeShmems);
+    if (aDisplayList.mDLItemsShmem) {
+      DeallocShmem(aDisplayList.mDLItemsShmem.ref());
+      aDisplayList.mDLItemsShmem.reset();
+    }
     return IPC_OK();
   }
 
@@ -2673,6 +2691,57 @@ void WebRenderBridgeParent::FlushTransactionIdsForEpoch(
 
       RecordPaintPhaseTelemetry(aStats);
 
+      FrameTimelineRecord timeline;
+      timeline.mTransactionId = transactionId.mId;
+      timeline.mTxnStartTime = transactionId.mTxnStartTime;
+      timeline.mFwdTime = transactionId.mFwdTime;
+      timeline.mSceneBuiltTime = transactionId.mSceneBuiltTime;
+      timeline.mCompositeStartTime = aCompositeStartTime;
+      timeline.mRenderStartTime = aRenderStartTime;
+      timeline.mPresentTime = aEndTime;
+      RecordFrameTimeline(timeline);
+
+      if (profiler_thread_is_being_profiled_for_markers()) {
+        struct FrameTimelineMarker {
+          static constexpr Span<const char> MarkerTypeName() {
+            return MakeStringSpan("FrameTimeline");
+          }
+          static void StreamJSONMarkerData(
+              baseprofiler::SpliceableJSONWriter& aWriter, double aForwardMs,
+              double aSceneBuildMs, double aCompositeWaitMs, double aRenderMs) {
+            aWriter.DoubleProperty("forward", aForwardMs);
+            aWriter.DoubleProperty("sceneBuild", aSceneBuildMs);
+            aWriter.DoubleProperty("compositeWait", aCompositeWaitMs);
+            aWriter.DoubleProperty("render", aRenderMs);
+          }
+          static MarkerSchema MarkerTypeDisplay() {
+            using MS = MarkerSchema;
+            MS schema{MS::Location::MarkerChart, MS::Location::MarkerTable};
+            schema.AddKeyLabelFormat("forward", "Forward",
+                                     MS::Format::Duration);
+            schema.AddKeyLabelFormat("sceneBuild", "Scene build",
+                                     MS::Format::Duration);
+            schema.AddKeyLabelFormat("compositeWait", "Composite wait",
+                                     MS::Format::Duration);
+            schema.AddKeyLabelFormat("render", "Render", MS::Format::Duration);
+            return schema;
+          }
+        };
+
+        auto phaseMs = [](const TimeStamp& aFrom, const TimeStamp& aTo) {
+          return aFrom && aTo && aFrom <= aTo ? (aTo - aFrom).ToMilliseconds()
+                                              : 0.0;
+        };
+        profiler_add_marker(
+            "FrameTimeline", geckoprofiler::category::GRAPHICS,
+            MarkerTiming::Interval(transactionId.mTxnStartTime, aEndTime),
+            FrameTimelineMarker{},
+            phaseMs(transactionId.mTxnStartTime, transactionId.mFwdTime),
+            phaseMs(transactionId.mFwdTime, transactionId.mSceneBuiltTime),
+            phaseMs(transactionId.mSceneBuiltTime, aCompositeStartTime),
+            phaseMs(aRenderStartTime, aEndTime));
+      }
+
       if (StaticPrefs::gfx_logging_slow_frames_enabled_AtStartup() &&
           contentFrameTime > 200) {
         aOutputStats.AppendElement(FrameStats(
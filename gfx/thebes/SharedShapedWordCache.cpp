@@ -0,0 +1,287 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "SharedShapedWordCache.h"
+
+#include <atomic>
+
+#include "gfxFontEntry.h"
+#include "mozilla/Atomics.h"
+#include "mozilla/HashFunctions.h"
+#include "mozilla/Preferences.h"
+#include "mozilla/dom/ContentChild.h"
+#include "nsThreadUtils.h"
+
+namespace mozilla {
+
+using CompressedGlyph = gfxShapedText::CompressedGlyph;
+
+namespace {
+
+// Number of record slots in the table. With the record layout below this
+// comes to a bit under 2.5MB of shared memory, enough for the UI strings of
+// a typical session without being worth accounting against content.
+constexpr uint32_t kCapacity = 8192;
+
+// How far linear probing walks before giving up, on both insert and lookup.
+constexpr uint32_t kMaxProbes = 8;
+
+constexpr uint32_t kStatePublished = 1;
+
+struct CacheHeader {
+  uint32_t mCapacity;
+  uint32_t mRecordSize;
+};
+
+}  // namespace
+
+struct SharedShapedWordCache::Record {
+  // Primary hash of the word; 0 means the slot is empty. Writers claim a
+  // slot by compare-exchanging this from 0.
+  std::atomic<uint32_t> mKey;
+  // 0 while the payload is being written, 1 once it is safe to read.
+  std::atomic<uint32_t> mState;
+  uint32_t mCheck;
+  uint16_t mLength;
+  uint16_t mTextIs8Bit;
+  char16_t mText[kMaxWordLength];
+  uint32_t mAdvances[kMaxWordLength];
+  uint16_t mGlyphs[kMaxWordLength];
+  uint8_t mIsSpace[kMaxWordLength];
+};
+
+static Atomic<SharedShapedWordCache*> sInstance;
+static Atomic<bool> sInitAttempted;
+
+SharedShapedWordCache::SharedShapedWordCache(
+    ipc::SharedMemoryMapping&& aShmem, ipc::ReadOnlySharedMemoryHandle&& aHandle)
+    : mShmem(std::move(aShmem)), mReadOnlyHandle(std::move(aHandle)) {
+  MOZ_ASSERT(XRE_IsParentProcess());
+}
+
+SharedShapedWordCache::SharedShapedWordCache(
+    ipc::ReadOnlySharedMemoryMapping&& aShmem)
+    : mShmem(std::move(aShmem)) {
+  MOZ_ASSERT(!XRE_IsParentProcess());
+}
+
+/* static */
+SharedShapedWordCache* SharedShapedWordCache::Get() {
+  SharedShapedWordCache* instance = sInstance;
+  if (instance || sInitAttempted) {
+    return instance;
+  }
+  if (!NS_IsMainThread()) {
+    return nullptr;
+  }
+  sInitAttempted = true;
+  if (XRE_IsParentProcess()) {
+    if (Preferences::GetBool("gfx.font_rendering.shared_shaping_cache.enabled",
+                             true)) {
+      instance = Create();
+    }
+  } else if (XRE_IsContentProcess()) {
+    instance = FetchFromParent();
+  }
+  sInstance = instance;
+  return instance;
+}
+
+/* static */
+SharedShapedWordCache* SharedShapedWordCache::Create() {
+  size_t size = sizeof(CacheHeader) + size_t(kCapacity) * sizeof(Record);
+  auto handle = ipc::shared_memory::CreateFreezable(size);
+  if (!handle) {
+    return nullptr;
+  }
+  auto [readOnly, shm] = std::move(handle).Map().FreezeWithMutableMapping();
+  if (!shm || !shm.Address() || !readOnly) {
+    return nullptr;
+  }
+  // Freshly created shared memory is zeroed, so all slots start out empty;
+  // we only need to fill in the header.
+  auto* header = static_cast<CacheHeader*>(shm.Address());
+  header->mCapacity = kCapacity;
+  header->mRecordSize = sizeof(Record);
+  return new SharedShapedWordCache(std::move(shm), std::move(readOnly));
+}
+
+/* static */
+SharedShapedWordCache* SharedShapedWordCache::FetchFromParent() {
+  ipc::ReadOnlySharedMemoryHandle handle;
+  if (!dom::ContentChild::GetSingleton()->SendGetSharedShapedWordCache(
+          &handle) ||
+      !handle) {
+    // Null handle: the cache is disabled in the parent.
+    return nullptr;
+  }
+  auto shm = handle.Map();
+  if (!shm || !shm.Address() || shm.Size() < sizeof(CacheHeader)) {
+    return nullptr;
+  }
+  const auto* header = shm.DataAs<CacheHeader>();
+  if (header->mRecordSize != sizeof(Record) ||
+      shm.Size() <
+          sizeof(CacheHeader) + uint64_t(header->mCapacity) * sizeof(Record)) {
+    // Mismatched layout (e.g. during an unaligned update); don't use it.
+    return nullptr;
+  }
+  return new SharedShapedWordCache(std::move(shm));
+}
+
+SharedShapedWordCache::Record* SharedShapedWordCache::Records() const {
+  return reinterpret_cast<Record*>(static_cast<uint8_t*>(mShmem.Address()) +
+                                   sizeof(CacheHeader));
+}
+
+uint32_t SharedShapedWordCache::Capacity() const {
+  return static_cast<const CacheHeader*>(mShmem.Address())->mCapacity;
+}
+
+/* static */
+bool SharedShapedWordCache::IsEligible(const gfxFont* aFont,
+                                       uint32_t aLength) {
+  return aLength > 0 && aLength <= kMaxWordLength &&
+         !aFont->GetFontEntry()->IsUserFont();
+}
+
+/* static */
+SharedShapedWordCache::WordKey SharedShapedWordCache::ComputeKey(
+    const gfxFont* aFont, uint32_t aTextHash, uint32_t aLength,
+    intl::Script aRunScript, nsAtom* aLanguage, uint16_t aAppUnitsPerDevUnit,
+    gfx::ShapedTextFlags aFlags, gfxFontShaper::RoundingFlags aRounding) {
+  const gfxFontEntry* fe = aFont->GetFontEntry();
+  const gfxFontStyle* style = aFont->GetStyle();
+
+  // Identify the font by entry name and style; gfxFontStyle::Hash() does not
+  // cover feature settings, which change shaping, so mix those in explicitly.
+  uint32_t fontHash = AddToHash(HashString(fe->Name()), style->Hash());
+  if (!style->featureSettings.IsEmpty()) {
+    fontHash = AddToHash(
+        fontHash,
+        HashBytes(style->featureSettings.Elements(),
+                  style->featureSettings.Length() * sizeof(gfxFontFeature)));
+  }
+
+  uint32_t langHash = aLanguage ? aLanguage->hash() : 0;
+
+  WordKey key;
+  key.mKey = AddToHash(fontHash, aTextHash, aLength, uint32_t(aRunScript),
+                       langHash, aAppUnitsPerDevUnit, uint32_t(aFlags),
+                       uint32_t(aRounding));
+  // Mix the same inputs in the opposite order for the check hash, so that a
+  // collision requires two independently-mixed 32-bit hashes to agree.
+  key.mCheck =
+      AddToHash(HashGeneric(uint32_t(aRounding), uint32_t(aFlags)),
+                aAppUnitsPerDevUnit, langHash, uint32_t(aRunScript), aLength,
+                aTextHash, fontHash);
+  if (!key.mKey) {
+    key.mKey = 1;  // 0 is the empty-slot sentinel
+  }
+  return key;
+}
+
+bool SharedShapedWordCache::Fill(const WordKey& aKey,
+                                 gfxShapedWord* aWord) const {
+  if (XRE_IsParentProcess()) {
+    // The parent is the writer; it shapes every word itself.
+    return false;
+  }
+  const Record* records = Records();
+  const uint32_t capacity = Capacity();
+  uint32_t index = aKey.mKey % capacity;
+  for (uint32_t probe = 0; probe < kMaxProbes;
+       ++probe, index = (index + 1) % capacity) {
+    const Record& rec = records[index];
+    uint32_t key = rec.mKey.load(std::memory_order_acquire);
+    if (!key) {
+      // An empty slot terminates the probe sequence: the word is not here.
+      return false;
+    }
+    if (key != aKey.mKey ||
+        rec.mState.load(std::memory_order_acquire) != kStatePublished) {
+      continue;
+    }
+    if (rec.mCheck != aKey.mCheck || rec.mLength != aWord->GetLength() ||
+        bool(rec.mTextIs8Bit) != aWord->TextIs8Bit()) {
+      continue;
+    }
+    uint32_t length = rec.mLength;
+    bool textMatches = true;
+    for (uint32_t i = 0; i < length; ++i) {
+      if (aWord->GetCharAt(i) != rec.mText[i]) {
+        textMatches = false;
+        break;
+      }
+    }
+    if (!textMatches) {
+      continue;
+    }
+    CompressedGlyph* glyphs = aWord->GetCharacterGlyphs();
+    for (uint32_t i = 0; i < length; ++i) {
+      CompressedGlyph g =
+          CompressedGlyph::MakeSimpleGlyph(rec.mAdvances[i], rec.mGlyphs[i]);
+      if (rec.mIsSpace[i]) {
+        g.SetIsSpace();
+      }
+      glyphs[i] = g;
+    }
+    return true;
+  }
+  return false;
+}
+
+void SharedShapedWordCache::Add(const WordKey& aKey,
+                                const gfxShapedWord* aWord) {
+  MOZ_ASSERT(XRE_IsParentProcess());
+  uint32_t length = aWord->GetLength();
+  if (!length || length > kMaxWordLength) {
+    return;
+  }
+  const CompressedGlyph* glyphs = aWord->GetCharacterGlyphs();
+  for (uint32_t i = 0; i < length; ++i) {
+    if (!glyphs[i].IsSimpleGlyph()) {
+      // Complex records need DetailedGlyph side tables; not representable.
+      return;
+    }
+  }
+
+  Record* records = Records();
+  const uint32_t capacity = Capacity();
+  uint32_t index = aKey.mKey % capacity;
+  for (uint32_t probe = 0; probe < kMaxProbes;
+       ++probe, index = (index + 1) % capacity) {
+    Record& rec = records[index];
+    uint32_t expected = 0;
+    if (!rec.mKey.compare_exchange_strong(expected, aKey.mKey,
+                                          std::memory_order_acq_rel)) {
+      if (expected == aKey.mKey) {
+        // Already cached (or being written right now by another thread).
+        return;
+      }
+      continue;
+    }
+    rec.mCheck = aKey.mCheck;
+    rec.mLength = uint16_t(length);
+    rec.mTextIs8Bit = aWord->TextIs8Bit();
+    for (uint32_t i = 0; i < length; ++i) {
+      rec.mText[i] = aWord->GetCharAt(i);
+      rec.mAdvances[i] = glyphs[i].GetSimpleAdvance();
+      rec.mGlyphs[i] = uint16_t(glyphs[i].GetSimpleGlyph());
+      rec.mIsSpace[i] = glyphs[i].CharIsSpace();
+    }
+    rec.mState.store(kStatePublished, std::memory_order_release);
+    return;
+  }
+  // Every slot in the neighborhood is taken by other words; drop this one.
+}
+
+ipc::ReadOnlySharedMemoryHandle SharedShapedWordCache::CloneHandle() const {
+  MOZ_ASSERT(XRE_IsParentProcess());
+  return mReadOnlyHandle.Clone();
+}
+
+}  // namespace mozilla
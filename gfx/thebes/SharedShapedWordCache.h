@@ -0,0 +1,111 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef SharedShapedWordCache_h
+#define SharedShapedWordCache_h
+
+#include "gfxFont.h"
+#include "mozilla/ipc/SharedMemoryHandle.h"
+#include "mozilla/ipc/SharedMemoryMapping.h"
+
+namespace mozilla {
+
+/**
+ * A fixed-size, cross-process cache of shaped words, created and written by
+ * the parent process and mapped read-only into content processes.
+ *
+ * The per-gfxFont word caches are per-process, so with many content processes
+ * the same UI strings (menus, form controls, default page chrome) get shaped
+ * over and over. The parent process shapes those strings too; by publishing
+ * its results in shared memory, content processes can copy the glyphs instead
+ * of repeating the HarfBuzz work, which is a significant win for first paint
+ * in scripts with expensive shaping.
+ *
+ * The table is an open-addressed hash of fixed-size records, append-published:
+ * a writer claims an empty slot with a compare-exchange on the key word, fills
+ * in the payload, and then release-stores a published flag. Readers
+ * acquire-load the flag before touching the payload, so no locking is needed
+ * on the (hot) read side. Entries are never updated or evicted; a full
+ * neighborhood simply stops accepting new words.
+ *
+ * Only words whose glyphs are all "simple" (see CompressedGlyph) can be
+ * cached, because complex records reference per-word DetailedGlyph side
+ * tables that cannot be shared this way. User fonts are excluded because
+ * their names do not identify the same resource across documents.
+ */
+class SharedShapedWordCache {
+ public:
+  // Longest word (in characters) that a record can store.
+  static constexpr uint32_t kMaxWordLength = 32;
+
+  /**
+   * Return the per-process instance, or null if the cache is disabled or
+   * could not be created/mapped. The instance is created lazily on the main
+   * thread (in a content process this involves a sync message to the parent);
+   * off-main-thread callers simply miss until it exists.
+   */
+  static SharedShapedWordCache* Get();
+
+  /**
+   * Hash key identifying a shaped word. The primary hash selects the slot;
+   * the independently-mixed check hash, together with the text stored in the
+   * record, guards against collisions.
+   */
+  struct WordKey {
+    uint32_t mKey = 0;
+    uint32_t mCheck = 0;
+  };
+
+  // Whether a word of aLength characters shaped with aFont may use the
+  // shared cache at all.
+  static bool IsEligible(const gfxFont* aFont, uint32_t aLength);
+
+  static WordKey ComputeKey(const gfxFont* aFont, uint32_t aTextHash,
+                            uint32_t aLength, intl::Script aRunScript,
+                            nsAtom* aLanguage, uint16_t aAppUnitsPerDevUnit,
+                            gfx::ShapedTextFlags aFlags,
+                            gfxFontShaper::RoundingFlags aRounding);
+
+  /**
+   * Look up aKey and, on a hit, copy the cached glyphs into aWord, which must
+   * already hold the word's text. Returns false on a miss, and always in the
+   * parent process, which shapes for itself.
+   */
+  bool Fill(const WordKey& aKey, gfxShapedWord* aWord) const;
+
+  /**
+   * Publish aWord under aKey. Parent process only. Words that are not
+   * representable (complex glyphs, overlong) are silently skipped, as are
+   * insertions whose probe neighborhood is already full.
+   */
+  void Add(const WordKey& aKey, const gfxShapedWord* aWord);
+
+  // Parent only: clone the read-only handle for sending to a content process.
+  ipc::ReadOnlySharedMemoryHandle CloneHandle() const;
+
+ private:
+  struct Record;
+
+  SharedShapedWordCache(ipc::SharedMemoryMapping&& aShmem,
+                        ipc::ReadOnlySharedMemoryHandle&& aHandle);
+  explicit SharedShapedWordCache(ipc::ReadOnlySharedMemoryMapping&& aShmem);
+
+  // Parent: allocate and initialize the shared table.
+  static SharedShapedWordCache* Create();
+  // Content: request the read-only handle from the parent and map it.
+  static SharedShapedWordCache* FetchFromParent();
+
+  Record* Records() const;
+  uint32_t Capacity() const;
+
+  ipc::MutableOrReadOnlySharedMemoryMapping mShmem;
+  // Parent only: the frozen handle shared with content processes.
+  ipc::ReadOnlySharedMemoryHandle mReadOnlyHandle;
+};
+
+}  // namespace mozilla
+
+#endif  // SharedShapedWordCache_h
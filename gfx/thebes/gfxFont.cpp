@@ -47,6 +47,7 @@
 #include "mozilla/glean/GfxMetrics.h"
 #include "gfxMathTable.h"
 #include "gfxSVGGlyphs.h"
+#include "SharedShapedWordCache.h"
 #include "gfx2DGlue.h"
 #include "TextDrawTarget.h"
 
@@ -3315,10 +3316,30 @@ bool gfxFont::ProcessShapedWordInternal(
     NS_WARNING("failed to create gfxShapedWord - expect missing text");
     return false;
   }
-  DebugOnly<bool> ok =
-      ShapeText(aDrawTarget, aText, 0, aLength, aRunScript, aLanguage,
-                aVertical, aRounding, newShapedWord.get());
-  NS_WARNING_ASSERTION(ok, "failed to shape word - expect garbled text");
+
+  // Consult the cross-process shared cache before shaping: if the parent
+  // process has already shaped this word, copy its glyphs instead of
+  // repeating the work. The parent publishes eligible words that it shapes.
+  SharedShapedWordCache* sharedCache =
+      SharedShapedWordCache::IsEligible(this, aLength)
+          ? SharedShapedWordCache::Get()
+          : nullptr;
+  SharedShapedWordCache::WordKey sharedKey;
+  if (sharedCache) {
+    sharedKey = SharedShapedWordCache::ComputeKey(
+        this, aHash, aLength, aRunScript, aLanguage, aAppUnitsPerDevUnit,
+        aFlags, aRounding);
+  }
+
+  if (!sharedCache || !sharedCache->Fill(sharedKey, newShapedWord.get())) {
+    DebugOnly<bool> ok =
+        ShapeText(aDrawTarget, aText, 0, aLength, aRunScript, aLanguage,
+                  aVertical, aRounding, newShapedWord.get());
+    NS_WARNING_ASSERTION(ok, "failed to shape word - expect garbled text");
+    if (sharedCache && XRE_IsParentProcess()) {
+      sharedCache->Add(sharedKey, newShapedWord.get());
+    }
+  }
 
   {
     // We're going to cache the new shaped word, so lock for writing now.
@@ -589,6 +589,16 @@ static void WebRenderBlobTileSizePrefChangeCallback(const char* aPrefName,
   gfx::gfxVars::SetWebRenderBlobTileSize(tileSize);
 }
 
+static void TouchResamplingPrefChangeCallback(const char* aPrefName, void*) {
+  float horizonMs =
+      Preferences::GetFloat("apz.touch_resampling.prediction_ms", 0.0f);
+  float maxOvershootPx =
+      Preferences::GetFloat("apz.touch_resampling.max_overshoot_px", 24.0f);
+
+  gfx::gfxVars::SetTouchResamplingPredictionMs(horizonMs);
+  gfx::gfxVars::SetTouchResamplingMaxOvershootPx(maxOvershootPx);
+}
+
 static void WebRenderUploadThresholdPrefChangeCallback(const char* aPrefName,
                                                        void*) {
   int value = Preferences::GetInt(
@@ -2720,6 +2730,9 @@ void gfxPlatform::InitWebRenderConfig() {
       nsDependentCString(
           StaticPrefs::GetPrefName_gfx_webrender_batched_upload_threshold()));
 
+  Preferences::RegisterPrefixCallbackAndCall(TouchResamplingPrefChangeCallback,
+                                             "apz.touch_resampling");
+
   if (WebRenderResourcePathOverride()) {
     CrashReporter::RecordAnnotationBool(
         CrashReporter::Annotation::IsWebRenderResourcePathOverridden, true);
@@ -729,9 +729,35 @@ bool gfxPlatformFontList::InitFontList() {
     }
   }
 
+  MaybeStartCmapPrefetch();
+
   return true;
 }
 
+void gfxPlatformFontList::MaybeStartCmapPrefetch() {
+  // Only the parent runs the cmap loader; content processes pick up the
+  // results through the shared font list. The pref is checked on the main
+  // thread, inside the idle task, because InitFontList may be running on the
+  // startup font-info thread.
+  if (!XRE_IsParentProcess()) {
+    return;
+  }
+  NS_DispatchToMainThreadQueue(
+      NS_NewRunnableFunction(
+          "gfxPlatformFontList::MaybeStartCmapPrefetch",
+          [] {
+            if (!Preferences::GetBool(
+                    "gfx.font_rendering.fallback.cmap-prefetch", true)) {
+              return;
+            }
+            auto* pfl = PlatformFontList();
+            if (pfl && pfl->SharedFontList()) {
+              pfl->StartCmapLoadingFromFamily(0);
+            }
+          }),
+      EventQueuePriority::Idle);
+}
+
 void gfxPlatformFontList::LoadIconFontOverrideList() {
   mIconFontsSet.Clear();
   AutoTArray<nsCString, 20> iconFontsList;
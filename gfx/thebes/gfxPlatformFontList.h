@@ -379,6 +379,11 @@ class gfxPlatformFontList : public gfxFontInfoLoader {
   // given family index. (For use in any process that needs font lookups.)
   void StartCmapLoadingFromFamily(uint32_t aStartIndex);
 
+  // [Parent] Schedule an idle-time prefetch of family character maps, so
+  // that the first global font fallback doesn't find them all missing and
+  // have to restart layout once the async loader catches up.
+  void MaybeStartCmapPrefetch();
+
   // [Parent] Handle request from content process to start cmap loading.
   void StartCmapLoading(uint32_t aGeneration, uint32_t aStartIndex);
 
@@ -201,9 +201,9 @@ gfxTextRun::~gfxTextRun() {
   mFlags2 = ~nsTextFrameUtils::Flags();
 #endif
 
-  // The cached ellipsis textrun (if any) in a fontgroup will have already
-  // been told to release its reference to the group, so we mustn't do that
-  // again here.
+  // The cached ellipsis or hyphen textrun (if any) in a fontgroup will have
+  // already been told to release its reference to the group, so we mustn't
+  // do that again here.
   if (!mReleasedFontGroup) {
 #ifndef RELEASE_OR_BETA
     gfxTextPerfMetrics* tp = mFontGroup->GetTextPerfMetrics();
@@ -224,10 +224,10 @@ void gfxTextRun::ReleaseFontGroup() {
   //
   // (It doesn't actually matter that we can't get up-to-date results for
   // ShouldSkipDrawing(), since the only text runs that we call
-  // ReleaseFontGroup() for are ellipsis text runs, and we ask the font
-  // group for a new ellipsis text run each time we want to draw one,
-  // and ensure that the cached one is cleared in ClearCachedData() when
-  // font loading status changes.)
+  // ReleaseFontGroup() for are the cached ellipsis and hyphen text runs,
+  // and we ask the font group for those runs each time we want to draw
+  // one, and ensure that the cached ones are cleared in ClearCachedData()
+  // when font loading status changes.)
   mReleasedFontGroupSkippedDrawing = mFontGroup->ShouldSkipDrawing();
 
   NS_RELEASE(mFontGroup);
@@ -1904,6 +1904,7 @@ void gfxFontGroup::EnsureFontList() {
     // Forget cached fonts that may no longer be valid.
     mLastPrefFamily = FontFamily();
     mLastPrefFont = nullptr;
+    mRecentFallbackFonts.Clear();
     mDefaultFont = nullptr;
     mResolvedFonts = false;
   }
@@ -2467,19 +2468,40 @@ already_AddRefed<gfxTextRun> gfxFontGroup::MakeBlankTextRun(
 already_AddRefed<gfxTextRun> gfxFontGroup::MakeHyphenTextRun(
     DrawTarget* aDrawTarget, gfx::ShapedTextFlags aFlags,
     uint32_t aAppUnitsPerDevUnit) {
+  // The run depends only on the fontgroup's current fonts, the orientation/
+  // direction flags and the appunits scale, so a single cached run can be
+  // shared by all the frames that hyphenate with this fontgroup (like the
+  // ellipsis run above).
+  constexpr auto kFlagsMask =
+      ShapedTextFlags::TEXT_ORIENT_MASK | ShapedTextFlags::TEXT_IS_RTL;
+  if (mCachedHyphenTextRun &&
+      (mCachedHyphenTextRun->GetFlags() & kFlagsMask) ==
+          (aFlags & kFlagsMask) &&
+      mCachedHyphenTextRun->GetAppUnitsPerDevUnit() == aAppUnitsPerDevUnit) {
+    return do_AddRef(mCachedHyphenTextRun);
+  }
+
   // only use U+2010 if it is supported by the first font in the group;
   // it's better to use ASCII '-' from the primary font than to fall back to
   // U+2010 from some other, possibly poorly-matching face
   static const char16_t hyphen = 0x2010;
   RefPtr<gfxFont> font = GetFirstValidFont(uint32_t(hyphen));
+  RefPtr<gfxTextRun> textRun;
   if (font->HasCharacter(hyphen)) {
-    return MakeTextRun(&hyphen, 1, aDrawTarget, aAppUnitsPerDevUnit, aFlags,
-                       nsTextFrameUtils::Flags(), nullptr);
+    textRun = MakeTextRun(&hyphen, 1, aDrawTarget, aAppUnitsPerDevUnit, aFlags,
+                          nsTextFrameUtils::Flags(), nullptr);
+  } else {
+    static const uint8_t dash = '-';
+    textRun = MakeTextRun(&dash, 1, aDrawTarget, aAppUnitsPerDevUnit, aFlags,
+                          nsTextFrameUtils::Flags(), nullptr);
   }
-
-  static const uint8_t dash = '-';
-  return MakeTextRun(&dash, 1, aDrawTarget, aAppUnitsPerDevUnit, aFlags,
-                     nsTextFrameUtils::Flags(), nullptr);
+  if (textRun) {
+    mCachedHyphenTextRun = textRun;
+    // don't let the presence of a cached hyphen textrun prolong the
+    // fontgroup's life
+    mCachedHyphenTextRun->ReleaseFontGroup();
+  }
+  return textRun.forget();
 }
 
 gfxFloat gfxFontGroup::GetHyphenWidth(
@@ -3925,10 +3947,36 @@ already_AddRefed<gfxFont> gfxFontGroup::WhichPrefFontSupportsChar(
 already_AddRefed<gfxFont> gfxFontGroup::WhichSystemFontSupportsChar(
     uint32_t aCh, uint32_t aNextCh, Script aRunScript,
     FontPresentation aPresentation) {
+  // Before the full system search, try the fonts that recent fallbacks for
+  // this font group resolved to, using the same acceptance criterion as the
+  // global search (color-glyph presence must match the requested
+  // presentation).
+  for (uint32_t i = 0; i < mRecentFallbackFonts.Length(); ++i) {
+    const RefPtr<gfxFont>& font = mRecentFallbackFonts[i];
+    if (font->HasCharacter(aCh) &&
+        font->HasColorGlyphFor(aCh, aNextCh) == PrefersColor(aPresentation)) {
+      RefPtr<gfxFont> result = font;
+      if (i > 0) {
+        // Keep the most recently useful font at the front.
+        mRecentFallbackFonts.RemoveElementAt(i);
+        mRecentFallbackFonts.InsertElementAt(0, result);
+      }
+      return result.forget();
+    }
+  }
+
   FontVisibility visibility;
-  return gfxPlatformFontList::PlatformFontList()->SystemFindFontForChar(
-      mPresContext, aCh, aNextCh, aRunScript, aPresentation, &mStyle,
-      &visibility);
+  RefPtr<gfxFont> font =
+      gfxPlatformFontList::PlatformFontList()->SystemFindFontForChar(
+          mPresContext, aCh, aNextCh, aRunScript, aPresentation, &mStyle,
+          &visibility);
+  if (font && !mRecentFallbackFonts.Contains(font)) {
+    mRecentFallbackFonts.InsertElementAt(0, font);
+    if (mRecentFallbackFonts.Length() > 4) {
+      mRecentFallbackFonts.TruncateLength(4);
+    }
+  }
+  return font.forget();
 }
 
 gfxFont::Metrics gfxFontGroup::GetMetricsForCSSUnits(
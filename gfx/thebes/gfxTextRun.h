@@ -990,8 +990,9 @@ class gfxFontGroup final : public gfxTextRunFactory {
    * Make a text run representing a single hyphen character.
    * This will use U+2010 HYPHEN if available in the first font,
    * otherwise fall back to U+002D HYPHEN-MINUS.
-   * The caller is responsible for deleting the returned text run
-   * when no longer required.
+   * The returned run may be shared with other callers (it is cached on the
+   * fontgroup until the fonts or the requested size/orientation change), so
+   * it must be treated as immutable.
    */
   already_AddRefed<gfxTextRun> MakeHyphenTextRun(
       DrawTarget* aDrawTarget, mozilla::gfx::ShapedTextFlags aFlags,
@@ -1040,6 +1041,7 @@ class gfxFontGroup final : public gfxTextRunFactory {
     mSkipDrawing = false;
     mHyphenWidth = -1;
     mCachedEllipsisTextRun = nullptr;
+    mCachedHyphenTextRun = nullptr;
   }
 
   // If there is a user font set, check to see whether the font list or any
@@ -1382,9 +1384,20 @@ class gfxFontGroup final : public gfxTextRunFactory {
   // at a specific appUnitsPerDevPixel size and orientation
   RefPtr<gfxTextRun> mCachedEllipsisTextRun;
 
+  // Cache the textrun representing the default hyphenation character, at a
+  // specific appUnitsPerDevPixel size and orientation/direction; frames that
+  // hyphenate measure and draw this run repeatedly, so it is worth keeping
+  RefPtr<gfxTextRun> mCachedHyphenTextRun;
+
   // cache the most recent pref font to avoid general pref font lookup
   FontFamily mLastPrefFamily;
   RefPtr<gfxFont> mLastPrefFont;
+
+  // Small MRU of fonts recently found by global system fallback; text runs
+  // with several missing characters nearly always resolve to the same font,
+  // so checking these first avoids repeating the full cmap search for every
+  // character.
+  AutoTArray<RefPtr<gfxFont>, 4> mRecentFallbackFonts;
   eFontPrefLang mLastPrefLang = eFontPrefLang_Western;  // lang group for last
                                                         // pref font
   eFontPrefLang mPageLang;
@@ -11,6 +11,7 @@
 #include "mozilla/DebugOnly.h"
 #include "mozilla/Monitor.h"
 #include "mozilla/ProfilerLabels.h"
+#include "mozilla/ProfilerMarkers.h"
 #include "mozilla/SchedulerGroup.h"
 #include "mozilla/Services.h"
 #include "mozilla/StaticPrefs_image.h"
@@ -141,15 +142,32 @@ DecodePool::Observe(nsISupports*, const char* aTopic, const char16_t*) {
   return sSingleton->mShuttingDown;
 }
 
+static EventQueuePriority ToEventQueuePriority(TaskPriority aPriority) {
+  switch (aPriority) {
+    case TaskPriority::eLow:
+      return EventQueuePriority::Normal;
+    case TaskPriority::eMedium:
+      return EventQueuePriority::MediumHigh;
+    default:
+      return EventQueuePriority::RenderBlocking;
+  }
+}
+
 class DecodingTask final : public Task {
  public:
   explicit DecodingTask(RefPtr<IDecodingTask>&& aTask)
-      : Task(Kind::OffMainThreadOnly, aTask->Priority() == TaskPriority::eLow
-                                          ? EventQueuePriority::Normal
-                                          : EventQueuePriority::RenderBlocking),
-        mTask(aTask) {}
+      : Task(Kind::OffMainThreadOnly, ToEventQueuePriority(aTask->Priority())),
+        mTask(aTask),
+        mDispatchTime(TimeStamp::Now()) {}
 
   TaskResult Run() override {
+    // Record how long this task waited behind other decodes, so that queue
+    // head-of-line blocking (e.g. small icons stuck behind a large photo)
+    // is visible in profiles.
+    if (profiler_thread_is_being_profiled_for_markers()) {
+      PROFILER_MARKER_UNTYPED("ImageDecodeQueueWait", GRAPHICS,
+                              MarkerTiming::IntervalUntilNowFrom(mDispatchTime));
+    }
     mTask->Run();
     return TaskResult::Complete;
   }
@@ -163,6 +181,7 @@ class DecodingTask final : public Task {
 
  private:
   RefPtr<IDecodingTask> mTask;
+  TimeStamp mDispatchTime;
 };
 
 void DecodePool::AsyncRun(IDecodingTask* aTask) {
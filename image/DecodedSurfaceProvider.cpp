@@ -19,12 +19,14 @@ namespace image {
 
 DecodedSurfaceProvider::DecodedSurfaceProvider(NotNull<RasterImage*> aImage,
                                                const SurfaceKey& aSurfaceKey,
-                                               NotNull<Decoder*> aDecoder)
+                                               NotNull<Decoder*> aDecoder,
+                                               TaskPriority aPriority)
     : ISurfaceProvider(ImageKey(aImage.get()), aSurfaceKey,
                        AvailabilityState::StartAsPlaceholder()),
       mImage(aImage.get()),
       mMutex("mozilla::image::DecodedSurfaceProvider"),
-      mDecoder(aDecoder.get()) {
+      mDecoder(aDecoder.get()),
+      mPriority(aPriority) {
   MOZ_ASSERT(!mDecoder->IsMetadataDecode(),
              "Use MetadataDecodingTask for metadata decodes");
   MOZ_ASSERT(mDecoder->IsFirstFrameDecode(),
@@ -113,6 +115,18 @@ size_t DecodedSurfaceProvider::LogicalSizeInBytes() const {
   return size_t(size.width) * size_t(size.height) * sizeof(uint32_t);
 }
 
+bool DecodedSurfaceProvider::CompressSurfaceData() {
+  {
+    MutexAutoLock lock(mMutex);
+    if (mDecoder) {
+      // The decoder may still be writing to the surface.
+      return false;
+    }
+  }
+
+  return !IsLocked() && mSurface && mSurface->CompressSurfaceData();
+}
+
 void DecodedSurfaceProvider::Run() {
   MutexAutoLock lock(mMutex);
 
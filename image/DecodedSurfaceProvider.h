@@ -28,7 +28,7 @@ class DecodedSurfaceProvider final : public ISurfaceProvider,
 
   DecodedSurfaceProvider(NotNull<RasterImage*> aImage,
                          const SurfaceKey& aSurfaceKey,
-                         NotNull<Decoder*> aDecoder);
+                         NotNull<Decoder*> aDecoder, TaskPriority aPriority);
 
   //////////////////////////////////////////////////////////////////////////////
   // ISurfaceProvider implementation.
@@ -37,6 +37,7 @@ class DecodedSurfaceProvider final : public ISurfaceProvider,
  public:
   bool IsFinished() const override;
   size_t LogicalSizeInBytes() const override;
+  bool CompressSurfaceData() override;
 
  protected:
   DrawableFrameRef DrawableRef(size_t aFrame) override;
@@ -51,9 +52,10 @@ class DecodedSurfaceProvider final : public ISurfaceProvider,
   void Run() override;
   bool ShouldPreferSyncRun() const override;
 
-  // Full decodes are low priority compared to metadata decodes because they
-  // don't block layout or page load.
-  TaskPriority Priority() const override { return TaskPriority::eLow; }
+  // Full decodes never block layout or page load, so they run below metadata
+  // decodes; within that, the creator decides the priority based on how close
+  // the image is to the viewport.
+  TaskPriority Priority() const override { return mPriority; }
 
   //////////////////////////////////////////////////////////////////////////////
   // WebRenderImageProvider implementation.
@@ -85,6 +87,9 @@ class DecodedSurfaceProvider final : public ISurfaceProvider,
 
   /// A drawable reference to our service; used for locking.
   DrawableFrameRef mLockRef;
+
+  /// The priority our decoding task should be scheduled at.
+  const TaskPriority mPriority;
 };
 
 }  // namespace image
@@ -178,7 +178,8 @@ nsresult DecoderFactory::CreateDecoder(
     DecoderType aType, NotNull<RasterImage*> aImage,
     NotNull<SourceBuffer*> aSourceBuffer, const IntSize& aIntrinsicSize,
     const IntSize& aOutputSize, DecoderFlags aDecoderFlags,
-    SurfaceFlags aSurfaceFlags, IDecodingTask** aOutTask) {
+    SurfaceFlags aSurfaceFlags, TaskPriority aPriority,
+    IDecodingTask** aOutTask) {
   if (aType == DecoderType::UNKNOWN) {
     return NS_ERROR_INVALID_ARG;
   }
@@ -211,7 +212,7 @@ nsresult DecoderFactory::CreateDecoder(
   SurfaceKey surfaceKey =
       RasterSurfaceKey(aOutputSize, aSurfaceFlags, PlaybackType::eStatic);
   auto provider = MakeNotNull<RefPtr<DecodedSurfaceProvider>>(
-      aImage, surfaceKey, WrapNotNull(decoder));
+      aImage, surfaceKey, WrapNotNull(decoder), aPriority);
   if (aDecoderFlags & DecoderFlags::CANNOT_SUBSTITUTE) {
     provider->Availability().SetCannotSubstitute();
   }
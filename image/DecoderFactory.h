@@ -26,6 +26,8 @@ class RasterImage;
 class SourceBuffer;
 class SourceBufferIterator;
 
+enum class TaskPriority : uint8_t;
+
 class DecoderFactory {
  public:
   /// @return the type of decoder which is appropriate for @aMimeType.
@@ -52,6 +54,9 @@ class DecoderFactory {
    * @param aDecoderFlags Flags specifying the behavior of this decoder.
    * @param aSurfaceFlags Flags specifying the type of output this decoder
    *                      should produce.
+   * @param aPriority The priority at which the returned task should be
+   *                  scheduled, typically based on how close the image is to
+   *                  the viewport.
    * @param aOutTask Task representing the decoder.
    * @return NS_OK if the decoder has been created/initialized successfully;
    *         NS_ERROR_ALREADY_INITIALIZED if there is already an active decoder
@@ -64,6 +69,7 @@ class DecoderFactory {
                                 const gfx::IntSize& aOutputSize,
                                 DecoderFlags aDecoderFlags,
                                 SurfaceFlags aSurfaceFlags,
+                                TaskPriority aPriority,
                                 IDecodingTask** aOutTask);
 
   /**
@@ -24,7 +24,11 @@ class Decoder;
 class RasterImage;
 
 /// A priority hint that DecodePool can use when scheduling an IDecodingTask.
-enum class TaskPriority : uint8_t { eLow, eHigh };
+/// eLow is used for speculative decodes of off-screen images, eMedium for
+/// decodes of images in or near the viewport (so that during fast scrolls they
+/// are scheduled ahead of any queued off-screen decodes), and eHigh for tasks
+/// which block layout, page load or animation playback.
+enum class TaskPriority : uint8_t { eLow, eMedium, eHigh };
 
 /**
  * An interface for tasks which can execute on the ImageLib DecodePool.
@@ -80,6 +80,14 @@ class ISurfaceProvider : public WebRenderImageProvider {
     ref->AddSizeOfExcludingThis(aMallocSizeOf, aCallback);
   }
 
+  /// Attempt to replace the decoded pixels of this ISurfaceProvider's surface
+  /// with a losslessly compressed copy, releasing the decoded buffer until the
+  /// surface is next used. The default implementation is appropriate for
+  /// providers whose surfaces are generated dynamically or are otherwise not
+  /// worth compressing.
+  /// @return true if the surface data is now stored compressed.
+  virtual bool CompressSurfaceData() { return false; }
+
   virtual void Reset() {}
   virtual void Advance(size_t aFrame) {}
   virtual bool MayAdvance() const { return false; }
@@ -316,6 +324,10 @@ class SimpleSurfaceProvider final : public ISurfaceProvider {
 
   void InvalidateSurface() override;
 
+  bool CompressSurfaceData() override {
+    return !IsLocked() && mSurface->CompressSurfaceData();
+  }
+
  protected:
   DrawableFrameRef DrawableRef(size_t aFrame) override {
     MOZ_ASSERT(aFrame == 0,
@@ -1222,10 +1222,15 @@ void RasterImage::Decode(const OrientedIntSize& aSize, uint32_t aFlags,
         mDecoderType, WrapNotNull(this), mSourceBuffer, mSize.ToUnknownSize(),
         decoderFlags, surfaceFlags, currentFrame, getter_AddRefs(task));
   } else {
-    rv = DecoderFactory::CreateDecoder(mDecoderType, WrapNotNull(this),
-                                       mSourceBuffer, mSize.ToUnknownSize(),
-                                       aSize.ToUnknownSize(), decoderFlags,
-                                       surfaceFlags, getter_AddRefs(task));
+    // Schedule decodes for images in or near the viewport ahead of any queued
+    // speculative decodes for off-screen images.
+    TaskPriority priority = (aFlags & FLAG_PRIORITY_IN_VIEWPORT)
+                                ? TaskPriority::eMedium
+                                : TaskPriority::eLow;
+    rv = DecoderFactory::CreateDecoder(
+        mDecoderType, WrapNotNull(this), mSourceBuffer, mSize.ToUnknownSize(),
+        aSize.ToUnknownSize(), decoderFlags, surfaceFlags, priority,
+        getter_AddRefs(task));
   }
 
   if (rv == NS_ERROR_ALREADY_INITIALIZED) {
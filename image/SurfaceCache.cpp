@@ -25,6 +25,7 @@
 #include "mozilla/CheckedInt.h"
 #include "mozilla/DebugOnly.h"
 #include "mozilla/Likely.h"
+#include "mozilla/Preferences.h"
 #include "mozilla/RefPtr.h"
 #include "mozilla/StaticMutex.h"
 #include "mozilla/StaticPrefs_image.h"
@@ -125,7 +126,7 @@ class CachedSurface {
   NS_INLINE_DECL_THREADSAFE_REFCOUNTING(CachedSurface)
 
   explicit CachedSurface(NotNull<ISurfaceProvider*> aProvider)
-      : mProvider(aProvider), mIsLocked(false) {}
+      : mProvider(aProvider), mIsLocked(false), mCompressedSinceUse(false) {}
 
   DrawableSurface GetDrawableSurface() const {
     if (MOZ_UNLIKELY(IsPlaceholder())) {
@@ -183,6 +184,15 @@ class CachedSurface {
 
   void InvalidateSurface() { mProvider->InvalidateSurface(); }
 
+  bool CompressSurfaceData() { return mProvider->CompressSurfaceData(); }
+
+  // Whether this surface has been compressed (in lieu of eviction) since it
+  // was last used. Surfaces which expire with this flag already set get
+  // evicted for real.
+  void SetCompressedSinceLastUse() { mCompressedSinceUse = true; }
+  void ClearCompressedSinceLastUse() { mCompressedSinceUse = false; }
+  bool WasCompressedSinceLastUse() const { return mCompressedSinceUse; }
+
   // A helper type used by SurfaceCacheImpl::CollectSizeOfSurfaces.
   struct MOZ_STACK_CLASS SurfaceMemoryReport {
     SurfaceMemoryReport(nsTArray<SurfaceMemoryCounter>& aCounters,
@@ -226,6 +236,7 @@ class CachedSurface {
   nsExpirationState mExpirationState;
   NotNull<RefPtr<ISurfaceProvider>> mProvider;
   bool mIsLocked;
+  bool mCompressedSinceUse;
 };
 
 static int64_t AreaOfIntSize(const IntSize& aSize) {
@@ -769,10 +780,11 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
 
   SurfaceCacheImpl(uint32_t aSurfaceCacheExpirationTimeMS,
                    uint32_t aSurfaceCacheDiscardFactor,
-                   uint32_t aSurfaceCacheSize)
+                   uint32_t aSurfaceCacheSize, bool aCompressColdSurfaces)
       : mExpirationTracker(aSurfaceCacheExpirationTimeMS),
         mMemoryPressureObserver(new MemoryPressureObserver),
         mDiscardFactor(aSurfaceCacheDiscardFactor),
+        mCompressColdSurfaces(aCompressColdSurfaces),
         mMaxCost(aSurfaceCacheSize),
         mAvailableCost(aSurfaceCacheSize),
         mLockedCost(0),
@@ -1447,9 +1459,41 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
     return aCost <= mMaxCost - mLockedCost;
   }
 
+  /**
+   * Called when aSurface expires from the tracker. If cold-surface
+   * compression is enabled, the first expiration of a surface compresses its
+   * pixel data in place instead of evicting it, and gives the surface another
+   * full expiration period. Using the surface decompresses it and clears the
+   * flag, so only surfaces which go two full expiration periods without being
+   * touched actually get evicted.
+   */
+  bool MaybeCompressInsteadOfEvicting(NotNull<CachedSurface*> aSurface,
+                                      const StaticMutexAutoLock& aAutoLock) {
+    if (!mCompressColdSurfaces || aSurface->IsPlaceholder() ||
+        aSurface->IsLocked() || aSurface->WasCompressedSinceLastUse()) {
+      return false;
+    }
+
+    if (!aSurface->CompressSurfaceData()) {
+      return false;
+    }
+
+    aSurface->SetCompressedSinceLastUse();
+    nsresult rv = mExpirationTracker.MarkUsedLocked(aSurface, aAutoLock);
+    if (NS_WARN_IF(NS_FAILED(rv))) {
+      // We failed to reinsert the surface into the tracker, so evict it after
+      // updating our own accounting, as MarkUsed() does.
+      StopTracking(aSurface, /* aIsTracked */ false, aAutoLock);
+      Remove(aSurface, /* aStopTracking */ false, aAutoLock);
+    }
+    return true;
+  }
+
   bool MarkUsed(NotNull<CachedSurface*> aSurface,
                 NotNull<ImageSurfaceCache*> aCache,
                 const StaticMutexAutoLock& aAutoLock) {
+    aSurface->ClearCompressedSinceLastUse();
+
     if (aCache->IsLocked()) {
       LockSurface(aSurface, aAutoLock);
       return true;
@@ -1521,6 +1565,11 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
    protected:
     void NotifyExpiredLocked(CachedSurface* aSurface,
                              const StaticMutexAutoLock& aAutoLock) override {
+      if (sInstance->MaybeCompressInsteadOfEvicting(WrapNotNull(aSurface),
+                                                    aAutoLock)) {
+        return;
+      }
+
       sInstance->Remove(WrapNotNull(aSurface), /* aStopTracking */ true,
                         aAutoLock);
     }
@@ -1566,6 +1615,7 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
   RefPtr<MemoryPressureObserver> mMemoryPressureObserver;
   nsTArray<RefPtr<image::Image>> mReleasingImagesOnMainThread;
   const uint32_t mDiscardFactor;
+  const bool mCompressColdSurfaces;
   const Cost mMaxCost;
   Cost mAvailableCost;
   Cost mLockedCost;
@@ -1636,12 +1686,21 @@ void SurfaceCache::Initialize() {
   uint32_t finalSurfaceCacheSizeBytes =
       min(surfaceCacheSizeBytes, uint64_t(UINT32_MAX));
 
+  // Whether surfaces that survive unused past their expiration window should
+  // be losslessly compressed in place (and given one more window) rather than
+  // evicted immediately. This trades some CPU time on the surface's next use
+  // for a smaller heap footprint, so it's enabled by default only on machines
+  // with 4GB of memory or less.
+  bool compressColdSurfaces =
+      Preferences::GetBool("image.mem.surfacecache.compress_cold_surfaces",
+                           memorySize <= 4ULL * 1024 * 1024 * 1024);
+
   // Create the surface cache singleton with the requested settings.  Note that
   // the size is a limit that the cache may not grow beyond, but we do not
   // actually allocate any storage for surfaces at this time.
-  sInstance = new SurfaceCacheImpl(surfaceCacheExpirationTimeMS,
-                                   surfaceCacheDiscardFactor,
-                                   finalSurfaceCacheSizeBytes);
+  sInstance = new SurfaceCacheImpl(
+      surfaceCacheExpirationTimeMS, surfaceCacheDiscardFactor,
+      finalSurfaceCacheSizeBytes, compressColdSurfaces);
   sInstance->InitMemoryReporter();
 }
 
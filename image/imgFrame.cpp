@@ -18,11 +18,13 @@
 
 #include "MainThreadUtils.h"
 #include "mozilla/CheckedInt.h"
+#include "mozilla/Compression.h"
 #include "mozilla/gfx/Tools.h"
 #include "mozilla/Likely.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/ProfilerLabels.h"
 #include "mozilla/StaticPrefs_browser.h"
+#include "mozilla/UniquePtrExtensions.h"
 #include "nsMargin.h"
 #include "nsRefreshDriver.h"
 #include "nsThreadUtils.h"
@@ -124,7 +126,9 @@ static bool ClearSurface(SourceSurfaceSharedData* aSurface,
 
 imgFrame::imgFrame()
     : mMonitor("imgFrame"),
+      mCompressedLength(0),
       mDecoded(0, 0, 0, 0),
+      mRawAccessCount(0),
       mAborted(false),
       mFinished(false),
       mShouldRecycle(false),
@@ -617,6 +621,94 @@ void imgFrame::FinalizeSurfaceInternal() {
   sharedSurf->Finalize();
 }
 
+bool imgFrame::CompressSurfaceData() {
+  MonitorAutoLock lock(mMonitor);
+
+  if (mCompressedData || !mRawSurface || mBlankRawSurface || mOptSurface ||
+      !mFinished || mAborted || mShouldRecycle || mRawAccessCount > 0) {
+    return false;
+  }
+
+  // If anything outside this imgFrame is holding the surface alive -- a
+  // mapping owned by a DrawableFrameRef, or the compositor -- then releasing
+  // our reference wouldn't actually free the buffer, so don't bother.
+  if (mRawSurface->refCount() > 1) {
+    return false;
+  }
+
+  size_t length = size_t(mRawSurface->Stride()) * mImageSize.height;
+  if (length == 0) {
+    return false;
+  }
+
+  size_t maxCompressedSize = Compression::LZ4::maxCompressedSize(length);
+  auto buffer = MakeUniqueFallible<char[]>(maxCompressedSize);
+  if (!buffer) {
+    return false;
+  }
+
+  size_t compressedLength;
+  {
+    DataSourceSurface::ScopedMap map(mRawSurface, DataSourceSurface::READ);
+    if (!map.IsMapped()) {
+      return false;
+    }
+
+    compressedLength = Compression::LZ4::compress(
+        reinterpret_cast<const char*>(map.GetData()), length, buffer.get());
+  }
+
+  if (compressedLength == 0 || compressedLength >= length) {
+    // Incompressible data; evicting and redecoding is the better trade.
+    return false;
+  }
+
+  // Copy into a buffer of exactly the right size, since we may retain the
+  // compressed data for a long time.
+  mCompressedData = MakeUniqueFallible<char[]>(compressedLength);
+  if (!mCompressedData) {
+    return false;
+  }
+  memcpy(mCompressedData.get(), buffer.get(), compressedLength);
+  mCompressedLength = compressedLength;
+
+  mRawSurface = nullptr;
+  return true;
+}
+
+void imgFrame::EnsureSurfaceDecompressed() {
+  if (!mCompressedData) {
+    return;
+  }
+
+  MOZ_ASSERT(!mRawSurface);
+
+  RefPtr<SourceSurfaceSharedData> surf =
+      AllocateBufferForImage(mImageSize, mFormat);
+  if (!surf) {
+    // Leave the compressed data in place; callers will see a missing surface
+    // and treat it like any other invalid frame.
+    return;
+  }
+
+  size_t length = size_t(surf->Stride()) * mImageSize.height;
+  size_t outputSize = 0;
+  if (!Compression::LZ4::decompress(mCompressedData.get(), mCompressedLength,
+                                    reinterpret_cast<char*>(surf->GetData()),
+                                    length, &outputSize) ||
+      outputSize != length) {
+    MOZ_ASSERT_UNREACHABLE("Failed to decompress surface data");
+    mCompressedData = nullptr;
+    mCompressedLength = 0;
+    return;
+  }
+
+  mCompressedData = nullptr;
+  mCompressedLength = 0;
+  mRawSurface = std::move(surf);
+  FinalizeSurfaceInternal();
+}
+
 already_AddRefed<SourceSurface> imgFrame::GetSourceSurface() {
   MonitorAutoLock lock(mMonitor);
   return GetSourceSurfaceInternal();
@@ -625,6 +717,8 @@ already_AddRefed<SourceSurface> imgFrame::GetSourceSurface() {
 already_AddRefed<SourceSurface> imgFrame::GetSourceSurfaceInternal() {
   mMonitor.AssertCurrentThreadOwns();
 
+  EnsureSurfaceDecompressed();
+
   if (mOptSurface) {
     if (mOptSurface->IsValid()) {
       RefPtr<SourceSurface> surf(mOptSurface);
@@ -704,6 +798,9 @@ void imgFrame::AddSizeOfExcludingThis(MallocSizeOf aMallocSizeOf,
     mRawSurface->SizeOfExcludingThis(aMallocSizeOf, info);
     metadata.Accumulate(info);
   }
+  if (mCompressedData) {
+    metadata.mHeapBytes += aMallocSizeOf(mCompressedData.get());
+  }
 
   aCallback(metadata);
 }
@@ -17,6 +17,7 @@
 #include "mozilla/Maybe.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/Monitor.h"
+#include "mozilla/UniquePtr.h"
 #include "nsRect.h"
 
 namespace mozilla {
@@ -170,6 +171,18 @@ class imgFrame {
   void FinalizeSurface();
   already_AddRefed<SourceSurface> GetSourceSurface();
 
+  /**
+   * Attempt to replace the raw surface's pixels with a losslessly compressed
+   * copy and release the underlying shared buffer. The compressed copy is
+   * transparently decompressed into a fresh buffer the next time the surface
+   * is needed. This only succeeds for finished, non-recyclable frames whose
+   * surface nothing else is holding alive, so callers (i.e. the SurfaceCache)
+   * may safely invoke it on any frame they believe to be idle.
+   *
+   * @return true if the pixel data is now stored compressed.
+   */
+  bool CompressSurfaceData();
+
   struct AddSizeOfCbData : public SourceSurface::SizeOfInfo {
     AddSizeOfCbData() : mIndex(0), mFinished(false) {}
 
@@ -191,6 +204,7 @@ class imgFrame {
   uint32_t GetImageDataLength() const;
   void FinalizeSurfaceInternal();
   already_AddRefed<SourceSurface> GetSourceSurfaceInternal();
+  void EnsureSurfaceDecompressed() MOZ_REQUIRES(mMonitor);
 
   struct SurfaceWithFormat {
     RefPtr<gfxDrawable> mDrawable;
@@ -237,8 +251,21 @@ class imgFrame {
    */
   RefPtr<SourceSurface> mOptSurface MOZ_GUARDED_BY(mMonitor);
 
+  /**
+   * When the SurfaceCache decides this frame has gone unused for long enough,
+   * CompressSurfaceData() moves the contents of mRawSurface into this
+   * losslessly compressed copy and drops the surface;
+   * EnsureSurfaceDecompressed() performs the reverse on the next use.
+   */
+  UniquePtr<char[]> mCompressedData MOZ_GUARDED_BY(mMonitor);
+  size_t mCompressedLength MOZ_GUARDED_BY(mMonitor);
+
   nsIntRect mDecoded MOZ_GUARDED_BY(mMonitor);
 
+  //! The number of live RawAccessFrameRefs pointing at this frame. While
+  //! nonzero, mRawSurface must not be released or replaced.
+  int32_t mRawAccessCount MOZ_GUARDED_BY(mMonitor);
+
   bool mAborted MOZ_GUARDED_BY(mMonitor);
   bool mFinished MOZ_GUARDED_BY(mMonitor);
   bool mShouldRecycle MOZ_GUARDED_BY(mMonitor);
@@ -287,6 +314,8 @@ class DrawableFrameRef final {
     MOZ_ASSERT(aFrame);
     MonitorAutoLock lock(aFrame->mMonitor);
 
+    aFrame->EnsureSurfaceDecompressed();
+
     if (aFrame->mRawSurface) {
       mRef.emplace(aFrame->mRawSurface, DataSourceSurface::READ);
       if (!mRef->IsMapped()) {
@@ -368,10 +397,12 @@ class RawAccessFrameRef final {
     // recycling in imgFrame::InitForDecoderRecycle.
     {
       MonitorAutoLock lock(mFrame->mMonitor);
+      mFrame->EnsureSurfaceDecompressed();
       gfx::DataSourceSurface::MappedSurface map;
       if (mFrame->mRawSurface && mFrame->mRawSurface->Map(aMapType, &map)) {
         MOZ_ASSERT(map.mData);
         mData = map.mData;
+        ++mFrame->mRawAccessCount;
       }
     }
 
@@ -393,6 +424,7 @@ class RawAccessFrameRef final {
     if (mFrame) {
       MonitorAutoLock lock(mFrame->mMonitor);
       mFrame->mRawSurface->Unmap();
+      --mFrame->mRawAccessCount;
     }
     mFrame = std::move(aOther.mFrame);
     mData = aOther.mData;
@@ -420,6 +452,7 @@ class RawAccessFrameRef final {
     if (mFrame) {
       MonitorAutoLock lock(mFrame->mMonitor);
       mFrame->mRawSurface->Unmap();
+      --mFrame->mRawAccessCount;
     }
     mFrame = nullptr;
     mData = nullptr;
@@ -21,6 +21,7 @@
 #include "mozilla/intl/ICU4XGeckoDataProvider.h"
 #include "mozilla/intl/Segmenter.h"
 #include "mozilla/intl/UnicodeProperties.h"
+#include "mozilla/StaticMutex.h"
 #include "mozilla/StaticPrefs_intl.h"
 
 #include <mutex>
@@ -1070,14 +1071,32 @@ static bool UseDefaultLineSegmenter(WordBreakRule aWordBreak,
          !aIsChineseOrJapanese;
 }
 
-static capi::ICU4XLineSegmenter* GetLineSegmenter(bool aUseDefault,
-                                                  WordBreakRule aWordBreak,
-                                                  LineBreakRule aLevel,
-                                                  bool aIsChineseOrJapanese) {
-  if (aUseDefault) {
-    MOZ_ASSERT(
-        UseDefaultLineSegmenter(aWordBreak, aLevel, aIsChineseOrJapanese));
-    return GetDefaultLineSegmenter();
+// Segmenters with non-default options are cached per option combination, so
+// that reflowing many text runs which share the same non-default rules (e.g.
+// word-break: keep-all, or Chinese/Japanese text) doesn't re-create an LSTM
+// segmenter for every run.  The option space is small enough that every
+// combination simply gets its own slot; the slots live until shutdown, like
+// the default segmenter.
+static constexpr size_t kWordBreakRuleCount = 3;  // Normal, BreakAll, KeepAll
+static constexpr size_t kLineBreakRuleCount =
+    5;  // Auto, Loose, Normal, Strict, Anywhere
+
+static StaticMutex sCustomLineSegmentersMutex;
+static capi::ICU4XLineSegmenter*
+    sCustomLineSegmenters[kWordBreakRuleCount * kLineBreakRuleCount * 2]
+        MOZ_GUARDED_BY(sCustomLineSegmentersMutex) = {};
+
+static capi::ICU4XLineSegmenter* GetCustomLineSegmenter(
+    WordBreakRule aWordBreak, LineBreakRule aLevel, bool aIsChineseOrJapanese) {
+  const size_t index = (static_cast<size_t>(aWordBreak) * kLineBreakRuleCount +
+                        static_cast<size_t>(aLevel)) *
+                           2 +
+                       (aIsChineseOrJapanese ? 1 : 0);
+  MOZ_ASSERT(index < ArrayLength(sCustomLineSegmenters));
+
+  StaticMutexAutoLock lock(sCustomLineSegmentersMutex);
+  if (capi::ICU4XLineSegmenter* segmenter = sCustomLineSegmenters[index]) {
+    return segmenter;
   }
 
   capi::ICU4XLineBreakOptionsV1 options;
@@ -1088,9 +1107,44 @@ static capi::ICU4XLineSegmenter* GetLineSegmenter(bool aUseDefault,
   auto result = capi::ICU4XLineSegmenter_create_lstm_with_options_v1(
       GetDataProvider(), options);
   MOZ_ASSERT(result.is_ok);
+  sCustomLineSegmenters[index] = result.ok;
+
+  static std::once_flag sRegisterCleanup;
+  std::call_once(sRegisterCleanup, [] {
+    auto cleanup = [] {
+      mozilla::RunOnShutdown([] {
+        StaticMutexAutoLock lock(sCustomLineSegmentersMutex);
+        for (capi::ICU4XLineSegmenter*& segmenter : sCustomLineSegmenters) {
+          if (segmenter) {
+            capi::ICU4XLineSegmenter_destroy(segmenter);
+            segmenter = nullptr;
+          }
+        }
+      });
+    };
+    if (NS_IsMainThread()) {
+      cleanup();
+    } else {
+      NS_DispatchToMainThread(
+          NS_NewRunnableFunction("GetCustomLineSegmenter", cleanup));
+    }
+  });
+
   return result.ok;
 }
 
+static capi::ICU4XLineSegmenter* GetLineSegmenter(bool aUseDefault,
+                                                  WordBreakRule aWordBreak,
+                                                  LineBreakRule aLevel,
+                                                  bool aIsChineseOrJapanese) {
+  if (aUseDefault) {
+    MOZ_ASSERT(
+        UseDefaultLineSegmenter(aWordBreak, aLevel, aIsChineseOrJapanese));
+    return GetDefaultLineSegmenter();
+  }
+  return GetCustomLineSegmenter(aWordBreak, aLevel, aIsChineseOrJapanese);
+}
+
 void LineBreaker::ComputeBreakPositions(
     const char16_t* aChars, uint32_t aLength, WordBreakRule aWordBreak,
     LineBreakRule aLevel, bool aIsChineseOrJapanese, uint8_t* aBreakBefore) {
@@ -1148,10 +1202,6 @@ void LineBreaker::ComputeBreakPositions(
         }
         aBreakBefore[nextPos] = 1;
       }
-
-      if (!useDefault) {
-        capi::ICU4XLineSegmenter_destroy(lineSegmenter);
-      }
     }
 
     if (useCache) {
@@ -1334,10 +1384,6 @@ void LineBreaker::ComputeBreakPositions(const uint8_t* aChars, uint32_t aLength,
       }
       aBreakBefore[nextPos] = 1;
     }
-
-    if (!useDefault) {
-      capi::ICU4XLineSegmenter_destroy(lineSegmenter);
-    }
     return;
   }
 
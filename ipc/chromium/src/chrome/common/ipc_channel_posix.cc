@@ -45,6 +45,7 @@
 #include "mozilla/StaticMutex.h"
 #include "mozilla/UniquePtr.h"
 #include "mozilla/Unused.h"
+#include "nsTArray.h"
 
 // Use OS specific iovec array limit where it's possible.
 #if defined(IOV_MAX)
@@ -620,6 +621,60 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
     MOZ_ASSERT(amt_to_write > 0);
 
     const bool intentional_short_write = !iter.Done();
+    const size_t front_amt = amt_to_write;
+
+    // If the entire front message fit into the iovec, opportunistically pack
+    // whole messages without attachments from the rest of the queue into the
+    // same sendmsg() call.  Channels carrying lots of small async messages
+    // otherwise pay one syscall per message.  (Not done on Darwin, where mach
+    // ports may need to be transferred per message before its bytes hit the
+    // wire.)
+    struct BatchedMessage {
+      Message* msg;
+      size_t amt;
+      bool fully_included;
+    };
+    AutoTArray<BatchedMessage, 8> batched;
+#if !defined(XP_DARWIN)
+    if (!intentional_short_write) {
+      auto it = output_queue_.begin();
+      ++it;  // Skip the front message; it is already in the iovec.
+      for (; it != output_queue_.end() && iov_count < kMaxIOVecSize &&
+             PipeBufHasSpaceAfter(amt_to_write);
+           ++it) {
+        Message* next = it->get();
+        if (!next->attached_handles_.IsEmpty()) {
+          // Never reorder messages; stop at the first message which needs a
+          // control message of its own.
+          break;
+        }
+        next->header()->num_handles = 0;
+
+        Pickle::BufferList::IterImpl next_iter(next->Buffers());
+        size_t next_amt = 0;
+        while (!next_iter.Done() && iov_count < kMaxIOVecSize &&
+               PipeBufHasSpaceAfter(amt_to_write)) {
+          size_t size = next_iter.RemainingInSegment();
+          iov[iov_count].iov_base = next_iter.Data();
+          iov[iov_count].iov_len = size;
+          iov_count++;
+          amt_to_write += size;
+          next_amt += size;
+          next_iter.Advance(next->Buffers(), size);
+        }
+        if (next_amt == 0) {
+          break;
+        }
+        batched.AppendElement(BatchedMessage{next, next_amt, next_iter.Done()});
+        if (!next_iter.Done()) {
+          // Ran out of budget partway through this message; it must be the
+          // last one in the batch.
+          break;
+        }
+      }
+    }
+#endif
+
     msgh.msg_iov = iov;
     msgh.msg_iovlen = iov_count;
 
@@ -667,37 +722,19 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
       }
     }
 
-    if (intentional_short_write ||
-        static_cast<size_t>(bytes_written) != amt_to_write) {
-      // If write() fails with EAGAIN or EMSGSIZE then bytes_written will be -1.
-      if (bytes_written > 0) {
-        MOZ_DIAGNOSTIC_ASSERT(intentional_short_write ||
-                              static_cast<size_t>(bytes_written) <
-                                  amt_to_write);
-        partial_write_->iter_.AdvanceAcrossSegments(msg->Buffers(),
-                                                    bytes_written);
+    // If write() fails with EAGAIN or EMSGSIZE then bytes_written will be -1.
+    size_t credited = bytes_written > 0 ? static_cast<size_t>(bytes_written) : 0;
+    bool blocked = false;
+
+    if (intentional_short_write || credited < front_amt) {
+      if (credited > 0) {
+        MOZ_DIAGNOSTIC_ASSERT(intentional_short_write || credited < front_amt);
+        partial_write_->iter_.AdvanceAcrossSegments(msg->Buffers(), credited);
         partial_write_->handles_ = handles.From(num_fds);
         // We should not hit the end of the buffer.
         MOZ_DIAGNOSTIC_ASSERT(!partial_write_->iter_.Done());
       }
-
-      is_blocked_on_write_ = true;
-      if (IOThread().IsOnCurrentThread()) {
-        // If we're on the I/O thread already, tell libevent to call us back
-        // when things are unblocked.
-        MessageLoopForIO::current()->WatchFileDescriptor(
-            pipe_,
-            false,  // One shot
-            MessageLoopForIO::WATCH_WRITE, &write_watcher_, this);
-      } else {
-        // Otherwise, emulate being called back from libevent on the I/O thread,
-        // which will re-try the write, and then potentially start watching if
-        // still necessary.
-        IOThread().Dispatch(mozilla::NewRunnableMethod<int>(
-            "ChannelImpl::ContinueProcessOutgoing", this,
-            &ChannelImpl::OnFileCanWriteWithoutBlocking, -1));
-      }
-      return true;
+      blocked = true;
     } else {
       MOZ_ASSERT(partial_write_->handles_.Length() == num_fds,
                  "not all handles were sent");
@@ -709,9 +746,7 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
             msg->fd_cookie(), std::move(msg->attached_handles_)});
       }
 #else
-      if (bytes_written > 0) {
-        msg->attached_handles_.Clear();
-      }
+      msg->attached_handles_.Clear();
 #endif
 
       // Message sent OK!
@@ -726,6 +761,58 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
       OutputQueuePop();
       // msg has been destroyed, so clear the dangling reference.
       msg = nullptr;
+      credited -= front_amt;
+
+      // Credit the batched messages, in queue order, with whatever the
+      // kernel accepted beyond the front message.
+      for (auto& b : batched) {
+        if (b.fully_included && credited >= b.amt) {
+          AddIPCProfilerMarker(*b.msg, other_pid_, MessageDirection::eSending,
+                               MessagePhase::TransferStart);
+          AddIPCProfilerMarker(*b.msg, other_pid_, MessageDirection::eSending,
+                               MessagePhase::TransferEnd);
+          credited -= b.amt;
+          OutputQueuePop();
+          continue;
+        }
+
+        // This message didn't make it out in full, and is now the front of
+        // the queue.  Record how far into it we got so that the next write
+        // resumes where this one stopped.
+        if (credited > 0) {
+          AddIPCProfilerMarker(*b.msg, other_pid_, MessageDirection::eSending,
+                               MessagePhase::TransferStart);
+          Pickle::BufferList::IterImpl resume(b.msg->Buffers());
+          partial_write_.emplace(
+              PartialWrite{resume, b.msg->attached_handles_});
+          partial_write_->iter_.AdvanceAcrossSegments(b.msg->Buffers(),
+                                                      credited);
+          MOZ_DIAGNOSTIC_ASSERT(!partial_write_->iter_.Done());
+          credited = 0;
+        }
+        blocked = true;
+        break;
+      }
+    }
+
+    if (blocked) {
+      is_blocked_on_write_ = true;
+      if (IOThread().IsOnCurrentThread()) {
+        // If we're on the I/O thread already, tell libevent to call us back
+        // when things are unblocked.
+        MessageLoopForIO::current()->WatchFileDescriptor(
+            pipe_,
+            false,  // One shot
+            MessageLoopForIO::WATCH_WRITE, &write_watcher_, this);
+      } else {
+        // Otherwise, emulate being called back from libevent on the I/O thread,
+        // which will re-try the write, and then potentially start watching if
+        // still necessary.
+        IOThread().Dispatch(mozilla::NewRunnableMethod<int>(
+            "ChannelImpl::ContinueProcessOutgoing", this,
+            &ChannelImpl::OnFileCanWriteWithoutBlocking, -1));
+      }
+      return true;
     }
   }
   return true;
@@ -34,6 +34,7 @@
 #include "mozilla/Unused.h"
 #include "mozilla/Vector.h"
 #include "mozilla/dom/ipc/StructuredCloneData.h"
+#include "mozilla/ipc/BigBuffer.h"
 #include "mozilla/dom/UserActivation.h"
 #include "gfxPlatform.h"
 #include "nsCSSPropertyID.h"
@@ -193,6 +194,54 @@ struct ParamTraits<nsTArray<E>> {
   }
 };
 
+// Large byte arrays are promoted to an out-of-line shared memory transfer
+// via BigBuffer rather than being copied through the message pickle.  This
+// keeps multi-megabyte payloads (image data, serialized blobs) from hitting
+// message size limits and from being streamed byte-by-byte through the
+// transport.
+template <>
+struct ParamTraits<nsTArray<uint8_t>> {
+  typedef nsTArray<uint8_t> paramType;
+
+  static void Write(MessageWriter* aWriter, const paramType& aParam) {
+    bool outOfLine =
+        aParam.Length() >= mozilla::ipc::BigBuffer::kShmemThreshold;
+    WriteParam(aWriter, outOfLine);
+    if (outOfLine) {
+      WriteParam(aWriter, mozilla::ipc::BigBuffer(mozilla::Span(
+                              aParam.Elements(), aParam.Length())));
+      return;
+    }
+    WriteSequenceParam<const uint8_t&>(aWriter, aParam.Elements(),
+                                       aParam.Length());
+  }
+
+  static void Write(MessageWriter* aWriter, paramType&& aParam) {
+    Write(aWriter, static_cast<const paramType&>(aParam));
+  }
+
+  static bool Read(MessageReader* aReader, paramType* aResult) {
+    bool outOfLine;
+    if (!ReadParam(aReader, &outOfLine)) {
+      return false;
+    }
+
+    if (outOfLine) {
+      mozilla::ipc::BigBuffer buf;
+      if (!ReadParam(aReader, &buf)) {
+        return false;
+      }
+      aResult->Clear();
+      aResult->AppendElements(buf.Data(), buf.Size());
+      return true;
+    }
+
+    return ReadSequenceParam<uint8_t>(aReader, [&](uint32_t aLength) {
+      return aResult->AppendElements(aLength);
+    });
+  }
+};
+
 template <typename E>
 struct ParamTraits<CopyableTArray<E>> : ParamTraits<nsTArray<E>> {};
 
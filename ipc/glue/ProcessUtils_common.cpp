@@ -34,9 +34,22 @@ SharedPreferenceSerializer::SharedPreferenceSerializer(
   MOZ_COUNT_CTOR(SharedPreferenceSerializer);
 }
 
+// The serialized changed-prefs blob only depends on the pref database and on
+// whether the destination is a web content process (which controls
+// sanitization), so it can be shared between process launches until a pref
+// changes. Cache the read-only handle for both destination flavors, tagged
+// with the pref change generation that produced it.
+struct CachedPrefsBlob {
+  uint32_t mGeneration = 0;
+  ReadOnlySharedMemoryHandle mHandle;
+};
+static CachedPrefsBlob sCachedPrefsBlob[2];
+
 bool SharedPreferenceSerializer::SerializeToSharedMemory(
     const GeckoProcessType aDestinationProcessType,
     const nsACString& aDestinationRemoteType) {
+  MOZ_ASSERT(NS_IsMainThread());
+
   mPrefMapHandle = Preferences::EnsureSnapshot();
 
   bool destIsWebContent =
@@ -44,6 +57,15 @@ bool SharedPreferenceSerializer::SerializeToSharedMemory(
       (StringBeginsWith(aDestinationRemoteType, WEB_REMOTE_TYPE) ||
        StringBeginsWith(aDestinationRemoteType, PREALLOC_REMOTE_TYPE));
 
+  CachedPrefsBlob& cached = sCachedPrefsBlob[destIsWebContent ? 1 : 0];
+  uint32_t generation = Preferences::ChangeGeneration();
+  if (cached.mHandle && cached.mGeneration == generation) {
+    mPrefsHandle = cached.mHandle.Clone();
+    if (mPrefsHandle) {
+      return true;
+    }
+  }
+
   // Serialize the early prefs.
   nsAutoCStringN<1024> prefs;
   Preferences::SerializePreferences(prefs, destIsWebContent);
@@ -65,6 +87,8 @@ bool SharedPreferenceSerializer::SerializeToSharedMemory(
   memcpy(mapping.DataAs<char>(), prefs.get(), prefsLength);
 
   mPrefsHandle = std::move(handle).ToReadOnly();
+  cached.mGeneration = generation;
+  cached.mHandle = mPrefsHandle.Clone();
   return true;
 }
 
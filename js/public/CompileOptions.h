@@ -332,6 +332,13 @@ class JS_PUBLIC_API TransitiveCompileOptions {
   // called. There is currently no mechanism to release the data sooner.
   bool usePinnedBytecode = false;
 
+  // When decoding from XDR, skip validating the content checksum stored in
+  // the buffer. The encoder always emits the checksum; validation reads every
+  // byte of the buffer up front, which defeats lazy page-in when the buffer
+  // is a (read-only) file mapping shared between processes. Only set this if
+  // the cache holding the buffer provides its own integrity guarantees.
+  bool skipTranscodeChecksum = false;
+
   PrefableCompileOptions prefableOptions_;
 
   /**
@@ -444,6 +451,7 @@ class JS_PUBLIC_API TransitiveCompileOptions {
     PrintFields_(topLevelAwait);
     PrintFields_(borrowBuffer);
     PrintFields_(usePinnedBytecode);
+    PrintFields_(skipTranscodeChecksum);
     PrintFields_(introductionType);
     PrintFields_(introductionLineno);
     PrintFields_(introductionOffset);
@@ -822,6 +830,7 @@ class JS_PUBLIC_API ReadOnlyDecodeOptions {
  public:
   bool borrowBuffer = false;
   bool usePinnedBytecode = false;
+  bool skipTranscodeChecksum = false;
 
  protected:
   JS::ConstUTF8CharsZ introducerFilename_;
@@ -843,6 +852,7 @@ class JS_PUBLIC_API ReadOnlyDecodeOptions {
   void copyPODOptionsFrom(const T& options) {
     borrowBuffer = options.borrowBuffer;
     usePinnedBytecode = options.usePinnedBytecode;
+    skipTranscodeChecksum = options.skipTranscodeChecksum;
     introductionType = options.introductionType;
     introductionLineno = options.introductionLineno;
     introductionOffset = options.introductionOffset;
@@ -852,6 +862,7 @@ class JS_PUBLIC_API ReadOnlyDecodeOptions {
   void copyPODOptionsTo(T& options) const {
     options.borrowBuffer = borrowBuffer;
     options.usePinnedBytecode = usePinnedBytecode;
+    options.skipTranscodeChecksum = skipTranscodeChecksum;
     options.introductionType = introductionType;
     options.introductionLineno = introductionLineno;
     options.introductionOffset = introductionOffset;
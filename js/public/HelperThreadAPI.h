@@ -36,6 +36,38 @@ extern JS_PUBLIC_API void RunHelperThreadTask(HelperThreadTask* task);
 extern JS_PUBLIC_API const char* GetHelperThreadTaskName(
     HelperThreadTask* task);
 
+/**
+ * Classes of helper thread work whose concurrency can be limited by the
+ * embedder.
+ */
+enum class HelperThreadTaskClass {
+  WasmCompilation,
+  IonCompilation,
+  BaselineCompilation,
+  Delazification,
+  PromiseTasks,
+  GCParallelWork,
+
+  Count
+};
+
+/**
+ * Limit the number of helper threads that may run tasks of the given class
+ * concurrently.
+ *
+ * By default each class may use up to a fixed fraction of the thread pool
+ * computed from the core count, which can allow a burst of work in one class
+ * (such as wasm tier-2 compilation) to occupy every thread and delay others.
+ * This sets a tighter cap for one class; it never raises a class above its
+ * default. Passing zero removes a previously set cap.
+ *
+ * May be called at any time, including while tasks are running; the new limit
+ * applies when the next task of that class is scheduled. Tasks that are
+ * already running are not interrupted.
+ */
+extern JS_PUBLIC_API void SetHelperThreadTaskLimit(
+    HelperThreadTaskClass taskClass, size_t limit);
+
 }  // namespace JS
 
 #endif  // js_HelperThreadAPI_h
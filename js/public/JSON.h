@@ -77,6 +77,26 @@ extern JS_PUBLIC_API bool ToJSON(JSContext* cx, Handle<Value> value,
                                  Handle<Value> space,
                                  JSONWriteCallback callback, void* data);
 
+/**
+ * Performs the JSON.stringify operation, as specified by ECMAScript, calling
+ * |callback| repeatedly with successive chunks of the output, passing |data|
+ * as argument.
+ *
+ * Unlike JS::ToJSON this never accumulates the complete result in memory, so
+ * it is suitable for serializations too large for a contiguous string
+ * allocation. Chunk boundaries are arbitrary and the chunk buffer is only
+ * valid for the duration of each call. If the callback returns false the
+ * stringification is aborted and this function returns false without an
+ * exception pending.
+ *
+ * In cases where JSON.stringify would return undefined, this function does
+ * not call |callback| at all.
+ */
+extern JS_PUBLIC_API bool ToJSONChunked(JSContext* cx, Handle<Value> value,
+                                        Handle<JSObject*> replacer,
+                                        Handle<Value> space,
+                                        JSONWriteCallback callback, void* data);
+
 } /* namespace JS */
 
 /**
@@ -617,6 +617,16 @@ JS_PUBLIC_API JSObject* NewProxyObject(
     JSContext* cx, const BaseProxyHandler* handler, JS::HandleValue priv,
     JSObject* proto, const ProxyOptions& options = ProxyOptions());
 
+/**
+ * Like NewProxyObject, but allocates the proxy using the current realm's local
+ * allocation site, if any, so that JIT callers get nursery pretenuring
+ * feedback for the proxies they allocate. The proxy reflector counterpart of
+ * JS_NewObjectWithGivenProtoAndUseAllocSite.
+ */
+JS_PUBLIC_API JSObject* NewProxyObjectWithUseAllocSite(
+    JSContext* cx, const BaseProxyHandler* handler, JS::HandleValue priv,
+    JSObject* proto, const ProxyOptions& options = ProxyOptions());
+
 JSObject* RenewProxyObject(JSContext* cx, JSObject* obj,
                            BaseProxyHandler* handler, const JS::Value& priv);
 
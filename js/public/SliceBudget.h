@@ -63,7 +63,8 @@ class JS_PUBLIC_API SliceBudget {
   int64_t counter = StepsPerExpensiveCheck;
 
   // External flag to request the current slice to be interrupted
-  // (and return isOverBudget() early.) Applies only to time-based budgets.
+  // (and return isOverBudget() early.) Applies only to time-based and
+  // unlimited budgets.
   InterruptRequestFlag* interruptRequested = nullptr;
 
   // Configuration
@@ -94,6 +95,14 @@ class JS_PUBLIC_API SliceBudget {
   // Use to create an unlimited budget.
   static SliceBudget unlimited() { return SliceBudget(nullptr); }
 
+  // Use to create an unlimited budget that can still be cut short by setting
+  // the given flag, e.g. for work happening on a background thread that the
+  // main thread may need to take over.
+  static SliceBudget unlimitedWithInterrupt(InterruptRequestFlag* aIrqPtr) {
+    MOZ_ASSERT(aIrqPtr);
+    return SliceBudget(aIrqPtr);
+  }
+
   // Instantiate as SliceBudget(TimeBudget(n)).
   explicit SliceBudget(TimeBudget time,
                        InterruptRequestFlag* interrupt = nullptr);
@@ -563,6 +563,18 @@ class MOZ_NON_MEMMOVABLE JS_PUBLIC_API JSStructuredCloneData {
     return bufList_.WriteBytes(data, size);
   }
 
+  // Append a heap-allocated buffer as a dedicated segment, transferring
+  // ownership of it to the buffer rather than copying. The data must have
+  // been allocated with the js_malloc family of functions, and on failure it
+  // is freed. Both 'size' and 'capacity' must be multiples of 8 so that the
+  // data can be iterated as 64-bit words.
+  [[nodiscard]] bool AppendBytesZeroCopy(char* data, size_t size,
+                                         size_t capacity) {
+    MOZ_ASSERT(scope() != JS::StructuredCloneScope::Unassigned);
+    MOZ_ASSERT(size % 8 == 0);
+    return bufList_.WriteBytesZeroCopy(data, size, capacity);
+  }
+
   // Update data stored within the existing buffer. There must be at least
   // 'size' bytes between the position of 'iter' and the end of the buffer.
   [[nodiscard]] bool UpdateBytes(Iterator& iter, const char* data,
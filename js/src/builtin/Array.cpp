@@ -8,6 +8,7 @@
 
 #include "mozilla/CheckedInt.h"
 #include "mozilla/DebugOnly.h"
+#include "mozilla/FloatingPoint.h"
 #include "mozilla/MathAlgorithms.h"
 #include "mozilla/Maybe.h"
 #include "mozilla/ScopeExit.h"
@@ -4455,6 +4456,34 @@ static bool SearchElementDense(JSContext* cx, HandleValue val, Iter iterator,
   return iterator(cx, cmp, rval);
 }
 
+/**
+ * Collect the raw Value bit patterns which compare strictly equal to the
+ * (non-NaN) number |d|, so that dense elements can be searched with
+ * SIMD::memchr64. A number stored in dense elements is either an Int32Value
+ * or a DoubleValue — possibly a DoubleValue holding an int32-representable
+ * number — and the two zeroes compare equal, so there are at most three
+ * patterns. Non-double Values are NaN-boxed and |d| is not NaN, so the
+ * DoubleValue patterns cannot alias a Value of a different type.
+ */
+static size_t NumberSearchBitPatterns(double d, uint64_t (&bits)[3]) {
+  MOZ_ASSERT(!std::isnan(d));
+
+  if (d == 0) {
+    bits[0] = Int32Value(0).asRawBits();
+    bits[1] = DoubleValue(0.0).asRawBits();
+    bits[2] = DoubleValue(-0.0).asRawBits();
+    return 3;
+  }
+
+  size_t n = 0;
+  int32_t i;
+  if (mozilla::NumberIsInt32(d, &i)) {
+    bits[n++] = Int32Value(i).asRawBits();
+  }
+  bits[n++] = DoubleValue(d).asRawBits();
+  return n;
+}
+
 // ES2026 draft rev a562082b031d89d00ee667181ce8a6158656bd4b
 // 23.1.3.17 Array.prototype.indexOf ( searchElement [ , fromIndex ] )
 bool js::array_indexOf(JSContext* cx, unsigned argc, Value* vp) {
@@ -4520,6 +4549,41 @@ bool js::array_indexOf(JSContext* cx, unsigned argc, Value* vp) {
       return true;
     }
 
+    // Numbers can also be searched with bitwise comparisons, but against up to
+    // three bit patterns, because int32 values have both an Int32Value and a
+    // DoubleValue representation and the two zeroes compare equal.
+    if (searchElement.isNumber() && length > start) {
+      double d = searchElement.toNumber();
+      if (std::isnan(d)) {
+        // Strict equality on NaN is always false.
+        args.rval().setInt32(-1);
+        return true;
+      }
+
+      uint64_t bits[3];
+      size_t numPatterns = NumberSearchBitPatterns(d, bits);
+
+      const uint64_t* begin = reinterpret_cast<const uint64_t*>(elements) +
+                              start;
+      size_t searchLength = length - start;
+      const uint64_t* best = nullptr;
+      for (size_t i = 0; i < numPatterns; i++) {
+        if (const uint64_t* res = SIMD::memchr64(begin, bits[i],
+                                                 searchLength)) {
+          best = res;
+          // Other patterns can only win with a strictly earlier match.
+          searchLength = res - begin;
+        }
+      }
+      if (best) {
+        args.rval().setInt32(static_cast<int32_t>(
+            best - reinterpret_cast<const uint64_t*>(elements)));
+      } else {
+        args.rval().setInt32(-1);
+      }
+      return true;
+    }
+
     auto iterator = [elements, start, length](JSContext* cx, auto cmp,
                                               MutableHandleValue rval) {
       static_assert(NativeObject::MAX_DENSE_ELEMENTS_COUNT <= INT32_MAX,
@@ -4757,6 +4821,26 @@ bool js::array_includes(JSContext* cx, unsigned argc, Value* vp) {
       return true;
     }
 
+    // Numbers other than NaN can be searched with bitwise comparisons against
+    // up to three bit patterns, see NumberSearchBitPatterns. NaN uses the
+    // scalar path because it matches any NaN bit pattern. Holes never match a
+    // number, so they need no special handling here.
+    if (searchElement.isNumber() && !std::isnan(searchElement.toNumber()) &&
+        length > start) {
+      uint64_t bits[3];
+      size_t numPatterns =
+          NumberSearchBitPatterns(searchElement.toNumber(), bits);
+
+      const uint64_t* begin = reinterpret_cast<const uint64_t*>(elements) +
+                              start;
+      bool found = false;
+      for (size_t i = 0; i < numPatterns && !found; i++) {
+        found = !!SIMD::memchr64(begin, bits[i], length - start);
+      }
+      args.rval().setBoolean(found);
+      return true;
+    }
+
     auto iterator = [elements, start, length](JSContext* cx, auto cmp,
                                               MutableHandleValue rval) {
       for (uint32_t i = start; i < length; i++) {
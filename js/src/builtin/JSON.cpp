@@ -7,12 +7,15 @@
 #include "builtin/JSON.h"
 
 #include "mozilla/CheckedInt.h"
+#include "mozilla/EndianUtils.h"
 #include "mozilla/FloatingPoint.h"
+#include "mozilla/MathAlgorithms.h"
 #include "mozilla/Range.h"
 #include "mozilla/ScopeExit.h"
 #include "mozilla/Variant.h"
 
 #include <algorithm>
+#include <string.h>
 
 #include "jsnum.h"
 #include "jstypes.h"
@@ -58,6 +61,83 @@ using mozilla::Variant;
 
 using JS::AutoStableStringChars;
 
+// Maps characters < 256 to the value that must follow the '\\' in the quoted
+// string. Entries with 'u' are handled as \\u00xy, and entries with 0 are not
+// escaped in any way. Characters >= 256 are all assumed to be unescaped.
+static const Latin1Char escapeLookup[256] = {
+    // clang-format off
+      'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't',
+      'n', 'u', 'f', 'r', 'u', 'u', 'u', 'u', 'u', 'u',
+      'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+      'u', 'u', 0,   0,  '\"', 0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,  '\\', // rest are all zeros
+    // clang-format on
+};
+
+/*
+ * The length of the longest prefix of [src, src + len) that can be copied
+ * into a quoted JSON string verbatim.
+ *
+ * For Latin-1 text this checks eight characters at a time with bitwise
+ * operations: a character needs escaping only if it is a control character
+ * (< 0x20), '"' or '\\', and each of those conditions sets the high bit of
+ * the matching byte. Escapes are rare, so most strings are one clean run.
+ */
+template <typename SrcCharT>
+static MOZ_ALWAYS_INLINE size_t CleanRunLength(const SrcCharT* src,
+                                               size_t len) {
+  size_t i = 0;
+
+  if constexpr (sizeof(SrcCharT) == 1) {
+    constexpr uint64_t EveryByte = 0x0101010101010101;
+    constexpr uint64_t HighBits = 0x8080808080808080;
+
+    while (i + sizeof(uint64_t) <= len) {
+      uint64_t word;
+      memcpy(&word, src + i, sizeof(word));
+
+      // hasless(x, 0x20) and haszero(x ^ c) from Bit Twiddling Hacks. Borrows
+      // in the subtractions can only set spurious high bits above a byte that
+      // genuinely matches, so the lowest set bit always identifies a true
+      // match.
+      uint64_t quote = word ^ (EveryByte * '"');
+      uint64_t backslash = word ^ (EveryByte * '\\');
+      uint64_t needsEscape = ((word - (EveryByte * 0x20)) & ~word) |
+                             ((quote - EveryByte) & ~quote) |
+                             ((backslash - EveryByte) & ~backslash);
+      needsEscape &= HighBits;
+
+      if (needsEscape) {
+#if MOZ_BIG_ENDIAN()
+        return i + mozilla::CountLeadingZeroes64(needsEscape) / 8;
+#else
+        return i + mozilla::CountTrailingZeroes64(needsEscape) / 8;
+#endif
+      }
+
+      i += sizeof(uint64_t);
+    }
+  }
+
+  for (; i < len; i++) {
+    SrcCharT c = src[i];
+    if (c < sizeof(escapeLookup)) {
+      if (escapeLookup[c]) {
+        return i;
+      }
+    } else if (unicode::IsSurrogate(c)) {
+      return i;
+    }
+  }
+
+  return len;
+}
+
 /* https://262.ecma-international.org/14.0/#sec-quotejsonstring
  * Requires that the destination has enough space allocated for src after
  * escaping (that is, `2 + 6 * (srcEnd - srcBegin)` characters).
@@ -66,24 +146,6 @@ template <typename SrcCharT, typename DstCharT>
 static MOZ_ALWAYS_INLINE RangedPtr<DstCharT> InfallibleQuoteJSONString(
     RangedPtr<const SrcCharT> srcBegin, RangedPtr<const SrcCharT> srcEnd,
     RangedPtr<DstCharT> dstPtr) {
-  // Maps characters < 256 to the value that must follow the '\\' in the quoted
-  // string. Entries with 'u' are handled as \\u00xy, and entries with 0 are not
-  // escaped in any way. Characters >= 256 are all assumed to be unescaped.
-  static const Latin1Char escapeLookup[256] = {
-      // clang-format off
-        'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't',
-        'n', 'u', 'f', 'r', 'u', 'u', 'u', 'u', 'u', 'u',
-        'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
-        'u', 'u', 0,   0,  '\"', 0,   0,   0,   0,   0,
-        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,  '\\', // rest are all zeros
-      // clang-format on
-  };
-
   /* Step 1. */
   *dstPtr++ = '"';
 
@@ -94,6 +156,17 @@ static MOZ_ALWAYS_INLINE RangedPtr<DstCharT> InfallibleQuoteJSONString(
 
   /* Step 2. */
   while (srcBegin != srcEnd) {
+    // Copy runs of characters that need no escaping in bulk.
+    size_t clean = CleanRunLength(srcBegin.get(), srcEnd - srcBegin);
+    if (clean > 0) {
+      std::copy_n(srcBegin.get(), clean, dstPtr.get());
+      srcBegin += clean;
+      dstPtr += clean;
+      if (srcBegin == srcEnd) {
+        break;
+      }
+    }
+
     const SrcCharT c = *srcBegin++;
 
     // Handle the Latin-1 cases.
@@ -220,14 +293,17 @@ class StringifyContext {
  public:
   StringifyContext(JSContext* cx, StringBuilder& sb, const StringBuilder& gap,
                    HandleObject replacer, const RootedIdVector& propertyList,
-                   bool maybeSafely)
+                   bool maybeSafely, JSONWriteCallback chunkCallback = nullptr,
+                   void* chunkData = nullptr)
       : sb(sb),
         gap(gap),
         replacer(cx, replacer),
         stack(cx, ObjectVector(cx)),
         propertyList(propertyList),
         depth(0),
-        maybeSafely(maybeSafely) {
+        maybeSafely(maybeSafely),
+        chunkCallback(chunkCallback),
+        chunkData(chunkData) {
     MOZ_ASSERT_IF(maybeSafely, !replacer);
     MOZ_ASSERT_IF(maybeSafely, gap.empty());
   }
@@ -239,8 +315,41 @@ class StringifyContext {
   const RootedIdVector& propertyList;
   uint32_t depth;
   bool maybeSafely;
+
+  // When set, accumulated output is handed to this callback in chunks instead
+  // of being kept in |sb| for the whole stringification.
+  JSONWriteCallback chunkCallback;
+  void* chunkData;
 };
 
+// Granularity at which a chunked stringification hands accumulated output to
+// the callback. The builder's contents are only final between appends, so
+// flushing happens at member boundaries once at least this much has been
+// buffered.
+static const size_t StringifyChunkSize = 64 * 1024;
+
+static bool FlushStringifyChunk(StringifyContext* scx) {
+  MOZ_ASSERT(scx->chunkCallback);
+  if (scx->sb.empty()) {
+    return true;
+  }
+  MOZ_ASSERT(!scx->sb.isUnderlyingBufferLatin1());
+  if (!scx->chunkCallback(scx->sb.rawTwoByteBegin(), scx->sb.length(),
+                          scx->chunkData)) {
+    return false;
+  }
+  scx->sb.clear();  // Preserves allocated space.
+  return true;
+}
+
+static MOZ_ALWAYS_INLINE bool MaybeFlushStringifyChunk(StringifyContext* scx) {
+  if (MOZ_LIKELY(!scx->chunkCallback) ||
+      scx->sb.length() < StringifyChunkSize) {
+    return true;
+  }
+  return FlushStringifyChunk(scx);
+}
+
 } /* anonymous namespace */
 
 static bool SerializeJSONProperty(JSContext* cx, const Value& v,
@@ -551,6 +660,10 @@ static bool SerializeJSONObject(JSContext* cx, HandleObject obj,
         !SerializeJSONProperty(cx, outputValue, scx)) {
       return false;
     }
+
+    if (!MaybeFlushStringifyChunk(scx)) {
+      return false;
+    }
   }
 
   if (wroteMember && !WriteIndent(scx, scx->depth - 1)) {
@@ -688,6 +801,10 @@ static bool SerializeJSONArray(JSContext* cx, HandleObject obj,
           return false;
         }
       }
+
+      if (!MaybeFlushStringifyChunk(scx)) {
+        return false;
+      }
     }
 
     /* Step 10(b)(iii). */
@@ -1456,10 +1573,14 @@ static bool FastSerializeJSONProperty(JSContext* cx, Handle<Value> v,
 /* https://262.ecma-international.org/14.0/#sec-json.stringify */
 bool js::Stringify(JSContext* cx, MutableHandleValue vp, JSObject* replacer_,
                    const Value& space_, StringBuilder& sb,
-                   StringifyBehavior stringifyBehavior) {
+                   StringifyBehavior stringifyBehavior,
+                   JSONWriteCallback chunkCallback, void* chunkData) {
   RootedObject replacer(cx, replacer_);
   RootedValue space(cx, space_);
 
+  MOZ_ASSERT_IF(chunkCallback,
+                stringifyBehavior == StringifyBehavior::SlowOnly);
+
   MOZ_ASSERT_IF(stringifyBehavior == StringifyBehavior::RestrictedSafe,
                 space.isNull());
   MOZ_ASSERT_IF(stringifyBehavior == StringifyBehavior::RestrictedSafe,
@@ -1669,7 +1790,8 @@ bool js::Stringify(JSContext* cx, MutableHandleValue vp, JSObject* replacer_,
   // Slow, general path.
 
   StringifyContext scx(cx, sb, gap, replacer, propertyList,
-                       stringifyBehavior == StringifyBehavior::RestrictedSafe);
+                       stringifyBehavior == StringifyBehavior::RestrictedSafe,
+                       chunkCallback, chunkData);
   if (!PreprocessValue(cx, wrapper, HandleId(emptyId), vp, &scx)) {
     return false;
   }
@@ -1681,6 +1803,11 @@ bool js::Stringify(JSContext* cx, MutableHandleValue vp, JSObject* replacer_,
     return false;
   }
 
+  // Hand any remaining output to the chunk callback.
+  if (chunkCallback && !FlushStringifyChunk(&scx)) {
+    return false;
+  }
+
   // For StringBehavior::Compare, when the fast path succeeded.
   if (MOZ_UNLIKELY(fastJSON)) {
     JSAtom* slowJSON = scx.sb.finishAtom();
@@ -1897,26 +2024,28 @@ static bool Revive(JSContext* cx, HandleValue reviver,
 
 template <typename CharT>
 bool ParseJSON(JSContext* cx, const mozilla::Range<const CharT> chars,
-               MutableHandleValue vp) {
+               MutableHandleValue vp, JSString* sourceString = nullptr) {
   Rooted<JSONParser<CharT>> parser(cx, cx, chars,
-                                   JSONParser<CharT>::ParseType::JSONParse);
+                                   JSONParser<CharT>::ParseType::JSONParse,
+                                   sourceString);
   return parser.parse(vp);
 }
 
 template <typename CharT>
 bool js::ParseJSONWithReviver(JSContext* cx,
                               const mozilla::Range<const CharT> chars,
-                              HandleValue reviver, MutableHandleValue vp) {
+                              HandleValue reviver, MutableHandleValue vp,
+                              JSString* sourceString) {
   js::AutoGeckoProfilerEntry pseudoFrame(cx, "parse JSON",
                                          JS::ProfilingCategoryPair::JS_Parsing);
   /* https://262.ecma-international.org/14.0/#sec-json.parse steps 2-10. */
   Rooted<ParseRecordObject*> pro(cx);
   if (JS::Prefs::experimental_json_parse_with_source() && IsCallable(reviver)) {
-    Rooted<JSONReviveParser<CharT>> parser(cx, cx, chars);
+    Rooted<JSONReviveParser<CharT>> parser(cx, cx, chars, sourceString);
     if (!parser.get().parse(vp, &pro)) {
       return false;
     }
-  } else if (!ParseJSON(cx, chars, vp)) {
+  } else if (!ParseJSON(cx, chars, vp, sourceString)) {
     return false;
   }
 
@@ -1929,11 +2058,11 @@ bool js::ParseJSONWithReviver(JSContext* cx,
 
 template bool js::ParseJSONWithReviver(
     JSContext* cx, const mozilla::Range<const Latin1Char> chars,
-    HandleValue reviver, MutableHandleValue vp);
+    HandleValue reviver, MutableHandleValue vp, JSString* sourceString);
 
 template bool js::ParseJSONWithReviver(
     JSContext* cx, const mozilla::Range<const char16_t> chars,
-    HandleValue reviver, MutableHandleValue vp);
+    HandleValue reviver, MutableHandleValue vp, JSString* sourceString);
 
 static bool json_toSource(JSContext* cx, unsigned argc, Value* vp) {
   CallArgs args = CallArgsFromVp(argc, vp);
@@ -1953,7 +2082,7 @@ static bool json_parse(JSContext* cx, unsigned argc, Value* vp) {
     return false;
   }
 
-  JSLinearString* linear = str->ensureLinear(cx);
+  Rooted<JSLinearString*> linear(cx, str->ensureLinear(cx));
   if (!linear) {
     return false;
   }
@@ -1968,9 +2097,9 @@ static bool json_parse(JSContext* cx, unsigned argc, Value* vp) {
   /* Steps 2-12. */
   return linearChars.isLatin1()
              ? ParseJSONWithReviver(cx, linearChars.latin1Range(), reviver,
-                                    args.rval())
+                                    args.rval(), linear)
              : ParseJSONWithReviver(cx, linearChars.twoByteRange(), reviver,
-                                    args.rval());
+                                    args.rval(), linear);
 }
 
 /* https://tc39.es/proposal-json-parse-with-source/#sec-json.israwjson */
@@ -11,6 +11,7 @@
 
 #include "NamespaceImports.h"
 
+#include "js/JSON.h"  // JSONWriteCallback
 #include "js/RootingAPI.h"
 
 namespace js {
@@ -48,15 +49,29 @@ enum class StringifyBehavior {
  * If stringifyBehavior is RestrictedSafe, Stringify will attempt to assert the
  * API requirements of JS::ToJSONMaybeSafely as it traverses the graph, and will
  * not try to invoke .toJSON on things as it goes.
+ *
+ * If a chunk callback is supplied, output is handed to it in chunks as it is
+ * produced instead of accumulating in |sb|, which must then have two-byte
+ * characters. This forces the slow path, so callers should also pass
+ * StringifyBehavior::SlowOnly.
  */
 extern bool Stringify(JSContext* cx, js::MutableHandleValue vp,
                       JSObject* replacer, const Value& space, StringBuilder& sb,
-                      StringifyBehavior stringifyBehavior);
-
+                      StringifyBehavior stringifyBehavior,
+                      JSONWriteCallback chunkCallback = nullptr,
+                      void* chunkData = nullptr);
+
+/*
+ * Parse the given characters as JSON. If |sourceString| is given it must be
+ * the string the characters belong to, with contents stable across GC for the
+ * duration of the call; long string values in the result are then created as
+ * dependent strings sharing its characters instead of as copies.
+ */
 template <typename CharT>
 extern bool ParseJSONWithReviver(JSContext* cx,
                                  const mozilla::Range<const CharT> chars,
-                                 HandleValue reviver, MutableHandleValue vp);
+                                 HandleValue reviver, MutableHandleValue vp,
+                                 JSString* sourceString = nullptr);
 
 }  // namespace js
 
@@ -764,6 +764,11 @@ bool MapObject::tryOptimizeCtorWithIterable(JSContext* cx,
     ArrayObject* array = &iterable->as<ArrayObject>();
     uint32_t len = array->getDenseInitializedLength();
 
+    // Pre-size the table so that the loop below doesn't rehash.
+    if (!Table(this).reserve(cx, len)) {
+      return false;
+    }
+
     for (uint32_t index = 0; index < len; index++) {
       Value element = array->getDenseElement(index);
       MOZ_ASSERT(IsPackedArray(&element.toObject()));
@@ -787,6 +792,9 @@ bool MapObject::tryOptimizeCtorWithIterable(JSContext* cx,
   // Fast path for `new Map(map)`.
   if (IsMapObjectWithDefaultIterator(iterable, cx)) {
     auto* iterableMap = &iterable->as<MapObject>();
+    if (!Table(this).reserve(cx, Table(iterableMap).count())) {
+      return false;
+    }
     auto addEntry = [cx, this](auto& entry) {
       return setWithHashableKey(cx, entry.key, entry.value);
     };
@@ -1518,6 +1526,11 @@ bool SetObject::tryOptimizeCtorWithIterable(JSContext* cx,
     ArrayObject* array = &iterable->as<ArrayObject>();
     uint32_t len = array->getDenseInitializedLength();
 
+    // Pre-size the table so that the loop below doesn't rehash.
+    if (!Table(this).reserve(cx, len)) {
+      return false;
+    }
+
     for (uint32_t index = 0; index < len; index++) {
       Value keyVal = array->getDenseElement(index);
       MOZ_ASSERT(!keyVal.isMagic(JS_ELEMENTS_HOLE));
@@ -1536,6 +1549,9 @@ bool SetObject::tryOptimizeCtorWithIterable(JSContext* cx,
     if (!IsSetObjectWithDefaultIterator(iterableSet, cx)) {
       return true;
     }
+    if (!Table(this).reserve(cx, Table(iterableSet).count())) {
+      return false;
+    }
     auto addEntry = [cx, this](auto& entry) {
       return addHashableValue(cx, entry);
     };
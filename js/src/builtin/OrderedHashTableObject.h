@@ -558,13 +558,16 @@ class MOZ_STACK_CLASS OrderedHashTableImpl {
     return {data, table, hcs, numBytes};
   }
 
-  [[nodiscard]] bool initBuffer(JSContext* cx) {
+  [[nodiscard]] bool initBuffer(JSContext* cx,
+                                uint32_t hashShift = InitialHashShift) {
     MOZ_ASSERT(!hasAllocatedBuffer());
     MOZ_ASSERT(getDataLength() == 0);
     MOZ_ASSERT(getLiveCount() == 0);
+    MOZ_ASSERT(hashShift >= MinHashShift);
+    MOZ_ASSERT(hashShift <= InitialHashShift);
 
-    constexpr uint32_t buckets = InitialBuckets;
-    constexpr uint32_t capacity = uint32_t(buckets * FillFactor);
+    const uint32_t buckets = hashShiftToNumHashBuckets(hashShift);
+    const uint32_t capacity = numHashBucketsToDataCapacity(buckets);
 
     auto [dataAlloc, tableAlloc, hcsAlloc, numBytes] =
         allocateBuffer(cx, capacity, buckets);
@@ -581,7 +584,7 @@ class MOZ_STACK_CLASS OrderedHashTableImpl {
     setHashTable(tableAlloc);
     setData(dataAlloc);
     setDataCapacity(capacity);
-    setHashShift(InitialHashShift);
+    setHashShift(hashShift);
     setHashCodeScrambler(hcsAlloc);
     MOZ_ASSERT(hashBuckets() == buckets);
     return true;
@@ -717,6 +720,30 @@ class MOZ_STACK_CLASS OrderedHashTableImpl {
     return e ? &e->element : nullptr;
   }
 
+  /*
+   * Ensure the table can hold at least |count| entries without rehashing,
+   * for use when the number of entries to be added is known in advance.
+   * Counts beyond the maximum data capacity are clamped; adding that many
+   * entries will fail with an allocation overflow error later.
+   *
+   * On allocation failure this returns false and leaves the table as it was.
+   */
+  [[nodiscard]] bool reserve(JSContext* cx, uint64_t count) {
+    uint32_t hashShift = InitialHashShift;
+    while (hashShift > MinHashShift &&
+           numHashBucketsToDataCapacity(hashShiftToNumHashBuckets(hashShift)) <
+               count) {
+      hashShift--;
+    }
+    if (!hasAllocatedBuffer()) {
+      return initBuffer(cx, hashShift);
+    }
+    if (hashShift < getHashShift()) {
+      return rehash(cx, hashShift);
+    }
+    return true;
+  }
+
   /*
    * If the table already contains an entry that matches |element|,
    * replace that entry with |element|. Otherwise add a new entry.
@@ -1360,6 +1387,9 @@ class MOZ_STACK_CLASS OrderedHashMapImpl {
   Entry* get(const Lookup& key) { return impl.get(key); }
   bool remove(JSContext* cx, const Lookup& key) { return impl.remove(cx, key); }
   void clear(JSContext* cx) { impl.clear(cx); }
+  [[nodiscard]] bool reserve(JSContext* cx, uint64_t count) {
+    return impl.reserve(cx, count);
+  }
 
   void destroy(JS::GCContext* gcx) { impl.destroy(gcx); }
 
@@ -1476,6 +1506,9 @@ class MOZ_STACK_CLASS OrderedHashSetImpl {
   [[nodiscard]] bool put(JSContext* cx, Input&& value) {
     return impl.put(cx, std::forward<Input>(value));
   }
+  [[nodiscard]] bool reserve(JSContext* cx, uint64_t count) {
+    return impl.reserve(cx, count);
+  }
   bool remove(JSContext* cx, const Lookup& value) {
     return impl.remove(cx, value);
   }
@@ -1528,12 +1528,18 @@ XDRResult XDRStencilDecoder::codeStencil(
   uint32_t hash;
   MOZ_TRY(codeUint32(&hash));
 
+  // Bounds-check the recorded length even when the checksum isn't validated.
   const uint8_t* contentBegin;
   MOZ_TRY(peekArray(length, &contentBegin));
-  uint32_t actualHash = mozilla::HashBytes(contentBegin, length);
 
-  if (MOZ_UNLIKELY(actualHash != hash)) {
-    return fail(JS::TranscodeResult::Failure_BadDecode);
+  // Hashing the content reads every byte of the buffer up front, which
+  // defeats lazy page-in when decoding from a file mapping shared between
+  // processes, so caches with their own integrity guarantees can opt out.
+  if (!options.skipTranscodeChecksum) {
+    uint32_t actualHash = mozilla::HashBytes(contentBegin, length);
+    if (MOZ_UNLIKELY(actualHash != hash)) {
+      return fail(JS::TranscodeResult::Failure_BadDecode);
+    }
   }
 
   MOZ_TRY(frontend::StencilXDR::codeSource(this, &options, stencil.source));
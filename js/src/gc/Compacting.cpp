@@ -471,6 +471,47 @@ inline void MovingTracer::onEdge(T** thingp, const char* name) {
   }
 }
 
+// A work item for parallel weak cache sweeping: a single weak cache belonging
+// to the zone being compacted.
+class WeakCachesToUpdate {
+ public:
+  explicit WeakCachesToUpdate(Zone* zone)
+      : cache(zone->weakCaches().getFirst()) {
+    settle();
+  }
+
+  bool done() const { return !cache; }
+
+  JS::detail::WeakCacheBase* get() const {
+    MOZ_ASSERT(!done());
+    return cache;
+  }
+
+  void next() {
+    MOZ_ASSERT(!done());
+    cache = cache->getNext();
+    settle();
+  }
+
+ private:
+  void settle() {
+    while (cache && cache->empty()) {
+      cache = cache->getNext();
+    }
+  }
+
+  JS::detail::WeakCacheBase* cache;
+};
+
+static size_t UpdateWeakCacheAfterCompacting(GCRuntime* gc,
+                                             JS::detail::WeakCacheBase* cache) {
+  MovingTracer trc(gc->rt);
+
+  // The nursery is empty during compaction so updating cache entries cannot
+  // generate store buffer entries, and a moving trace never removes entries.
+  return cache->traceWeak(&trc, JS::detail::WeakCacheBase::DontLockStoreBuffer);
+}
+
 void GCRuntime::sweepZoneAfterCompacting(MovingTracer* trc, Zone* zone) {
   MOZ_ASSERT(zone->isGCCompacting());
 
@@ -479,9 +520,19 @@ void GCRuntime::sweepZoneAfterCompacting(MovingTracer* trc, Zone* zone) {
 
   traceWeakFinalizationObserverEdges(trc, zone);
 
-  for (auto* cache : zone->weakCaches()) {
-    cache->traceWeak(trc, JS::detail::WeakCacheBase::DontLockStoreBuffer);
-  }
+  // Each weak cache is an independent table, so caches can be updated on
+  // helper threads in parallel with the weak sweeping below, in the same way
+  // as the cell pointer update.
+  WeakCachesToUpdate weakCaches(zone);
+
+  AutoLockHelperThreadState lock;
+
+  AutoRunParallelWork updateCaches(this, UpdateWeakCacheAfterCompacting,
+                                   gcstats::PhaseKind::COMPACT_UPDATE_CACHES,
+                                   GCUse::Unspecified, weakCaches,
+                                   SliceBudget::unlimited(), lock);
+
+  AutoUnlockHelperThreadState unlock(lock);
 
   if (jit::JitZone* jitZone = zone->jitZone()) {
     jitZone->traceWeak(trc, zone);
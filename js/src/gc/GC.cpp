@@ -1007,6 +1007,7 @@ void GCRuntime::finish() {
   // helper thread shuts down before we forcefully release any remaining GC
   // memory.
   sweepTask.join();
+  markTask.requestInterrupt();
   markTask.join();
   freeTask.join();
   allocTask.cancelAndWait();
@@ -1872,7 +1873,7 @@ int SliceBudget::describe(char* buffer, size_t maxlen) const {
 
 bool SliceBudget::checkOverBudget() {
   MOZ_ASSERT(counter <= 0);
-  MOZ_ASSERT(!isUnlimited());
+  MOZ_ASSERT_IF(isUnlimited(), interruptRequested);
 
   if (isWorkBudget()) {
     return true;
@@ -1886,7 +1887,7 @@ bool SliceBudget::checkOverBudget() {
     return true;
   }
 
-  if (TimeStamp::Now() >= budget.as<TimeBudget>().deadline) {
+  if (isTimeBudget() && TimeStamp::Now() >= budget.as<TimeBudget>().deadline) {
     return true;
   }
 
@@ -140,10 +140,21 @@ class BackgroundMarkTask : public GCParallelTask {
  public:
   explicit BackgroundMarkTask(GCRuntime* gc);
   void setBudget(const JS::SliceBudget& budget) { this->budget = budget; }
+
+  // Mark with an unlimited budget. The task runs concurrently with the
+  // mutator, so it is not bound by any slice deadline, but the main thread
+  // can interrupt it when it needs to join the task.
+  void setInterruptibleBudget() {
+    interruptRequested = false;
+    budget = JS::SliceBudget::unlimitedWithInterrupt(&interruptRequested);
+  }
+  void requestInterrupt() { interruptRequested = true; }
+
   void run(AutoLockHelperThreadState& lock) override;
 
  private:
   JS::SliceBudget budget;
+  JS::SliceBudget::InterruptRequestFlag interruptRequested;
 };
 
 class BackgroundUnmarkTask : public GCParallelTask {
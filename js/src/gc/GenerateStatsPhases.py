@@ -206,6 +206,7 @@ PhaseKindGraphRoots = [
                 [
                     getPhaseKind("MARK_ROOTS"),
                     addPhaseKind("COMPACT_UPDATE_CELLS", "Compact Update Cells"),
+                    addPhaseKind("COMPACT_UPDATE_CACHES", "Compact Update Caches"),
                     getPhaseKind("JOIN_PARALLEL_TASKS"),
                 ],
             ),
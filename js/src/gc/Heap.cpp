@@ -345,10 +345,22 @@ void ArenaChunk::decommitFreeArenas(GCRuntime* gc, const bool& cancel,
       continue;
     }
 
-    if (!decommitOneFreePage(gc, i, lock)) {
+    // Decommit a whole run of contiguous free pages with one system call.
+    // Issuing madvise per page makes the syscall count after a large
+    // collection proportional to the memory released, and on Linux with
+    // transparent huge pages it also splits each huge page separately; a
+    // mostly-empty chunk can instead be released in a single call.
+    size_t runEnd = i + 1;
+    while (runEnd < PagesPerChunk && canDecommitPage(runEnd)) {
+      runEnd++;
+    }
+
+    if (!decommitFreePages(gc, i, runEnd - i, lock)) {
       break;
     }
 
+    i = runEnd - 1;
+
     {
       // Give main thread a chance to take the lock.
       AutoUnlockGC unlock(lock);
@@ -384,29 +396,38 @@ void ArenaChunk::releaseArena(GCRuntime* gc, Arena* arena,
   verify();
 }
 
-bool ArenaChunk::decommitOneFreePage(GCRuntime* gc, size_t pageIndex,
-                                     const AutoLockGC& lock) {
+bool ArenaChunk::decommitFreePages(GCRuntime* gc, size_t firstPageIndex,
+                                   size_t numPages, const AutoLockGC& lock) {
   MOZ_ASSERT(DecommitEnabled());
-  MOZ_ASSERT(canDecommitPage(pageIndex));
+  MOZ_ASSERT(numPages > 0);
+  MOZ_ASSERT(firstPageIndex + numPages <= PagesPerChunk);
   MOZ_ASSERT(info.numArenasFree >= info.numArenasFreeCommitted);
-  MOZ_ASSERT(info.numArenasFreeCommitted >= ArenasPerPage);
+  MOZ_ASSERT(info.numArenasFreeCommitted >= numPages * ArenasPerPage);
+#ifdef DEBUG
+  for (size_t i = 0; i < numPages; i++) {
+    MOZ_ASSERT(canDecommitPage(firstPageIndex + i));
+  }
+#endif
 
   if (oom::ShouldFailWithOOM()) {
     return false;
   }
 
-  if (!MarkPagesUnusedSoft(pageAddress(pageIndex), PageSize)) {
+  if (!MarkPagesUnusedSoft(pageAddress(firstPageIndex), numPages * PageSize)) {
     return false;
   }
 
-  // Mark the page as decommited.
-  decommittedPages[pageIndex] = true;
-  for (size_t i = 0; i < ArenasPerPage; i++) {
-    size_t arenaIndex = pageToArenaIndex(pageIndex) + i;
-    MOZ_ASSERT(freeCommittedArenas[arenaIndex]);
-    freeCommittedArenas[arenaIndex] = false;
+  // Mark the pages as decommited.
+  for (size_t page = firstPageIndex; page < firstPageIndex + numPages;
+       page++) {
+    decommittedPages[page] = true;
+    for (size_t i = 0; i < ArenasPerPage; i++) {
+      size_t arenaIndex = pageToArenaIndex(page) + i;
+      MOZ_ASSERT(freeCommittedArenas[arenaIndex]);
+      freeCommittedArenas[arenaIndex] = false;
+    }
   }
-  info.numArenasFreeCommitted -= ArenasPerPage;
+  info.numArenasFreeCommitted -= numPages * ArenasPerPage;
 
   verify();
 
@@ -532,8 +532,8 @@ class ArenaChunk : public ArenaChunkBase {
   void releaseArena(GCRuntime* gc, Arena* arena, const AutoLockGC& lock);
 
   void decommitFreeArenas(GCRuntime* gc, const bool& cancel, AutoLockGC& lock);
-  [[nodiscard]] bool decommitOneFreePage(GCRuntime* gc, size_t pageIndex,
-                                         const AutoLockGC& lock);
+  [[nodiscard]] bool decommitFreePages(GCRuntime* gc, size_t firstPageIndex,
+                                       size_t numPages, const AutoLockGC& lock);
   void decommitAllArenas();
 
   // This will decommit each unused not-already decommitted arena. It performs a
@@ -2421,14 +2421,25 @@ IncrementalProgress JS::Zone::enterWeakMarkingMode(GCMarker* marker,
 
   MOZ_ASSERT(gcNurseryEphemeronEdges().count() == 0);
 
-  for (auto r = gcEphemeronEdges().all(); !r.empty(); r.popFront()) {
-    Cell* src = r.front().key();
+  // Use a mutable iterator so that entries whose edges have all been marked
+  // can be removed, as markImplicitEdges does. If the scan runs out of budget
+  // it restarts from the beginning of the table on the next slice, so leaving
+  // fully-processed entries in place would make the total scan cost quadratic
+  // in the number of ephemeron entries on WeakMap-heavy heaps. Removing them
+  // keeps each rescan proportional to the entries that may still need work.
+  // This is safe because the marking below only pushes things onto the mark
+  // stack and so cannot mutate the table while we are iterating it.
+  for (auto iter = gcEphemeronEdges().modIter(); !iter.done(); iter.next()) {
+    Cell* src = iter.get().key();
     CellColor srcColor = gc::detail::GetEffectiveColor(marker, src);
-    auto& edges = r.front().value();
+    auto& edges = iter.get().value();
 
     if (IsMarked(srcColor) && edges.length() > 0) {
       uint32_t steps = edges.length();
       marker->markEphemeronEdges(edges, AsMarkColor(srcColor));
+      if (edges.empty()) {
+        iter.remove();
+      }
       budget.step(steps);
       if (budget.isOverBudget()) {
         return NotFinished;
@@ -361,6 +361,13 @@ class Nursery {
 
   bool canCreateAllocSite() { return pretenuringNursery.canCreateAllocSite(); }
   void noteAllocSiteCreated() { pretenuringNursery.noteAllocSiteCreated(); }
+  bool maybeSeedAllocSite(gc::AllocSite* site, JSScript* script,
+                          uint32_t pcOffset) {
+    return pretenuringNursery.maybeSeedAllocSite(site, script, pcOffset);
+  }
+  void removePretenuredSiteHint(gc::AllocSite* site) {
+    pretenuringNursery.removePretenuredSiteHint(site);
+  }
   bool reportPretenuring() const { return pretenuringReportFilter_.enabled; }
   void maybeStopPretenuring(gc::GCRuntime* gc) {
     pretenuringNursery.maybeStopPretenuring(gc);
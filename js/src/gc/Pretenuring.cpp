@@ -7,6 +7,8 @@
 
 #include "gc/Pretenuring.h"
 
+#include "mozilla/HashFunctions.h"
+#include "mozilla/Maybe.h"
 #include "mozilla/Sprintf.h"
 
 #include "gc/GCInternals.h"
@@ -57,6 +59,11 @@ static constexpr size_t HighNurserySurvivalOptimizedAllocThreshold = 10000;
 // that must occur before recovery is attempted.
 static constexpr size_t HighNurserySurvivalCountBeforeRecovery = 2;
 
+// The maximum number of pretenuring hints to remember. This bounds the memory
+// used for hints when a runtime compiles many distinct scripts over its
+// lifetime.
+static constexpr size_t MaxPretenuredSiteHints = 16 * 1024;
+
 AllocSite* const AllocSite::EndSentinel = reinterpret_cast<AllocSite*>(1);
 JSScript* const AllocSite::WasmScript =
     reinterpret_cast<JSScript*>(AllocSite::STATE_MASK + 1);
@@ -72,6 +79,63 @@ bool PretenuringNursery::canCreateAllocSite() {
          allocSitesCreated < MaxAllocSitesPerMinorGC;
 }
 
+// Compute a key identifying an allocation site independently of the AllocSite
+// or script instance, so that hints survive recompilation of the same script.
+// Returns Nothing for scripts without a filename (e.g. eval code).
+static mozilla::Maybe<uint64_t> SiteHintKey(JSScript* script,
+                                            uint32_t pcOffset) {
+  const char* filename = script->filename();
+  if (!filename) {
+    return mozilla::Nothing();
+  }
+
+  return mozilla::Some(uint64_t(mozilla::AddToHash(
+      mozilla::HashString(filename), script->sourceStart(), pcOffset)));
+}
+
+void PretenuringNursery::recordPretenuredSiteHint(AllocSite* site) {
+  if (!site->isNormal() || !site->hasScript()) {
+    return;
+  }
+
+  if (pretenuredSiteHints.count() >= MaxPretenuredSiteHints) {
+    return;
+  }
+
+  if (auto key = SiteHintKey(site->script(), site->pcOffset())) {
+    // Hints are best effort; ignore OOM here.
+    (void)pretenuredSiteHints.put(*key);
+  }
+}
+
+void PretenuringNursery::removePretenuredSiteHint(AllocSite* site) {
+  if (pretenuredSiteHints.empty() || !site->isNormal() || !site->hasScript()) {
+    return;
+  }
+
+  if (auto key = SiteHintKey(site->script(), site->pcOffset())) {
+    pretenuredSiteHints.remove(*key);
+  }
+}
+
+bool PretenuringNursery::maybeSeedAllocSite(AllocSite* site, JSScript* script,
+                                            uint32_t pcOffset) {
+  MOZ_ASSERT(site->isNormal());
+  MOZ_ASSERT(site->state() == AllocSite::State::Unknown);
+
+  if (pretenuredSiteHints.empty()) {
+    return false;
+  }
+
+  auto key = SiteHintKey(script, pcOffset);
+  if (!key || !pretenuredSiteHints.has(*key)) {
+    return false;
+  }
+
+  site->setState(AllocSite::State::LongLived);
+  return true;
+}
+
 size_t PretenuringNursery::doPretenuring(GCRuntime* gc, JS::GCReason reason,
                                          bool validPromotionRate,
                                          double promotionRate,
@@ -125,6 +189,7 @@ size_t PretenuringNursery::doPretenuring(GCRuntime* gc, JS::GCReason reason,
         if (site->hasScript()) {
           site->script()->realm()->numAllocSitesPretenured++;
         }
+        recordPretenuredSiteHint(site);
       }
       if (result == AllocSite::WasPretenuredAndInvalidated) {
         sitesInvalidated++;
@@ -206,6 +271,12 @@ AllocSite::SiteResult AllocSite::processSite(
           result = WasPretenuredAndInvalidated;
         }
       }
+    } else if (prevState == AllocSite::State::LongLived &&
+               newState == AllocSite::State::Unknown) {
+      // The pretenuring decision was wrong, or the allocation behavior has
+      // changed. Forget any hint so future incarnations of this site don't
+      // start out pretenured again.
+      gc->nursery().removePretenuredSiteHint(this);
     }
   }
 
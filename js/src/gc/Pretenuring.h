@@ -22,6 +22,8 @@
 #include <algorithm>
 
 #include "gc/AllocKind.h"
+#include "js/AllocPolicy.h"
+#include "js/HashTable.h"
 #include "js/TypeDecls.h"
 
 class JS_PUBLIC_API JSTracer;
@@ -410,6 +412,16 @@ class PretenuringNursery {
 
   uint32_t totalAllocCount_ = 0;
 
+  // Hints recording allocation sites that were observed to be long-lived,
+  // keyed by script identity (source filename, source offset and bytecode
+  // offset) rather than by AllocSite. They therefore survive script and zone
+  // teardown, so when the same script is compiled again - e.g. on reload of
+  // the same application - its known-tenured sites skip the nursery from the
+  // first run instead of re-learning over several minor collections.
+  using SiteHintSet =
+      HashSet<uint64_t, DefaultHasher<uint64_t>, SystemAllocPolicy>;
+  SiteHintSet pretenuredSiteHints;
+
  public:
   PretenuringNursery() : allocatedSites(AllocSite::EndSentinel) {}
 
@@ -436,7 +448,17 @@ class PretenuringNursery {
 
   void* addressOfAllocatedSites() { return &allocatedSites; }
 
+  // If a previous incarnation of the script was observed to be long-lived at
+  // this bytecode offset, seed the freshly created site as pretenured and
+  // return true.
+  bool maybeSeedAllocSite(AllocSite* site, JSScript* script,
+                          uint32_t pcOffset);
+
+  void removePretenuredSiteHint(AllocSite* site);
+
  private:
+  void recordPretenuredSiteHint(AllocSite* site);
+
   void updateTotalAllocCounts(AllocSite* site);
 };
 
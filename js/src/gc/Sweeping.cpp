@@ -1861,7 +1861,15 @@ IncrementalProgress GCRuntime::markDuringSweeping(JS::GCContext* gcx,
     if (!marker().isDrained() || hasDelayedMarking()) {
       AutoLockHelperThreadState lock;
       MOZ_ASSERT(markTask.isIdle(lock));
-      markTask.setBudget(budget);
+      if (budget.isTimeBudget()) {
+        // The slice deadline only bounds how long the mutator is paused, but
+        // this task keeps running after the slice yields. Let it mark until
+        // it is drained or the next slice interrupts it to take over, rather
+        // than stopping as soon as the mutator resumes.
+        markTask.setInterruptibleBudget();
+      } else {
+        markTask.setBudget(budget);
+      }
       markTask.startOrRunIfIdle(lock);
     }
     return Finished;  // This means don't yield to the mutator here.
@@ -1941,6 +1949,9 @@ IncrementalProgress GCRuntime::joinBackgroundMarkTask() {
     return Finished;
   }
 
+  // If the task is marking on an interruptible budget, ask it to yield so
+  // that we don't block here for longer than a budget check interval.
+  markTask.requestInterrupt();
   joinTask(markTask, lock);
 
   IncrementalProgress result = sweepMarkResult;
@@ -1676,9 +1676,12 @@ bool BacktrackingAllocator::init() {
   // Partition the graph into hot and cold sections, for helping to make
   // splitting decisions. Since we don't have any profiling data this is a
   // crapshoot, so just mark the bodies of inner loops as hot and everything
-  // else as cold.
+  // else as cold. Blocks which branch hinting marked as unlikely are carved
+  // out of the hot section: spilling in a rarely taken block is preferable
+  // to spilling anywhere else in the loop.
 
   LBlock* backedge = nullptr;
+  size_t headerIndex = 0;
   for (size_t i = 0; i < graph.numBlocks(); i++) {
     LBlock* block = graph.getBlock(i);
 
@@ -1687,14 +1690,33 @@ bool BacktrackingAllocator::init() {
     // if there is an inner loop we will ignore the outer backedge.
     if (block->mir()->isLoopHeader()) {
       backedge = block->mir()->backedge()->lir();
+      headerIndex = i;
     }
 
     if (block == backedge) {
-      LBlock* header = block->mir()->loopHeaderOfBackedge()->lir();
-      LiveRange* range = LiveRange::FallibleNew(
-          alloc(), nullptr, entryOf(header), exitOf(block).next());
-      if (!range || !hotcode.insert(range)) {
-        return false;
+      MOZ_ASSERT(graph.getBlock(headerIndex) ==
+                 block->mir()->loopHeaderOfBackedge()->lir());
+      CodePosition hotFrom = entryOf(graph.getBlock(headerIndex));
+      for (size_t j = headerIndex; j <= i; j++) {
+        LBlock* loopBlock = graph.getBlock(j);
+        if (!loopBlock->mir()->branchHintingUnlikely()) {
+          continue;
+        }
+        if (hotFrom < entryOf(loopBlock)) {
+          LiveRange* range = LiveRange::FallibleNew(alloc(), nullptr, hotFrom,
+                                                    entryOf(loopBlock));
+          if (!range || !hotcode.insert(range)) {
+            return false;
+          }
+        }
+        hotFrom = exitOf(loopBlock).next();
+      }
+      if (hotFrom < exitOf(block).next()) {
+        LiveRange* range = LiveRange::FallibleNew(alloc(), nullptr, hotFrom,
+                                                  exitOf(block).next());
+        if (!range || !hotcode.insert(range)) {
+          return false;
+        }
       }
     }
   }
@@ -23,8 +23,10 @@ using namespace js::jit;
 // In a Mir to Mir transformation, we read the hints and do something with it:
 // - Unlikely blocks are pushed to the end of the function.
 // Because of Ion's structure, we don't do that for blocks inside a loop.
+// - The register allocator carves unlikely blocks out of its hot code
+// partition, so spills are placed in them in preference to the rest of the
+// loop (see BacktrackingAllocator::init).
 // - TODO: do something for likely blocks.
-// - TODO: register allocator can be tuned depending on the hints.
 bool jit::BranchHinting(const MIRGenerator* mir, MIRGraph& graph) {
   JitSpew(JitSpew_BranchHint, "Beginning BranchHinting pass");
 
@@ -10,6 +10,7 @@
 #include "jit/Ion.h"
 #include "jit/JitRuntime.h"
 #include "jit/JitScript.h"
+#include "jit/JitSpewer.h"
 #include "jit/WarpSnapshot.h"
 #include "vm/HelperThreadState.h"
 #include "vm/JSScript.h"
@@ -48,6 +49,14 @@ void IonCompileTask::runHelperThreadTask(AutoLockHelperThreadState& locked) {
 void IonCompileTask::runTask() {
   // This is the entry point when ion compiles are run offthread.
 
+  if (!enqueueTime_.IsNull()) {
+    mozilla::TimeDuration queueTime = mozilla::TimeStamp::Now() - enqueueTime_;
+    JitSpew(JitSpew_IonScripts,
+            "Starting off-thread compile of %s:%u:%u after %.2fms in queue",
+            script()->filename(), script()->lineno(),
+            script()->column().oneOriginValue(), queueTime.ToMilliseconds());
+  }
+
   jit::JitContext jctx(mirGen_.realm->runtime());
   setBackgroundCodegen(jit::CompileBackEnd(&mirGen_, snapshot_));
 }
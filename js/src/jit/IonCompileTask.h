@@ -8,6 +8,7 @@
 #define jit_IonCompileTask_h
 
 #include "mozilla/LinkedList.h"
+#include "mozilla/TimeStamp.h"
 
 #include "jit/CompilationDependencyTracker.h"
 #include "jit/MIRGenerator.h"
@@ -41,6 +42,10 @@ class IonCompileTask final : public HelperThreadTask,
   // removed from the helper threads. Thus this should be safe.
   const mozilla::Atomic<bool, mozilla::ReleaseAcquire>& isExecuting_;
 
+  // Time at which this task was appended to the helper thread worklist, used
+  // to report how long the compile waited before a thread picked it up.
+  mozilla::TimeStamp enqueueTime_;
+
  public:
   explicit IonCompileTask(JSContext* cx, MIRGenerator& mirGen,
                           WarpSnapshot* snapshot);
@@ -62,6 +67,9 @@ class IonCompileTask final : public HelperThreadTask,
   // executing JS code. This changes the way we prioritize tasks.
   bool isMainThreadRunningJS() const { return isExecuting_; }
 
+  void setEnqueueTime(mozilla::TimeStamp when) { enqueueTime_ = when; }
+  mozilla::TimeStamp enqueueTime() const { return enqueueTime_; }
+
   ThreadType threadType() override { return THREAD_TYPE_ION; }
   void runTask();
   void runHelperThreadTask(AutoLockHelperThreadState& locked) override;
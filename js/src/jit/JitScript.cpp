@@ -872,6 +872,10 @@ gc::AllocSite* ICScript::getOrCreateAllocSite(JSScript* outerScript,
 
   nursery.noteAllocSiteCreated();
 
+  // If a previous incarnation of this script observed allocations here to be
+  // long lived, start out pretenured instead of re-learning that.
+  nursery.maybeSeedAllocSite(site, outerScript, pcOffset);
+
   return site;
 }
 
@@ -0,0 +1,246 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * GC pause-time micro-benchmarks.
+ *
+ * Each test runs an allocation scenario while recording the duration of every
+ * nursery collection and major GC slice, then prints one machine-readable
+ * histogram line per pause kind:
+ *
+ *   GCBENCH {"scenario":"ropeChurn","pauses":"minor","samples":42,...}
+ *
+ * The workloads are deliberately small so the suite stays fast in automation;
+ * set JSAPI_GC_BENCH_SCALE to a multiplier to get stable distributions when
+ * measuring GC tuning changes on real hardware, e.g.
+ *
+ *   JSAPI_GC_BENCH_SCALE=20 jsapi-tests testGCBench
+ */
+
+#include "mozilla/TimeStamp.h"
+#include "mozilla/Vector.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "js/GCAPI.h"
+#include "js/SliceBudget.h"
+#include "jsapi-tests/tests.h"
+
+using mozilla::TimeDuration;
+using mozilla::TimeStamp;
+
+using PauseVector = mozilla::Vector<double, 0, js::SystemAllocPolicy>;
+
+static PauseVector gMinorPausesUs;
+static PauseVector gMajorSlicePausesUs;
+static TimeStamp gMinorStart;
+static TimeStamp gSliceStart;
+
+static void RecordNurseryPause(JSContext* cx, JS::GCNurseryProgress progress,
+                               JS::GCReason reason, void* data) {
+  if (progress == JS::GCNurseryProgress::GC_NURSERY_COLLECTION_START) {
+    gMinorStart = TimeStamp::Now();
+    return;
+  }
+  if (!gMinorStart.IsNull()) {
+    (void)gMinorPausesUs.append(
+        (TimeStamp::Now() - gMinorStart).ToMicroseconds());
+    gMinorStart = TimeStamp();
+  }
+}
+
+static void RecordSlicePause(JSContext* cx, JS::GCProgress progress,
+                             const JS::GCDescription& desc) {
+  if (progress == JS::GC_SLICE_BEGIN) {
+    gSliceStart = TimeStamp::Now();
+    return;
+  }
+  if (progress == JS::GC_SLICE_END && !gSliceStart.IsNull()) {
+    (void)gMajorSlicePausesUs.append(
+        (TimeStamp::Now() - gSliceStart).ToMicroseconds());
+    gSliceStart = TimeStamp();
+  }
+}
+
+// Installs the pause recorders and empties the sample vectors for a scenario.
+class MOZ_RAII AutoRecordGCPauses {
+  JSContext* cx_;
+  JS::GCSliceCallback prevSliceCallback_;
+
+ public:
+  explicit AutoRecordGCPauses(JSContext* cx) : cx_(cx) {
+    gMinorPausesUs.clear();
+    gMajorSlicePausesUs.clear();
+    gMinorStart = TimeStamp();
+    gSliceStart = TimeStamp();
+    prevSliceCallback_ = JS::SetGCSliceCallback(cx, RecordSlicePause);
+    MOZ_ALWAYS_TRUE(
+        JS::AddGCNurseryCollectionCallback(cx, RecordNurseryPause, nullptr));
+  }
+
+  ~AutoRecordGCPauses() {
+    JS::RemoveGCNurseryCollectionCallback(cx_, RecordNurseryPause, nullptr);
+    JS::SetGCSliceCallback(cx_, prevSliceCallback_);
+  }
+};
+
+static unsigned BenchScale() {
+  if (const char* env = getenv("JSAPI_GC_BENCH_SCALE")) {
+    long scale = atol(env);
+    if (scale > 0) {
+      return unsigned(scale);
+    }
+  }
+  return 1;
+}
+
+static double Percentile(const PauseVector& sorted, double p) {
+  MOZ_ASSERT(!sorted.empty());
+  size_t index = size_t(p * double(sorted.length() - 1));
+  return sorted[index];
+}
+
+static void ReportPauseHistogram(const char* scenario, const char* kind,
+                                 const PauseVector& samples) {
+  PauseVector sorted;
+  MOZ_ALWAYS_TRUE(sorted.appendAll(samples));
+  std::sort(sorted.begin(), sorted.end());
+
+  double total = 0;
+  for (double sample : sorted) {
+    total += sample;
+  }
+
+  if (sorted.empty()) {
+    printf("GCBENCH {\"scenario\":\"%s\",\"pauses\":\"%s\",\"samples\":0}\n",
+           scenario, kind);
+    return;
+  }
+
+  printf(
+      "GCBENCH {\"scenario\":\"%s\",\"pauses\":\"%s\",\"samples\":%zu,"
+      "\"min_us\":%.1f,\"p50_us\":%.1f,\"p90_us\":%.1f,\"p99_us\":%.1f,"
+      "\"max_us\":%.1f,\"total_ms\":%.3f}\n",
+      scenario, kind, sorted.length(), sorted[0], Percentile(sorted, 0.5),
+      Percentile(sorted, 0.9), Percentile(sorted, 0.99),
+      sorted[sorted.length() - 1], total / 1000.0);
+}
+
+static void ReportScenario(const char* scenario) {
+  ReportPauseHistogram(scenario, "minor", gMinorPausesUs);
+  ReportPauseHistogram(scenario, "major-slice", gMajorSlicePausesUs);
+}
+
+// Drives a full incremental GC with a fixed slice budget so the slice
+// histogram reflects incremental pauses rather than one monolithic collection.
+static void RunIncrementalGC(JSContext* cx) {
+  JS::PrepareForFullGC(cx);
+  JS::SliceBudget budget(JS::TimeBudget(5));
+  JS::StartIncrementalGC(cx, JS::GCOptions::Normal, JS::GCReason::API, budget);
+  while (JS::IsIncrementalGCInProgress(cx)) {
+    JS::PrepareForFullGC(cx);
+    JS::SliceBudget sliceBudget(JS::TimeBudget(5));
+    JS::IncrementalGCSlice(cx, JS::GCReason::API, sliceBudget);
+  }
+}
+
+BEGIN_TEST(testGCBenchRopeChurn) {
+  AutoLeaveZeal nozeal(cx);
+  AutoGCParameter enableIncremental(cx, JSGC_INCREMENTAL_GC_ENABLED, true);
+  AutoRecordGCPauses record(cx);
+
+  char script[512];
+  SprintfLiteral(script,
+                 "var keep = [];\n"
+                 "for (var i = 0; i < %u; i++) {\n"
+                 "  var s = 'rope';\n"
+                 "  for (var j = 0; j < 100; j++) {\n"
+                 "    s += 'abcdefghijklmnop' + j;\n"
+                 "  }\n"
+                 "  keep.push(s);\n"
+                 "  if (keep.length > 64) {\n"
+                 "    keep.shift();\n"
+                 "  }\n"
+                 "}\n",
+                 5000 * BenchScale());
+
+  JS::RootedValue unused(cx);
+  CHECK(evaluate(script, __FILE__, __LINE__, &unused));
+
+  RunIncrementalGC(cx);
+  CHECK(!gMajorSlicePausesUs.empty());
+
+  ReportScenario("ropeChurn");
+  return true;
+}
+END_TEST(testGCBenchRopeChurn)
+
+BEGIN_TEST(testGCBenchLargeTypedArrays) {
+  AutoLeaveZeal nozeal(cx);
+  AutoGCParameter enableIncremental(cx, JSGC_INCREMENTAL_GC_ENABLED, true);
+  AutoRecordGCPauses record(cx);
+
+  // Each Float64Array holds 2MB of data, with a rolling window of eight arrays
+  // live at any time, so this exercises large-allocation triggers and the
+  // malloc'd-buffer accounting rather than nursery churn.
+  char script[512];
+  SprintfLiteral(script,
+                 "var keep = [];\n"
+                 "for (var i = 0; i < %u; i++) {\n"
+                 "  keep.push(new Float64Array(256 * 1024));\n"
+                 "  if (keep.length > 8) {\n"
+                 "    keep.shift();\n"
+                 "  }\n"
+                 "}\n",
+                 64 * BenchScale());
+
+  JS::RootedValue unused(cx);
+  CHECK(evaluate(script, __FILE__, __LINE__, &unused));
+
+  RunIncrementalGC(cx);
+  CHECK(!gMajorSlicePausesUs.empty());
+
+  ReportScenario("largeTypedArrays");
+  return true;
+}
+END_TEST(testGCBenchLargeTypedArrays)
+
+BEGIN_TEST(testGCBenchManyZones) {
+  AutoLeaveZeal nozeal(cx);
+  AutoGCParameter enableIncremental(cx, JSGC_INCREMENTAL_GC_ENABLED, true);
+  AutoRecordGCPauses record(cx);
+
+  static const unsigned ZoneCount = 32;
+
+  JS::RootedValueVector globals(cx);
+  for (unsigned i = 0; i < ZoneCount; i++) {
+    JS::RealmOptions options;
+    options.creationOptions().setNewCompartmentAndZone();
+    JS::RootedObject zoneGlobal(
+        cx, JS_NewGlobalObject(cx, getGlobalClass(), nullptr,
+                               JS::FireOnNewGlobalHook, options));
+    CHECK(zoneGlobal);
+    CHECK(globals.append(JS::ObjectValue(*zoneGlobal)));
+
+    JSAutoRealm ar(cx, zoneGlobal);
+    char script[256];
+    SprintfLiteral(script,
+                   "var keep = [];\n"
+                   "for (var i = 0; i < %u; i++) {\n"
+                   "  keep.push({index: i, data: 'zone object ' + i});\n"
+                   "}\n",
+                   500 * BenchScale());
+    JS::RootedValue unused(cx);
+    CHECK(evaluate(script, __FILE__, __LINE__, &unused));
+  }
+
+  RunIncrementalGC(cx);
+  CHECK(!gMajorSlicePausesUs.empty());
+
+  ReportScenario("manyZones");
+  return true;
+}
+END_TEST(testGCBenchManyZones)
@@ -7,7 +7,8 @@
 #include <limits>
 #include <string.h>
 
-#include "js/Array.h"  // JS::IsArrayObject
+#include "js/AllocPolicy.h"  // js::SystemAllocPolicy
+#include "js/Array.h"        // JS::IsArrayObject
 #include "js/Exception.h"
 #include "js/friend/ErrorMessages.h"  // JSMSG_*
 #include "js/JSON.h"
@@ -110,3 +111,55 @@ static bool UnreachedCallback(const char16_t*, uint32_t, void*) {
 }
 
 END_TEST(testToJSON_different)
+
+using CharVector = js::Vector<char16_t, 0, js::SystemAllocPolicy>;
+
+struct ChunkAccumulator {
+  CharVector chars;
+  size_t calls = 0;
+};
+
+static bool AppendChunk(const char16_t* buffer, uint32_t length, void* data) {
+  ChunkAccumulator* acc = static_cast<ChunkAccumulator*>(data);
+  acc->calls++;
+  return acc->chars.append(buffer, length);
+}
+
+BEGIN_TEST(testToJSON_chunked) {
+  // Large enough that the output spans multiple chunks.
+  EXEC(
+      "var chunkInput = [];\n"
+      "for (var i = 0; i < 20000; i++) {\n"
+      "  chunkInput.push('value \"' + i + '\" \\\\ padding padding padding');\n"
+      "}\n");
+
+  JS::RootedValue input(cx);
+  EVAL("chunkInput", &input);
+
+  ChunkAccumulator chunked;
+  CHECK(JS::ToJSONChunked(cx, input, nullptr, JS::NullHandleValue, AppendChunk,
+                          &chunked));
+  CHECK(chunked.calls > 1);
+
+  ChunkAccumulator whole;
+  CHECK(JS::ToJSON(cx, input, nullptr, JS::NullHandleValue, AppendChunk,
+                   &whole));
+  CHECK_EQUAL(whole.calls, size_t(1));
+
+  CHECK_EQUAL(chunked.chars.length(), whole.chars.length());
+  CHECK(memcmp(chunked.chars.begin(), whole.chars.begin(),
+               whole.chars.length() * sizeof(char16_t)) == 0);
+
+  // A value JSON.stringify maps to undefined produces no chunks.
+  JS::Rooted<JS::Symbol*> symbol(cx, JS::NewSymbol(cx, nullptr));
+  JS::RootedValue symbolValue(cx, JS::SymbolValue(symbol));
+  CHECK(JS::ToJSONChunked(cx, symbolValue, nullptr, JS::NullHandleValue,
+                          UnreachedChunkCallback, nullptr));
+  return true;
+}
+
+static bool UnreachedChunkCallback(const char16_t*, uint32_t, void*) {
+  MOZ_CRASH("Should not call the callback");
+}
+
+END_TEST(testToJSON_chunked)
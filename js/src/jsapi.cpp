@@ -2465,6 +2465,7 @@ void JS::TransitiveCompileOptions::copyPODTransitiveOptions(
 
   borrowBuffer = rhs.borrowBuffer;
   usePinnedBytecode = rhs.usePinnedBytecode;
+  skipTranscodeChecksum = rhs.skipTranscodeChecksum;
 
   prefableOptions_ = rhs.prefableOptions_;
 
@@ -3736,6 +3737,21 @@ JS_PUBLIC_API bool JS::ToJSON(JSContext* cx, HandleValue value,
   return callback(sb.rawTwoByteBegin(), sb.length(), data);
 }
 
+JS_PUBLIC_API bool JS::ToJSONChunked(JSContext* cx, HandleValue value,
+                                     HandleObject replacer, HandleValue space,
+                                     JSONWriteCallback callback, void* data) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+  cx->check(replacer, space);
+  StringBuilder sb(cx);
+  if (!sb.ensureTwoByteChars()) {
+    return false;
+  }
+  RootedValue v(cx, value);
+  return Stringify(cx, &v, replacer, space, sb, StringifyBehavior::SlowOnly,
+                   callback, data);
+}
+
 JS_PUBLIC_API bool JS::ToJSONMaybeSafely(JSContext* cx, JS::HandleObject input,
                                          JSONWriteCallback callback,
                                          void* data) {
@@ -3803,9 +3819,10 @@ JS_PUBLIC_API bool JS_ParseJSONWithReviver(JSContext* cx, HandleString str,
   }
 
   return stableChars.isLatin1()
-             ? ParseJSONWithReviver(cx, stableChars.latin1Range(), reviver, vp)
-             : ParseJSONWithReviver(cx, stableChars.twoByteRange(), reviver,
-                                    vp);
+             ? ParseJSONWithReviver(cx, stableChars.latin1Range(), reviver, vp,
+                                    str)
+             : ParseJSONWithReviver(cx, stableChars.twoByteRange(), reviver, vp,
+                                    str);
 }
 
 /************************************************************************/
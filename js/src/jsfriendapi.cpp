@@ -524,6 +524,11 @@ JS_PUBLIC_API bool js::IsCompartmentZoneSweepingOrCompacting(
   return comp->zone()->isGCSweepingOrCompacting();
 }
 
+JS_PUBLIC_API bool js::WasCompartmentZoneCollected(JS::Compartment* comp) {
+  MOZ_ASSERT(comp);
+  return comp->zone()->wasCollected();
+}
+
 JS_PUBLIC_API void js::TraceGrayWrapperTargets(JSTracer* trc, Zone* zone) {
   JS::AutoSuppressGCAnalysis nogc;
 
@@ -286,6 +286,13 @@ extern JS_PUBLIC_API bool ZoneGlobalsAreAllGray(JS::Zone* zone);
 extern JS_PUBLIC_API bool IsCompartmentZoneSweepingOrCompacting(
     JS::Compartment* comp);
 
+/**
+ * Whether the compartment's zone was collected by the current GC. Only valid
+ * to call from a finalize callback, where zones still record whether the
+ * ending collection included them.
+ */
+extern JS_PUBLIC_API bool WasCompartmentZoneCollected(JS::Compartment* comp);
+
 using IterateGCThingCallback = void (*)(void*, JS::GCCellPtr,
                                         const JS::AutoRequireNoGC&);
 
@@ -1005,10 +1005,11 @@ const JSClass js::ProxyClass = PROXY_CLASS_DEF_WITH_CLASS_SPEC(
     JSCLASS_HAS_CACHED_PROTO(JSProto_Proxy) | JSCLASS_HAS_RESERVED_SLOTS(2),
     &ProxyClassSpec);
 
-JS_PUBLIC_API JSObject* js::NewProxyObject(JSContext* cx,
-                                           const BaseProxyHandler* handler,
-                                           HandleValue priv, JSObject* proto_,
-                                           const ProxyOptions& options) {
+static JSObject* NewProxyObjectInternal(JSContext* cx,
+                                        const BaseProxyHandler* handler,
+                                        HandleValue priv, JSObject* proto_,
+                                        const ProxyOptions& options,
+                                        gc::AllocSite* site) {
   AssertHeapIsIdle();
   CHECK_THREAD(cx);
 
@@ -1027,7 +1028,21 @@ JS_PUBLIC_API JSObject* js::NewProxyObject(JSContext* cx,
   }
 
   return ProxyObject::New(cx, handler, priv, TaggedProto(proto_),
-                          options.clasp());
+                          options.clasp(), site);
+}
+
+JS_PUBLIC_API JSObject* js::NewProxyObject(JSContext* cx,
+                                           const BaseProxyHandler* handler,
+                                           HandleValue priv, JSObject* proto_,
+                                           const ProxyOptions& options) {
+  return NewProxyObjectInternal(cx, handler, priv, proto_, options, nullptr);
+}
+
+JS_PUBLIC_API JSObject* js::NewProxyObjectWithUseAllocSite(
+    JSContext* cx, const BaseProxyHandler* handler, HandleValue priv,
+    JSObject* proto_, const ProxyOptions& options) {
+  return NewProxyObjectInternal(cx, handler, priv, proto_, options,
+                                cx->realm()->localAllocSite);
 }
 
 void ProxyObject::renew(const BaseProxyHandler* handler, const Value& priv) {
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -96,13 +97,43 @@ template <typename Char1, typename Char2>
 inline int32_t CompareChars(const Char1* s1, size_t len1, const Char2* s2,
                             size_t len2) {
   size_t n = std::min(len1, len2);
-  for (size_t i = 0; i < n; i++) {
-    if (int32_t cmp = s1[i] - s2[i]) {
+
+  if constexpr (std::is_same_v<Char1, Char2> && sizeof(Char1) == 1 &&
+                std::is_unsigned_v<Char1>) {
+    // Latin-1 code units order like unsigned bytes, so the sign of memcmp is
+    // the sign of the first differing code unit and compilers emit wide
+    // comparisons instead of a byte loop.
+    if (int32_t cmp = memcmp(s1, s2, n)) {
       return cmp;
     }
+    return int32_t(len1 - len2);
+  } else if constexpr (std::is_same_v<Char1, Char2>) {
+    // memcmp's byte order doesn't match two-byte code unit order on
+    // little-endian platforms, but it can still locate the first mismatching
+    // block: skip ahead block by block and only scan the block containing the
+    // first difference a code unit at a time.
+    constexpr size_t BlockChars = 16;
+    size_t i = 0;
+    while (n - i >= BlockChars) {
+      if (memcmp(s1 + i, s2 + i, BlockChars * sizeof(Char1)) != 0) {
+        break;
+      }
+      i += BlockChars;
+    }
+    for (; i < n; i++) {
+      if (int32_t cmp = s1[i] - s2[i]) {
+        return cmp;
+      }
+    }
+    return int32_t(len1 - len2);
+  } else {
+    for (size_t i = 0; i < n; i++) {
+      if (int32_t cmp = s1[i] - s2[i]) {
+        return cmp;
+      }
+    }
+    return int32_t(len1 - len2);
   }
-
-  return int32_t(len1 - len2);
 }
 
 // Return s advanced past any Unicode white space characters.
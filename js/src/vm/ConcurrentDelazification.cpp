@@ -22,6 +22,7 @@
 #include "frontend/Stencil.h"  // TaggedScriptThingIndex, ScriptStencilExtra
 #include "js/AllocPolicy.h"    // ReportOutOfMemory
 #include "js/experimental/JSStencil.h"  // RefPtrTraits<JS::Stencil>
+#include "vm/HelperThreads.h"           // HasQueuedJitCompileTasks
 #include "vm/JSContext.h"               // JSContext
 
 using namespace js;
@@ -220,6 +221,15 @@ bool DelazificationContext::delazify() {
       isInterrupted_ = false;
       break;
     }
+
+    // Eager delazification is speculative work: if a JIT compilation task is
+    // waiting for a thread, yield at this function boundary. The DelazifyTask
+    // re-adds itself to the worklist when it is not done, so the remaining
+    // functions are delazified once the helper threads are idle again.
+    if (HasQueuedJitCompileTasks()) {
+      break;
+    }
+
     const CompilationStencil* innerStencil;
     ScriptIndex scriptIndex = strategy_->next();
     {
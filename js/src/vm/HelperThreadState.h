@@ -15,6 +15,7 @@
 
 #include "mozilla/AlreadyAddRefed.h"  // already_AddRefed
 #include "mozilla/Assertions.h"       // MOZ_ASSERT, MOZ_CRASH
+#include "mozilla/Atomics.h"          // mozilla::Atomic
 #include "mozilla/Attributes.h"       // MOZ_RAII
 #include "mozilla/EnumeratedArray.h"  // mozilla::EnumeratedArray
 #include "mozilla/LinkedList.h"  // mozilla::LinkedList, mozilla::LinkedListElement
@@ -136,6 +137,16 @@ class GlobalHelperThreadState {
       runningTaskCount;
   size_t totalCountRunningTasks;
 
+  // Embedder-imposed caps on the number of threads that may run each class of
+  // task concurrently, applied on top of the defaults computed from the core
+  // count. Zero means no cap is set. Written at any time via
+  // JS::SetHelperThreadTaskLimit, so stored as atomics and read without
+  // locking.
+  mozilla::EnumeratedArray<JS::HelperThreadTaskClass,
+                           mozilla::Atomic<size_t, mozilla::Relaxed>,
+                           size_t(JS::HelperThreadTaskClass::Count)>
+      taskClassLimits;
+
   WriteOnceData<JS::RegisterThreadCallback> registerThread;
   WriteOnceData<JS::UnregisterThreadCallback> unregisterThread;
 
@@ -234,6 +245,10 @@ class GlobalHelperThreadState {
   size_t maxCompressionThreads() const;
   size_t maxGCParallelThreads() const;
 
+  // Apply any embedder-set cap for |taskClass| to the default |maxThreads|.
+  size_t clampTaskClassLimit(JS::HelperThreadTaskClass taskClass,
+                             size_t maxThreads) const;
+
   GlobalHelperThreadState();
 
   bool isInitialized(const AutoLockHelperThreadState& lock) const {
@@ -8,7 +8,8 @@
 
 #include "mozilla/ReverseIterator.h"  // mozilla::Reversed(...)
 #include "mozilla/ScopeExit.h"
-#include "mozilla/Span.h"  // mozilla::Span<TaggedScriptThingIndex>
+#include "mozilla/Span.h"       // mozilla::Span<TaggedScriptThingIndex>
+#include "mozilla/TimeStamp.h"  // mozilla::TimeStamp
 
 #include <algorithm>
 
@@ -143,6 +144,12 @@ JS_PUBLIC_API MOZ_NEVER_INLINE const char* JS::GetHelperThreadTaskName(
   return task->getName();
 }
 
+JS_PUBLIC_API void JS::SetHelperThreadTaskLimit(HelperThreadTaskClass taskClass,
+                                                size_t limit) {
+  MOZ_ASSERT(taskClass < HelperThreadTaskClass::Count);
+  HelperThreadState().taskClassLimits[taskClass] = limit;
+}
+
 void GlobalHelperThreadState::setDispatchTaskCallback(
     JS::HelperThreadTaskCallback callback, size_t threadCount, size_t stackSize,
     const AutoLockHelperThreadState& lock) {
@@ -221,6 +228,10 @@ GlobalHelperThreadState::GlobalHelperThreadState()
   cpuCount = ClampDefaultCPUCount(GetCPUCount());
   threadCount = ThreadCountForCPUCount(cpuCount);
 
+  for (auto& limit : taskClassLimits) {
+    limit = 0;
+  }
+
   MOZ_ASSERT(cpuCount > 0, "GetCPUCount() seems broken");
 }
 
@@ -441,18 +452,29 @@ void GlobalHelperThreadState::addSizeOfIncludingThis(
   htStats.idleThreadCount = threadCount - totalCountRunningTasks;
 }
 
+size_t GlobalHelperThreadState::clampTaskClassLimit(
+    JS::HelperThreadTaskClass taskClass, size_t maxThreads) const {
+  size_t limit = taskClassLimits[taskClass];
+  if (limit != 0 && limit < maxThreads) {
+    return limit;
+  }
+  return maxThreads;
+}
+
 size_t GlobalHelperThreadState::maxBaselineCompilationThreads() const {
   if (IsHelperThreadSimulatingOOM(js::THREAD_TYPE_BASELINE)) {
     return 1;
   }
-  return threadCount;
+  return clampTaskClassLimit(JS::HelperThreadTaskClass::BaselineCompilation,
+                             threadCount);
 }
 
 size_t GlobalHelperThreadState::maxIonCompilationThreads() const {
   if (IsHelperThreadSimulatingOOM(js::THREAD_TYPE_ION)) {
     return 1;
   }
-  return threadCount;
+  return clampTaskClassLimit(JS::HelperThreadTaskClass::IonCompilation,
+                             threadCount);
 }
 
 size_t GlobalHelperThreadState::maxIonFreeThreads() const {
@@ -465,14 +487,16 @@ size_t GlobalHelperThreadState::maxPromiseHelperThreads() const {
   if (IsHelperThreadSimulatingOOM(js::THREAD_TYPE_PROMISE_TASK)) {
     return 1;
   }
-  return std::min(cpuCount, threadCount);
+  return clampTaskClassLimit(JS::HelperThreadTaskClass::PromiseTasks,
+                             std::min(cpuCount, threadCount));
 }
 
 size_t GlobalHelperThreadState::maxDelazifyThreads() const {
   if (IsHelperThreadSimulatingOOM(js::THREAD_TYPE_DELAZIFY)) {
     return 1;
   }
-  return std::min(cpuCount, threadCount);
+  return clampTaskClassLimit(JS::HelperThreadTaskClass::Delazification,
+                             std::min(cpuCount, threadCount));
 }
 
 size_t GlobalHelperThreadState::maxCompressionThreads() const {
@@ -489,7 +513,8 @@ size_t GlobalHelperThreadState::maxGCParallelThreads() const {
   if (IsHelperThreadSimulatingOOM(js::THREAD_TYPE_GCPARALLEL)) {
     return 1;
   }
-  return threadCount;
+  return clampTaskClassLimit(JS::HelperThreadTaskClass::GCParallelWork,
+                             threadCount);
 }
 
 size_t GlobalHelperThreadState::maxWasmCompilationThreads() const {
@@ -497,7 +522,8 @@ size_t GlobalHelperThreadState::maxWasmCompilationThreads() const {
       IsHelperThreadSimulatingOOM(js::THREAD_TYPE_WASM_COMPILE_TIER2)) {
     return 1;
   }
-  return std::min(cpuCount, threadCount);
+  return clampTaskClassLimit(JS::HelperThreadTaskClass::WasmCompilation,
+                             std::min(cpuCount, threadCount));
 }
 
 size_t js::GetMaxWasmCompilationThreads() {
@@ -719,6 +745,13 @@ static bool IonCompileTaskHasHigherPriority(jit::IonCompileTask* first,
   // This method can return whatever it wants, though it really ought to be a
   // total order. The ordering is allowed to race (change on the fly), however.
 
+  // Compiles whose main thread is currently executing JS come first: those
+  // are the scripts the user may be actively waiting on, while the rest can
+  // tier up whenever a thread is free.
+  if (first->isMainThreadRunningJS() != second->isMainThreadRunningJS()) {
+    return first->isMainThreadRunningJS();
+  }
+
   // A higher warm-up counter indicates a higher priority.
   jit::JitScript* firstJitScript = first->script()->jitScript();
   jit::JitScript* secondJitScript = second->script()->jitScript();
@@ -776,6 +809,7 @@ bool GlobalHelperThreadState::submitTask(
     jit::IonCompileTask* task, const AutoLockHelperThreadState& locked) {
   MOZ_ASSERT(isInitialized(locked));
 
+  task->setEnqueueTime(mozilla::TimeStamp::Now());
   if (!ionWorklist(locked).append(task)) {
     return false;
   }
@@ -1249,6 +1283,20 @@ void GlobalHelperThreadState::submitTask(
   dispatch(locked);
 }
 
+bool js::HasQueuedJitCompileTasks() {
+  AutoLockHelperThreadState lock;
+
+  if (!HelperThreadState().isInitialized(lock)) {
+    return false;
+  }
+
+  // Use the canStart predicates rather than raw worklist emptiness: if the
+  // compilation threads for a task type are already saturated, freeing up a
+  // thread wouldn't let the queued task run any sooner.
+  return HelperThreadState().canStartIonCompileTask(lock) ||
+         HelperThreadState().canStartBaselineCompileTask(lock);
+}
+
 void js::StartOffThreadDelazification(
     JSContext* maybeCx, const JS::ReadOnlyCompileOptions& options,
     frontend::InitialStencilAndDelazifications* stencils) {
@@ -2041,7 +2089,7 @@ bool GlobalHelperThreadState::canStartWasmCompile(
     if (completeTier2oversubscribed) {
       threads = maxWasmCompilationThreads();
     } else {
-      threads = physCoresAvailable;
+      threads = std::min(physCoresAvailable, maxWasmCompilationThreads());
     }
     threadType = THREAD_TYPE_WASM_COMPILE_TIER2;
   } else {
@@ -298,6 +298,11 @@ void StartOffThreadDelazification(
     JSContext* maybeCx, const JS::ReadOnlyCompileOptions& options,
     frontend::InitialStencilAndDelazifications* stencils);
 
+// Return whether any JIT compilation task is waiting for a helper thread.
+// Long-running background tasks use this to yield at a convenient boundary
+// rather than delay compiles the main thread may be waiting on.
+bool HasQueuedJitCompileTasks();
+
 // Drain the task queues and wait for all helper threads to finish running.
 //
 // Note that helper threads are shared between runtimes and it's possible that
@@ -85,21 +85,6 @@ using namespace js;
 using mozilla::DebugOnly;
 using mozilla::NumberEqualsInt32;
 
-template <bool Eq>
-static MOZ_ALWAYS_INLINE bool LooseEqualityOp(JSContext* cx,
-                                              InterpreterRegs& regs) {
-  HandleValue rval = regs.stackHandleAt(-1);
-  HandleValue lval = regs.stackHandleAt(-2);
-  bool cond;
-  if (!LooselyEqual(cx, lval, rval, &cond)) {
-    return false;
-  }
-  cond = (cond == Eq);
-  regs.sp--;
-  regs.sp[-1].setBoolean(cond);
-  return true;
-}
-
 JSObject* js::BoxNonStrictThis(JSContext* cx, HandleValue thisv) {
   MOZ_ASSERT(!thisv.isMagic());
 
@@ -2341,6 +2326,7 @@ bool MOZ_NEVER_INLINE JS_HAZ_JSNATIVE_CALLER js::Interpret(JSContext* cx,
         goto error;
       }
 
+      TRY_BRANCH_AFTER_COND(found, 2);
       REGS.sp--;
       REGS.sp[-1].setBoolean(found);
     }
@@ -2553,16 +2539,29 @@ bool MOZ_NEVER_INLINE JS_HAZ_JSNATIVE_CALLER js::Interpret(JSContext* cx,
     END_CASE(BitAnd)
 
     CASE(Eq) {
-      if (!LooseEqualityOp<true>(cx, REGS)) {
+      bool cond;
+      HandleValue lval = REGS.stackHandleAt(-2);
+      HandleValue rval = REGS.stackHandleAt(-1);
+      if (!LooselyEqual(cx, lval, rval, &cond)) {
         goto error;
       }
+      TRY_BRANCH_AFTER_COND(cond, 2);
+      REGS.sp[-2].setBoolean(cond);
+      REGS.sp--;
     }
     END_CASE(Eq)
 
     CASE(Ne) {
-      if (!LooseEqualityOp<false>(cx, REGS)) {
+      bool cond;
+      HandleValue lval = REGS.stackHandleAt(-2);
+      HandleValue rval = REGS.stackHandleAt(-1);
+      if (!LooselyEqual(cx, lval, rval, &cond)) {
         goto error;
       }
+      cond = !cond;
+      TRY_BRANCH_AFTER_COND(cond, 2);
+      REGS.sp[-2].setBoolean(cond);
+      REGS.sp--;
     }
     END_CASE(Ne)
 
@@ -2581,6 +2580,7 @@ bool MOZ_NEVER_INLINE JS_HAZ_JSNATIVE_CALLER js::Interpret(JSContext* cx,
     CASE(StrictEq) {
       bool cond;
       STRICT_EQUALITY_OP(==, cond);
+      TRY_BRANCH_AFTER_COND(cond, 1);
       REGS.sp[-1].setBoolean(cond);
     }
     END_CASE(StrictEq)
@@ -2588,6 +2588,7 @@ bool MOZ_NEVER_INLINE JS_HAZ_JSNATIVE_CALLER js::Interpret(JSContext* cx,
     CASE(StrictNe) {
       bool cond;
       STRICT_EQUALITY_OP(!=, cond);
+      TRY_BRANCH_AFTER_COND(cond, 1);
       REGS.sp[-1].setBoolean(cond);
     }
     END_CASE(StrictNe)
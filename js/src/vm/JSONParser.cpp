@@ -14,8 +14,10 @@
 #include "mozilla/Sprintf.h"    // SprintfLiteral
 #include "mozilla/TextUtils.h"  // mozilla::AsciiAlphanumericToNumber, mozilla::IsAsciiDigit, mozilla::IsAsciiHexDigit
 
+#include <limits.h>  // CHAR_BIT
 #include <stddef.h>  // size_t
-#include <stdint.h>  // uint32_t
+#include <stdint.h>  // uint32_t, uintptr_t
+#include <string.h>  // memcpy
 #include <utility>   // std::move
 
 #include "jsnum.h"  // ParseDecimalNumber, GetFullInteger, FullStringToDouble
@@ -349,6 +351,69 @@ JSONToken JSONTokenizer<CharT, ParserT>::numberToken(double d) {
   return JSONToken::Number;
 }
 
+// Broadcast a character value to every lane of a machine word.
+template <typename CharT>
+static constexpr uintptr_t BroadcastChar(CharT c) {
+  uintptr_t word = 0;
+  for (size_t i = 0; i < sizeof(uintptr_t) / sizeof(CharT); i++) {
+    word = (word << (CHAR_BIT * sizeof(CharT))) | uintptr_t(c);
+  }
+  return word;
+}
+
+/*
+ * Return the number of leading characters in |chars| that can appear verbatim
+ * in a JSON string, i.e. everything up to the first '"' (ending the string),
+ * '\\' (starting an escape sequence) or control character (a syntax error).
+ *
+ * This is the hottest loop when parsing large JSON input, which is dominated
+ * by long runs of unexceptional string characters.  Rather than a separate
+ * simdjson-style structural indexing pass, which would not fit the
+ * incremental tokenizer, skip over plain characters a machine word at a time
+ * using SWAR bit tricks; the exact position of the first special character is
+ * then found by the scalar tail loop.
+ */
+template <typename CharT>
+static size_t SkipPlainStringChars(const CharT* chars, size_t length) {
+  static_assert(sizeof(CharT) == 1 || sizeof(CharT) == 2,
+                "SWAR masks below assume 8 or 16 bit characters");
+
+  constexpr size_t CharsPerWord = sizeof(uintptr_t) / sizeof(CharT);
+
+  constexpr uintptr_t quotes = BroadcastChar(CharT('"'));
+  constexpr uintptr_t backslashes = BroadcastChar(CharT('\\'));
+  constexpr uintptr_t spaces = BroadcastChar(CharT(0x0020));
+  constexpr uintptr_t ones = BroadcastChar(CharT(1));
+  constexpr uintptr_t highBits =
+      BroadcastChar(CharT(CharT(1) << (CHAR_BIT * sizeof(CharT) - 1)));
+
+  size_t i = 0;
+  for (; length - i >= CharsPerWord; i += CharsPerWord) {
+    uintptr_t word;
+    memcpy(&word, chars + i, sizeof(word));
+
+    // A lane's high bit is set in |special| if the lane equals '"' or '\\'
+    // (zero-lane test on the XOR) or is less than 0x20 (unsigned comparison
+    // bit trick; lanes with their high bit already set are correctly rejected
+    // by the ~word term).
+    uintptr_t special = ((word ^ quotes) - ones) & ~(word ^ quotes);
+    special |= ((word ^ backslashes) - ones) & ~(word ^ backslashes);
+    special |= (word - spaces) & ~word;
+    if (special & highBits) {
+      break;
+    }
+  }
+
+  for (; i < length; i++) {
+    CharT c = chars[i];
+    if (c == '"' || c == '\\' || c <= 0x001F) {
+      break;
+    }
+  }
+
+  return i;
+}
+
 template <typename CharT, typename ParserT>
 template <JSONStringType ST>
 JSONToken JSONTokenizer<CharT, ParserT>::readString() {
@@ -370,18 +435,16 @@ JSONToken JSONTokenizer<CharT, ParserT>::readString() {
    * string directly from the source text.
    */
   CharPtr start = current;
-  for (; current < end; current++) {
+  current += SkipPlainStringChars(current.get(), size_t(end - current));
+  if (current < end) {
     if (*current == '"') {
       size_t length = current - start;
       current++;
       return stringToken<ST>(start, length);
     }
 
-    if (*current == '\\') {
-      break;
-    }
-
-    if (*current <= 0x001F) {
+    if (*current != '\\') {
+      MOZ_ASSERT(*current <= 0x001F);
       error("bad control character in string literal");
       return token(JSONToken::Error);
     }
@@ -481,11 +544,7 @@ JSONToken JSONTokenizer<CharT, ParserT>::readString() {
     }
 
     start = current;
-    for (; current < end; current++) {
-      if (*current == '"' || *current == '\\' || *current <= 0x001F) {
-        break;
-      }
-    }
+    current += SkipPlainStringChars(current.get(), size_t(end - current));
   } while (current < end);
 
   error("unterminated string");
@@ -626,6 +685,7 @@ JSONFullParseHandlerAnyChar::JSONFullParseHandlerAnyChar(
     : cx(other.cx),
       v(other.v),
       parseType(other.parseType),
+      sourceString(other.sourceString),
       gcHeap(cx, 1),
       freeElements(std::move(other.freeElements)),
       freeProperties(std::move(other.freeProperties)) {}
@@ -774,6 +834,10 @@ inline void JSONFullParseHandlerAnyChar::freeStackEntry(StackEntry& entry) {
 
 void JSONFullParseHandlerAnyChar::trace(JSTracer* trc) {
   JS::TraceRoot(trc, &v, "JSONFullParseHandlerAnyChar current value");
+  if (sourceString) {
+    JS::TraceRoot(trc, &sourceString,
+                  "JSONFullParseHandlerAnyChar source string");
+  }
 }
 
 template <typename CharT>
@@ -787,6 +851,12 @@ bool JSONFullParseHandler<CharT>::JSONStringBuilder::append(const CharT* begin,
   return buffer.append(begin, end);
 }
 
+// The minimum length of an escape-free string value to create as a dependent
+// string sharing the source's characters. Short strings are cheap to copy
+// (and may be inlined anyway), and copying them avoids keeping a large source
+// string alive just for a handful of small substrings.
+static constexpr size_t MinDependentSourceLength = 64;
+
 template <typename CharT>
 template <JSONStringType ST>
 inline bool JSONFullParseHandler<CharT>::setStringValue(
@@ -794,6 +864,12 @@ inline bool JSONFullParseHandler<CharT>::setStringValue(
   JSString* str;
   if constexpr (ST == JSONStringType::PropertyName) {
     str = AtomizeChars(cx, start.get(), length);
+  } else if (sourceString && length >= MinDependentSourceLength) {
+    // Defer materializing the characters of long escape-free strings: share
+    // the source string's buffer instead of copying out of it.
+    size_t offset = size_t(start.get() - sourceBegin);
+    MOZ_ASSERT(offset + length <= sourceString->length());
+    str = NewDependentString(cx, sourceString, offset, length, gcHeap);
   } else {
     str = NewStringCopyN<CanGC>(cx, start.get(), length, gcHeap);
   }
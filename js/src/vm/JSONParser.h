@@ -216,6 +216,13 @@ class MOZ_STACK_CLASS JSONFullParseHandlerAnyChar {
 
   ParseType parseType = ParseType::JSONParse;
 
+  // When non-null, the string whose characters are being parsed. Long
+  // escape-free string values are then created as dependent strings sharing
+  // this string's characters instead of as copies. Only set when the
+  // characters passed to the tokenizer belong to this string and are stable
+  // for the duration of the parse.
+  JSString* sourceString = nullptr;
+
   AutoSelectGCHeap gcHeap;
 
  private:
@@ -308,14 +315,23 @@ class MOZ_STACK_CLASS JSONFullParseHandler
     bool append(const CharT* begin, const CharT* end);
   };
 
+  // The start of the source characters, used to turn a token's character
+  // pointer back into an offset into |sourceString|.
+  const CharT* sourceBegin = nullptr;
+
   explicit JSONFullParseHandler(JSContext* cx) : Base(cx) {}
 
   JSONFullParseHandler(JSONFullParseHandler&& other) noexcept
-      : Base(std::move(other)) {}
+      : Base(std::move(other)), sourceBegin(other.sourceBegin) {}
 
   JSONFullParseHandler(const JSONFullParseHandler& other) = delete;
   void operator=(const JSONFullParseHandler& other) = delete;
 
+  void setSource(JSString* source, const CharT* begin) {
+    this->sourceString = source;
+    sourceBegin = begin;
+  }
+
   template <JSONStringType ST>
   inline bool setStringValue(CharPtr start, size_t length,
                              mozilla::Span<const CharT>&& source);
@@ -571,11 +587,17 @@ class MOZ_STACK_CLASS JSONParser
 
   /* Public API */
 
-  /* Create a parser for the provided JSON data. */
+  /*
+   * Create a parser for the provided JSON data. If |sourceString| is given it
+   * must be the string the data belongs to, with characters stable for the
+   * lifetime of the parser; long string values are then created as dependent
+   * strings sharing its characters rather than as copies.
+   */
   JSONParser(JSContext* cx, mozilla::Range<const CharT> data,
-             ParseType parseType)
+             ParseType parseType, JSString* sourceString = nullptr)
       : Base(cx, data) {
     this->handler.parseType = parseType;
+    this->handler.setSource(sourceString, data.begin().get());
   }
 
   /* Allow move construction for use with Rooted. */
@@ -621,9 +643,13 @@ class MOZ_STACK_CLASS JSONReviveParser
 
   /* Public API */
 
-  /* Create a parser for the provided JSON data. */
-  JSONReviveParser(JSContext* cx, mozilla::Range<const CharT> data)
-      : Base(cx, data) {}
+  /* Create a parser for the provided JSON data. |sourceString| is as for
+   * JSONParser. */
+  JSONReviveParser(JSContext* cx, mozilla::Range<const CharT> data,
+                   JSString* sourceString = nullptr)
+      : Base(cx, data) {
+    this->handler.setSource(sourceString, data.begin().get());
+  }
 
   /* Allow move construction for use with Rooted. */
   JSONReviveParser(JSONReviveParser&& other) noexcept
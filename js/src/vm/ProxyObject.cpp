@@ -74,7 +74,7 @@ void ProxyObject::init(const BaseProxyHandler* handler, HandleValue priv,
 /* static */
 ProxyObject* ProxyObject::New(JSContext* cx, const BaseProxyHandler* handler,
                               HandleValue priv, TaggedProto proto_,
-                              const JSClass* clasp) {
+                              const JSClass* clasp, gc::AllocSite* site) {
   Rooted<TaggedProto> proto(cx, proto_);
 
   MOZ_ASSERT(!clasp->isNativeObject());
@@ -84,6 +84,7 @@ ProxyObject* ProxyObject::New(JSContext* cx, const BaseProxyHandler* handler,
   MOZ_ASSERT_IF(proto.isObject(),
                 cx->compartment() == proto.toObject()->compartment());
   MOZ_ASSERT(clasp->hasFinalize());
+  MOZ_ASSERT_IF(site, site->zone() == cx->zone());
 
 #ifdef DEBUG
   if (priv.isGCThing()) {
@@ -112,18 +113,22 @@ ProxyObject* ProxyObject::New(JSContext* cx, const BaseProxyHandler* handler,
   MOZ_ASSERT(!IsAboutToBeFinalizedUnbarriered(shape.get()));
 
   // Ensure that the wrapper has the same lifetime assumptions as the
-  // wrappee. Prefer to allocate in the nursery, when possible.
+  // wrappee. Prefer to allocate in the nursery, when possible, letting the
+  // allocation site's pretenuring state pick the heap if the caller supplied
+  // one.
   gc::Heap heap;
   if ((priv.isGCThing() && priv.toGCThing()->isTenured()) ||
       !handler->canNurseryAllocate()) {
     heap = gc::Heap::Tenured;
+  } else if (site) {
+    heap = site->initialHeap();
   } else {
     heap = gc::Heap::Default;
   }
 
   debugCheckNewObject(shape, allocKind, heap);
 
-  ProxyObject* proxy = cx->newCell<ProxyObject>(allocKind, heap, clasp);
+  ProxyObject* proxy = cx->newCell<ProxyObject>(allocKind, heap, clasp, site);
   if (!proxy) {
     return nullptr;
   }
@@ -13,6 +13,10 @@
 
 namespace js {
 
+namespace gc {
+class AllocSite;
+}  // namespace gc
+
 /**
  * This is the base class for the various kinds of proxy objects.  It's never
  * instantiated.
@@ -41,7 +45,8 @@ class ProxyObject : public JSObject {
  public:
   static ProxyObject* New(JSContext* cx, const BaseProxyHandler* handler,
                           HandleValue priv, TaggedProto proto_,
-                          const JSClass* clasp);
+                          const JSClass* clasp,
+                          gc::AllocSite* site = nullptr);
 
   void init(const BaseProxyHandler* handler, HandleValue priv, JSContext* cx);
 
@@ -9,6 +9,7 @@
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/PodOperations.h"
 
+#include <algorithm>
 #include <type_traits>
 
 #include "builtin/RegExp.h"
@@ -25,6 +26,7 @@
 #include "js/RegExpFlags.h"  // JS::RegExpFlags
 #include "util/StringBuilder.h"
 #include "util/Unicode.h"
+#include "vm/JSAtomUtils.h"  // js::AtomizeChars
 #include "vm/JSONPrinter.h"  // js::JSONPrinter
 #include "vm/MatchPairs.h"
 #include "vm/PlainObject.h"
@@ -646,6 +648,37 @@ bool js::StringHasRegExpMetaChars(const JSLinearString* str) {
   return HasRegExpMetaChars(str->twoByteChars(nogc), str->length());
 }
 
+// Return the length of the longest leading run of pattern characters that
+// every match of the pattern must begin with, or 0 if there is none. Escapes
+// and all other syntax characters conservatively terminate the literal.
+template <typename CharT>
+static size_t MandatoryLiteralPrefixLength(const CharT* chars, size_t length) {
+  size_t prefixLen = 0;
+  while (prefixLen < length && !IsRegExpMetaChar(chars[prefixLen])) {
+    prefixLen++;
+  }
+
+  // An alternation anywhere in the rest of the pattern may provide a way to
+  // match without the prefix, e.g. /ab|c/. Rejecting '|' even inside groups
+  // and character classes is conservative.
+  for (size_t i = prefixLen; i < length; i++) {
+    if (chars[i] == '|') {
+      return 0;
+    }
+  }
+
+  // A quantifier can make the final literal character optional, e.g. the
+  // second 'o' in /foo*bar/, so exclude it. ('+' repetitions keep the
+  // character mandatory, but excluding it is always safe.)
+  if (prefixLen > 0 && prefixLen < length &&
+      (chars[prefixLen] == '*' || chars[prefixLen] == '?' ||
+       chars[prefixLen] == '{' || chars[prefixLen] == '+')) {
+    prefixLen--;
+  }
+
+  return prefixLen;
+}
+
 /* RegExpShared */
 
 RegExpShared::RegExpShared(JSAtom* source, RegExpFlags flags)
@@ -659,6 +692,7 @@ void RegExpShared::traceChildren(JSTracer* trc) {
     for (auto& comp : compilationArray) {
       TraceNullableEdge(trc, &comp.jitCode, "RegExpShared code");
     }
+    TraceNullableEdge(trc, &literalPrefix_, "RegExpShared literal prefix");
     TraceNullableEdge(trc, &groupsTemplate_, "RegExpShared groups template");
   }
 }
@@ -726,6 +760,64 @@ bool RegExpShared::compileIfNecessary(JSContext* cx,
   return true;
 }
 
+// Longer prefixes make the skip-ahead search itself more expensive without
+// filtering out many more candidate positions.
+static constexpr size_t MaxLiteralPrefixLength = 32;
+
+/* static */
+JSAtom* RegExpShared::maybeLiteralPrefix(JSContext* cx,
+                                         MutableHandleRegExpShared re) {
+  if (re->literalPrefixComputed_) {
+    return re->literalPrefix_;
+  }
+  re->literalPrefixComputed_ = true;
+
+  // Case-insensitive matching defeats an exact literal search, and sticky
+  // patterns must match at the start position, so there is nothing to skip.
+  if (re->ignoreCase() || re->sticky()) {
+    return nullptr;
+  }
+
+  JSAtom* source = re->getSource();
+  bool latin1 = source->hasLatin1Chars();
+  size_t prefixLen;
+  {
+    AutoCheckCannotGC nogc;
+    prefixLen = latin1 ? MandatoryLiteralPrefixLength(source->latin1Chars(nogc),
+                                                      source->length())
+                       : MandatoryLiteralPrefixLength(
+                             source->twoByteChars(nogc), source->length());
+  }
+  prefixLen = std::min(prefixLen, MaxLiteralPrefixLength);
+  if (prefixLen == 0) {
+    return nullptr;
+  }
+
+  JSAtom* prefix;
+  if (latin1) {
+    Latin1Char buf[MaxLiteralPrefixLength];
+    {
+      AutoCheckCannotGC nogc;
+      mozilla::PodCopy(buf, source->latin1Chars(nogc), prefixLen);
+    }
+    prefix = AtomizeChars(cx, buf, prefixLen);
+  } else {
+    char16_t buf[MaxLiteralPrefixLength];
+    {
+      AutoCheckCannotGC nogc;
+      mozilla::PodCopy(buf, source->twoByteChars(nogc), prefixLen);
+    }
+    prefix = AtomizeChars(cx, buf, prefixLen);
+  }
+  if (!prefix) {
+    cx->recoverFromOutOfMemory();
+    return nullptr;
+  }
+
+  re->literalPrefix_ = prefix;
+  return prefix;
+}
+
 /* static */
 RegExpRunStatus RegExpShared::execute(JSContext* cx,
                                       MutableHandleRegExpShared re,
@@ -753,6 +845,24 @@ RegExpRunStatus RegExpShared::execute(JSContext* cx,
     return RegExpShared::executeAtom(re, input, start, matches);
   }
 
+  /*
+   * If every match must begin with a literal prefix, skip ahead to its first
+   * occurrence with a (vectorized) substring search instead of letting the
+   * engine try every position. Long inputs that don't contain the prefix are
+   * rejected without entering the engine at all.
+   */
+  if (JSAtom* prefix = maybeLiteralPrefix(cx, re)) {
+    MOZ_ASSERT(!re->sticky());
+    if (start + prefix->length() > input->length()) {
+      return RegExpRunStatus::Success_NotFound;
+    }
+    int matchStart = StringFindPattern(input, prefix, start);
+    if (matchStart < 0) {
+      return RegExpRunStatus::Success_NotFound;
+    }
+    start = size_t(matchStart);
+  }
+
   /*
    * Ensure sufficient memory for output vector.
    * No need to initialize it. The RegExp engine fills them in on a match.
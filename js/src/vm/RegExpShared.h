@@ -121,6 +121,12 @@ class RegExpShared
   uint32_t maxRegisters_ = 0;
   uint32_t ticks_ = 0;
 
+  // Literal characters every match of this pattern must begin with, used to
+  // skip ahead in the input before entering the regexp engine, or nullptr if
+  // there are none. Computed lazily; see maybeLiteralPrefix.
+  GCPtr<JSAtom*> literalPrefix_;
+  bool literalPrefixComputed_ = false;
+
   // With duplicate named capture groups, it's possible that the number of
   // distinct named groups is less than the total number of named captures.
   // If they are equal, we used the namedCaptureIndices_ array directly to
@@ -165,6 +171,13 @@ class RegExpShared
                                      Handle<JSLinearString*> input,
                                      size_t start, VectorMatchPairs* matches);
 
+  // Return the mandatory literal prefix of this pattern, computing and
+  // caching it on first call. Returns nullptr if the pattern has none or if
+  // atomizing the prefix failed: the prefix only enables an optimization, so
+  // failure to compute it is not propagated.
+  static JSAtom* maybeLiteralPrefix(JSContext* cx,
+                                    MutableHandleRegExpShared re);
+
   // Execute this RegExp on input starting from searchIndex, filling in matches.
   static RegExpRunStatus execute(JSContext* cx, MutableHandleRegExpShared res,
                                  Handle<JSLinearString*> input,
@@ -18,7 +18,20 @@ template <typename IntoOwnedChars>
   MOZ_ASSERT(chars);
   Hasher::Lookup lookup(Hasher::hashLongString(chars, length), chars, length);
 
-  auto locked = inner_->lock();
+  // Hot path: a hit on an existing entry only needs the lock for reading, so
+  // concurrent lookups do not serialize against each other. Any entry found
+  // here has a non-zero refcount: the count only drops to zero while holding
+  // the lock for writing, which also frees the chars and thereby makes
+  // `Hasher::match` reject the entry.
+  {
+    auto locked = inner_->readLock();
+    if (auto entry = locked->set.lookup(lookup)) {
+      MOZ_ASSERT((*entry)->refcount > 0);
+      return SharedImmutableString(entry->get());
+    }
+  }
+
+  auto locked = inner_->writeLock();
   auto entry = locked->set.lookupForAdd(lookup);
   if (!entry) {
     OwnedChars ownedChars(intoOwnedChars());
@@ -48,7 +61,16 @@ SharedImmutableStringsCache::getOrCreate(
                                      length * sizeof(char16_t));
   Hasher::Lookup lookup(hash, chars, length);
 
-  auto locked = inner_->lock();
+  // See the comment on the hot path in the `const char*` overload above.
+  {
+    auto locked = inner_->readLock();
+    if (auto entry = locked->set.lookup(lookup)) {
+      MOZ_ASSERT((*entry)->refcount > 0);
+      return SharedImmutableTwoByteString(entry->get());
+    }
+  }
+
+  auto locked = inner_->writeLock();
   auto entry = locked->set.lookupForAdd(lookup);
   if (!entry) {
     OwnedTwoByteChars ownedTwoByteChars(intoOwnedTwoByteChars());
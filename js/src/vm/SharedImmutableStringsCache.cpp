@@ -66,19 +66,33 @@ SharedImmutableString::~SharedImmutableString() {
     return;
   }
 
-  auto locked = box_->cache_->lock();
-
   MOZ_ASSERT(box_->refcount > 0);
 
-  box_->refcount--;
-  if (box_->refcount == 0) {
+  // While other references remain, drop ours with a bare atomic decrement. Our
+  // own reference keeps the count above zero until then, so `purge` cannot
+  // remove the box from under us.
+  size_t count = box_->refcount;
+  while (count > 1) {
+    if (box_->refcount.compareExchange(count, count - 1)) {
+      return;
+    }
+    count = box_->refcount;
+  }
+
+  // This is the last reference. Freeing the chars must not race with a reader
+  // matching this entry under the read lock, so take the lock for writing. A
+  // concurrent `getOrCreate` may have taken a new reference in the meantime,
+  // hence the re-check.
+  auto locked = box_->cache_->writeLock();
+  if (--box_->refcount == 0) {
     box_->chars_.reset(nullptr);
   }
 }
 
 SharedImmutableString SharedImmutableString::clone() const {
-  auto locked = box_->cache_->lock();
   MOZ_ASSERT(box_);
+  // Our own reference pins the refcount above zero, so taking another is a
+  // bare atomic increment and needs no lock.
   MOZ_ASSERT(box_->refcount > 0);
   return SharedImmutableString(box_);
 }
@@ -104,13 +118,12 @@ bool SharedImmutableStringsCache::init() {
   MOZ_ASSERT(!inner_);
 
   auto* inner =
-      js_new<ExclusiveData<Inner>>(mutexid::SharedImmutableStringsCache);
+      js_new<RWExclusiveData<Inner>>(mutexid::SharedImmutableStringsCache);
   if (!inner) {
     return false;
   }
 
-  auto locked = inner->lock();
-  inner_ = locked.parent();
+  inner_ = inner;
 
   return true;
 }
@@ -7,6 +7,7 @@
 #ifndef vm_SharedImmutableStringsCache_h
 #define vm_SharedImmutableStringsCache_h
 
+#include "mozilla/Atomics.h"
 #include "mozilla/Maybe.h"
 #include "mozilla/UniquePtr.h"
 
@@ -31,10 +32,12 @@ class SharedImmutableTwoByteString;
  * immutable strings (either `const char*` [any encoding, not restricted to
  * only Latin-1 or only UTF-8] or `const char16_t*`) between threads.
  *
- * The locking mechanism is dead-simple and coarse grained: a single lock guards
- * all of the internal table itself, the table's entries, and the entries'
- * reference counts. It is only safe to perform any mutation on the cache or any
- * data stored within the cache when this lock is acquired.
+ * The locking mechanism is coarse grained: a single reader-writer lock guards
+ * the internal table and its entries. Lookups of existing entries — the common
+ * case when many helper threads compile in parallel — only take the lock for
+ * reading and bump an atomic reference count, so they do not serialize against
+ * each other. Inserting an entry, and dropping the last reference to one (which
+ * frees its characters), require the lock for writing.
  */
 class SharedImmutableStringsCache {
   static SharedImmutableStringsCache singleton_;
@@ -138,7 +141,7 @@ class SharedImmutableStringsCache {
     MOZ_ASSERT(inner_);
     size_t n = mallocSizeOf(inner_);
 
-    auto locked = inner_->lock();
+    auto locked = inner_->readLock();
 
     // Size of the table.
     n += locked->set.shallowSizeOfExcludingThis(mallocSizeOf);
@@ -185,7 +188,7 @@ class SharedImmutableStringsCache {
    * Purge the cache of all refcount == 0 entries.
    */
   void purge() {
-    auto locked = inner_->lock();
+    auto locked = inner_->writeLock();
 
     for (Inner::Set::Enum e(locked->set); !e.empty(); e.popFront()) {
       if (e.front()->refcount == 0) {
@@ -206,15 +209,18 @@ class SharedImmutableStringsCache {
 
     OwnedChars chars_;
     size_t length_;
-    const ExclusiveData<Inner>* cache_;
+    const RWExclusiveData<Inner>* cache_;
 
    public:
-    mutable size_t refcount;
+    // The reference count is atomic so that cache hits can bump it while only
+    // holding the cache's lock for reading. It only drops to zero, and the
+    // chars are only freed, while holding the lock for writing.
+    mutable mozilla::Atomic<size_t> refcount;
 
     using Ptr = js::UniquePtr<StringBox>;
 
     StringBox(OwnedChars&& chars, size_t length,
-              const ExclusiveData<Inner>* cache)
+              const RWExclusiveData<Inner>* cache)
         : chars_(std::move(chars)),
           length_(length),
           cache_(cache),
@@ -223,7 +229,7 @@ class SharedImmutableStringsCache {
     }
 
     static Ptr Create(OwnedChars&& chars, size_t length,
-                      const ExclusiveData<Inner>* cache) {
+                      const RWExclusiveData<Inner>* cache) {
       return js::MakeUnique<StringBox>(std::move(chars), length, cache);
     }
 
@@ -314,7 +320,7 @@ class SharedImmutableStringsCache {
     Inner& operator=(const Inner&) = delete;
   };
 
-  const ExclusiveData<Inner>* inner_ = nullptr;
+  const RWExclusiveData<Inner>* inner_ = nullptr;
 };
 
 /**
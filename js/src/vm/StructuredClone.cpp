@@ -1009,19 +1009,43 @@ bool SCOutput::writeArray(const T* p, size_t nelems) {
   return true;
 }
 
+// Byte payloads of at least this size get their own right-sized segment in
+// the clone buffer instead of being chopped into standard-capacity segments.
+// Cloning or transferring a large ArrayBuffer cross-process then costs a
+// single allocation and copy rather than one per segment.
+static const size_t kLargeByteArraySegmentThreshold = 64 * 1024;
+
 template <>
 bool SCOutput::writeArray<uint8_t>(const uint8_t* p, size_t nelems) {
   if (nelems == 0) {
     return true;
   }
 
+  size_t padbytes = ComputePadding(nelems, 1);
+
+  if (nelems >= kLargeByteArraySegmentThreshold) {
+    size_t total = nelems + padbytes;
+    char* block = js_pod_malloc<char>(total);
+    if (!block) {
+      ReportOutOfMemory(context());
+      return false;
+    }
+    memcpy(block, p, nelems);
+    memset(block + nelems, 0, padbytes);
+    // On failure this frees the block.
+    if (!buf.AppendBytesZeroCopy(block, total, total)) {
+      ReportOutOfMemory(context());
+      return false;
+    }
+    return true;
+  }
+
   if (!buf.AppendBytes(reinterpret_cast<const char*>(p), nelems)) {
     ReportOutOfMemory(context());
     return false;
   }
 
   // zero-pad to 8 bytes boundary
-  size_t padbytes = ComputePadding(nelems, 1);
   char zeroes[sizeof(uint64_t)] = {0};
   if (!buf.AppendBytes(zeroes, padbytes)) {
     ReportOutOfMemory(context());
@@ -103,7 +103,7 @@ using CodeFunc = CoderResult (*)(Coder<mode>&, CoderArg<mode, T>);
 CoderResult Coder<MODE_SIZE>::writeBytes(const void* unusedSrc, size_t length) {
   size_ += length;
   if (!size_.isValid()) {
-    return Err(OutOfMemory());
+    return Err(CoderError::OutOfMemory);
   }
   return Ok();
 }
@@ -270,7 +270,7 @@ CoderResult CodePodVector(Coder<mode>& coder,
 
   // Prepare to copy into the vector
   if (!item->initLengthUninitialized(length)) {
-    return Err(OutOfMemory());
+    return Err(CoderError::OutOfMemory);
   }
 
   // Copy directly from the buffer to the vector
@@ -311,7 +311,7 @@ CoderResult CodeVector(Coder<MODE_DECODE>& coder,
   // Attempt to grow the buffer to length, this will default initialize each
   // element
   if (!item->resize(length)) {
-    return Err(OutOfMemory());
+    return Err(CoderError::OutOfMemory);
   }
 
   // Decode each child element from the buffer
@@ -353,7 +353,7 @@ CoderResult CodeRefPtr(Coder<mode>& coder, CoderArg<mode, RefPtr<T>> item) {
     // Allocate and default construct the inner type
     auto* allocated = js_new<std::remove_const_t<T>>();
     if (!allocated) {
-      return Err(OutOfMemory());
+      return Err(CoderError::OutOfMemory);
     }
 
     // Initialize the RefPtr
@@ -404,7 +404,7 @@ CoderResult CodeUniquePtr(Coder<mode>& coder,
     // Allocate and default construct the inner type
     auto allocated = js::MakeUnique<std::remove_const_t<T>>();
     if (!allocated.get()) {
-      return Err(OutOfMemory());
+      return Err(CoderError::OutOfMemory);
     }
 
     // Decode the inner type
@@ -433,7 +433,7 @@ CoderResult CodeUniqueChars(Coder<MODE_DECODE>& coder, UniqueChars* item) {
   if (lengthWithNullChar) {
     item->reset(js_pod_malloc<char>(lengthWithNullChar));
     if (!item->get()) {
-      return Err(OutOfMemory());
+      return Err(CoderError::OutOfMemory);
     }
     return coder.readBytes((char*)item->get(), lengthWithNullChar);
   }
@@ -637,7 +637,7 @@ CoderResult CodeStructType(Coder<mode>& coder,
                                                              &item->fields_)));
   if constexpr (mode == MODE_DECODE) {
     if (!item->init()) {
-      return Err(OutOfMemory());
+      return Err(CoderError::OutOfMemory);
     }
   }
   return Ok();
@@ -724,7 +724,7 @@ CoderResult CodeTypeContext(Coder<mode>& coder,
       if (canonRecGroupIndex != recGroupIndex) {
         SharedRecGroup recGroup = item->groups()[canonRecGroupIndex];
         if (!item->addRecGroup(recGroup)) {
-          return Err(OutOfMemory());
+          return Err(CoderError::OutOfMemory);
         }
         continue;
       }
@@ -735,7 +735,7 @@ CoderResult CodeTypeContext(Coder<mode>& coder,
 
       MutableRecGroup recGroup = item->startRecGroup(numTypes);
       if (!recGroup) {
-        return Err(OutOfMemory());
+        return Err(CoderError::OutOfMemory);
       }
 
       // Decode the type definitions
@@ -746,7 +746,7 @@ CoderResult CodeTypeContext(Coder<mode>& coder,
 
       // Finish the recursion group
       if (!item->endRecGroup()) {
-        return Err(OutOfMemory());
+        return Err(CoderError::OutOfMemory);
       }
     }
   } else {
@@ -781,7 +781,7 @@ CoderResult CodeTypeContext(Coder<mode>& coder,
           canonRecGroups.lookupForAdd(group.get());
       if (!canonRecGroupIndex) {
         if (!canonRecGroups.add(canonRecGroupIndex, group.get(), groupIndex)) {
-          return Err(OutOfMemory());
+          return Err(CoderError::OutOfMemory);
         }
       }
 
@@ -847,7 +847,7 @@ CoderResult CodeTagType(Coder<mode>& coder, CoderArg<mode, TagType> item) {
   MOZ_TRY(CodeTypeDefRef(coder, &item->type_));
   if constexpr (mode == MODE_DECODE) {
     if (!item->initialize(item->type_)) {
-      return Err(OutOfMemory());
+      return Err(CoderError::OutOfMemory);
     }
   }
 
@@ -1028,7 +1028,7 @@ CoderResult CodeStackMap(Coder<MODE_DECODE>& coder,
   // Allocate a stack map for the header
   StackMap* map = StackMap::create(header);
   if (!map) {
-    return Err(OutOfMemory());
+    return Err(CoderError::OutOfMemory);
   }
 
   // Decode the bitmap into the stackmap
@@ -1071,7 +1071,7 @@ CoderResult CodeStackMaps(Coder<MODE_DECODE>& coder,
 
     // Add it to the map
     if (!item->add(codeOffset, map)) {
-      return Err(OutOfMemory());
+      return Err(CoderError::OutOfMemory);
     }
   }
 
@@ -1302,7 +1302,7 @@ CoderResult CodeCodeBlock(Coder<MODE_DECODE>& coder,
   WASM_VERIFY_SERIALIZATION_FOR_SIZE(wasm::CodeBlock, 2624);
   *item = js::MakeUnique<CodeBlock>(CodeBlock::kindFromTier(Tier::Serialized));
   if (!*item) {
-    return Err(OutOfMemory());
+    return Err(CoderError::OutOfMemory);
   }
   MOZ_TRY(Magic(coder, Marker::CodeBlock));
 
@@ -1320,7 +1320,7 @@ CoderResult CodeCodeBlock(Coder<MODE_DECODE>& coder,
       CodeSegment::allocate(codeSource, nullptr, /* allowLastDitchGC */ true,
                             &codeStart, &allocationLength);
   if (!(*item)->segment) {
-    return Err(OutOfMemory());
+    return Err(CoderError::OutOfMemory);
   }
   (*item)->codeBase = codeStart;
   (*item)->codeLength = codeSource.lengthBytes();
@@ -1402,7 +1402,7 @@ CoderResult CodeSharedCode(Coder<MODE_DECODE>& coder, wasm::SharedCode* item,
                    std::move(funcImports), std::move(sharedStubs),
                    std::move(sharedStubsLinkData), std::move(optimizedCode),
                    std::move(optimizedCodeLinkData), CompileAndLinkStats())) {
-    return Err(OutOfMemory());
+    return Err(CoderError::OutOfMemory);
   }
 
   // not serialized: debugStubOffset_
@@ -1457,12 +1457,18 @@ CoderResult CodeModule(Coder<MODE_DECODE>& coder, MutableModule* item) {
   WASM_VERIFY_SERIALIZATION_FOR_SIZE(wasm::Module, 56);
   JS::BuildIdCharVector currentBuildId;
   if (!GetOptimizedEncodingBuildId(&currentBuildId)) {
-    return Err(OutOfMemory());
+    return Err(CoderError::OutOfMemory);
   }
   JS::BuildIdCharVector deserializedBuildId;
   MOZ_TRY(CodePodVector(coder, &deserializedBuildId));
 
-  MOZ_RELEASE_ASSERT(EqualContainers(currentBuildId, deserializedBuildId));
+  // A cache entry written by a different build, or on a CPU with different
+  // observed features, encodes machine code we cannot run. Reject it here so
+  // that callers fall back to compiling the module bytecode instead of
+  // crashing on a stale entry.
+  if (!EqualContainers(currentBuildId, deserializedBuildId)) {
+    return Err(CoderError::BadBuildId);
+  }
 
   MutableModuleMetadata moduleMeta;
   MOZ_TRY((CodeRefPtr<MODE_DECODE, ModuleMetadata, &CodeModuleMetadata>(
@@ -1486,7 +1492,7 @@ CoderResult CodeModule(Coder<mode>& coder, CoderArg<mode, Module> item) {
 
   JS::BuildIdCharVector currentBuildId;
   if (!GetOptimizedEncodingBuildId(&currentBuildId)) {
-    return Err(OutOfMemory());
+    return Err(CoderError::OutOfMemory);
   }
   MOZ_TRY(CodePodVector(coder, &currentBuildId));
   MOZ_TRY((CodeRefPtr<mode, const ModuleMetadata, &CodeModuleMetadata>(
@@ -1555,7 +1561,8 @@ MutableModule Module::deserialize(const uint8_t* begin, size_t size) {
   MutableModule module;
   CoderResult result = CodeModule(coder, &module);
   if (result.isErr()) {
-    // An error is an OOM, return nullptr
+    // An error is either an OOM or a build-id mismatch from a stale cache
+    // entry; in both cases return nullptr so the caller recompiles.
     return nullptr;
   }
   // Every byte is accounted for
@@ -78,11 +78,18 @@ class TypeContext;
 // they require access to protected state in a type, they may use the
 // WASM_DECLARE_FRIEND_SERIALIZE macro.
 
-// Signal an out of memory condition
-struct OutOfMemory {};
+// The reason a coding function failed.
+enum class CoderError {
+  // An allocation failed while encoding or decoding.
+  OutOfMemory,
+  // The bytes being decoded were produced by an incompatible build or CPU, as
+  // determined by the build ID in the prelude, and cannot be used. Callers are
+  // expected to fall back to compiling the module bytecode.
+  BadBuildId,
+};
 
-// The result of serialization, either OK or OOM
-using CoderResult = mozilla::Result<mozilla::Ok, OutOfMemory>;
+// The result of serialization, either OK or a CoderError
+using CoderResult = mozilla::Result<mozilla::Ok, CoderError>;
 
 // CoderMode parameterizes the coding functions
 enum CoderMode {
@@ -914,6 +914,24 @@ void XPCJSRuntime::FinalizeCallback(JS::GCContext* gcx, JSFinalizeStatus status,
 
       XPCWrappedNativeScope::SweepAllWrappedNativeTearOffs();
 
+      // The sweep only visits scopes in collected zones, so it may not have
+      // cleared the marks set above if a call context's tearoff lives in an
+      // uncollected zone. Walk the call contexts again to unmark them; for
+      // tearoffs the sweep did visit this is a no-op.
+      if (CycleCollectedJSContext* ccx = self->GetContext()) {
+        XPCCallContext* ccxp =
+            static_cast<const XPCJSContext*>(ccx)->GetCallContext();
+        while (ccxp) {
+          if (ccxp->CanGetTearOff()) {
+            XPCWrappedNativeTearOff* to = ccxp->GetTearOff();
+            if (to) {
+              to->Unmark();
+            }
+          }
+          ccxp = ccxp->GetPrevCallContext();
+        }
+      }
+
       // Now we need to kill the 'Dying' XPCWrappedNativeProtos.
       //
       // We transferred these native objects to this list when their JSObjects
@@ -330,6 +330,14 @@ void XPCWrappedNativeScope::UpdateWeakPointersAfterGC(JSTracer* trc) {
 // static
 void XPCWrappedNativeScope::SweepAllWrappedNativeTearOffs() {
   for (XPCWrappedNativeScope* cur : AllScopes()) {
+    // A tearoff's JSObject pointer is only cleared when that JSObject is
+    // finalized, which can only have happened during this GC if the scope's
+    // zone was collected. Skipping the other scopes keeps zonal GCs from
+    // walking the wrapper map of every scope in the runtime. The caller is
+    // responsible for unmarking any tearoffs it marked in skipped scopes.
+    if (!js::WasCompartmentZoneCollected(cur->Compartment())) {
+      continue;
+    }
     for (auto i = cur->mWrappedNativeMap->Iter(); !i.done(); i.next()) {
       i.get().value()->SweepTearOffs();
     }
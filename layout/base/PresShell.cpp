@@ -10628,7 +10628,8 @@ DOMHighResTimeStamp PresShell::GetPerformanceNowUnclamped() {
 }
 
 bool PresShell::DoReflow(nsIFrame* target, bool aInterruptible,
-                         OverflowChangedTracker* aOverflowTracker) {
+                         OverflowChangedTracker* aOverflowTracker,
+                         gfxContext* aReferenceRenderingContext) {
   [[maybe_unused]] nsIURI* uri = mDocument->GetDocumentURI();
   AUTO_PROFILER_LABEL_DYNAMIC_NSCSTRING_RELEVANT_FOR_JS(
       "Reflow", LAYOUT_Reflow, uri ? uri->GetSpecOrDefault() : "N/A"_ns);
@@ -10643,10 +10644,15 @@ bool PresShell::DoReflow(nsIFrame* target, bool aInterruptible,
     timeStart = TimeStamp::Now();
   }
 
-  // set up a cache that saves all nodes contained in each selection,
+  // Set up a cache that saves all nodes contained in each selection,
   // allowing a fast lookup in `nsTextFrame::IsFrameSelected()`.
-  // This cache only lives throughout this reflow call.
-  SelectionNodeCache cache(*this);
+  // This cache lives at most throughout this reflow call; when a batch of
+  // dirty roots is being reflowed, ProcessReflowCommands has already set up
+  // one cache to share across all of them.
+  Maybe<SelectionNodeCache> cache;
+  if (!mSelectionNodeCache) {
+    cache.emplace(*this);
+  }
 
   // Schedule a paint, but don't actually mark this frame as changed for
   // retained DL building purposes. If any child frames get moved, then
@@ -10672,7 +10678,12 @@ bool PresShell::DoReflow(nsIFrame* target, bool aInterruptible,
              "non-root frames");
 
   // CreateReferenceRenderingContext can return nullptr
-  UniquePtr<gfxContext> rcx(CreateReferenceRenderingContext());
+  UniquePtr<gfxContext> localRcx;
+  gfxContext* rcx = aReferenceRenderingContext;
+  if (!rcx) {
+    localRcx = CreateReferenceRenderingContext();
+    rcx = localRcx.get();
+  }
 
 #ifdef DEBUG
   mCurrentReflowRoot = target;
@@ -10700,7 +10711,7 @@ bool PresShell::DoReflow(nsIFrame* target, bool aInterruptible,
   // Don't pass size directly to the reflow input, since a
   // constrained height implies page/column breaking.
   LogicalSize reflowSize(wm, size.ISize(wm), NS_UNCONSTRAINEDSIZE);
-  ReflowInput reflowInput(mPresContext, target, rcx.get(), reflowSize,
+  ReflowInput reflowInput(mPresContext, target, rcx, reflowSize,
                           ReflowInput::InitFlag::CallerWillInit);
 
   if (isRoot) {
@@ -10894,6 +10905,15 @@ bool PresShell::ProcessReflowCommands(bool aInterruptible) {
 
     OverflowChangedTracker overflowTracker;
 
+    // Pages that use independent reflow roots heavily (e.g. grids of
+    // `contain: layout` cells) can queue hundreds of dirty roots per flush.
+    // Set up the per-reflow state that is identical for every root once for
+    // the whole batch rather than in each DoReflow call: the selection node
+    // cache (selections cannot change under the script blocker above) and the
+    // reference rendering context.
+    SelectionNodeCache selectionCache(*this);
+    UniquePtr<gfxContext> rcx(CreateReferenceRenderingContext());
+
     do {
       // Send an incremental reflow notification to the target frame.
       nsIFrame* target = mDirtyRoots.PopShallowestRoot();
@@ -10905,7 +10925,8 @@ bool PresShell::ProcessReflowCommands(bool aInterruptible) {
         continue;
       }
 
-      interrupted = !DoReflow(target, aInterruptible, &overflowTracker);
+      interrupted =
+          !DoReflow(target, aInterruptible, &overflowTracker, rcx.get());
 
       // Keep going until we're out of reflow commands, or we've run
       // past our deadline, or we're interrupted.
@@ -13123,6 +13144,7 @@ PresShell::ProximityToViewportResult PresShell::DetermineProximityToViewport() {
 
   auto input = DOMIntersectionObserver::ComputeInput(
       *mDocument, /* aRoot = */ nullptr, &rootMargin, nullptr);
+  dom::IntersectionUpdateCache cache;
 
   for (nsIFrame* frame : mContentVisibilityAutoFrames) {
     auto* element = frame->GetContent()->AsElement();
@@ -13140,7 +13162,7 @@ PresShell::ProximityToViewportResult PresShell::DetermineProximityToViewport() {
     bool intersects =
         DOMIntersectionObserver::Intersect(
             input, *element, DOMIntersectionObserver::BoxToUse::OverflowClip,
-            DOMIntersectionObserver::IsForProximityToViewport::Yes)
+            DOMIntersectionObserver::IsForProximityToViewport::Yes, &cache)
             .Intersects();
     element->SetVisibleForContentVisibility(intersects);
 
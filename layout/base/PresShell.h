@@ -1561,8 +1561,12 @@ class PresShell final : public nsStubDocumentObserver,
   // DoReflow returns whether the reflow finished without interruption
   // If aFrame is not the root frame, the caller must pass a non-null
   // aOverflowTracker.
+  // Callers reflowing a batch of dirty roots may pass a shared reference
+  // rendering context to avoid creating one per root; if null, one is created
+  // for this reflow.
   bool DoReflow(nsIFrame* aFrame, bool aInterruptible,
-                OverflowChangedTracker* aOverflowTracker);
+                OverflowChangedTracker* aOverflowTracker,
+                gfxContext* aReferenceRenderingContext = nullptr);
 
   /**
    * Add a solid color item to the bottom of aList with frame aFrame and bounds
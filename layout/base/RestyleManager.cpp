@@ -36,6 +36,7 @@
 #include "mozilla/dom/HTMLBodyElement.h"
 #include "mozilla/dom/HTMLInputElement.h"
 
+#include "GeckoProfiler.h"
 #include "ScrollSnap.h"
 #include "nsAnimationManager.h"
 #include "nsBlockFrame.h"
@@ -2457,6 +2458,13 @@ void RestyleManager::PostRestyleEvent(Element* aElement,
   }
 
   if (aRestyleHint || aMinChangeHint) {
+    auto origin = RestyleOrigin::Other;
+    if (aRestyleHint && (aRestyleHint & RestyleHint::ForAnimations())) {
+      origin = RestyleOrigin::Animations;
+    } else if (mRestyleForCSSRuleChanges) {
+      origin = RestyleOrigin::CSSRules;
+    }
+    NoteRestylePosted(origin);
     Servo_NoteExplicitHints(aElement, aRestyleHint, aMinChangeHint);
   }
 }
@@ -2474,6 +2482,7 @@ void RestyleManager::PostRestyleEventForAnimations(
 
   mPresContext->TriggeredAnimationRestyle();
 
+  NoteRestylePosted(RestyleOrigin::Animations);
   Servo_NoteExplicitHints(elementToRestyle, aRestyleHint, nsChangeHint(0));
 }
 
@@ -3226,6 +3235,11 @@ void RestyleManager::DoProcessPendingRestyles(ServoTraversalFlags aFlags) {
   // It'd be bad!
   PresShell::AutoAssertNoFlush noReentrantFlush(*presShell);
 
+  TimeStamp flushStart;
+  if (profiler_thread_is_being_profiled_for_markers()) {
+    flushStart = TimeStamp::Now();
+  }
+
   // Create a AnimationsWithDestroyedFrame during restyling process to
   // stop animations and transitions on elements that have no frame at the end
   // of the restyling process.
@@ -3259,6 +3273,7 @@ void RestyleManager::DoProcessPendingRestyles(ServoTraversalFlags aFlags) {
   while (styleSet->StyleDocument(aFlags)) {
     ClearSnapshots();
     mRestyledAsWholeContainer.Clear();
+    mContainersSweptForNthOf.Clear();
 
     // Select scroll anchors for frames that have been scrolled. Do this
     // before processing restyled frames so that anchor nodes are correctly
@@ -3355,6 +3370,7 @@ void RestyleManager::DoProcessPendingRestyles(ServoTraversalFlags aFlags) {
   presContext->UpdateHiddenByContentVisibilityForAnimationsIfNeeded();
   ClearSnapshots();
   mRestyledAsWholeContainer.Clear();
+  mContainersSweptForNthOf.Clear();
   styleSet->AssertTreeIsClean();
 
   mHaveNonAnimationRestyles = false;
@@ -3369,6 +3385,23 @@ void RestyleManager::DoProcessPendingRestyles(ServoTraversalFlags aFlags) {
   //       |mAnimationsWithDestroyedFrame| is still valid.
   MOZ_ASSERT(mAnimationsWithDestroyedFrame);
   mAnimationsWithDestroyedFrame->StopAnimationsForElementsWithoutFrames();
+
+  // Attribute the flush for the profiler: how long it took, and how many
+  // restyle requests were coalesced into it, bucketed by what posted them.
+  if (!flushStart.IsNull()) {
+    nsPrintfCString desc(
+        "%u attribute, %u state, %u animation, %u CSS rule, %u other",
+        mRestyleCountsByOrigin[RestyleOrigin::Attribute],
+        mRestyleCountsByOrigin[RestyleOrigin::State],
+        mRestyleCountsByOrigin[RestyleOrigin::Animations],
+        mRestyleCountsByOrigin[RestyleOrigin::CSSRules],
+        mRestyleCountsByOrigin[RestyleOrigin::Other]);
+    PROFILER_MARKER_TEXT("RestyleFlush", LAYOUT,
+                         MarkerTiming::IntervalUntilNowFrom(flushStart), desc);
+  }
+  for (auto& count : mRestyleCountsByOrigin) {
+    count = 0;
+  }
 }
 
 #ifdef DEBUG
@@ -3471,6 +3504,8 @@ void RestyleManager::ElementStateChanged(Element* aElement,
     return;
   }
 
+  NoteRestylePosted(RestyleOrigin::State);
+
   ServoElementSnapshot& snapshot = SnapshotFor(*aElement);
   ElementState previousState = aElement->StyleState() ^ aChangedBits;
   snapshot.AddState(previousState);
@@ -3631,6 +3666,8 @@ void RestyleManager::TakeSnapshotForAttributeChange(Element& aElement,
   // so we also set this true here.
   mHaveNonAnimationRestyles = true;
 
+  NoteRestylePosted(RestyleOrigin::Attribute);
+
   ServoElementSnapshot& snapshot = SnapshotFor(aElement);
   snapshot.AddAttrs(aElement, aNameSpaceID, aAttribute);
 
@@ -3694,6 +3731,7 @@ void RestyleManager::AttributeChanged(Element* aElement, int32_t aNameSpaceID,
   }
 
   if (restyleHint || changeHint) {
+    NoteRestylePosted(RestyleOrigin::Attribute);
     Servo_NoteExplicitHints(aElement, restyleHint, changeHint);
   }
 
@@ -3710,6 +3748,14 @@ void RestyleManager::AttributeChanged(Element* aElement, int32_t aNameSpaceID,
 
 void RestyleManager::RestyleSiblingsForNthOf(Element* aChild,
                                              NodeSelectorFlags aParentFlags) {
+  // The sweep depends only on the sibling list and the parent's selector
+  // flags, not on which particular child changed, so when script changes many
+  // siblings before the next flush the second and later sweeps of the same
+  // container would only re-post hints the first sweep already posted.
+  // Coalesce them into one sweep per container per flush.
+  if (!mContainersSweptForNthOf.EnsureInserted(aChild->GetParentNode())) {
+    return;
+  }
   StyleSet()->RestyleSiblingsForNthOf(*aChild,
                                       static_cast<uint32_t>(aParentFlags));
 }
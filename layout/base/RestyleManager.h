@@ -8,6 +8,7 @@
 #define mozilla_RestyleManager_h
 
 #include "mozilla/AutoRestore.h"
+#include "mozilla/EnumeratedArray.h"
 #include "mozilla/Maybe.h"
 #include "mozilla/OverflowChangedTracker.h"
 #include "mozilla/ServoElementSnapshot.h"
@@ -205,6 +206,18 @@ class RestyleManager {
   typedef ServoElementSnapshotTable SnapshotTable;
   typedef mozilla::dom::Element Element;
 
+  // What posted a restyle request. Used to attribute the work done in a given
+  // flush, so that profiles can tell (say) script toggling classes apart from
+  // animation ticks.
+  enum class RestyleOrigin : uint8_t {
+    Attribute,
+    State,
+    Animations,
+    CSSRules,
+    Other,
+    Count,
+  };
+
   // Get an integer that increments every time we process pending restyles.
   // The value is never 0.
   uint64_t GetRestyleGeneration() const { return mRestyleGeneration; }
@@ -551,6 +564,21 @@ class RestyleManager {
   // Containers we've already fully restyled / invalidated.
   nsTHashSet<RefPtr<nsINode>> mRestyledAsWholeContainer;
 
+  // Containers whose children we've already swept for :nth-child(.. of ..)
+  // invalidation, so that changing many siblings in one flush performs a
+  // single sweep rather than one per changed sibling.
+  nsTHashSet<RefPtr<nsINode>> mContainersSweptForNthOf;
+
+  void NoteRestylePosted(RestyleOrigin aOrigin) {
+    ++mRestyleCountsByOrigin[aOrigin];
+  }
+
+  // Number of restyle requests posted since the last flush, bucketed by what
+  // posted them. Reported as a profiler marker and reset by
+  // DoProcessPendingRestyles.
+  EnumeratedArray<RestyleOrigin, uint32_t, size_t(RestyleOrigin::Count)>
+      mRestyleCountsByOrigin{};
+
  protected:
   // True if we're in the middle of a nsRefreshDriver refresh
   bool mInStyleRefresh;
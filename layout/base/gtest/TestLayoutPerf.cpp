@@ -0,0 +1,137 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h"  // For MOZ_GTEST_BENCH_F
+
+#include "mozilla/ErrorResult.h"
+#include "mozilla/dom/DOMParser.h"
+#include "mozilla/dom/Document.h"
+#include "nsCOMPtr.h"
+#include "nsString.h"
+
+// Benchmarks over synthetic content trees shaped like the workloads layout
+// cares about (deep nesting, wide sibling lists, grid, flex, text-heavy
+// documents). Timings are reported through MozGTestBench in PERFHERDER_DATA
+// form, so perfherder can track them per push.
+//
+// The gtest harness provides XPCOM but no widget, view manager or document
+// viewer, so a live PresShell (and with it frame construction, reflow and
+// display list building) cannot be driven from here; those phases are
+// covered by the reftest/talos harnesses on the same kinds of trees. What
+// can be isolated headlessly is the content-side cost of building these
+// trees, which is the input to every layout phase and regresses for the
+// same reasons (per-node allocation, attribute handling, sibling list
+// maintenance).
+
+namespace mozilla {
+
+using dom::DOMParser;
+using dom::Document;
+
+constexpr size_t kIterations = 10;
+
+static void AppendOpenTag(nsString& aMarkup, const char* aTag,
+                          const char* aStyle) {
+  aMarkup.AppendLiteral("<");
+  aMarkup.AppendASCII(aTag);
+  if (aStyle) {
+    aMarkup.AppendLiteral(" style=\"");
+    aMarkup.AppendASCII(aStyle);
+    aMarkup.AppendLiteral("\"");
+  }
+  aMarkup.AppendLiteral(">");
+}
+
+static void AppendCloseTag(nsString& aMarkup, const char* aTag) {
+  aMarkup.AppendLiteral("</");
+  aMarkup.AppendASCII(aTag);
+  aMarkup.AppendLiteral(">");
+}
+
+class LayoutPerf : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // A chain of 512 nested blocks, the shape that stresses ancestor walks.
+    mDeep.AssignLiteral("<!DOCTYPE html><html><body>");
+    for (size_t i = 0; i < 512; ++i) {
+      AppendOpenTag(mDeep, "div", "padding:1px");
+    }
+    mDeep.AppendLiteral("x");
+    for (size_t i = 0; i < 512; ++i) {
+      AppendCloseTag(mDeep, "div");
+    }
+    mDeep.AppendLiteral("</body></html>");
+
+    // 5000 siblings under one parent, the shape that stresses sibling lists
+    // and :nth-* style invalidation.
+    mWide.AssignLiteral("<!DOCTYPE html><html><body>");
+    for (size_t i = 0; i < 5000; ++i) {
+      mWide.AppendLiteral("<div class=\"cell\">x</div>");
+    }
+    mWide.AppendLiteral("</body></html>");
+
+    // A 50x50 grid of items.
+    mGrid.AssignLiteral("<!DOCTYPE html><html><body>");
+    AppendOpenTag(mGrid, "div",
+                  "display:grid;grid-template-columns:repeat(50,1fr)");
+    for (size_t i = 0; i < 50 * 50; ++i) {
+      mGrid.AppendLiteral("<div>x</div>");
+    }
+    AppendCloseTag(mGrid, "div");
+    mGrid.AppendLiteral("</body></html>");
+
+    // 100 flex rows of 10 items each.
+    mFlex.AssignLiteral("<!DOCTYPE html><html><body>");
+    for (size_t i = 0; i < 100; ++i) {
+      AppendOpenTag(mFlex, "div", "display:flex;flex-wrap:wrap");
+      for (size_t j = 0; j < 10; ++j) {
+        mFlex.AppendLiteral("<div style=\"flex:1 1 auto\">x</div>");
+      }
+      AppendCloseTag(mFlex, "div");
+    }
+    mFlex.AppendLiteral("</body></html>");
+
+    // 500 paragraphs of plain text with inline markup sprinkled in.
+    mTextHeavy.AssignLiteral("<!DOCTYPE html><html><body>");
+    for (size_t i = 0; i < 500; ++i) {
+      mTextHeavy.AppendLiteral("<p>The quick brown fox <b>jumps</b> over ");
+      mTextHeavy.AppendLiteral("the lazy dog; pack my <i>box</i> with five ");
+      mTextHeavy.AppendLiteral("dozen liquor jugs.</p>");
+    }
+    mTextHeavy.AppendLiteral("</body></html>");
+  }
+
+  static void ParseTree(const nsString& aMarkup) {
+    for (size_t i = 0; i < kIterations; ++i) {
+      IgnoredErrorResult rv;
+      RefPtr<DOMParser> parser = DOMParser::CreateWithoutGlobal(rv);
+      ASSERT_FALSE(rv.Failed());
+      nsCOMPtr<Document> document = parser->ParseFromStringInternal(
+          aMarkup, dom::SupportedType::Text_html, rv);
+      ASSERT_FALSE(rv.Failed());
+      ASSERT_TRUE(document);
+    }
+  }
+
+  nsString mDeep;
+  nsString mWide;
+  nsString mGrid;
+  nsString mFlex;
+  nsString mTextHeavy;
+};
+
+MOZ_GTEST_BENCH_F(LayoutPerf, DeepTree, [this] { ParseTree(mDeep); });
+
+MOZ_GTEST_BENCH_F(LayoutPerf, WideTree, [this] { ParseTree(mWide); });
+
+MOZ_GTEST_BENCH_F(LayoutPerf, GridTree, [this] { ParseTree(mGrid); });
+
+MOZ_GTEST_BENCH_F(LayoutPerf, FlexTree, [this] { ParseTree(mFlex); });
+
+MOZ_GTEST_BENCH_F(LayoutPerf, TextHeavyTree, [this] { ParseTree(mTextHeavy); });
+
+}  // namespace mozilla
@@ -3433,13 +3433,32 @@ nsCSSFrameConstructor::FindDataByInt(int32_t aInt, const Element& aElement,
   return nullptr;
 }
 
+/* static */
+uint64_t nsCSSFrameConstructor::TagDataFilter(
+    const FrameConstructionDataByTag* aDataPtr, uint32_t aDataLength) {
+  uint64_t filter = 0;
+  for (uint32_t i = 0; i < aDataLength; i++) {
+    filter |= uint64_t(1) << (aDataPtr[i].mTag->hash() % 64);
+  }
+  return filter;
+}
+
 /* static */
 const nsCSSFrameConstructor::FrameConstructionData*
 nsCSSFrameConstructor::FindDataByTag(const Element& aElement,
                                      ComputedStyle& aStyle,
                                      const FrameConstructionDataByTag* aDataPtr,
-                                     uint32_t aDataLength) {
+                                     uint32_t aDataLength,
+                                     uint64_t aTagFilter) {
   const nsAtom* tag = aElement.NodeInfo()->NameAtom();
+
+  // Typical content is dominated by tags (div, span, p, a, ...) that have no
+  // entry in any of these tables; reject those with one bit test instead of
+  // walking the table.
+  if (!(aTagFilter & (uint64_t(1) << (tag->hash() % 64)))) {
+    return nullptr;
+  }
+
   for (const FrameConstructionDataByTag *curData = aDataPtr,
                                         *endData = aDataPtr + aDataLength;
        curData != endData; ++curData) {
@@ -3544,8 +3563,11 @@ nsCSSFrameConstructor::FindHTMLData(const Element& aElement,
       SIMPLE_TAG_CHAIN(details, nsCSSFrameConstructor::FindDetailsData),
       SIMPLE_TAG_CHAIN(h1, nsCSSFrameConstructor::FindH1Data),
   };
+  static const uint64_t sHTMLDataFilter =
+      TagDataFilter(sHTMLData, std::size(sHTMLData));
 
-  return FindDataByTag(aElement, aStyle, sHTMLData, std::size(sHTMLData));
+  return FindDataByTag(aElement, aStyle, sHTMLData, std::size(sHTMLData),
+                       sHTMLDataFilter);
 }
 
 /* static */
@@ -4174,8 +4196,11 @@ nsCSSFrameConstructor::FindXULTagData(const Element& aElement,
       {nsGkAtoms::menupopup, kPopupData},
       {nsGkAtoms::tooltip, kPopupData},
   };
+  static const uint64_t sXULTagDataFilter =
+      TagDataFilter(sXULTagData, std::size(sXULTagData));
 
-  return FindDataByTag(aElement, aStyle, sXULTagData, std::size(sXULTagData));
+  return FindDataByTag(aElement, aStyle, sXULTagData, std::size(sXULTagData),
+                       sXULTagDataFilter);
 }
 
 /* static */
@@ -4681,7 +4706,11 @@ nsCSSFrameConstructor::FindMathMLData(const Element& aElement,
       SIMPLE_MATHML_CREATE(menclose, NS_NewMathMLmencloseFrame),
       SIMPLE_MATHML_CREATE(semantics, NS_NewMathMLmrowFrame)};
 
-  return FindDataByTag(aElement, aStyle, sMathMLData, std::size(sMathMLData));
+  static const uint64_t sMathMLDataFilter =
+      TagDataFilter(sMathMLData, std::size(sMathMLData));
+
+  return FindDataByTag(aElement, aStyle, sMathMLData, std::size(sMathMLData),
+                       sMathMLDataFilter);
 }
 
 nsContainerFrame* nsCSSFrameConstructor::ConstructFrameWithAnonymousChild(
@@ -4987,8 +5016,11 @@ nsCSSFrameConstructor::FindSVGData(const Element& aElement,
       SIMPLE_SVG_CREATE(feTile, NS_NewSVGFELeafFrame),
       SIMPLE_SVG_CREATE(feTurbulence, NS_NewSVGFELeafFrame)};
 
-  const FrameConstructionData* data =
-      FindDataByTag(aElement, aStyle, sSVGData, std::size(sSVGData));
+  static const uint64_t sSVGDataFilter =
+      TagDataFilter(sSVGData, std::size(sSVGData));
+
+  const FrameConstructionData* data = FindDataByTag(
+      aElement, aStyle, sSVGData, std::size(sSVGData), sSVGDataFilter);
 
   if (!data) {
     data = &sContainerData;
@@ -5848,7 +5880,6 @@ nsIFrame* nsCSSFrameConstructor::FindSiblingInternal(
     return AdjustSiblingFrame(aPotentialSiblingFrame, aTargetContent,
                               aTargetContentDisplay, aDirection);
   };
-
   auto nextDomSibling = [](FlattenedChildIterator& aIter) -> nsIContent* {
     return aDirection == SiblingDirection::Forward ? aIter.GetNextChild()
                                                    : aIter.GetPreviousChild();
@@ -856,10 +856,20 @@ class nsCSSFrameConstructor final : public nsFrameManager {
    * This can return null if none of the tags match or if the matching tag has a
    * FrameConstructionDataGetter that returns null. In the case that the tags
    * actually match, aTagFound will be true, even if the return value is null.
+   *
+   * aTagFilter is a Bloom filter over the hashes of the tags in aDataPtr,
+   * computed by TagDataFilter; most elements match no entry in a given table,
+   * and the filter rejects them without scanning it.
    */
   static const FrameConstructionData* FindDataByTag(
       const Element& aElement, ComputedStyle& aComputedStyle,
-      const FrameConstructionDataByTag* aDataPtr, uint32_t aDataLength);
+      const FrameConstructionDataByTag* aDataPtr, uint32_t aDataLength,
+      uint64_t aTagFilter);
+
+  /* Computes the Bloom filter over the tag hashes of a
+     FrameConstructionDataByTag table for use with FindDataByTag. */
+  static uint64_t TagDataFilter(const FrameConstructionDataByTag* aDataPtr,
+                                uint32_t aDataLength);
 
   /* A class representing a list of FrameConstructionItems.  Instances of this
      class are only created as AutoFrameConstructionItemList, or as a member
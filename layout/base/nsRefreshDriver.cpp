@@ -1033,17 +1033,17 @@ class StartupRefreshDriverTimer : public SimpleTimerBasedRefreshDriverTimer {
 
 /*
  * A RefreshDriverTimer for inactive documents.  When a new refresh driver is
- * added, the rate is reset to the base (normally 1s/1fps).  Every time
- * it ticks, a single refresh driver is poked.  Once they have all been poked,
- * the duration between ticks doubles, up to mDisableAfterMilliseconds.  At that
+ * added, the rate is reset to the base (normally 1s/1fps).  Every time it
+ * ticks, all of its refresh drivers are poked in one batch, and the duration
+ * until the next tick doubles, up to mDisableAfterMilliseconds.  At that
  * point, the timer is quiet and doesn't tick (until something is added to it
  * again).
  *
- * When a timer is removed, there is a possibility of another timer
- * being skipped for one cycle.  We could avoid this by adjusting
- * mNextDriverIndex in RemoveRefreshDriver, but there's little need to
- * add that complexity.  All we want is for inactive drivers to tick
- * at some point, but we don't care too much about how often.
+ * Ticking the drivers one per timer fire would spread the (cheap) work of
+ * the inactive documents out further, but it costs one wake-up per document
+ * per cycle; with many background iframes the wake-ups dominate the work, so
+ * we batch them instead.  All we want is for inactive drivers to tick at
+ * some point, but we don't care too much about how often.
  */
 class InactiveRefreshDriverTimer final
     : public SimpleTimerBasedRefreshDriverTimer {
@@ -1051,14 +1051,12 @@ class InactiveRefreshDriverTimer final
   explicit InactiveRefreshDriverTimer(double aRate)
       : SimpleTimerBasedRefreshDriverTimer(aRate),
         mNextTickDuration(aRate),
-        mDisableAfterMilliseconds(-1.0),
-        mNextDriverIndex(0) {}
+        mDisableAfterMilliseconds(-1.0) {}
 
   InactiveRefreshDriverTimer(double aRate, double aDisableAfterMilliseconds)
       : SimpleTimerBasedRefreshDriverTimer(aRate),
         mNextTickDuration(aRate),
-        mDisableAfterMilliseconds(aDisableAfterMilliseconds),
-        mNextDriverIndex(0) {}
+        mDisableAfterMilliseconds(aDisableAfterMilliseconds) {}
 
   void AddRefreshDriver(nsRefreshDriver* aDriver) override {
     RefreshDriverTimer::AddRefreshDriver(aDriver);
@@ -1066,13 +1064,9 @@ class InactiveRefreshDriverTimer final
     LOG("[%p] inactive timer got new refresh driver %p, resetting rate", this,
         aDriver);
 
-    // reset the timer, and start with the newly added one next time.
+    // reset the backoff so the newly added driver ticks promptly.
     mNextTickDuration = mRateMilliseconds;
 
-    // we don't really have to start with the newly added one, but we may as
-    // well not tick the old ones at the fastest rate any more than we need to.
-    mNextDriverIndex = GetRefreshDriverCount() - 1;
-
     StopTimer();
     StartTimer();
   }
@@ -1082,10 +1076,6 @@ class InactiveRefreshDriverTimer final
   }
 
  protected:
-  uint32_t GetRefreshDriverCount() {
-    return mContentRefreshDrivers.Length() + mRootRefreshDrivers.Length();
-  }
-
   void StartTimer() override {
     mLastFireTime = TimeStamp::Now();
     mLastFireId = VsyncId();
@@ -1093,7 +1083,7 @@ class InactiveRefreshDriverTimer final
     mTargetTime = mLastFireTime + mRateDuration;
 
     uint32_t delay = static_cast<uint32_t>(mRateMilliseconds);
-    mTimer->InitWithNamedFuncCallback(TimerTickOne, this, delay,
+    mTimer->InitWithNamedFuncCallback(TimerTick, this, delay,
                                       nsITimer::TYPE_ONE_SHOT,
                                       "InactiveRefreshDriverTimer::StartTimer");
     mIsTicking = true;
@@ -1113,56 +1103,24 @@ class InactiveRefreshDriverTimer final
       return;
     }
 
-    // double the next tick time if we've already gone through all of them once
-    if (mNextDriverIndex >= GetRefreshDriverCount()) {
-      mNextTickDuration *= 2.0;
-      mNextDriverIndex = 0;
-    }
+    // back off now that the whole batch has been poked once
+    mNextTickDuration *= 2.0;
 
     // this doesn't need to be precise; do a simple schedule
     uint32_t delay = static_cast<uint32_t>(mNextTickDuration);
     mTimer->InitWithNamedFuncCallback(
-        TimerTickOne, this, delay, nsITimer::TYPE_ONE_SHOT,
+        TimerTick, this, delay, nsITimer::TYPE_ONE_SHOT,
         "InactiveRefreshDriverTimer::ScheduleNextTick");
 
-    LOG("[%p] inactive timer next tick in %f ms [index %d/%d]", this,
-        mNextTickDuration, mNextDriverIndex, GetRefreshDriverCount());
+    LOG("[%p] inactive timer next tick in %f ms", this, mNextTickDuration);
   }
 
  public:
   bool IsTicking() const override { return mIsTicking; }
 
  protected:
-  /* Runs just one driver's tick. */
-  void TickOne() {
-    TimeStamp now = TimeStamp::Now();
-
-    ScheduleNextTick(now);
-
-    mLastFireTime = now;
-    mLastFireId = VsyncId();
-
-    nsTArray<RefPtr<nsRefreshDriver>> drivers(mContentRefreshDrivers.Clone());
-    drivers.AppendElements(mRootRefreshDrivers);
-    size_t index = mNextDriverIndex;
-
-    if (index < drivers.Length() &&
-        !drivers[index]->IsTestControllingRefreshesEnabled()) {
-      TickDriver(drivers[index], VsyncId(), now);
-    }
-
-    mNextDriverIndex++;
-  }
-
-  static void TimerTickOne(nsITimer* aTimer, void* aClosure) {
-    RefPtr<InactiveRefreshDriverTimer> timer =
-        static_cast<InactiveRefreshDriverTimer*>(aClosure);
-    timer->TickOne();
-  }
-
   double mNextTickDuration;
   double mDisableAfterMilliseconds;
-  uint32_t mNextDriverIndex;
   bool mIsTicking = false;
 };
 
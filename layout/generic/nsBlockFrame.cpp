@@ -3117,6 +3117,25 @@ bool nsBlockFrame::ReflowDirtyLines(BlockReflowState& aState) {
                "reflow");
   }
 
+  // True when none of the dirtiness checks in the loop below can mark a
+  // clean float-free inline line dirty: we are not fragmenting, not
+  // resizing in the block axis, and there is no constrained content
+  // block-size for lines to be slid past. Under these conditions, once
+  // deltaBCoord reaches zero the rest of the loop body reduces to pure
+  // bookkeeping for such lines, so we can fast-forward over them instead
+  // of running every check on every remaining line. This is what keeps a
+  // single-line edit in a large block from being O(total lines) with a
+  // large constant. (Float-manager state can change while reflowing dirty
+  // lines, so it is checked at the point we fast-forward, not here.)
+  const bool canSkipCleanLines =
+      !selfDirty && !aState.mReflowInput.IsBResize() &&
+      aState.mReflowInput.AvailableBSize() == NS_UNCONSTRAINEDSIZE &&
+      aState.ContentBSize() == NS_UNCONSTRAINEDSIZE &&
+      !HasAnyStateBits(NS_FRAME_HAS_MULTI_COLUMN_ANCESTOR) &&
+      !presCtx->IsPaginated() && !canBreakForPageNames &&
+      !aState.mReflowInput.mFlags.mMustReflowPlaceholders &&
+      !aState.mReflowInput.mFlags.mMovedBlockFragments;
+
   // Reflow the lines that are already ours
   for (; line != line_end; ++line, aState.AdvanceToNextLine()) {
     DumpLine(aState, line, deltaBCoord, 0);
@@ -3124,6 +3143,40 @@ bool nsBlockFrame::ReflowDirtyLines(BlockReflowState& aState) {
     AutoNoisyIndenter indent2(gNoisyReflow);
 #endif
 
+    // Fast-forward over a run of clean float-free inline lines with no
+    // clearance when nothing in this loop can dirty or move them. Each
+    // such line keeps its position and break points, so all we need from
+    // it is the running mBCoord and line-number bookkeeping.
+    if (canSkipCleanLines && deltaBCoord == 0 && !willReflowAgain &&
+        inlineFloatClearType == UsedClear::None &&
+        !aState.FloatManager()->HasAnyFloats() &&
+        !aState.mPresContext->HasPendingInterrupt()
+#ifdef DEBUG
+        && !gNoisyReflow
+#endif
+    ) {
+      bool skippedAny = false;
+      while (line != line_end && line->IsInline() && !line->IsDirty() &&
+             !line->HasFloats() && !line->IsPreviousMarginDirty() &&
+             !line->HasFloatClearTypeBefore() &&
+             !line->HasFloatClearTypeAfter() &&
+             aState.ContainerSize() == line->mContainerSize) {
+        if (!line->CachedIsEmpty()) {
+          aState.mBCoord = line->BEnd();
+        }
+        skippedAny = true;
+        ++line;
+        aState.AdvanceToNextLine();
+      }
+      if (skippedAny) {
+        repositionViews = true;
+        needToRecoverState = true;
+        if (line == line_end) {
+          break;
+        }
+      }
+    }
+
     if (selfDirty) {
       line->MarkDirty();
     }
@@ -1459,6 +1459,14 @@ void nsImageFrame::MaybeDecodeForPredictedSize() {
   // Determine the optimal image size to use.
   uint32_t flags = imgIContainer::FLAG_HIGH_QUALITY_SCALING |
                    imgIContainer::FLAG_ASYNC_NOTIFY;
+
+  // Approximate visibility extends out to the displayport margins; images
+  // actually within the scrollport should have their decodes scheduled ahead
+  // of those speculative decodes, so the images the user can already see win
+  // during fast scrolls.
+  if (!IsScrolledOutOfView()) {
+    flags |= imgIContainer::FLAG_PRIORITY_IN_VIEWPORT;
+  }
   SamplingFilter samplingFilter =
       nsLayoutUtils::GetSamplingFilterForFrame(this);
   gfxSize gfxPredictedScreenSize =
@@ -189,6 +189,14 @@ bool RetainedDisplayListBuilder::PreProcessDisplayList(
 
   nsDisplayList out(Builder());
 
+  // Consecutive items in a list frequently share the same invalidation frame
+  // (the background, border and content items for an element, for example),
+  // so remember the result of the ancestor walk for the previous item rather
+  // than repeating it. This walk is most of the preprocessing cost when a
+  // small change dirties a leaf within a large retained list.
+  nsIFrame* lastInvalidationFrame = nullptr;
+  bool lastInvalidationFrameModified = false;
+
   size_t i = 0;
   while (nsDisplayItem* item = aList->RemoveBottom()) {
 #ifdef MOZ_DIAGNOSTIC_ASSERT_ENABLED
@@ -215,8 +223,18 @@ bool RetainedDisplayListBuilder::PreProcessDisplayList(
       }
     }
 
-    if (!item->CanBeReused() || item->HasDeletedFrame() ||
-        AnyContentAncestorModified(item->FrameForInvalidation(), aOuterFrame)) {
+    bool reusable = item->CanBeReused() && !item->HasDeletedFrame();
+    if (reusable) {
+      nsIFrame* invalidationFrame = item->FrameForInvalidation();
+      if (invalidationFrame != lastInvalidationFrame) {
+        lastInvalidationFrame = invalidationFrame;
+        lastInvalidationFrameModified =
+            AnyContentAncestorModified(invalidationFrame, aOuterFrame);
+      }
+      reusable = !lastInvalidationFrameModified;
+    }
+
+    if (!reusable) {
       if (initializeOldItems) {
         aList->mOldItems.AppendElement(OldItemInfo(nullptr));
       } else {
@@ -1486,6 +1504,11 @@ bool IsReuseableStackingContextItem(nsDisplayItem* aItem) {
 void CollectStackingContextItems(nsDisplayListBuilder* aBuilder,
                                  nsDisplayList* aList, nsIFrame* aOuterFrame,
                                  int aDepth = 0, bool aParentReused = false) {
+  // As in PreProcessDisplayList, consecutive items frequently share an
+  // invalidation frame, so remember the result of the previous ancestor walk.
+  nsIFrame* lastInvalidationFrame = nullptr;
+  bool lastInvalidationFrameModified = false;
+
   for (nsDisplayItem* item : aList->TakeItems()) {
     if (DL_LOG_TEST(LogLevel::Debug)) {
       DL_LOGD(
@@ -1497,8 +1520,18 @@ void CollectStackingContextItems(nsDisplayListBuilder* aBuilder,
           aParentReused);
     }
 
-    if (!item->CanBeReused() || item->HasDeletedFrame() ||
-        AnyContentAncestorModified(item->FrameForInvalidation(), aOuterFrame)) {
+    bool reusable = item->CanBeReused() && !item->HasDeletedFrame();
+    if (reusable) {
+      nsIFrame* invalidationFrame = item->FrameForInvalidation();
+      if (invalidationFrame != lastInvalidationFrame) {
+        lastInvalidationFrame = invalidationFrame;
+        lastInvalidationFrameModified =
+            AnyContentAncestorModified(invalidationFrame, aOuterFrame);
+      }
+      reusable = !lastInvalidationFrameModified;
+    }
+
+    if (!reusable) {
       DL_LOGD("%*s Deleted modified or temporary item %p", aDepth, "", item);
       item->Destroy(aBuilder);
       continue;
@@ -13,7 +13,9 @@
 #include "mozilla/dom/ContentParent.h"
 #include "mozilla/dom/Document.h"
 #include "mozilla/ServoBindings.h"
+#include "mozilla/Services.h"
 #include "nsContentUtils.h"
+#include "nsIObserverService.h"
 #include "nsXULPrototypeCache.h"
 
 extern mozilla::LazyLogModule sCssLoaderLog;
@@ -22,18 +24,38 @@ extern mozilla::LazyLogModule sCssLoaderLog;
 
 namespace mozilla {
 
-NS_IMPL_ISUPPORTS(SharedStyleSheetCache, nsIMemoryReporter)
+NS_IMPL_ISUPPORTS(SharedStyleSheetCache, nsIMemoryReporter, nsIObserver,
+                  nsISupportsWeakReference)
 
 MOZ_DEFINE_MALLOC_SIZE_OF(SharedStyleSheetCacheMallocSizeOf)
 
 SharedStyleSheetCache::SharedStyleSheetCache() = default;
 
-void SharedStyleSheetCache::Init() { RegisterWeakMemoryReporter(this); }
+void SharedStyleSheetCache::Init() {
+  RegisterWeakMemoryReporter(this);
+
+  // Parsed sheets for documents that are no longer open can be a significant
+  // chunk of heap in a session with many content processes, and they can
+  // always be re-parsed from the necko cache, so shed them under memory
+  // pressure.
+  if (nsCOMPtr<nsIObserverService> obs = services::GetObserverService()) {
+    obs->AddObserver(this, "memory-pressure", /* aOwnsWeak = */ true);
+  }
+}
 
 SharedStyleSheetCache::~SharedStyleSheetCache() {
   UnregisterWeakMemoryReporter(this);
 }
 
+NS_IMETHODIMP
+SharedStyleSheetCache::Observe(nsISupports* aSubject, const char* aTopic,
+                               const char16_t* aData) {
+  if (!strcmp(aTopic, "memory-pressure")) {
+    ClearInProcess(Nothing(), Nothing(), Nothing(), Nothing(), Nothing());
+  }
+  return NS_OK;
+}
+
 void SharedStyleSheetCache::LoadCompleted(SharedStyleSheetCache* aCache,
                                           StyleSheetLoadData& aData,
                                           nsresult aStatus) {
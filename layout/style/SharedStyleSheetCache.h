@@ -20,7 +20,9 @@
 //    might re-create it.
 
 #include "mozilla/SharedSubResourceCache.h"
+#include "nsIObserver.h"
 #include "nsRefPtrHashtable.h"
+#include "nsWeakReference.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/css/Loader.h"
 
@@ -48,13 +50,16 @@ struct SharedStyleSheetCacheTraits {
 class SharedStyleSheetCache final
     : public SharedSubResourceCache<SharedStyleSheetCacheTraits,
                                     SharedStyleSheetCache>,
-      public nsIMemoryReporter {
+      public nsIMemoryReporter,
+      public nsIObserver,
+      public nsSupportsWeakReference {
  public:
   using Base = SharedSubResourceCache<SharedStyleSheetCacheTraits,
                                       SharedStyleSheetCache>;
 
   NS_DECL_ISUPPORTS
   NS_DECL_NSIMEMORYREPORTER
+  NS_DECL_NSIOBSERVER
 
   SharedStyleSheetCache();
   void Init();
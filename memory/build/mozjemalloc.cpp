@@ -415,6 +415,11 @@ struct arena_bin_t {
   // Current number of runs in this bin, full or otherwise.
   uint32_t mNumRuns;
 
+  // Cumulative number of allocations served from this bin, so that the
+  // allocation rate per size class can be derived from deltas between
+  // jemalloc_stats() calls.
+  uint64_t mNumAllocations;
+
   // A constant for fast division by size class.  This value is 16 bits wide so
   // it is placed last.
   FastDivisor<uint16_t> mSizeDivisor;
@@ -449,11 +454,13 @@ struct arena_bin_t {
 // often that's 64 bytes on x86 and ARM, we don't make assumptions for other
 // architectures.
 #if defined(__x86_64__) || defined(__aarch64__)
-// On 64bit platforms this structure is often 48 bytes
-// long, which means every other array element will be properly aligned.
-static_assert(sizeof(arena_bin_t) == 48);
+// On 64bit platforms this structure is often 56 bytes
+// long, which keeps array elements 8-byte aligned.
+static_assert(sizeof(arena_bin_t) == 56);
 #elif defined(__x86__) || defined(__arm__)
-static_assert(sizeof(arena_bin_t) == 32);
+// On 32bit platforms the size depends on the alignment of uint64_t (4 bytes
+// on x86, 8 bytes on ARM EABI).
+static_assert(sizeof(arena_bin_t) == 40 || sizeof(arena_bin_t) == 48);
 #endif
 
 // We cannot instantiate
@@ -2434,6 +2441,7 @@ void arena_bin_t::Init(SizeClass aSizeClass) {
 
   mSizeClass = aSizeClass.Size();
   mNumRuns = 0;
+  mNumAllocations = 0;
 
   // Run size expansion loop.
   while (true) {
@@ -2611,6 +2619,7 @@ void* arena_t::MallocSmall(size_t aSize, bool aZero) {
 
     mStats.allocated_small += aSize;
     mStats.operations++;
+    bin->mNumAllocations++;
   }
   if (num_dirty_after < num_dirty_before) {
     NotifySignificantReuse();
@@ -4230,6 +4239,7 @@ inline void MozJemalloc::jemalloc_stats_internal(
           aBinStats[j].size = bin->mSizeClass;
           aBinStats[j].num_non_full_runs += num_non_full_runs;
           aBinStats[j].num_runs += bin->mNumRuns;
+          aBinStats[j].num_allocations += bin->mNumAllocations;
           aBinStats[j].bytes_unused += bin_unused;
           size_t bytes_per_run = static_cast<size_t>(bin->mRunSizePages)
                                  << gPageSize2Pow;
@@ -141,6 +141,9 @@ typedef struct {
                              // bin stats array entry is unused (no more bins).
   size_t num_non_full_runs;  // The number of non-full runs
   size_t num_runs;           // The number of runs in this bin
+  uint64_t num_allocations;  // Cumulative allocations served from this bin
+                             // across all arenas; deltas between calls give
+                             // the per-size-class allocation rate.
   size_t bytes_unused;       // The unallocated bytes across all these bins
   size_t bytes_total;        // The total storage area for runs in this bin,
   size_t bytes_per_run;      // The number of bytes per run, including headers.
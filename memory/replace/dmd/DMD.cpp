@@ -468,7 +468,21 @@ class Thread {
   // indirectly call vanilla malloc via functions like MozStackWalk.)
   bool mBlockIntercepts;
 
-  Thread() : mBlockIntercepts(false) {}
+#if defined(XP_LINUX) && defined(MOZ_PROFILING)
+  // The end of this thread's stack, for FramePointerStackWalk(). Computing
+  // it needs pthread calls (which parse /proc for the main thread), so it is
+  // looked up once per thread and cached here.
+  void* mStackEnd;
+#endif
+
+  Thread()
+      : mBlockIntercepts(false)
+#if defined(XP_LINUX) && defined(MOZ_PROFILING)
+        ,
+        mStackEnd(nullptr)
+#endif
+  {
+  }
 
   Thread(const Thread&) = delete;
 
@@ -495,6 +509,23 @@ class Thread {
     return t;
   }
 
+#if defined(XP_LINUX) && defined(MOZ_PROFILING)
+  void* StackEnd() {
+    if (MOZ_UNLIKELY(!mStackEnd)) {
+      pthread_attr_t attr;
+      if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+        void* stackBase = nullptr;
+        size_t stackSize = 0;
+        if (pthread_attr_getstack(&attr, &stackBase, &stackSize) == 0) {
+          mStackEnd = static_cast<char*>(stackBase) + stackSize;
+        }
+        pthread_attr_destroy(&attr);
+      }
+    }
+    return mStackEnd;
+  }
+#endif
+
   bool BlockIntercepts() {
     MOZ_ASSERT(!mBlockIntercepts);
     return mBlockIntercepts = true;
@@ -658,6 +689,21 @@ static uint32_t gGCStackTraceTableWhenSizeExceeds = 4 * 1024;
 #  pragma GCC diagnostic pop
     void* stackEnd = pthread_get_stackaddr_np(pthread_self());
     FramePointerStackWalk(StackWalkCallback, MaxFrames, &tmp, fp, stackEnd);
+#elif defined(XP_LINUX) && defined(MOZ_PROFILING) && \
+    (defined(__x86_64__) || defined(__aarch64__))
+    // MOZ_PROFILING builds keep frame pointers on Linux (the Gecko profiler
+    // depends on this for its own FramePointerStackWalk() use), so take the
+    // fast frame-pointer walk instead of the much slower
+    // _Unwind_Backtrace-based MozStackWalk().
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wframe-address"
+    void** fp = reinterpret_cast<void**>(__builtin_frame_address(1));
+#  pragma GCC diagnostic pop
+    if (void* stackEnd = aT->StackEnd()) {
+      FramePointerStackWalk(StackWalkCallback, MaxFrames, &tmp, fp, stackEnd);
+    } else {
+      MozStackWalk(StackWalkCallback, nullptr, MaxFrames, &tmp);
+    }
 #else
     MozStackWalk(StackWalkCallback, nullptr, MaxFrames, &tmp);
 #endif
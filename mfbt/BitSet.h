@@ -133,6 +133,20 @@ class BitSet {
     return result;
   }
 
+  // Set difference, i.e. and-not: clears any bits set in |aOther|.
+  BitSet& operator-=(const BitSet<N, Word>& aOther) {
+    for (size_t i = 0; i < std::size(mStorage); i++) {
+      mStorage[i] &= ~aOther.mStorage[i];
+    }
+    return *this;
+  }
+
+  BitSet operator-(const BitSet<N, Word>& aOther) const {
+    BitSet result = *this;
+    result -= aOther;
+    return result;
+  }
+
   bool operator==(const BitSet<N, Word>& aOther) const {
     return mStorage == aOther.mStorage;
   }
@@ -160,6 +174,58 @@ class BitSet {
     ResetPaddingBits();
   }
 
+  // Set all bits in the range [aBegin, aEnd) to true, a whole word at a time
+  // rather than bit by bit.
+  void SetRange(size_t aBegin, size_t aEnd) {
+    MOZ_ASSERT(aBegin <= aEnd);
+    MOZ_ASSERT(aEnd <= N);
+    if (aBegin == aEnd) {
+      return;
+    }
+
+    size_t firstWord = aBegin / kBitsPerWord;
+    size_t lastWord = (aEnd - 1) / kBitsPerWord;
+    Word firstMask = Word(-1) << (aBegin % kBitsPerWord);
+    Word lastMask = Word(-1) >> (kBitsPerWord - 1 - (aEnd - 1) % kBitsPerWord);
+
+    if (firstWord == lastWord) {
+      mStorage[firstWord] |= firstMask & lastMask;
+      return;
+    }
+
+    mStorage[firstWord] |= firstMask;
+    for (size_t i = firstWord + 1; i < lastWord; i++) {
+      mStorage[i] = Word(-1);
+    }
+    mStorage[lastWord] |= lastMask;
+  }
+
+  // Set all bits in the range [aBegin, aEnd) to false, a whole word at a time
+  // rather than bit by bit.
+  void ClearRange(size_t aBegin, size_t aEnd) {
+    MOZ_ASSERT(aBegin <= aEnd);
+    MOZ_ASSERT(aEnd <= N);
+    if (aBegin == aEnd) {
+      return;
+    }
+
+    size_t firstWord = aBegin / kBitsPerWord;
+    size_t lastWord = (aEnd - 1) / kBitsPerWord;
+    Word firstMask = Word(-1) << (aBegin % kBitsPerWord);
+    Word lastMask = Word(-1) >> (kBitsPerWord - 1 - (aEnd - 1) % kBitsPerWord);
+
+    if (firstWord == lastWord) {
+      mStorage[firstWord] &= ~(firstMask & lastMask);
+      return;
+    }
+
+    mStorage[firstWord] &= ~firstMask;
+    for (size_t i = firstWord + 1; i < lastWord; i++) {
+      mStorage[i] = 0;
+    }
+    mStorage[lastWord] &= ~lastMask;
+  }
+
   void Flip() {
     for (Word& word : mStorage) {
       word = ~word;
@@ -246,6 +246,14 @@ class HashMap {
     return mImpl.readonlyThreadsafeLookup(aLookup);
   }
 
+  // Look up each of the |aCount| keys in |aKeys|, writing the result Ptrs to
+  // |aPtrsOut| (which must have room for |aCount| of them). The hashed slots
+  // of several keys are prefetched before any of them is probed, which hides
+  // much of the cache-miss latency when performing runs of lookups.
+  void lookupBatch(const Lookup* aKeys, size_t aCount, Ptr* aPtrsOut) const {
+    mImpl.lookupBatch(aKeys, aCount, aPtrsOut);
+  }
+
   // -- Insertions -----------------------------------------------------------
 
   // Overwrite existing value with |aValue|, or add it if not present. Returns
@@ -545,6 +553,14 @@ class HashSet {
     return mImpl.readonlyThreadsafeLookup(aLookup);
   }
 
+  // Look up each of the |aCount| keys in |aKeys|, writing the result Ptrs to
+  // |aPtrsOut| (which must have room for |aCount| of them). The hashed slots
+  // of several keys are prefetched before any of them is probed, which hides
+  // much of the cache-miss latency when performing runs of lookups.
+  void lookupBatch(const Lookup* aKeys, size_t aCount, Ptr* aPtrsOut) const {
+    mImpl.lookupBatch(aKeys, aCount, aPtrsOut);
+  }
+
   // -- Insertions -----------------------------------------------------------
 
   // Add |aU| if it is not present already. Returns false on OOM.
@@ -933,6 +949,16 @@ static bool EnsureHash(Lookup&& aLookup, HashNumber* aHashOut) {
       std::forward<Lookup>(aLookup), aHashOut);
 }
 
+// Issue a best-effort CPU hint that |aPtr| will shortly be read. Compiles to
+// nothing on toolchains without a prefetch intrinsic.
+static inline void PrefetchForRead(const void* aPtr) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(aPtr, 0 /* for read */, 3 /* high temporal locality */);
+#else
+  (void)aPtr;
+#endif
+}
+
 //---------------------------------------------------------------------------
 // Implementation Details (HashMapEntry, HashTableEntry, HashTable)
 //---------------------------------------------------------------------------
@@ -1787,6 +1813,16 @@ class HashTable : private AllocPolicy {
     return Slot(&entries[aIndex], &hashes[aIndex]);
   }
 
+  // Prefetch the stored hash and the entry at the primary hash address of
+  // |aKeyHash|, ahead of a lookup with that hash.
+  void prefetchSlotForHash(HashNumber aKeyHash) const {
+    HashNumber h1 = hash1(aKeyHash);
+    auto hashes = reinterpret_cast<HashNumber*>(mTable);
+    auto entries = reinterpret_cast<Entry*>(&hashes[capacity()]);
+    PrefetchForRead(&hashes[h1]);
+    PrefetchForRead(&entries[h1]);
+  }
+
   // Warning: in order for readonlyThreadsafeLookup() to be safe this
   // function must not modify the table in any way when Reason==ForNonAdd.
   template <LookupReason Reason>
@@ -2133,6 +2169,49 @@ class HashTable : private AllocPolicy {
     return readonlyThreadsafeLookup(aLookup);
   }
 
+  // Equivalent to calling lookup() on each of the |aCount| keys in |aKeys| and
+  // storing the results in |aPtrsOut|, but processes the keys in small chunks,
+  // prefetching the hashed slots of a whole chunk before probing any of them.
+  // This overlaps the cache misses of runs of independent lookups instead of
+  // paying the full memory latency per key.
+  void lookupBatch(const Lookup* aKeys, size_t aCount, Ptr* aPtrsOut) const {
+    ReentrancyGuard g(*this);
+
+    if (empty()) {
+      for (size_t i = 0; i < aCount; i++) {
+        aPtrsOut[i] = Ptr();
+      }
+      return;
+    }
+
+    // Big enough to hide the latency of a miss per key, small enough to stay
+    // within the number of outstanding loads the hardware tracks.
+    static const size_t kChunkSize = 8;
+
+    for (size_t base = 0; base < aCount; base += kChunkSize) {
+      size_t chunk =
+          aCount - base < kChunkSize ? aCount - base : kChunkSize;
+      HashNumber keyHashes[kChunkSize];
+      bool haveHash[kChunkSize];
+
+      for (size_t i = 0; i < chunk; i++) {
+        HashNumber inputHash;
+        haveHash[i] = MaybeGetHash<HashPolicy>(aKeys[base + i], &inputHash);
+        if (haveHash[i]) {
+          keyHashes[i] = prepareHash(inputHash);
+          prefetchSlotForHash(keyHashes[i]);
+        }
+      }
+
+      for (size_t i = 0; i < chunk; i++) {
+        aPtrsOut[base + i] =
+            haveHash[i]
+                ? Ptr(lookup<ForNonAdd>(aKeys[base + i], keyHashes[i]), *this)
+                : Ptr();
+      }
+    }
+  }
+
   MOZ_ALWAYS_INLINE AddPtr lookupForAdd(const Lookup& aLookup) {
     ReentrancyGuard g(*this);
 
@@ -20,7 +20,10 @@
 #ifndef mozilla_SegmentedVector_h
 #define mozilla_SegmentedVector_h
 
+#include <algorithm>
 #include <new>  // for placement new
+#include <string.h>
+#include <type_traits>
 #include <utility>
 
 #include "mozilla/AllocPolicy.h"
@@ -102,6 +105,34 @@ class SegmentedVector : private AllocPolicy {
       new (KnownNotNull, elem) T(std::forward<U>(aU));
     }
 
+    // Appends |aCount| elements constructed from |aBegin| onwards. The caller
+    // must ensure they fit in the remaining capacity.
+    template <typename U>
+    void AppendRange(U* aBegin, uint32_t aCount) {
+      MOZ_ASSERT(mLength + aCount <= SegmentCapacity);
+      T* elems = Elems() + mLength;
+      if constexpr (std::is_same_v<std::remove_const_t<U>, T> &&
+                    std::is_trivially_copyable_v<T>) {
+        memcpy(elems, aBegin, aCount * sizeof(T));
+      } else {
+        for (uint32_t i = 0; i < aCount; i++) {
+          new (KnownNotNull, &elems[i]) T(std::move(aBegin[i]));
+        }
+      }
+      mLength += aCount;
+    }
+
+    // Appends |aCount| copies of |aValue|. The caller must ensure they fit in
+    // the remaining capacity.
+    void AppendFill(const T& aValue, uint32_t aCount) {
+      MOZ_ASSERT(mLength + aCount <= SegmentCapacity);
+      T* elems = Elems() + mLength;
+      for (uint32_t i = 0; i < aCount; i++) {
+        new (KnownNotNull, &elems[i]) T(aValue);
+      }
+      mLength += aCount;
+    }
+
     void PopLast() {
       MOZ_ASSERT(mLength > 0);
       (*this)[mLength - 1].~T();
@@ -164,14 +195,9 @@ class SegmentedVector : private AllocPolicy {
   // allocation policy, use InfallibleAppend() instead.)
   template <typename U>
   [[nodiscard]] bool Append(U&& aU) {
-    Segment* last = mSegments.getLast();
-    if (!last || last->Length() == kSegmentCapacity) {
-      last = this->template pod_malloc<Segment>(1);
-      if (!last) {
-        return false;
-      }
-      new (KnownNotNull, last) Segment();
-      mSegments.insertBack(last);
+    Segment* last = GetLastSegmentWithSpace();
+    if (!last) {
+      return false;
     }
     last->Append(std::forward<U>(aU));
     return true;
@@ -192,6 +218,52 @@ class SegmentedVector : private AllocPolicy {
 #endif  // MOZ_INTERNAL_API
   }
 
+  // Appends the elements in [aBegin, aEnd), filling whole segments at a time
+  // rather than paying a capacity check per element. Elements are
+  // copy-constructed if |U| is const and move-constructed otherwise;
+  // trivially copyable types are memcpy'd. Returns false if an allocation
+  // failed, in which case a prefix of the range may have been appended.
+  template <typename U>
+  [[nodiscard]] bool AppendRange(U* aBegin, U* aEnd) {
+    MOZ_ASSERT(aBegin <= aEnd);
+    while (aBegin != aEnd) {
+      Segment* last = GetLastSegmentWithSpace();
+      if (!last) {
+        return false;
+      }
+      uint32_t count = std::min<size_t>(aEnd - aBegin,
+                                        kSegmentCapacity - last->Length());
+      last->AppendRange(aBegin, count);
+      aBegin += count;
+    }
+    return true;
+  }
+
+  // Appends |aCount| copies of |aValue|. Returns false if an allocation
+  // failed, in which case fewer than |aCount| copies may have been appended.
+  [[nodiscard]] bool AppendN(const T& aValue, size_t aCount) {
+    while (aCount) {
+      Segment* last = GetLastSegmentWithSpace();
+      if (!last) {
+        return false;
+      }
+      uint32_t count =
+          std::min<size_t>(aCount, kSegmentCapacity - last->Length());
+      last->AppendFill(aValue, count);
+      aCount -= count;
+    }
+    return true;
+  }
+
+  // Moves all elements from |aOther| to the end of this vector in O(1),
+  // leaving |aOther| empty. No elements are copied or moved individually;
+  // the segment list is stolen wholesale, so both vectors must have the same
+  // type, segment size, and allocation policy.
+  void SpliceFrom(SegmentedVector& aOther) {
+    MOZ_ASSERT(&aOther != this);
+    mSegments.extendBack(std::move(aOther.mSegments));
+  }
+
   void Clear() {
     Segment* segment;
     while ((segment = mSegments.popFirst())) {
@@ -349,6 +421,21 @@ class SegmentedVector : private AllocPolicy {
   }
 
  private:
+  // Returns the last segment if it has free space, otherwise appends and
+  // returns a new segment. Returns null on allocation failure.
+  Segment* GetLastSegmentWithSpace() {
+    Segment* last = mSegments.getLast();
+    if (!last || last->Length() == kSegmentCapacity) {
+      last = this->template pod_malloc<Segment>(1);
+      if (!last) {
+        return nullptr;
+      }
+      new (KnownNotNull, last) Segment();
+      mSegments.insertBack(last);
+    }
+    return last;
+  }
+
   mozilla::LinkedList<Segment> mSegments;
 };
 
@@ -216,21 +216,41 @@ struct VectorImpl {
                                           size_t aNewCap) {
     MOZ_ASSERT(!aV.usingInlineStorage());
     MOZ_ASSERT(!CapacityHasExcessSpace<sizeof(T)>(aNewCap));
-    T* newbuf = aV.template pod_malloc<T>(aNewCap);
-    if (MOZ_UNLIKELY(!newbuf)) {
-      return false;
-    }
-    T* dst = newbuf;
-    T* src = aV.beginNoCheck();
-    for (; src < aV.endNoCheck(); ++dst, ++src) {
-      new_(dst, std::move(*src));
+    /*
+     * Trivially copyable elements may be relocated by the allocator, so grow
+     * with pod_realloc. With mozjemalloc this often extends the existing run
+     * in place, skipping the copy entirely; this matters for large buffers
+     * that only need fractional headroom. Element types that are trivially
+     * copyable but not trivial (e.g. with user-provided constructors) don't
+     * get the POD specialization below, so handle them here.
+     */
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      T* newbuf =
+          aV.template pod_realloc<T>(aV.mBegin, aV.mTail.mCapacity, aNewCap);
+      if (MOZ_UNLIKELY(!newbuf)) {
+        return false;
+      }
+      aV.mBegin = newbuf;
+      /* aV.mLength is unchanged. */
+      aV.mTail.mCapacity = aNewCap;
+      return true;
+    } else {
+      T* newbuf = aV.template pod_malloc<T>(aNewCap);
+      if (MOZ_UNLIKELY(!newbuf)) {
+        return false;
+      }
+      T* dst = newbuf;
+      T* src = aV.beginNoCheck();
+      for (; src < aV.endNoCheck(); ++dst, ++src) {
+        new_(dst, std::move(*src));
+      }
+      VectorImpl::destroy(aV.beginNoCheck(), aV.endNoCheck());
+      aV.free_(aV.mBegin, aV.mTail.mCapacity);
+      aV.mBegin = newbuf;
+      /* aV.mLength is unchanged. */
+      aV.mTail.mCapacity = aNewCap;
+      return true;
     }
-    VectorImpl::destroy(aV.beginNoCheck(), aV.endNoCheck());
-    aV.free_(aV.mBegin, aV.mTail.mCapacity);
-    aV.mBegin = newbuf;
-    /* aV.mLength is unchanged. */
-    aV.mTail.mCapacity = aNewCap;
-    return true;
   }
 };
 
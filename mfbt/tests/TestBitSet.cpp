@@ -162,11 +162,57 @@ class BitSetSuite {
     }
   }
 
+  void testRangesAndDifference() {
+    constexpr size_t size = kBitsPerWord * 3 + 2;
+
+    // Test all range boundaries around word edges, plus a few in between.
+    for (size_t begin = 0; begin < size; begin += 3) {
+      for (size_t end = begin; end <= size; end += 5) {
+        TestBitSet<size> bitset;
+        bitset.SetRange(begin, end);
+        for (size_t i = 0; i < size; i++) {
+          MOZ_RELEASE_ASSERT(bitset.test(i) == (i >= begin && i < end));
+        }
+        MOZ_RELEASE_ASSERT(bitset.Count() == end - begin);
+
+        bitset.SetAll();
+        bitset.ClearRange(begin, end);
+        for (size_t i = 0; i < size; i++) {
+          MOZ_RELEASE_ASSERT(bitset.test(i) == (i < begin || i >= end));
+        }
+        MOZ_RELEASE_ASSERT(bitset.Count() == size - (end - begin));
+      }
+    }
+
+    // SetRange over the full set must not touch the padding bits.
+    TestBitSet<size> full;
+    full.SetRange(0, size);
+    TestBitSet<size> all;
+    all.SetAll();
+    MOZ_RELEASE_ASSERT(full == all);
+
+    // Set difference clears exactly the bits set in the other set.
+    TestBitSet<size> lhs;
+    lhs.SetRange(0, kBitsPerWord + 2);
+    TestBitSet<size> rhs;
+    rhs.SetRange(kBitsPerWord, size);
+    lhs -= rhs;
+    for (size_t i = 0; i < size; i++) {
+      MOZ_RELEASE_ASSERT(lhs.test(i) == (i < kBitsPerWord));
+    }
+
+    TestBitSet<size> diff = all - rhs;
+    for (size_t i = 0; i < size; i++) {
+      MOZ_RELEASE_ASSERT(diff.test(i) == (i < kBitsPerWord));
+    }
+  }
+
   void runTests() {
     testLength();
     testConstruct();
     testSetBit();
     testFindBits();
+    testRangesAndDifference();
   }
 };
 
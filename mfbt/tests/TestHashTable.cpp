@@ -131,9 +131,55 @@ void TestHashPair() {
   }
 }
 
+void TestLookupBatch() {
+  using namespace mozilla;
+
+  HashMap<int, int> map;
+
+  // An empty map yields all-not-found Ptrs.
+  int missingKey = 7;
+  HashMap<int, int>::Ptr missingPtr;
+  map.lookupBatch(&missingKey, 1, &missingPtr);
+  MOZ_RELEASE_ASSERT(!missingPtr);
+
+  // Use enough keys to span several prefetch chunks.
+  static const size_t kCount = 100;
+  for (size_t i = 0; i < kCount; i++) {
+    MOZ_RELEASE_ASSERT(map.putNew(int(i), int(i) * 2));
+  }
+
+  int keys[kCount + 1];
+  HashMap<int, int>::Ptr ptrs[kCount + 1];
+  for (size_t i = 0; i <= kCount; i++) {
+    keys[i] = int(i);
+  }
+  map.lookupBatch(keys, kCount + 1, ptrs);
+
+  for (size_t i = 0; i < kCount; i++) {
+    MOZ_RELEASE_ASSERT(ptrs[i]);
+    MOZ_RELEASE_ASSERT(ptrs[i]->key() == int(i));
+    MOZ_RELEASE_ASSERT(ptrs[i]->value() == int(i) * 2);
+  }
+  MOZ_RELEASE_ASSERT(!ptrs[kCount]);
+
+  // And the same via HashSet.
+  HashSet<int> set;
+  for (size_t i = 0; i < kCount; i++) {
+    MOZ_RELEASE_ASSERT(set.putNew(int(i)));
+  }
+  HashSet<int>::Ptr setPtrs[kCount + 1];
+  set.lookupBatch(keys, kCount + 1, setPtrs);
+  for (size_t i = 0; i < kCount; i++) {
+    MOZ_RELEASE_ASSERT(setPtrs[i]);
+    MOZ_RELEASE_ASSERT(*setPtrs[i] == int(i));
+  }
+  MOZ_RELEASE_ASSERT(!setPtrs[kCount]);
+}
+
 int main() {
   TestMoveConstructor();
   TestEnumHash();
   TestHashPair();
+  TestLookupBatch();
   return 0;
 }
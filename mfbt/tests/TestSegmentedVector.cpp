@@ -394,12 +394,73 @@ void TestIterator() {
   MOZ_RELEASE_ASSERT(iterFromLast.Done());
 }
 
+// This tests the bulk AppendRange()/AppendN() operations and SpliceFrom().
+void TestBulkOperations() {
+  // Small segments, so that bulk appends straddle several boundaries.
+  typedef SegmentedVector<int, 64, InfallibleAllocPolicy> MyVector;
+
+  static const size_t kCount = 1000;
+  int source[kCount];
+  for (size_t i = 0; i < kCount; i++) {
+    source[i] = int(i);
+  }
+
+  MyVector v;
+  gDummy = v.AppendRange(source, source + kCount);
+  CheckContents(v, kCount);
+
+  // Appending an empty range is a no-op.
+  gDummy = v.AppendRange(source, source);
+  CheckContents(v, kCount);
+
+  // AppendN on a vector whose last segment is partially full.
+  MyVector w;
+  gDummy = w.Append(0);
+  gDummy = w.AppendN(1, 500);
+  MOZ_RELEASE_ASSERT(w.Length() == 501);
+  size_t n = 0;
+  for (auto iter = w.Iter(); !iter.Done(); iter.Next()) {
+    MOZ_RELEASE_ASSERT(iter.Get() == (n == 0 ? 0 : 1));
+    n++;
+  }
+  MOZ_RELEASE_ASSERT(n == 501);
+
+  // SpliceFrom steals the segment list and leaves the donor empty.
+  MyVector x;
+  gDummy = x.AppendRange(source, source + 100);
+  MyVector y;
+  gDummy = y.AppendRange(source + 100, source + kCount);
+  x.SpliceFrom(y);
+  MOZ_RELEASE_ASSERT(y.IsEmpty());
+  CheckContents(x, kCount);
+
+  // The spliced-into vector must still support further appends and pops.
+  gDummy = x.Append(int(kCount));
+  CheckContents(x, kCount + 1);
+  x.PopLastN(600);
+  CheckContents(x, kCount + 1 - 600);
+
+  // AppendRange from non-const pointers move-constructs non-trivial types.
+  typedef SegmentedVector<NonPOD, 64, InfallibleAllocPolicy> NonPODVector;
+  size_t moveCtorsBefore = gNumMoveCtors;
+  size_t dtorsBefore = gNumDtors;
+  {
+    NonPOD source2[10];
+    NonPODVector z;
+    gDummy = z.AppendRange(source2, source2 + 10);
+    MOZ_RELEASE_ASSERT(z.Length() == 10);
+    MOZ_RELEASE_ASSERT(gNumMoveCtors == moveCtorsBefore + 10);
+  }
+  MOZ_RELEASE_ASSERT(gNumDtors == dtorsBefore + 20);
+}
+
 int main(void) {
   TestBasics();
   TestMoveAndSwap();
   TestConstructorsAndDestructors();
   TestSegmentCapacitiesAndAlignments();
   TestIterator();
+  TestBulkOperations();
 
   return 0;
 }
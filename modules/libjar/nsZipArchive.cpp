@@ -457,9 +457,10 @@ nsZipItem* nsZipArchive::GetItem(const nsACString& aEntryName) {
       }
     }
     MMAP_FAULT_HANDLER_BEGIN_HANDLE(mFd)
-    nsZipItem* item = mFiles[HashName(aEntryName.BeginReading(), len)];
+    uint32_t hash = HashName(aEntryName.BeginReading(), len);
+    nsZipItem* item = mFiles[hash % ZIP_TABSIZE];
     while (item) {
-      if ((len == item->nameLength) &&
+      if ((hash == item->nameHash) && (len == item->nameLength) &&
           (!memcmp(aEntryName.BeginReading(), item->Name(), len))) {
         // Successful GetItem() is a good indicator that the file is about to be
         // read
@@ -721,8 +722,9 @@ nsresult nsZipArchive::BuildFileList(PRFileDesc* aFd)
     LOG(("   %s", PromiseFlatCString(name).get()));
 #endif
     uint32_t hash = HashName(item->Name(), namelen);
-    item->next = mFiles[hash];
-    mFiles[hash] = item;
+    item->nameHash = hash;
+    item->next = mFiles[hash % ZIP_TABSIZE];
+    mFiles[hash % ZIP_TABSIZE] = item;
 
     sig = 0;
   } /* while reading central directory records */
@@ -771,8 +773,9 @@ nsresult nsZipArchive::BuildSynthetics() {
         // Is the directory already in the file table?
         uint32_t hash = HashName(item->Name(), dirlen);
         bool found = false;
-        for (nsZipItem* zi = mFiles[hash]; zi != nullptr; zi = zi->next) {
-          if ((dirlen == zi->nameLength) &&
+        for (nsZipItem* zi = mFiles[hash % ZIP_TABSIZE]; zi != nullptr;
+             zi = zi->next) {
+          if ((hash == zi->nameHash) && (dirlen == zi->nameLength) &&
               (0 == memcmp(item->Name(), zi->Name(), dirlen))) {
             // we've already added this dir and all its parents
             found = true;
@@ -789,12 +792,13 @@ nsresult nsZipArchive::BuildSynthetics() {
 
         // Point to the central record of the original item for the name part.
         diritem->central = item->central;
+        diritem->nameHash = hash;
         diritem->nameLength = dirlen;
         diritem->isSynthetic = true;
 
         // add diritem to the file table
-        diritem->next = mFiles[hash];
-        mFiles[hash] = diritem;
+        diritem->next = mFiles[hash % ZIP_TABSIZE];
+        mFiles[hash % ZIP_TABSIZE] = diritem;
       } /* end processing of dirs in item's name */
     }
   }
@@ -982,7 +986,8 @@ nsZipFind::~nsZipFind() {
 /*
  * HashName
  *
- * returns a hash key for the entry name
+ * returns the full 32-bit hash of the entry name; callers reduce it
+ * modulo ZIP_TABSIZE to pick a bucket
  */
 MOZ_NO_SANITIZE_UNSIGNED_OVERFLOW
 static uint32_t HashName(const char* aName, uint16_t len) {
@@ -995,7 +1000,7 @@ static uint32_t HashName(const char* aName, uint16_t len) {
     val = val * 37 + *p++;
   }
 
-  return (val % ZIP_TABSIZE);
+  return val;
 }
 
 /*
@@ -1051,7 +1056,11 @@ static PRTime GetModTime(uint16_t aDate, uint16_t aTime) {
 }
 
 nsZipItem::nsZipItem()
-    : next(nullptr), central(nullptr), nameLength(0), isSynthetic(false) {}
+    : next(nullptr),
+      central(nullptr),
+      nameHash(0),
+      nameLength(0),
+      isSynthetic(false) {}
 
 uint32_t nsZipItem::LocalOffset() { return xtolong(central->localhdr_offset); }
 
@@ -68,6 +68,9 @@ class nsZipItem final {
 
   nsZipItem* next;
   const ZipCentral* central;
+  // The full 32-bit hash of the entry name, so that walking a hash chain
+  // can reject non-matching entries without touching their names.
+  uint32_t nameHash;
   uint16_t nameLength;
   bool isSynthetic;
 };
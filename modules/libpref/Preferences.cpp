@@ -583,6 +583,10 @@ static bool ShouldSanitizePreference(const Pref* const aPref);
 // content processes.
 static bool gContentProcessPrefsAreInited = false;
 
+// Incremented on every pref change in the parent process. Used to detect
+// whether cached serializations of the pref database are still current.
+static uint32_t gChangeGeneration = 0;
+
 class Pref {
  public:
   explicit Pref(const nsACString& aName)
@@ -1935,6 +1939,10 @@ static void NotifyCallbacks(const nsCString& aPrefName,
                             const PrefWrapper* aPref) {
   bool reentered = gCallbacksInProgress;
 
+  if (XRE_IsParentProcess()) {
+    gChangeGeneration++;
+  }
+
   gCallbackPref = aPref;
   auto cleanup = MakeScopeExit([]() { gCallbackPref = nullptr; });
 
@@ -3811,6 +3819,12 @@ Preferences::~Preferences() {
 NS_IMPL_ISUPPORTS(Preferences, nsIPrefService, nsIObserver, nsIPrefBranch,
                   nsISupportsWeakReference)
 
+/* static */
+uint32_t Preferences::ChangeGeneration() {
+  MOZ_ASSERT(XRE_IsParentProcess());
+  return gChangeGeneration;
+}
+
 /* static */
 void Preferences::SerializePreferences(nsCString& aStr,
                                        bool aIsDestinationWebContentProcess) {
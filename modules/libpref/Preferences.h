@@ -408,6 +408,11 @@ class Preferences final : public nsIPrefService,
   // prefs in bulk from the parent process, via shared memory.
   static void SerializePreferences(nsCString& aStr,
                                    bool aIsDestinationWebContentProcess);
+
+  // Returns a counter that is incremented whenever a pref changes in the
+  // parent process. Callers that cache a serialization of the pref database
+  // can compare generations to decide whether the cache is still usable.
+  static uint32_t ChangeGeneration();
   static void DeserializePreferences(const char* aStr, size_t aPrefsLen);
 
   static mozilla::ipc::ReadOnlySharedMemoryHandle EnsureSnapshot();
@@ -937,6 +937,19 @@ ProtocolHandlerInfo nsIOService::LookupProtocolHandler(
   nsAutoCString scheme(aScheme);
   ToLowerCase(scheme);
 
+  // In the default configuration no scheme is forced external by prefs, so a
+  // static protocol handler can be returned without taking mLock at all:
+  // static handlers cannot be overridden by dynamically registered ones, and
+  // none of the schemes hard-coded as external in UsesExternalProtocolHandler
+  // has a static handler.  This keeps the hot http(s) look-ups issued for
+  // every channel from contending with the lock.
+  if (mForceExternalSchemesEmpty) {
+    if (const xpcom::StaticProtocolHandler* handler =
+            xpcom::StaticProtocolHandler::Lookup(scheme)) {
+      return ProtocolHandlerInfo(*handler);
+    }
+  }
+
   // NOTE: If we could get rid of mForceExternalSchemes (or prevent them from
   // disabling static protocols), we could avoid locking mLock until we need to
   // check `mRuntimeProtocolHandlers.
@@ -1655,6 +1668,7 @@ void nsIOService::PrefsChanged(const char* pref) {
     }
     AutoWriteLock lock(mLock);
     mForceExternalSchemes = std::move(forceExternalSchemes);
+    mForceExternalSchemesEmpty = mForceExternalSchemes.IsEmpty();
   }
 
   if (!pref || strncmp(pref, SIMPLE_URI_SCHEMES_PREF,
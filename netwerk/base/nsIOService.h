@@ -236,6 +236,10 @@ class nsIOService final : public nsIIOService,
   RWLock mLock{"nsIOService::mLock"};
   nsTArray<int32_t> mRestrictedPortList MOZ_GUARDED_BY(mLock);
   nsTArray<nsCString> mForceExternalSchemes MOZ_GUARDED_BY(mLock);
+  // Mirrors mForceExternalSchemes.IsEmpty() so that LookupProtocolHandler()
+  // can serve static handlers without taking mLock in the default
+  // configuration (no network.protocol-handler.external.* prefs set).
+  mozilla::Atomic<bool, mozilla::Relaxed> mForceExternalSchemesEmpty{true};
   nsTHashMap<nsCString, RuntimeProtocolHandler> mRuntimeProtocolHandlers
       MOZ_GUARDED_BY(mLock);
 
@@ -724,9 +724,13 @@ nsresult nsInputStreamPump::CreateBufferedStreamIfNeeded() {
     return NS_OK;
   }
 
+  // Match the pipe segment size so the wrap copies at the same granularity
+  // the rest of necko moves data at, and honors the network.buffer.cache.size
+  // tuning pref instead of pinning high-throughput streams to 4K chunks.
   nsCOMPtr<nsIInputStream> stream;
-  nsresult rv = NS_NewBufferedInputStream(getter_AddRefs(stream),
-                                          mAsyncStream.forget(), 4096);
+  nsresult rv =
+      NS_NewBufferedInputStream(getter_AddRefs(stream), mAsyncStream.forget(),
+                                nsIOService::gDefaultSegmentSize);
   NS_ENSURE_SUCCESS(rv, rv);
 
   // A buffered inputStream must implement nsIAsyncInputStream.
@@ -587,30 +587,9 @@ void nsSocketTransportService::ApplyPortRemapPreference(
   }
 }
 
-PRIntervalTime nsSocketTransportService::PollTimeout(PRIntervalTime now) {
-  if (mActiveList.IsEmpty()) {
-    return NS_SOCKET_POLL_TIMEOUT;
-  }
-
-  // compute minimum time before any socket timeout expires.
-  PRIntervalTime minR = NS_SOCKET_POLL_TIMEOUT;
-  for (uint32_t i = 0; i < mActiveList.Length(); ++i) {
-    const SocketContext& s = mActiveList[i];
-    PRIntervalTime r = s.TimeoutIn(now);
-    if (r < minR) {
-      minR = r;
-    }
-  }
-  if (minR == NS_SOCKET_POLL_TIMEOUT) {
-    SOCKET_LOG(("poll timeout: none\n"));
-    return NS_SOCKET_POLL_TIMEOUT;
-  }
-  SOCKET_LOG(("poll timeout: %" PRIu32 "\n", PR_IntervalToSeconds(minR)));
-  return minR;
-}
-
 int32_t nsSocketTransportService::Poll(TimeDuration* pollDuration,
-                                       PRIntervalTime ts) {
+                                       PRIntervalTime ts,
+                                       PRIntervalTime aMinTimeout) {
   MOZ_ASSERT(IsOnCurrentThread());
   PRPollDesc* firstPollEntry;
   uint32_t pollCount;
@@ -626,7 +605,7 @@ int32_t nsSocketTransportService::Poll(TimeDuration* pollDuration,
     mPollList[0].out_flags = 0;
     firstPollEntry = &mPollList[0];
     pollCount = mPollList.Length();
-    pollTimeout = pendingEvents ? PR_INTERVAL_NO_WAIT : PollTimeout(ts);
+    pollTimeout = pendingEvents ? PR_INTERVAL_NO_WAIT : aMinTimeout;
   } else {
     // no pollable event, so busy wait...
     pollCount = mActiveList.Length();
@@ -1312,6 +1291,11 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
   // should become active.  take care to check only idle sockets that
   // were idle to begin with ;-)
   //
+  // while we are touching every active socket anyway, also compute the
+  // minimum time before any socket timeout expires, so the poll below
+  // doesn't have to scan the whole list a second time.
+  //
+  PRIntervalTime minTimeout = NS_SOCKET_POLL_TIMEOUT;
   count = mIdleList.Length();
   for (i = mActiveList.Length() - 1; i >= 0; --i) {
     //---
@@ -1331,7 +1315,11 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
         // update poll flags
         mPollList[i + 1].in_flags = in_flags;
         mPollList[i + 1].out_flags = 0;
+        // The epoch reset used to happen in the servicing loop below, but
+        // that loop no longer visits every socket; this walk does.
+        mActiveList[i].MaybeResetEpoch();
         mActiveList[i].EnsureTimeout(now);
+        minTimeout = std::min(minTimeout, mActiveList[i].TimeoutIn(now));
       }
     }
   }
@@ -1346,6 +1334,16 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
     if (NS_FAILED(mIdleList[i].mHandler->mCondition)) {
       DetachSocket(mIdleList, &mIdleList[i]);
     } else if (mIdleList[i].mHandler->mPollFlags != 0) {
+      // Compute the remaining timeout before the move; AddToPollList engages
+      // a fresh epoch for sockets that don't have one yet.
+      SocketContext& s = mIdleList[i];
+      PRIntervalTime r = s.mPollStartEpoch
+                             ? s.TimeoutIn(now)
+                             : (s.mHandler->mPollTimeout == UINT16_MAX
+                                    ? NS_SOCKET_POLL_TIMEOUT
+                                    : PR_SecondsToInterval(
+                                          s.mHandler->mPollTimeout));
+      minTimeout = std::min(minTimeout, r);
       MoveToPollList(&mIdleList[i]);
     }
   }
@@ -1376,12 +1374,13 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
 #if defined(XP_WIN)
     StartPolling();
 #endif
-    n = Poll(pollDuration, now);
+    n = Poll(pollDuration, now, minTimeout);
 #if defined(XP_WIN)
     EndPolling();
 #endif
   }
 
+  PRIntervalTime beforePoll = now;
   now = PR_IntervalNow();
 #ifdef MOZ_GECKO_PROFILER
   TimeStamp startTime;
@@ -1398,18 +1397,31 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
     //
     // service "active" sockets...
     //
+    // all ready sockets are serviced in one batch before any runnables
+    // dispatched by their handlers get to run.  once every ready descriptor
+    // has been handled and no socket can have timed out, stop scanning the
+    // remainder of the (potentially large) active list.
+    //
+    int32_t numberOfReadySockets = std::max(n, 0);
+    if (n > 0 && mPollList[0].out_flags != 0) {
+      numberOfReadySockets--;
+    }
+    bool timeoutsPossible =
+        minTimeout != NS_SOCKET_POLL_TIMEOUT && (now - beforePoll) >= minTimeout;
     for (i = 0; i < int32_t(mActiveList.Length()); ++i) {
+      if (numberOfReadySockets <= 0 && !timeoutsPossible) {
+        break;
+      }
       PRPollDesc& desc = mPollList[i + 1];
       SocketContext& s = mActiveList[i];
       if (n > 0 && desc.out_flags != 0) {
+        numberOfReadySockets--;
         s.DisengageTimeout();
         s.mHandler->OnSocketReady(desc.fd, desc.out_flags);
-      } else if (s.IsTimedOut(now)) {
+      } else if (timeoutsPossible && s.IsTimedOut(now)) {
         SOCKET_LOG(("socket %p timed out", s.mHandler.get()));
         s.DisengageTimeout();
         s.mHandler->OnSocketReady(desc.fd, -1);
-      } else {
-        s.MaybeResetEpoch();
       }
     }
     //
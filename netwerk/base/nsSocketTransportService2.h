@@ -255,11 +255,12 @@ class nsSocketTransportService final : public nsPISocketTransportService,
 
   nsTArray<PRPollDesc> mPollList;
 
-  PRIntervalTime PollTimeout(
-      PRIntervalTime now);  // computes ideal poll timeout
   nsresult DoPollIteration(TimeDuration* pollDuration);
   // perfoms a single poll iteration
-  int32_t Poll(TimeDuration* pollDuration, PRIntervalTime ts);
+  int32_t Poll(TimeDuration* pollDuration, PRIntervalTime ts,
+               PRIntervalTime aMinTimeout);
+  // aMinTimeout is the minimum time in which any active socket times out,
+  // computed by DoPollIteration while it walks the active list.
   // calls PR_Poll.  the out param
   // interval indicates the poll
   // duration in seconds.
@@ -14,6 +14,7 @@
 #include "CacheStorageService.h"
 #include "mozilla/IntegerPrintfMacros.h"
 #include "mozilla/Telemetry.h"
+#include "mozilla/glean/NetwerkCache2Metrics.h"
 #include "mozilla/psm/TransportSecurityInfo.h"
 #include "nsComponentManagerUtils.h"
 #include "nsIAsyncOutputStream.h"
@@ -1803,6 +1804,16 @@ void CacheEntry::BackgroundOp(uint32_t aOperations, bool aForceAsync)
     if (aOperations & Ops::FRECENCYUPDATE) {
       ++mUseCount;
 
+      if (mUseCount > 1 && !IsUsingDisk()) {
+        // A re-use promotes a memory-only entry from the probationary to the
+        // protected segment of the memory pool.  Count the hit against the
+        // segment the entry was found in; purges are counted in
+        // MemoryPool::PurgeByFrecency.
+        mozilla::glean::network::cache_memory_pool_segment
+            .Get(mUseCount == 2 ? "hit_probation"_ns : "hit_protected"_ns)
+            .Add(1);
+      }
+
 #ifndef M_LN2
 #  define M_LN2 0.69314718055994530942
 #endif
@@ -104,6 +104,10 @@ class CacheFileHandle final : public nsISupports {
   // flags are only accessed on the IO thread.
   bool mDoomWhenFoundPinned : 1;
   bool mDoomWhenFoundNonPinned : 1;
+  // Set on the first read from this handle once a readahead hint has been
+  // given to the OS so that we issue it only once per handle. Accessed only
+  // on the IO thread.
+  bool mReadAheadHinted : 1;
   // Set when after shutdown AND:
   // - when writing: writing data (not metadata) OR the physical file handle is
   //   not currently open
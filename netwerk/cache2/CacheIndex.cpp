@@ -25,6 +25,10 @@
 
 #define kMinUnwrittenChanges 300
 #define kMinDumpInterval 20000  // in milliseconds
+// Unwritten changes are flushed to the journal instead of dumping the whole
+// index as long as the dirty entries make up less than
+// 1/kJournalFlushMaxDirtyFraction of all active entries.
+#define kJournalFlushMaxDirtyFraction 4
 #define kMaxBufSize 16384
 #define kIndexVersion 0x0000000A
 #define kUpdateIndexStartDelay 50000  // in milliseconds
@@ -1159,6 +1163,7 @@ nsresult CacheIndex::RemoveAll() {
 
     index->mIndexOnDiskIsValid = false;
     index->mIndexNeedsUpdate = false;
+    index->mCanFlushJournal = false;
 
     index->mIndexStats.Clear();
     index->mFrecencyArray.Clear(lock);
@@ -1679,7 +1684,7 @@ void CacheIndex::ProcessPendingOperations(
 bool CacheIndex::WriteIndexToDiskIfNeeded(
     const StaticMutexAutoLock& aProofOfLock) {
   sLock.AssertCurrentThreadOwns();
-  if (mState != READY || mShuttingDown || mRWPending) {
+  if (mState != READY || mShuttingDown || mRWPending || mJournalFlushPending) {
     return false;
   }
 
@@ -1693,6 +1698,18 @@ bool CacheIndex::WriteIndexToDiskIfNeeded(
     return false;
   }
 
+  // When only a small fraction of the entries is dirty, flushing just those
+  // to the journal is much cheaper than rewriting the whole index. Once the
+  // dirty entries grow beyond the fraction, dump the whole index so that the
+  // accumulated changes (including removals) are folded into the index file
+  // and the journal starts from scratch.
+  if (mCanFlushJournal &&
+      mIndexStats.Dirty() * kJournalFlushMaxDirtyFraction <
+          mIndexStats.ActiveEntriesCount()) {
+    ScheduleJournalFlush(aProofOfLock);
+    return true;
+  }
+
   WriteIndexToDisk(aProofOfLock);
   return true;
 }
@@ -1882,6 +1899,9 @@ void CacheIndex::FinishWrite(bool aSucceeded,
     }
 
     mIndexOnDiskIsValid = true;
+    // All removals are now reflected in the index file, so incremental
+    // journal flushes can be written on top of it.
+    mCanFlushJournal = true;
   } else {
     if (mIndexFileOpener) {
       // If opening of the file is still in progress (e.g. WRITE process was
@@ -2087,6 +2107,141 @@ nsresult CacheIndex::WriteLogToDisk() {
   return NS_OK;
 }
 
+void CacheIndex::ScheduleJournalFlush(const StaticMutexAutoLock& aProofOfLock) {
+  sLock.AssertCurrentThreadOwns();
+  LOG(("CacheIndex::ScheduleJournalFlush()"));
+
+  MOZ_ASSERT(mState == READY);
+  MOZ_ASSERT(!mJournalFlushPending);
+
+  RefPtr<CacheIOThread> ioThread = CacheFileIOManager::IOThread();
+  MOZ_ASSERT(ioThread);
+
+  mJournalFlushPending = true;
+  nsresult rv = ioThread->Dispatch(this, CacheIOThread::INDEX);
+  if (NS_FAILED(rv)) {
+    mJournalFlushPending = false;
+    NS_WARNING("CacheIndex::ScheduleJournalFlush() - Can't dispatch event");
+    LOG(("CacheIndex::ScheduleJournalFlush() - Can't dispatch event"));
+  }
+}
+
+void CacheIndex::FlushJournalToDisk(const StaticMutexAutoLock& aProofOfLock) {
+  sLock.AssertCurrentThreadOwns();
+  MOZ_ASSERT(CacheFileIOManager::IsOnIOThread());
+  LOG(("CacheIndex::FlushJournalToDisk()"));
+
+  nsresult rv;
+
+  mJournalFlushPending = false;
+
+  if (mState != READY || mShuttingDown || !mCanFlushJournal) {
+    return;
+  }
+
+  MOZ_ASSERT(mPendingUpdates.Count() == 0);
+  mIndexStats.Log();
+
+  // The timestamp is taken before the records are snapshotted, so that any
+  // entry file modified after this point has a last modified time that is not
+  // lower than the timestamp and will be examined by the update process.
+  uint32_t timestamp = static_cast<uint32_t>(PR_Now() / PR_USEC_PER_SEC);
+
+  // Snapshot all unwritten changes under the lock. The journal is always
+  // written as a whole, so it accumulates every change made since the last
+  // dump of the whole index, including removals.
+  uint32_t count = 0;
+  for (auto iter = mIndex.Iter(); !iter.Done(); iter.Next()) {
+    CacheIndexEntry* entry = iter.Get();
+    if (entry->IsRemoved() || entry->IsDirty()) {
+      count++;
+    }
+  }
+
+  uint32_t bufSize =
+      count * sizeof(CacheIndexRecord) + sizeof(CacheHash::Hash32_t);
+  UniquePtr<char[]> buf = MakeUnique<char[]>(bufSize);
+  uint32_t bufPos = 0;
+  for (auto iter = mIndex.Iter(); !iter.Done(); iter.Next()) {
+    CacheIndexEntry* entry = iter.Get();
+    if (entry->IsRemoved() || entry->IsDirty()) {
+      entry->WriteToBuf(buf.get() + bufPos);
+      bufPos += sizeof(CacheIndexRecord);
+    }
+  }
+  MOZ_ASSERT(bufPos + sizeof(CacheHash::Hash32_t) == bufSize);
+
+  RefPtr<CacheHash> hash = new CacheHash();
+  hash->Update(buf.get(), bufPos);
+  NetworkEndian::writeUint32(buf.get() + bufPos, hash->GetHash());
+  bufPos += sizeof(CacheHash::Hash32_t);
+
+  nsCOMPtr<nsIFile> journalFile;
+  rv = GetFile(nsLiteralCString(JOURNAL_NAME), getter_AddRefs(journalFile));
+  NS_ENSURE_SUCCESS_VOID(rv);
+
+  nsCOMPtr<nsIFile> indexFile;
+  rv = GetFile(nsLiteralCString(INDEX_NAME), getter_AddRefs(indexFile));
+  NS_ENSURE_SUCCESS_VOID(rv);
+
+  bool success = false;
+  {
+    // Do not do IO under the lock.
+    StaticMutexAutoUnlock unlock(sLock);
+
+    PRFileDesc* fd = nullptr;
+    rv = journalFile->OpenNSPRFileDesc(
+        PR_RDWR | PR_CREATE_FILE | PR_TRUNCATE, 0600, &fd);
+    if (NS_SUCCEEDED(rv)) {
+      int32_t bytesWritten = PR_Write(fd, buf.get(), bufPos);
+      PR_Close(fd);
+
+      if (bytesWritten == static_cast<int32_t>(bufPos)) {
+        // The journal is complete on disk, now update the timestamp and the
+        // dirty flag in the index header so that the journal is applied on
+        // top of the index on the next startup.
+        rv = indexFile->OpenNSPRFileDesc(PR_RDWR, 0600, &fd);
+        if (NS_SUCCEEDED(rv)) {
+          static_assert(
+              sizeof(uint32_t) == offsetof(CacheIndexHeader, mTimeStamp),
+              "Unexpected offset of CacheIndexHeader::mTimeStamp");
+          int64_t offset = PR_Seek64(fd, sizeof(uint32_t), PR_SEEK_SET);
+          if (offset != -1) {
+            char headerBuf[2 * sizeof(uint32_t)];
+            NetworkEndian::writeUint32(headerBuf, timestamp);
+            NetworkEndian::writeUint32(headerBuf + sizeof(uint32_t),
+                                       kIndexHeaderRuntimeFlushed);
+            success = PR_Write(fd, headerBuf, sizeof(headerBuf)) ==
+                      static_cast<int32_t>(sizeof(headerBuf));
+          }
+          PR_Close(fd);
+        }
+      }
+
+      if (!success) {
+        // An incomplete journal must not survive; the header still marks the
+        // index as dirty, but remove the file to be safe.
+        journalFile->Remove(false);
+      }
+    }
+  }
+
+  if (mState != READY || mShuttingDown) {
+    // The index was shut down or removed while the lock was released.
+    return;
+  }
+
+  if (success) {
+    LOG(("CacheIndex::FlushJournalToDisk() - Flushed %u entries", count));
+    mLastDumpTime = TimeStamp::NowLoRes();
+  } else {
+    LOG(("CacheIndex::FlushJournalToDisk() - Failed, falling back to dump"));
+    // Fall back to dumping the whole index; a successful dump re-enables
+    // incremental flushes.
+    mCanFlushJournal = false;
+  }
+}
+
 void CacheIndex::ReadIndexFromDisk(const StaticMutexAutoLock& aProofOfLock) {
   sLock.AssertCurrentThreadOwns();
   LOG(("CacheIndex::ReadIndexFromDisk()"));
@@ -2203,15 +2358,24 @@ void CacheIndex::ParseRecords(const StaticMutexAutoLock& aProofOfLock) {
     mIndexTimeStamp = NetworkEndian::readUint32(mRWBuf + pos);
     pos += sizeof(uint32_t);
 
-    if (NetworkEndian::readUint32(mRWBuf + pos)) {
+    uint32_t dirtyFlag = NetworkEndian::readUint32(mRWBuf + pos);
+    if (dirtyFlag != kIndexHeaderClean &&
+        dirtyFlag != kIndexHeaderRuntimeFlushed) {
       if (mJournalHandle) {
         CacheFileIOManager::DoomFile(mJournalHandle, nullptr);
         mJournalHandle = nullptr;
       }
     } else {
+      if (dirtyFlag == kIndexHeaderRuntimeFlushed) {
+        // The journal was written by a periodic runtime flush, not a clean
+        // shutdown. It can be applied on top of the index, but the update
+        // process must examine files modified after the flush.
+        mJournalFromRuntimeFlush = true;
+      }
+
       uint32_t* isDirty =
           reinterpret_cast<uint32_t*>(moz_xmalloc(sizeof(uint32_t)));
-      NetworkEndian::writeUint32(isDirty, 1);
+      NetworkEndian::writeUint32(isDirty, kIndexHeaderDirty);
 
       // Mark index dirty. The buffer will be freed by CacheFileIOManager.
       CacheFileIOManager::WriteWithoutCallback(
@@ -2562,6 +2726,20 @@ void CacheIndex::FinishRead(bool aSucceeded,
   ProcessPendingOperations(aProofOfLock);
   mIndexStats.Log();
 
+  if (mJournalFromRuntimeFlush) {
+    // The journal came from a periodic runtime flush, so the index is
+    // accurate only up to the time of that flush. Start the update process to
+    // reconcile changes made between the flush and the crash; mIndexTimeStamp
+    // limits the parsing to files modified after the flush.
+    mJournalFromRuntimeFlush = false;
+    StartUpdatingIndex(false, aProofOfLock);
+    return;
+  }
+
+  // The data on disk is complete, so incremental journal flushes can be
+  // written on top of it.
+  mCanFlushJournal = true;
+
   ChangeState(READY, aProofOfLock);
   mLastDumpTime = TimeStamp::NowLoRes();  // Do not dump new index immediately
 }
@@ -3224,6 +3402,12 @@ void CacheIndex::FinishUpdate(bool aSucceeded,
   // reason to believe that it will succeed next time.
   mIndexNeedsUpdate = false;
 
+  // The build and update processes remove entries from memory without leaving
+  // a removed entry behind, so the index file on disk may contain entries that
+  // a journal flush would not mark as removed. Force a full dump before any
+  // incremental flush.
+  mCanFlushJournal = false;
+
   ChangeState(READY, aProofOfLock);
   mLastDumpTime = TimeStamp::NowLoRes();  // Do not dump new index immediately
 }
@@ -3495,6 +3679,7 @@ nsresult CacheIndex::Run() {
   }
 
   if (mState == READY && mShuttingDown) {
+    mJournalFlushPending = false;
     return NS_OK;
   }
 
@@ -3507,6 +3692,12 @@ nsresult CacheIndex::Run() {
     case UPDATING:
       UpdateIndex(lock);
       break;
+    case READY:
+      if (mJournalFlushPending) {
+        FlushJournalToDisk(lock);
+        break;
+      }
+      [[fallthrough]];
     default:
       LOG(("CacheIndex::Run() - Update/Build was canceled"));
   }
@@ -41,6 +41,16 @@ class CacheIndexIterator;
 const uint16_t kIndexTimeNotAvailable = 0xFFFFU;
 const uint16_t kIndexTimeOutOfBound = 0xFFFEU;
 
+// Values of CacheIndexHeader::mIsDirty. kIndexHeaderRuntimeFlushed means that
+// the index file and the journal were last written by a periodic runtime
+// flush instead of a clean shutdown; the journal can be applied on top of the
+// index, but the entries directory must still be reconciled with changes made
+// after the flush. Any other non-zero value is treated the same as
+// kIndexHeaderDirty, so older versions fall back to the update process.
+const uint32_t kIndexHeaderClean = 0;
+const uint32_t kIndexHeaderDirty = 1;
+const uint32_t kIndexHeaderRuntimeFlushed = 2;
+
 using CacheIndexHeader = struct {
   // Version of the index. The index must be ignored and deleted when the file
   // on disk was written with a newer version.
@@ -53,10 +63,11 @@ using CacheIndexHeader = struct {
   // date.
   uint32_t mTimeStamp;
 
-  // We set this flag as soon as possible after parsing index during startup
-  // and clean it after we write journal to disk during shutdown. We ignore the
-  // journal and start update process whenever this flag is set during index
-  // parsing.
+  // We set this flag to kIndexHeaderDirty as soon as possible after parsing
+  // index during startup and clean it after we write journal to disk during
+  // shutdown. A periodic runtime flush of the journal sets it to
+  // kIndexHeaderRuntimeFlushed. We ignore the journal and start update
+  // process whenever this flag is kIndexHeaderDirty during index parsing.
   uint32_t mIsDirty;
 
   // The amount of data written to the cache. When it reaches
@@ -897,6 +908,23 @@ class CacheIndex final : public CacheFileIOListener, public nsIRunnable {
   // Writes journal to the disk and clears dirty flag in index header.
   nsresult WriteLogToDisk() MOZ_REQUIRES(sLock);
 
+  // Following methods perform an incremental flush of unwritten changes at
+  // runtime. Instead of dumping the whole index every kMinDumpInterval, only
+  // the dirty entries are written to the journal file and the dirty flag in
+  // the index header is set to kIndexHeaderRuntimeFlushed. When FF crashes,
+  // the journal is applied on top of the index file on the next startup and
+  // the update process has to parse only files modified after the flush.
+  //
+  // Dispatches an event that calls FlushJournalToDisk() on the IO thread.
+  void ScheduleJournalFlush(const StaticMutexAutoLock& aProofOfLock)
+      MOZ_REQUIRES(sLock);
+  // Writes all dirty entries to the journal file and updates timestamp and
+  // dirty flag in the index header. Called on the IO thread; the records are
+  // snapshotted under the lock and written to disk without it, so that other
+  // threads can keep updating the index in the meantime.
+  void FlushJournalToDisk(const StaticMutexAutoLock& aProofOfLock)
+      MOZ_REQUIRES(sLock);
+
   // Following methods perform reading of the index from the disk.
   //
   // Index is read at startup just after initializing the CacheIndex. There are
@@ -916,6 +944,8 @@ class CacheIndex final : public CacheFileIOListener, public nsIRunnable {
   // C      I        *       - unexpected state    -> UPDATE
   // C      V        E       - unexpected state    -> UPDATE
   // C      V        M       - index is up to date -> READY
+  // R      M/I      *       - index is dirty      -> UPDATE
+  // R      V        M       - journal from flush  -> merge journal, UPDATE
   //
   // where the letters mean:
   //   * - any state
@@ -925,9 +955,14 @@ class CacheIndex final : public CacheFileIOListener, public nsIRunnable {
   //   D - dirty (data in index file is correct, but dirty flag is set)
   //   C - clean (index file is clean)
   //   V - valid (data in journal file is correct)
+  //   R - runtime-flushed (data in index file is correct, dirty flag is
+  //       kIndexHeaderRuntimeFlushed)
   //
   // Note: We accept the data from journal only when the index is up to date as
-  // a whole (i.e. C,V,M state).
+  // a whole (i.e. C,V,M state) or when both were written by a runtime flush
+  // (R,V,M state). In the latter case the update process still runs afterwards
+  // to reconcile changes made after the flush, limited by the header timestamp
+  // to files modified since then.
   //
   // We rename the journal file to the temporary file as soon as possible after
   // initial test to ensure that we start update process on the next startup if
@@ -1143,6 +1178,21 @@ class CacheIndex final : public CacheFileIOListener, public nsIRunnable {
   // Reading of journal succeeded if true.
   bool mJournalReadSuccessfully MOZ_GUARDED_BY(sLock){false};
 
+  // The journal that is being read was written by a runtime flush (see
+  // FlushJournalToDisk()) instead of a clean shutdown. If true, the update
+  // process must be started after merging the journal to pick up changes made
+  // between the flush and the crash.
+  bool mJournalFromRuntimeFlush MOZ_GUARDED_BY(sLock){false};
+
+  // An incremental journal flush is allowed only when the index file on disk
+  // contains all removals, i.e. after a successful write of the whole index.
+  // The build and update processes can remove entries from memory without
+  // leaving a removed entry behind, so they clear this flag.
+  bool mCanFlushJournal MOZ_GUARDED_BY(sLock){false};
+
+  // A journal flush event was dispatched to the IO thread and hasn't run yet.
+  bool mJournalFlushPending MOZ_GUARDED_BY(sLock){false};
+
   // Handle used for writing and reading index file.
   RefPtr<CacheFileHandle> mIndexHandle MOZ_GUARDED_BY(sLock);
   // Handle used for reading journal file.
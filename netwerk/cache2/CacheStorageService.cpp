@@ -1472,13 +1472,23 @@ Result<size_t, nsresult> CacheStorageService::MemoryPool::PurgeByFrecency(
   struct mayPurgeEntry {
     RefPtr<CacheEntry> mEntry;
     double mFrecency;
+    bool mProtected;
 
     explicit mayPurgeEntry(CacheEntry* aEntry) {
       mEntry = aEntry;
       mFrecency = aEntry->GetFrecency();
+      // Entries re-used at least once since their admission belong to the
+      // protected segment, the rest to the probationary one.
+      mProtected = aEntry->UseCount() > 1;
     }
 
     bool operator<(const mayPurgeEntry& aOther) const {
+      // The probationary segment sorts before the protected one, so that
+      // one-shot entries are abandoned first; within a segment the least
+      // frecent entries go first.
+      if (mProtected != aOther.mProtected) {
+        return !mProtected;
+      }
       return mFrecency < aOther.mFrecency;
     }
   };
@@ -1516,8 +1526,15 @@ Result<size_t, nsresult> CacheStorageService::MemoryPool::PurgeByFrecency(
 
     if (entry->Purge(CacheEntry::PURGE_WHOLE)) {
       numPurged++;
-      LOG(("  abandoned (%d), entry=%p, frecency=%1.10f",
-           CacheEntry::PURGE_WHOLE, entry.get(), entry->GetFrecency()));
+      if (mType == EType::MEMORY) {
+        mozilla::glean::network::cache_memory_pool_segment
+            .Get(checkPurge.mProtected ? "purge_protected"_ns
+                                       : "purge_probation"_ns)
+            .Add(1);
+      }
+      LOG(("  abandoned (%d), entry=%p, frecency=%1.10f, protected=%d",
+           CacheEntry::PURGE_WHOLE, entry.get(), entry->GetFrecency(),
+           checkPurge.mProtected));
     }
 
     if (numPurged >= minprogress && CacheIOThread::YieldAndRerun()) {
@@ -346,7 +346,11 @@ class CacheStorageService final : public nsICacheStorageService,
     bool OnMemoryConsumptionChange(uint32_t aSavedMemorySize,
                                    uint32_t aCurrentMemoryConsumption);
     /**
-     * Purges entries from memory based on the frecency ordered array.
+     * Purges entries from memory in two segments: the probationary segment
+     * (entries never re-used since their admission) is abandoned first, the
+     * protected segment (re-used entries) only when we are still over the
+     * limit.  Within each segment the least frecent entries go first.  This
+     * keeps one-shot streams from evicting frequently hit small resources.
      */
     void PurgeExpiredOrOverMemoryLimit();
     size_t PurgeExpired(size_t minprogress);
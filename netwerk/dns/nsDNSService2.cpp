@@ -33,6 +33,9 @@
 #include "nsQueryObject.h"
 #include "nsIObserverService.h"
 #include "nsINetworkLinkService.h"
+#include "nsIFile.h"
+#include "nsAppDirectoryServiceDefs.h"
+#include "nsDirectoryServiceUtils.h"
 #include "DNSAdditionalInfo.h"
 #include "TRRService.h"
 
@@ -46,6 +49,7 @@
 #include "mozilla/StaticPtr.h"
 #include "mozilla/SyncRunnable.h"
 #include "mozilla/TextUtils.h"
+#include "mozilla/Unused.h"
 #include "mozilla/Utf8.h"
 
 using namespace mozilla;
@@ -61,6 +65,29 @@ static const char kPrefDnsForceResolve[] = "network.dns.forceResolve";
 static const char kPrefDnsNotifyResolution[] = "network.dns.notifyResolution";
 static const char kPrefDnsMockHTTPSRRDomain[] =
     "network.dns.mock_HTTPS_RR_domain";
+static const char kPrefDnsPersistCache[] = "network.dns.persistCache";
+
+// Name of the persisted DNS cache snapshot in the profile directory.
+static const char kDnsCacheFileName[] = "dnscache.txt";
+
+static already_AddRefed<nsIFile> GetPersistedDNSCacheFile() {
+  if (!XRE_IsParentProcess() ||
+      !Preferences::GetBool(kPrefDnsPersistCache, false)) {
+    return nullptr;
+  }
+
+  nsCOMPtr<nsIFile> file;
+  nsresult rv = NS_GetSpecialDirectory(NS_APP_USER_PROFILE_50_DIR,
+                                       getter_AddRefs(file));
+  if (NS_FAILED(rv)) {
+    return nullptr;
+  }
+  rv = file->AppendNative(nsDependentCString(kDnsCacheFileName));
+  if (NS_FAILED(rv)) {
+    return nullptr;
+  }
+  return file.forget();
+}
 
 //-----------------------------------------------------------------------------
 
@@ -892,6 +919,21 @@ nsDNSService::Init() {
     mTrrService = nullptr;
   }
 
+  if (res) {
+    if (nsCOMPtr<nsIFile> file = GetPersistedDNSCacheFile()) {
+      // Warm the cache with the records the previous session persisted.  The
+      // file is read off the main thread; the resolver never overwrites
+      // records resolved in this session and drops any persisted record whose
+      // TTL ran out while we were gone.
+      NS_DispatchBackgroundTask(
+          NS_NewRunnableFunction("nsDNSService::LoadPersistedDNSCache",
+                                 [res, file]() {
+                                   Unused << res->LoadCacheFromFile(file);
+                                 }),
+          NS_DISPATCH_EVENT_MAY_BLOCK);
+    }
+  }
+
   return NS_OK;
 }
 
@@ -905,6 +947,11 @@ nsDNSService::Shutdown() {
     res = std::move(mResolver);
   }
   if (res) {
+    if (nsCOMPtr<nsIFile> file = GetPersistedDNSCacheFile()) {
+      // Snapshot still-valid records for the next session before the
+      // resolver drops them.
+      Unused << res->SaveCacheToFile(file);
+    }
     // Shutdown outside lock.
     res->Shutdown();
   }
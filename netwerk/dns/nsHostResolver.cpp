@@ -16,6 +16,7 @@
 #include <ctime>
 #include "nsHostResolver.h"
 #include "nsError.h"
+#include "nsIFile.h"
 #include "nsIOService.h"
 #include "nsISupports.h"
 #include "nsISupportsUtils.h"
@@ -1993,5 +1994,208 @@ void nsHostResolver::GetDNSCacheEntries(nsTArray<DNSCacheEntries>* args) {
   }
 }
 
+// The persisted DNS cache is a plain text, tab separated format: the first
+// line carries the format version, every following line one record as host,
+// origin suffix, address family, absolute expiration time in seconds since
+// the epoch and a comma separated address list.  Only the fresh part of the
+// lifetime (up to mGraceStart) is persisted, so restored records honor the
+// TTL the server originally handed out.
+static const uint32_t kDNSCacheFileVersion = 1;
+
+nsresult nsHostResolver::SaveCacheToFile(nsIFile* aFile) {
+  nsAutoCString payload;
+  payload.AppendInt(kDNSCacheFileVersion);
+  payload.Append('\n');
+
+  uint32_t numRecords = 0;
+  uint32_t const maxRecords = StaticPrefs::network_dnsCacheEntries();
+  int64_t const nowEpoch = PR_Now() / PR_USEC_PER_SEC;
+  TimeStamp now = TimeStamp::NowLoRes();
+
+  {
+    MutexAutoLock lock(mLock);
+    for (const auto& recordEntry : mRecordDB) {
+      nsHostRecord* rec = recordEntry.GetWeak();
+      if (!rec || !IS_ADDR_TYPE(rec->type) || rec->pb ||
+          !rec->mTrrServer.IsEmpty() ||
+          rec->flags != nsIDNSService::RESOLVE_DEFAULT_FLAGS ||
+          rec->negative || rec->mGraceStart.IsNull() ||
+          rec->mGraceStart <= now) {
+        continue;
+      }
+
+      RefPtr<AddrHostRecord> addrRec = do_QueryObject(rec);
+      if (!addrRec) {
+        continue;
+      }
+
+      nsAutoCString addresses;
+      {
+        MutexAutoLock addrLock(addrRec->addr_info_lock);
+        if (!addrRec->addr_info) {
+          continue;
+        }
+        for (const auto& addr : addrRec->addr_info->Addresses()) {
+          char buf[kIPv6CStrBufSize];
+          if (addr.ToStringBuffer(buf, sizeof(buf))) {
+            if (!addresses.IsEmpty()) {
+              addresses.Append(',');
+            }
+            addresses.Append(buf);
+          }
+        }
+      }
+      if (addresses.IsEmpty()) {
+        continue;
+      }
+
+      payload.Append(rec->host);
+      payload.Append('\t');
+      payload.Append(rec->originSuffix);
+      payload.Append('\t');
+      payload.AppendInt(rec->af);
+      payload.Append('\t');
+      payload.AppendInt(nowEpoch +
+                        (int64_t)((rec->mGraceStart - now).ToSeconds()));
+      payload.Append('\t');
+      payload.Append(addresses);
+      payload.Append('\n');
+
+      if (++numRecords >= maxRecords) {
+        break;
+      }
+    }
+  }
+
+  PRFileDesc* fd = nullptr;
+  nsresult rv = aFile->OpenNSPRFileDesc(PR_WRONLY | PR_CREATE_FILE | PR_TRUNCATE,
+                                        0600, &fd);
+  NS_ENSURE_SUCCESS(rv, rv);
+
+  int32_t written = PR_Write(fd, payload.get(), payload.Length());
+  PR_Close(fd);
+  if (written != (int32_t)payload.Length()) {
+    aFile->Remove(false);
+    return NS_ERROR_FAILURE;
+  }
+
+  LOG(("nsHostResolver::SaveCacheToFile persisted %u records", numRecords));
+  return NS_OK;
+}
+
+nsresult nsHostResolver::LoadCacheFromFile(nsIFile* aFile) {
+  // Refuse to parse unreasonably large files; the snapshot is already capped
+  // by network.dnsCacheEntries at save time.
+  static const int64_t kMaxFileSize = 2 * 1024 * 1024;
+
+  int64_t fileSize = 0;
+  nsresult rv = aFile->GetFileSize(&fileSize);
+  NS_ENSURE_SUCCESS(rv, rv);
+  if (fileSize <= 0 || fileSize > kMaxFileSize) {
+    return NS_ERROR_FILE_CORRUPTED;
+  }
+
+  PRFileDesc* fd = nullptr;
+  rv = aFile->OpenNSPRFileDesc(PR_RDONLY, 0, &fd);
+  NS_ENSURE_SUCCESS(rv, rv);
+
+  nsAutoCString payload;
+  if (!payload.SetLength((uint32_t)fileSize, fallible)) {
+    PR_Close(fd);
+    return NS_ERROR_OUT_OF_MEMORY;
+  }
+  int32_t read = PR_Read(fd, payload.BeginWriting(), (int32_t)fileSize);
+  PR_Close(fd);
+  if (read != (int32_t)fileSize) {
+    return NS_ERROR_FAILURE;
+  }
+
+  int64_t const nowEpoch = PR_Now() / PR_USEC_PER_SEC;
+  TimeStamp now = TimeStamp::NowLoRes();
+  unsigned int const grace =
+      StaticPrefs::network_dnsCacheExpirationGracePeriod();
+
+  uint32_t numRestored = 0;
+  bool versionChecked = false;
+  for (const nsACString& line : payload.Split('\n')) {
+    if (!versionChecked) {
+      nsresult parseRv;
+      uint32_t version = PromiseFlatCString(line).ToInteger(&parseRv);
+      if (NS_FAILED(parseRv) || version != kDNSCacheFileVersion) {
+        return NS_ERROR_FILE_CORRUPTED;
+      }
+      versionChecked = true;
+      continue;
+    }
+    if (line.IsEmpty()) {
+      continue;
+    }
+
+    nsTArray<nsCString> fields;
+    for (const nsACString& field : line.Split('\t')) {
+      fields.AppendElement(field);
+    }
+    if (fields.Length() != 5) {
+      continue;
+    }
+
+    nsresult parseRv;
+    uint16_t af = (uint16_t)fields[2].ToInteger(&parseRv);
+    if (NS_FAILED(parseRv)) {
+      continue;
+    }
+    int64_t expiration = fields[3].ToInteger64(&parseRv);
+    if (NS_FAILED(parseRv)) {
+      continue;
+    }
+
+    int64_t remaining = expiration - nowEpoch;
+    if (remaining <= 0) {
+      // The TTL ran out while we were gone.
+      continue;
+    }
+
+    nsTArray<NetAddr> addrs;
+    for (const nsACString& addrStr : fields[4].Split(',')) {
+      NetAddr addr;
+      if (NS_SUCCEEDED(addr.InitFromString(addrStr))) {
+        addrs.AppendElement(addr);
+      }
+    }
+    if (addrs.IsEmpty()) {
+      continue;
+    }
+
+    nsHostKey key(fields[0], ""_ns, nsIDNSService::RESOLVE_TYPE_DEFAULT,
+                  nsIDNSService::RESOLVE_DEFAULT_FLAGS, af, false, fields[1]);
+
+    MutexAutoLock lock(mLock);
+    if (mShutdown) {
+      return NS_ERROR_NOT_INITIALIZED;
+    }
+    if (mRecordDB.Get(key)) {
+      // Never clobber a record resolved in this session.
+      continue;
+    }
+
+    RefPtr<nsHostRecord> rec = InitRecord(key);
+    RefPtr<AddrHostRecord> addrRec = do_QueryObject(rec);
+    MOZ_ASSERT(addrRec);
+    {
+      MutexAutoLock addrLock(addrRec->addr_info_lock);
+      addrRec->addr_info =
+          new AddrInfo(key.host, DNSResolverType::Native, 0, std::move(addrs),
+                       (uint32_t)remaining);
+    }
+    addrRec->SetExpiration(now, (uint32_t)remaining, grace);
+    mRecordDB.InsertOrUpdate(key, rec);
+    AddToEvictionQ(rec, lock);
+    numRestored++;
+  }
+
+  LOG(("nsHostResolver::LoadCacheFromFile restored %u records", numRestored));
+  return NS_OK;
+}
+
 #undef LOG
 #undef LOG_ENABLED
@@ -29,6 +29,8 @@
 #include "mozilla/Maybe.h"
 #include "mozilla/StaticPrefs_network.h"
 
+class nsIFile;
+
 namespace mozilla {
 namespace net {
 class TRR;
@@ -308,6 +310,17 @@ class nsHostResolver : public nsISupports, public AHostResolver {
    */
   void GetDNSCacheEntries(nsTArray<mozilla::net::DNSCacheEntries>*);
 
+  /**
+   * Persists still-valid positive records to aFile so that the next session
+   * can start with a warm DNS cache, and restores such a snapshot again.
+   * Only default-type, default-flags, non-private records resolved without a
+   * custom TRR server are stored.  Both methods may be called on any thread.
+   * LoadCacheFromFile never overwrites records resolved in this session and
+   * drops persisted records whose TTL has run out in the meantime.
+   */
+  nsresult SaveCacheToFile(nsIFile* aFile);
+  nsresult LoadCacheFromFile(nsIFile* aFile);
+
   static bool IsNativeHTTPSEnabled();
 };
 
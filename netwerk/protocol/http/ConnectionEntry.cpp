@@ -222,6 +222,7 @@ void ConnectionEntry::InsertTransaction(
   mPendingQ.InsertTransaction(pendingTransInfo,
                               aInsertAsFirstForTheSamePriority);
   pendingTransInfo->Transaction()->OnPendingQueueInserted(mConnInfo->HashKey());
+  gHttpHandler->ConnMgr()->NotePendingQ(this);
 }
 
 nsTArray<RefPtr<PendingTransactionInfo>>*
@@ -2631,7 +2631,22 @@ nsresult Http2Session::ReadSegmentsAgain(nsAHttpSegmentReader* reader,
   // tries to flush the output queue) - SENDING_FIN_STREAM can be an example
   // of that. But we might still have old data buffered that would be good
   // to flush.
-  FlushOutputQueue();
+  //
+  // However, when this stream produced data, other streams are waiting their
+  // turn in this same tick, and the staging buffer is still small, defer the
+  // flush: the caller loops straight back into ReadSegmentsAgain, so the next
+  // stream's frames are appended to the staged bytes and shipped in the same
+  // OnReadSegment call rather than costing one socket write per stream. Once
+  // the ready queue drains, the no-stream path above flushes whatever has
+  // accumulated.
+  if (NS_SUCCEEDED(rv) && *countRead > 0 && !mAttemptingEarlyData &&
+      GetWriteQueueSize() &&
+      ((mOutputQueueUsed - mOutputQueueSent) < kCoalesceFlushThreshold)) {
+    LOG3(("Http2Session %p deferring flush of %u bytes for coalescing", this,
+          mOutputQueueUsed - mOutputQueueSent));
+  } else {
+    FlushOutputQueue();
+  }
 
   // Allow new server reads - that might be data or control information
   // (e.g. window updates or http replies) that are responses to these writes
@@ -180,6 +180,12 @@ class Http2Session final : public ASpdySession,
   const static uint32_t kQueueTailRoom = 4096;
   const static uint32_t kQueueReserved = 1024;
 
+  // While more streams are ready to write in the same tick, output queue
+  // flushes are deferred until this many bytes have been staged, so that
+  // small frames from many streams share one OnReadSegment call (and
+  // therefore one socket write) instead of costing one write per stream.
+  const static uint32_t kCoalesceFlushThreshold = 16384;
+
   const static uint32_t kMaxStreamID = 0x7800000;
 
   // This is a sentinel for a deleted stream. It is not a valid
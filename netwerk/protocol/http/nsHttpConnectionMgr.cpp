@@ -1217,6 +1217,47 @@ bool nsHttpConnectionMgr::ProcessPendingQForEntry(nsHttpConnectionInfo* ci) {
   return false;
 }
 
+void nsHttpConnectionMgr::NotePendingQ(ConnectionEntry* ent) {
+  MOZ_ASSERT(OnSocketThread(), "not on socket thread");
+  mEntriesWithPendingQ.Insert(ent->mConnInfo->HashKey());
+}
+
+bool nsHttpConnectionMgr::ProcessPendingQForIndexedEntries(bool considerAll) {
+  MOZ_ASSERT(OnSocketThread(), "not on socket thread");
+
+  // ProcessPendingQForEntry re-inserts the transactions it could not
+  // dispatch, which feeds back into mEntriesWithPendingQ, so iterate over a
+  // snapshot of the keys rather than the live set.
+  nsTArray<nsCString> keys(mEntriesWithPendingQ.Count());
+  for (const auto& key : mEntriesWithPendingQ) {
+    keys.AppendElement(key);
+  }
+
+  bool dispatchedSuccessfully = false;
+  for (const auto& key : keys) {
+    ConnectionEntry* ent = mCT.GetWeak(key);
+    if (!ent ||
+        (!ent->PendingQueueLength() && !ent->UrgentStartQueueLength())) {
+      // The entry went away or drained since it was indexed.
+      mEntriesWithPendingQ.Remove(key);
+      continue;
+    }
+
+    if (ProcessPendingQForEntry(ent, considerAll)) {
+      dispatchedSuccessfully = true;
+      if (!considerAll) {
+        break;
+      }
+    }
+
+    if (!ent->PendingQueueLength() && !ent->UrgentStartQueueLength()) {
+      mEntriesWithPendingQ.Remove(key);
+    }
+  }
+
+  return dispatchedSuccessfully;
+}
+
 // we're at the active connection limit if any one of the following conditions
 // is true:
 //  (1) at max-connections
@@ -2299,10 +2340,8 @@ void nsHttpConnectionMgr::OnMsgProcessPendingQ(int32_t, ARefBase* param) {
 
   if (!ci) {
     LOG(("nsHttpConnectionMgr::OnMsgProcessPendingQ [ci=nullptr]\n"));
-    // Try and dispatch everything
-    for (const auto& entry : mCT.Values()) {
-      Unused << ProcessPendingQForEntry(entry.get(), true);
-    }
+    // Try and dispatch everything that has something queued.
+    Unused << ProcessPendingQForIndexedEntries(true);
     return;
   }
 
@@ -2313,12 +2352,9 @@ void nsHttpConnectionMgr::OnMsgProcessPendingQ(int32_t, ARefBase* param) {
   ConnectionEntry* ent = mCT.GetWeak(ci->HashKey());
   if (!(ent && ProcessPendingQForEntry(ent, false))) {
     // if we reach here, it means that we couldn't dispatch a transaction
-    // for the specified connection info.  walk the connection table...
-    for (const auto& entry : mCT.Values()) {
-      if (ProcessPendingQForEntry(entry.get(), false)) {
-        break;
-      }
-    }
+    // for the specified connection info.  walk the entries known to have
+    // queued transactions...
+    Unused << ProcessPendingQForIndexedEntries(false);
   }
 }
 
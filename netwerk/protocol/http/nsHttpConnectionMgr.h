@@ -12,6 +12,7 @@
 #include "nsHttpConnection.h"
 #include "nsHttpTransaction.h"
 #include "nsTArray.h"
+#include "nsTHashSet.h"
 #include "nsThreadUtils.h"
 #include "nsClassHashtable.h"
 #include "mozilla/ReentrantMonitor.h"
@@ -182,6 +183,11 @@ class nsHttpConnectionMgr final : public HttpConnectionMgrShell,
 
   [[nodiscard]] bool ProcessPendingQForEntry(nsHttpConnectionInfo*);
 
+  // Called by ConnectionEntry whenever a transaction is placed in its
+  // pending or urgent-start queue, so the "process everything" dispatch
+  // paths can visit it without scanning the whole connection table.
+  void NotePendingQ(ConnectionEntry* ent);
+
   // public, so that the SPDY/http2 seesions can activate
   void ActivateTimeoutTick();
 
@@ -246,6 +252,11 @@ class nsHttpConnectionMgr final : public HttpConnectionMgrShell,
 
   [[nodiscard]] bool ProcessPendingQForEntry(ConnectionEntry*,
                                              bool considerAll);
+  // Runs ProcessPendingQForEntry over the entries recorded in
+  // mEntriesWithPendingQ, pruning keys whose queues have drained or whose
+  // entry no longer exists. When |considerAll| is false the walk stops at
+  // the first successful dispatch.
+  bool ProcessPendingQForIndexedEntries(bool considerAll);
   bool DispatchPendingQ(nsTArray<RefPtr<PendingTransactionInfo>>& pendingQ,
                         ConnectionEntry* ent, bool considerAll);
 
@@ -383,6 +394,14 @@ class nsHttpConnectionMgr final : public HttpConnectionMgrShell,
   //
   nsRefPtrHashtable<nsCStringHashKey, ConnectionEntry> mCT;
 
+  // Keys of entries in mCT that have (or recently had) transactions waiting
+  // in their pending or urgent-start queues. mCT grows with every origin
+  // contacted during a session, so the dispatch paths that used to walk the
+  // whole table iterate this much smaller set instead. Keys are added when a
+  // transaction is queued and removed lazily when a walk finds the queues
+  // empty. Socket thread only.
+  nsTHashSet<nsCString> mEntriesWithPendingQ;
+
   // Read Timeout Tick handlers
   void TimeoutTick();
 
@@ -51,6 +51,10 @@ class BrotliWrapper {
   nsresult mStatus = NS_OK;
   Atomic<bool, Relaxed> mBrotliStateIsStreamEnd{false};
 
+  // Decompression output buffer, allocated lazily on the first chunk and
+  // reused for every subsequent OnDataAvailable call, like the zstd path.
+  UniquePtr<uint8_t[]> mOutBuffer;
+
   nsIRequest* mRequest{nullptr};
   nsISupports* mContext{nullptr};
   uint64_t mSourceOffset{0};
@@ -319,14 +323,16 @@ nsresult nsHTTPCompressConv::BrotliHandler(nsIInputStream* stream,
     return NS_OK;
   }
 
-  auto outBuffer = MakeUniqueFallible<uint8_t[]>(kOutSize);
-  if (outBuffer == nullptr) {
-    self->mBrotli->mStatus = NS_ERROR_OUT_OF_MEMORY;
-    return self->mBrotli->mStatus;
+  if (!self->mBrotli->mOutBuffer) {
+    self->mBrotli->mOutBuffer = MakeUniqueFallible<uint8_t[]>(kOutSize);
+    if (!self->mBrotli->mOutBuffer) {
+      self->mBrotli->mStatus = NS_ERROR_OUT_OF_MEMORY;
+      return self->mBrotli->mStatus;
+    }
   }
   do {
     outSize = kOutSize;
-    outPtr = outBuffer.get();
+    outPtr = self->mBrotli->mOutBuffer.get();
 
     // brotli api is documented in brotli/dec/decode.h and brotli/dec/decode.c
     LOG(("nsHttpCompresssConv %p brotlihandler decompress %zu\n", self, avail));
@@ -376,7 +382,8 @@ nsresult nsHTTPCompressConv::BrotliHandler(nsIInputStream* stream,
     if (outSize > 0) {
       if (NS_FAILED(callOnDataAvailable(
               self->mBrotli->mSourceOffset,
-              reinterpret_cast<const char*>(outBuffer.get()), outSize))) {
+              reinterpret_cast<const char*>(self->mBrotli->mOutBuffer.get()),
+              outSize))) {
         return self->mBrotli->mStatus;
       }
       self->mBrotli->mSourceOffset += outSize;
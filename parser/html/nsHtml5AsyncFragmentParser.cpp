@@ -0,0 +1,165 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "nsHtml5AsyncFragmentParser.h"
+
+#include <algorithm>
+
+#include "mozilla/Unused.h"
+#include "mozilla/dom/Document.h"
+#include "mozilla/dom/DocumentFragment.h"
+#include "nsHtml5DependentUTF16Buffer.h"
+#include "nsHtml5OplessBuilder.h"
+#include "nsHtml5Tokenizer.h"
+#include "nsHtml5TreeBuilder.h"
+#include "nsIURI.h"
+#include "nsThreadUtils.h"
+
+using mozilla::dom::Document;
+using mozilla::dom::DocumentFragment;
+
+/**
+ * The number of UTF-16 code units tokenized per main-thread task. Large
+ * enough to keep the per-task setup cost negligible, small enough that a
+ * slice typically stays within a few milliseconds.
+ */
+static const int32_t kSliceLength = 64 * 1024;
+
+NS_IMPL_ISUPPORTS0(nsHtml5AsyncFragmentParser)
+
+nsHtml5AsyncFragmentParser::nsHtml5AsyncFragmentParser(
+    const nsAString& aSourceBuffer)
+    : mBuilder(new nsHtml5OplessBuilder()),
+      mTreeBuilder(new nsHtml5TreeBuilder(mBuilder)),
+      mTokenizer(new nsHtml5Tokenizer(mTreeBuilder.get(), false)),
+      mSource(aSourceBuffer),
+      mOffset(0),
+      mLastWasCR(false),
+      mDone(false) {
+  mTokenizer->setInterner(&mAtomTable);
+}
+
+nsHtml5AsyncFragmentParser::~nsHtml5AsyncFragmentParser() {
+  // The slice runnables keep us alive until the parse finishes, so the
+  // promise should always have been settled by now; reject defensively so
+  // the holder doesn't assert if that invariant is ever broken.
+  if (!mPromiseHolder.IsEmpty()) {
+    mPromiseHolder.Reject(NS_ERROR_ABORT, __func__);
+  }
+}
+
+/* static */
+RefPtr<nsHtml5AsyncFragmentParser::ParsePromise>
+nsHtml5AsyncFragmentParser::Parse(const nsAString& aSourceBuffer,
+                                  Document* aDocument,
+                                  nsAtom* aContextLocalName,
+                                  int32_t aContextNamespace, bool aQuirks,
+                                  bool aAllowDeclarativeShadowRoots) {
+  MOZ_ASSERT(NS_IsMainThread(), "Wrong thread!");
+
+  if (aSourceBuffer.Length() > INT32_MAX) {
+    return ParsePromise::CreateAndReject(NS_ERROR_OUT_OF_MEMORY, __func__);
+  }
+  nsIURI* uri = aDocument->GetDocumentURI();
+  if (!uri) {
+    return ParsePromise::CreateAndReject(NS_ERROR_NOT_AVAILABLE, __func__);
+  }
+
+  RefPtr<nsHtml5AsyncFragmentParser> parser =
+      new nsHtml5AsyncFragmentParser(aSourceBuffer);
+  parser->mFragment = aDocument->CreateDocumentFragment();
+
+  parser->mTreeBuilder->setFragmentContext(aContextLocalName,
+                                           aContextNamespace,
+                                           parser->mFragment.get(), aQuirks);
+  parser->mTreeBuilder->SetPreventScriptExecution(true);
+
+  parser->mBuilder->Init(aDocument, uri, nullptr, nullptr);
+  parser->mBuilder->SetParser(parser);
+  parser->mBuilder->SetNodeInfoManager(aDocument->NodeInfoManager());
+
+  // Mark the parser as *not* broken by passing NS_OK
+  mozilla::Unused << parser->mBuilder->MarkAsBroken(NS_OK);
+
+  parser->mTreeBuilder->setScriptingEnabled(true);
+  parser->mTreeBuilder->setIsSrcdocDocument(aDocument->IsSrcdocDocument());
+  parser->mTreeBuilder->setAllowDeclarativeShadowRoots(
+      aAllowDeclarativeShadowRoots);
+
+  parser->mBuilder->Start();
+  parser->mTokenizer->start();
+  parser->mBuilder->Suspend();
+
+  RefPtr<ParsePromise> promise = parser->mPromiseHolder.Ensure(__func__);
+  NS_DispatchToCurrentThread(
+      mozilla::NewRunnableMethod("nsHtml5AsyncFragmentParser::ParseSlice",
+                                 parser,
+                                 &nsHtml5AsyncFragmentParser::ParseSlice));
+  return promise;
+}
+
+void nsHtml5AsyncFragmentParser::ParseSlice() {
+  MOZ_ASSERT(NS_IsMainThread(), "Wrong thread!");
+  if (mDone) {
+    return;
+  }
+  TokenizeOneSlice();
+  if (!mDone) {
+    NS_DispatchToCurrentThread(
+        mozilla::NewRunnableMethod("nsHtml5AsyncFragmentParser::ParseSlice",
+                                   this,
+                                   &nsHtml5AsyncFragmentParser::ParseSlice));
+  }
+}
+
+void nsHtml5AsyncFragmentParser::TokenizeOneSlice() {
+  mBuilder->Start();
+  nsresult rv = mBuilder->IsBroken();
+
+  const int32_t sourceLength = int32_t(mSource.Length());
+  const int32_t sliceEnd = std::min(mOffset + kSliceLength, sourceLength);
+  if (mOffset < sliceEnd) {
+    const nsDependentSubstring slice =
+        Substring(mSource, uint32_t(mOffset), uint32_t(sliceEnd - mOffset));
+    nsHtml5DependentUTF16Buffer buffer(slice);
+    while (buffer.hasMore() && NS_SUCCEEDED(rv)) {
+      buffer.adjust(mLastWasCR);
+      mLastWasCR = false;
+      if (buffer.hasMore()) {
+        if (!mTokenizer->EnsureBufferSpace(buffer.getLength())) {
+          rv = mBuilder->MarkAsBroken(NS_ERROR_OUT_OF_MEMORY);
+          break;
+        }
+        mLastWasCR = mTokenizer->tokenizeBuffer(&buffer);
+        rv = mBuilder->IsBroken();
+      }
+    }
+    mOffset = sliceEnd;
+  }
+
+  if (NS_FAILED(rv) || mOffset == sourceLength) {
+    FinishParse(rv);
+    return;
+  }
+
+  // Yield to the event loop; the half-built fragment is disconnected and
+  // can't run scripts, so nothing can observe it before the next slice.
+  mBuilder->Suspend();
+}
+
+void nsHtml5AsyncFragmentParser::FinishParse(nsresult aRv) {
+  if (NS_SUCCEEDED(aRv)) {
+    mTokenizer->eof();
+  }
+  mTokenizer->end();
+  mBuilder->Finish();
+  mAtomTable.Clear();
+  mDone = true;
+  if (NS_SUCCEEDED(aRv)) {
+    mPromiseHolder.Resolve(mFragment, __func__);
+  } else {
+    mPromiseHolder.Reject(aRv, __func__);
+  }
+  mFragment = nullptr;
+}
@@ -0,0 +1,138 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef nsHtml5AsyncFragmentParser_h
+#define nsHtml5AsyncFragmentParser_h
+
+#include "mozilla/MozPromise.h"
+#include "mozilla/UniquePtr.h"
+#include "nsHtml5AtomTable.h"
+#include "nsParserBase.h"
+#include "nsString.h"
+
+class nsHtml5OplessBuilder;
+class nsHtml5TreeBuilder;
+class nsHtml5Tokenizer;
+namespace mozilla {
+namespace dom {
+class Document;
+class DocumentFragment;
+}  // namespace dom
+}  // namespace mozilla
+
+/**
+ * Parses an HTML fragment into a disconnected DocumentFragment without
+ * blocking the main thread for the duration of the whole parse.
+ *
+ * The tree builder does not support building fragments off the main thread
+ * (scripts need a main-thread target to document.write into), so instead of
+ * using the parser thread, the source is tokenized in bounded slices, one
+ * main-thread task per slice, with the document update batch closed between
+ * slices. Nothing can observe the half-built fragment between slices because
+ * it is disconnected and script execution is prevented, so this is
+ * equivalent to the synchronous fragment parsing algorithm with the jank
+ * spread out. The resulting fragment is delivered whole, for the caller to
+ * insert in one mutation.
+ *
+ * Intended for multi-megabyte fragments; for typical innerHTML-sized inputs
+ * the synchronous path in nsHtml5StringParser has less overhead.
+ */
+class nsHtml5AsyncFragmentParser final : public nsParserBase {
+ public:
+  NS_DECL_ISUPPORTS
+
+  using ParsePromise =
+      mozilla::MozPromise<RefPtr<mozilla::dom::DocumentFragment>, nsresult,
+                          /* IsExclusive = */ true>;
+
+  /**
+   * Invoke the fragment parsing algorithm asynchronously. The promise
+   * resolves with a DocumentFragment owned by aDocument, or rejects if the
+   * parser runs out of memory. Script execution is always prevented; the
+   * caller decides whether inserting the fragment runs scripts.
+   *
+   * @param aSourceBuffer the fragment source; copied, so the caller's buffer
+   *                      may be freed immediately
+   * @param aDocument the owner document for the resulting fragment
+   * @param aContextLocalName local name of context node
+   * @param aContextNamespace namespace of context node
+   * @param aQuirks true to make <table> not close <p>
+   * @param aAllowDeclarativeShadowRoots allow the creation of declarative
+   *                                     shadow roots
+   */
+  static RefPtr<ParsePromise> Parse(const nsAString& aSourceBuffer,
+                                    mozilla::dom::Document* aDocument,
+                                    nsAtom* aContextLocalName,
+                                    int32_t aContextNamespace, bool aQuirks,
+                                    bool aAllowDeclarativeShadowRoots);
+
+ private:
+  explicit nsHtml5AsyncFragmentParser(const nsAString& aSourceBuffer);
+  virtual ~nsHtml5AsyncFragmentParser();
+
+  /**
+   * Posted to the main thread once per slice; tokenizes one slice and
+   * reposts itself until the source is exhausted.
+   */
+  void ParseSlice();
+
+  /**
+   * Tokenizes the next slice of the source inside its own flush and document
+   * update, finishing the parse (and settling the promise) when the source
+   * is exhausted or the parser becomes broken.
+   */
+  void TokenizeOneSlice();
+
+  void FinishParse(nsresult aRv);
+
+  /**
+   * The document builder; executes tree operations eagerly on the main
+   * thread, like the synchronous fragment path.
+   */
+  RefPtr<nsHtml5OplessBuilder> mBuilder;
+
+  /**
+   * The HTML5 tree builder
+   */
+  const mozilla::UniquePtr<nsHtml5TreeBuilder> mTreeBuilder;
+
+  /**
+   * The HTML5 tokenizer
+   */
+  const mozilla::UniquePtr<nsHtml5Tokenizer> mTokenizer;
+
+  /**
+   * The scoped atom table
+   */
+  nsHtml5AtomTable mAtomTable;
+
+  /**
+   * Our copy of the fragment source.
+   */
+  const nsString mSource;
+
+  /**
+   * The number of code units of mSource already tokenized.
+   */
+  int32_t mOffset;
+
+  /**
+   * Whether the previous slice ended with an unconsumed carriage return.
+   */
+  bool mLastWasCR;
+
+  /**
+   * Whether the parse has finished and the promise has been settled.
+   */
+  bool mDone;
+
+  /**
+   * The fragment under construction.
+   */
+  RefPtr<mozilla::dom::DocumentFragment> mFragment;
+
+  mozilla::MozPromiseHolder<ParsePromise> mPromiseHolder;
+};
+
+#endif  // nsHtml5AsyncFragmentParser_h
@@ -19,6 +19,11 @@ void nsHtml5OplessBuilder::Start() {
   BeginDocUpdate();
 }
 
+void nsHtml5OplessBuilder::Suspend() {
+  EndDocUpdate();
+  EndFlush();
+}
+
 void nsHtml5OplessBuilder::Finish() {
   EndDocUpdate();
   EndFlush();
@@ -27,6 +27,15 @@ class nsHtml5OplessBuilder : public nsHtml5DocumentBuilder {
   ~nsHtml5OplessBuilder();
   void Start();
   void Finish();
+
+  /**
+   * Ends the current flush and document update without tearing down builder
+   * state, so that a caller tokenizing in slices can yield to the event loop
+   * between slices and resume with Start(). A document update batch must not
+   * span the event loop.
+   */
+  void Suspend();
+
   void SetParser(nsParserBase* aParser);
 
  private:
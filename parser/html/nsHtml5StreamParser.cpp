@@ -14,6 +14,7 @@
 #include "js/GCAPI.h"
 #include "mozilla/Buffer.h"
 #include "mozilla/CheckedInt.h"
+#include "mozilla/ClearOnShutdown.h"
 #include "mozilla/Encoding.h"
 #include "mozilla/EncodingDetector.h"
 #include "mozilla/Likely.h"
@@ -23,8 +24,10 @@
 #include "mozilla/Services.h"
 #include "mozilla/StaticPrefs_html5.h"
 #include "mozilla/StaticPrefs_network.h"
+#include "mozilla/StaticPtr.h"
 #include "mozilla/TextUtils.h"
 #include "mozilla/glean/NetwerkMetrics.h"
+#include "mozilla/glean/ParserHtmlMetrics.h"
 
 #include "mozilla/Unused.h"
 #include "mozilla/dom/BindingDeclarations.h"
@@ -65,6 +68,7 @@
 #include "nsLiteralString.h"
 #include "nsNetUtil.h"
 #include "nsString.h"
+#include "nsTHashMap.h"
 #include "nsTPromiseFlatString.h"
 #include "nsThreadUtils.h"
 #include "nsXULAppAPI.h"
@@ -77,6 +81,31 @@ const mozilla::Encoding* xmldecl_parse(const uint8_t* buf, size_t buf_len);
 using namespace mozilla;
 using namespace mozilla::dom;
 
+/**
+ * Documents, keyed by URI, whose recent loads have had failed speculations,
+ * mapped to the number of loads on which a failure was seen. document.write
+ * patterns that break speculation (typically injected ad scripts) tend to
+ * break it the same way on every load, so once a document has failed on a few
+ * loads we stop speculating over it up front instead of parsing everything
+ * twice again. Main thread only.
+ */
+static StaticAutoPtr<nsTHashMap<nsCStringHashKey, uint32_t>>
+    sSpeculationFailureHistory;
+
+/**
+ * The number of documents remembered before the history table is reset.
+ * Resetting forgets old offenders, which merely costs one more failed
+ * speculation per document to relearn.
+ */
+static const uint32_t kSpeculationFailureHistoryLimit = 100;
+
+/**
+ * The number of loads with failed speculations after which a document is no
+ * longer speculated over. Requiring more than one load avoids penalizing
+ * documents whose one-off failure was timing-dependent.
+ */
+static const uint32_t kSpeculationFailureHistoryThreshold = 2;
+
 /*
  * Note that nsHtml5StreamParser implements cycle collecting AddRef and
  * Release. Therefore, nsHtml5StreamParser must never be refcounted from
@@ -789,6 +818,7 @@ nsresult nsHtml5StreamParser::SniffStreamBytes(Span<const uint8_t> aFromSegment,
       }
       mSpeculations.AppendElement(speculation);  // adopts the pointer
       mSpeculating = true;
+      glean::parsing::speculations.Add(1);
     } else {
       mLookingForMetaCharset = false;
       mBufferingBytes = false;
@@ -1033,6 +1063,53 @@ class MaybeRunCollector : public Runnable {
   nsCOMPtr<nsIDocShell> mDocShell;
 };
 
+static bool SpeculationHistoryKey(nsHtml5TreeOpExecutor* aExecutor,
+                                  nsAutoCString& aKey) {
+  Document* doc = aExecutor->GetDocument();
+  nsIURI* uri = doc ? doc->GetDocumentURI() : nullptr;
+  return uri && NS_SUCCEEDED(uri->GetSpecIgnoringRef(aKey));
+}
+
+void nsHtml5StreamParser::RememberSpeculationFailure() {
+  MOZ_ASSERT(NS_IsMainThread(), "Wrong thread!");
+  if (mSpeculationFailureCount != 1) {
+    // Record each load at most once.
+    return;
+  }
+  nsAutoCString key;
+  if (!SpeculationHistoryKey(mExecutor, key)) {
+    return;
+  }
+  if (!sSpeculationFailureHistory) {
+    sSpeculationFailureHistory = new nsTHashMap<nsCStringHashKey, uint32_t>();
+    ClearOnShutdown(&sSpeculationFailureHistory);
+  } else if (sSpeculationFailureHistory->Count() >=
+                 kSpeculationFailureHistoryLimit &&
+             !sSpeculationFailureHistory->Contains(key)) {
+    sSpeculationFailureHistory->Clear();
+  }
+  sSpeculationFailureHistory->LookupOrInsert(key, 0)++;
+}
+
+void nsHtml5StreamParser::MaybeDisableSpeculationFromHistory() {
+  MOZ_ASSERT(NS_IsMainThread(), "Wrong thread!");
+  if (!sSpeculationFailureHistory) {
+    return;
+  }
+  nsAutoCString key;
+  if (!SpeculationHistoryKey(mExecutor, key)) {
+    return;
+  }
+  uint32_t failedLoads = 0;
+  if (sSpeculationFailureHistory->Get(key, &failedLoads) &&
+      failedLoads >= kSpeculationFailureHistoryThreshold) {
+    // Start the load with speculation already disabled, so that the parser
+    // thread doesn't parse ahead of document.writes it has been re-parsed
+    // over on previous loads.
+    mSpeculationFailureCount = kMaxSpeculationFailures;
+  }
+}
+
 nsresult nsHtml5StreamParser::OnStartRequest(nsIRequest* aRequest) {
   MOZ_RELEASE_ASSERT(STREAM_NOT_STARTED == mStreamState,
                      "Got OnStartRequest when the stream had already started.");
@@ -1055,6 +1132,8 @@ nsresult nsHtml5StreamParser::OnStartRequest(nsIRequest* aRequest) {
 
   mStreamState = STREAM_BEING_READ;
 
+  MaybeDisableSpeculationFromHistory();
+
   // For View Source, the parser should run with scripts "enabled" if a normal
   // load would have scripts enabled.
   bool scriptingEnabled =
@@ -2532,6 +2611,7 @@ void nsHtml5StreamParser::ParseAvailableData() {
         mTreeBuilder->SetOpSink(speculation);
         mSpeculations.AppendElement(speculation);  // adopts the pointer
         mSpeculating = true;
+        glean::parsing::speculations.Add(1);
       }
       if (IsTerminatedOrInterrupted()) {
         return;
@@ -2610,7 +2690,10 @@ void nsHtml5StreamParser::ContinueAfterScriptsOrEncodingCommitment(
          !aTreeBuilder->snapshotMatches(speculation->GetSnapshot()))) {
       speculationFailed = true;
       // We've got a failed speculation :-(
+      PROFILER_MARKER_UNTYPED("HTML5 speculation failed", DOM);
+      glean::parsing::speculation_failures.Add(1);
       MaybeDisableFutureSpeculation();
+      RememberSpeculationFailure();
       Interrupt();  // Make the parser thread release the tokenizer mutex sooner
       // Note that the interrupted state continues across possible intervening
       // Necko events until the nsHtml5StreamParserContinuation posted at the
@@ -2667,6 +2750,7 @@ void nsHtml5StreamParser::ContinueAfterScriptsOrEncodingCommitment(
     // holding the tokenizer mutex.
     if (speculationFailed) {
       MOZ_ASSERT(mMode == NORMAL);
+      TimeStamp rollbackStart = TimeStamp::Now();
       // Rewind the stream
       mAtEOF = false;
       const auto& speculation = mSpeculations.ElementAt(0);
@@ -2704,6 +2788,12 @@ void nsHtml5StreamParser::ContinueAfterScriptsOrEncodingCommitment(
       mLastWasCR = aLastWasCR;
       mTokenizer->loadState(aTokenizer);
       mTreeBuilder->loadState(aTreeBuilder);
+
+      glean::parsing::speculation_rollback.AccumulateRawDuration(
+          TimeStamp::Now() - rollbackStart);
+      PROFILER_MARKER_TEXT("HTML5 speculation rollback", DOM,
+                           MarkerTiming::IntervalUntilNowFrom(rollbackStart),
+                           ""_ns);
     } else {
       // We've got a successful speculation and at least a moment ago it was
       // the current speculation
@@ -464,11 +464,34 @@ class nsHtml5StreamParser final : public nsISupports {
 
   /**
    * Used to check whether we're getting too many speculation failures and
-   * should just stop trying.  The 100 is picked pretty randomly to be not too
-   * small (so most pages are not affected) but small enough that we don't end
-   * up with failed speculations over and over in pathological cases.
+   * should just stop trying.  The limit is picked pretty randomly to be not
+   * too small (so most pages are not affected) but small enough that we don't
+   * end up with failed speculations over and over in pathological cases.
    */
-  bool IsSpeculationEnabled() { return mSpeculationFailureCount < 100; }
+  bool IsSpeculationEnabled() {
+    return mSpeculationFailureCount < kMaxSpeculationFailures;
+  }
+
+  /**
+   * The number of speculation failures per load after which we stop
+   * speculating. Also what mSpeculationFailureCount is primed with when
+   * previous loads of the document are remembered to have failed.
+   */
+  static const uint32_t kMaxSpeculationFailures = 100;
+
+  /**
+   * Remembers, keyed by document URI, that a load of this document had a
+   * failed speculation, so that future loads of the same document can stop
+   * speculating over its document.writes up front. Main thread only.
+   */
+  void RememberSpeculationFailure();
+
+  /**
+   * Disables speculation for this load if enough previous loads of the same
+   * document are remembered to have had failed speculations. Main thread
+   * only.
+   */
+  void MaybeDisableSpeculationFromHistory();
 
   /**
    * Dispatch an event to a Quantum DOM main thread-ish thread.
@@ -30,6 +30,8 @@
 
 #define nsHtml5Tokenizer_cpp__
 
+#include "mozilla/SIMD.h"
+
 #include "nsHtml5AttributeName.h"
 #include "nsHtml5ElementName.h"
 #include "nsHtml5TreeBuilder.h"
@@ -469,6 +471,21 @@ bool nsHtml5Tokenizer::tokenizeBuffer(nsHtml5UTF16Buffer* buffer) {
   return lastCR;
 }
 
+// Finds the earlier occurrence of either of two characters, or nullptr if
+// neither occurs. SIMD::memchr2x16 matches a two-character sequence, not
+// either character, so probe for each separately, narrowing the second
+// search to the prefix before the first hit.
+static inline const char16_t* FindEarlierOfTwo(const char16_t* aStart,
+                                               size_t aLength, char16_t aFirst,
+                                               char16_t aSecond) {
+  const char16_t* hit = mozilla::SIMD::memchr16(aStart, aFirst, aLength);
+  if (const char16_t* other = mozilla::SIMD::memchr16(
+          aStart, aSecond, hit ? size_t(hit - aStart) : aLength)) {
+    return other;
+  }
+  return hit;
+}
+
 template <class P>
 int32_t nsHtml5Tokenizer::stateLoop(int32_t state, char16_t c, int32_t pos,
                                     char16_t* buf, bool reconsume,
@@ -485,6 +502,22 @@ stateloop:
             if (++pos == endPos) {
               NS_HTML5_BREAK(stateloop);
             }
+            if (P::scanDataWithSimd) {
+              const char16_t* start = buf + pos;
+              const size_t max = endPos - pos;
+              const char16_t* markup = FindEarlierOfTwo(start, max, '&', '<');
+              const size_t textLen = markup ? size_t(markup - start) : max;
+              const char16_t* control =
+                  FindEarlierOfTwo(start, textLen, '\0', '\r');
+              const char16_t* found = control ? control : markup;
+              if (!found) {
+                P::silentDataRun(this, start, max);
+                pos = endPos;
+                NS_HTML5_BREAK(stateloop);
+              }
+              P::silentDataRun(this, start, size_t(found - start));
+              pos = int32_t(found - buf);
+            }
             c = P::checkChar(this, buf, pos);
           }
           switch (c) {
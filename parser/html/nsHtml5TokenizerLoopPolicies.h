@@ -11,6 +11,13 @@
  */
 struct nsHtml5FastestPolicy {
   static const bool reportErrors = false;
+  // The data state may skip over plain-text runs with SIMD instead of
+  // dispatching per character. silentDataRun() is then responsible for any
+  // bookkeeping checkChar() and silentLineFeed() would have done for the
+  // skipped characters; here there is none.
+  static const bool scanDataWithSimd = true;
+  static void silentDataRun(nsHtml5Tokenizer* aTokenizer, const char16_t* aRun,
+                            size_t aLength) {}
   static int32_t transition(nsHtml5Highlighter* aHighlighter, int32_t aState,
                             bool aReconsume, int32_t aPos) {
     return aState;
@@ -37,6 +44,28 @@ struct nsHtml5FastestPolicy {
  */
 struct nsHtml5LineColPolicy {
   static const bool reportErrors = false;
+  // The data state may skip over plain-text runs with SIMD; silentDataRun()
+  // below replays the line and column bookkeeping for the skipped characters
+  // without the tokenizer dispatching on each of them.
+  static const bool scanDataWithSimd = true;
+  static void silentDataRun(nsHtml5Tokenizer* aTokenizer, const char16_t* aRun,
+                            size_t aLength) {
+    // The run may contain line feeds but never a carriage return, which the
+    // data state always dispatches on.
+    for (size_t i = 0; i < aLength; i++) {
+      char16_t c = aRun[i];
+      if (MOZ_UNLIKELY(aTokenizer->nextCharOnNewLine)) {
+        aTokenizer->line++;
+        aTokenizer->col = 1;
+        aTokenizer->nextCharOnNewLine = false;
+      } else if (MOZ_LIKELY(!NS_IS_LOW_SURROGATE(c))) {
+        aTokenizer->col++;
+      }
+      if (c == '\n') {
+        silentLineFeed(aTokenizer);
+      }
+    }
+  }
   static int32_t transition(nsHtml5Highlighter* aHighlighter, int32_t aState,
                             bool aReconsume, int32_t aPos) {
     return aState;
@@ -96,6 +125,10 @@ struct nsHtml5LineColPolicy {
  */
 struct nsHtml5ViewSourcePolicy {
   static const bool reportErrors = true;
+  // The highlighter needs to see line feeds one at a time.
+  static const bool scanDataWithSimd = false;
+  static void silentDataRun(nsHtml5Tokenizer* aTokenizer, const char16_t* aRun,
+                            size_t aLength) {}
   static int32_t transition(nsHtml5Highlighter* aHighlighter, int32_t aState,
                             bool aReconsume, int32_t aPos) {
     return aHighlighter->Transition(aState, aReconsume, aPos);
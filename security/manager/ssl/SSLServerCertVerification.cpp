@@ -92,6 +92,7 @@
 
 #include "SSLServerCertVerification.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "CertVerifier.h"
@@ -131,6 +132,7 @@
 #include "mozpkix/pkixcheck.h"
 #include "mozpkix/pkixnss.h"
 #include "mozpkix/pkixutil.h"
+#include "prsystem.h"
 #include "secerr.h"
 #include "secport.h"
 #include "ssl.h"
@@ -162,7 +164,14 @@ void InitializeSSLServerCertVerificationThreads() {
   gCertVerificationThreadPool = new nsThreadPool();
   NS_ADDREF(gCertVerificationThreadPool);
 
-  (void)gCertVerificationThreadPool->SetThreadLimit(5);
+  // A burst of new connections (e.g. restoring a session with many origins)
+  // queues one verification per handshake, so scale the pool with the
+  // machine rather than pinning it at a fixed size.  Verification is mostly
+  // CPU-bound (path building and signature checks), so there is little to
+  // gain from exceeding the core count.
+  int32_t threadLimit =
+      std::clamp<int32_t>(PR_GetNumberOfProcessors(), 5, 16);
+  (void)gCertVerificationThreadPool->SetThreadLimit(threadLimit);
   (void)gCertVerificationThreadPool->SetIdleThreadLimit(1);
   (void)gCertVerificationThreadPool->SetIdleThreadMaximumTimeout(30 * 1000);
   (void)gCertVerificationThreadPool->SetIdleThreadGraceTimeout(500);
@@ -44,6 +44,10 @@
 #  include <windows.h>
 #endif
 
+#if defined(XP_UNIX)
+#  include <sys/mman.h>
+#endif
+
 #ifdef IS_BIG_ENDIAN
 #  define SC_ENDIAN "big"
 #else
@@ -727,6 +731,24 @@ void StartupCache::ThreadedPrefetch(uint8_t* aStart, size_t aSize) {
   MMAP_FAULT_HANDLER_CATCH()
 }
 
+// Hint to the OS that it may reclaim the (clean, file-backed) pages of the
+// cache mapping.  By the time the write timer fires, startup is over and the
+// bulk of the prefetched cache data is typically never touched again; entries
+// requested later simply fault their pages back in from disk.  The mapping
+// itself stays valid.
+void StartupCache::ReleaseCacheMMapPages() {
+  if (!mCacheData.initialized()) {
+    return;
+  }
+#if defined(XP_UNIX)
+  madvise(mCacheData.get<uint8_t>().get(), mCacheData.size(), MADV_DONTNEED);
+#elif defined(XP_WIN)
+  // Removes the pages from the working set; they remain cached by the OS
+  // until there is actual memory pressure.
+  VirtualUnlock(mCacheData.get<uint8_t>().get(), mCacheData.size());
+#endif
+}
+
 // mTableLock must be held
 bool StartupCache::ShouldCompactCache() {
   // If we've requested less than 4/5 of the startup cache, then we should
@@ -760,6 +782,11 @@ void StartupCache::MaybeWriteOffMainThread() {
   {
     MutexAutoLock lock(mTableLock);
     if (mWrittenOnce || (mCacheData.initialized() && !ShouldCompactCache())) {
+      // We're keeping the cache file as-is.  Entries requested during
+      // startup have been decompressed into their own heap buffers, so the
+      // resident pages of the mapping are mostly dead weight from here on.
+      WaitOnPrefetch();
+      ReleaseCacheMMapPages();
       return;
     }
   }
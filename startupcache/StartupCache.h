@@ -224,6 +224,7 @@ class StartupCache : public nsIMemoryReporter {
 
   void WaitOnPrefetch();
   void StartPrefetchMemory() MOZ_REQUIRES(mTableLock);
+  void ReleaseCacheMMapPages() MOZ_REQUIRES(mTableLock);
 
   static nsresult InitSingleton();
   static void WriteTimeout(nsITimer* aTimer, void* aClosure);
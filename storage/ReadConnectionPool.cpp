@@ -0,0 +1,126 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: sw=2 ts=2 et lcs=trail\:.,tab\:>~ :
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "ReadConnectionPool.h"
+
+#include "MainThreadUtils.h"
+#include "nsDebug.h"
+
+namespace mozilla::storage {
+
+NS_IMPL_ISUPPORTS(ReadConnectionPool, mozIStorageCompletionCallback)
+
+ReadConnectionPool::ReadConnectionPool(mozIStorageConnection* aWriter,
+                                       uint32_t aMaxReaders)
+    : mWriter(aWriter),
+      mMaxReaders(aMaxReaders),
+      mWriterStatements(mWriter) {
+  MOZ_ASSERT(NS_IsMainThread());
+  MOZ_ASSERT(aWriter);
+  MOZ_ASSERT(aMaxReaders > 0);
+}
+
+ReadConnectionPool::~ReadConnectionPool() {
+  MOZ_ASSERT(mClosed, "Close() the pool before dropping the last reference");
+  if (!mClosed) {
+    Close();
+  }
+}
+
+already_AddRefed<mozIStorageAsyncStatement>
+ReadConnectionPool::GetCachedStatement(const nsACString& aQuery) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (mClosed) {
+    return nullptr;
+  }
+
+  Reader* reader = GetReaderFor(aQuery);
+  if (!reader) {
+    // No reader is available yet, serve the query from the writer connection
+    // as if there was no pool.
+    return mWriterStatements.GetCachedStatement(aQuery);
+  }
+
+  return reader->mStatements.GetCachedStatement(aQuery);
+}
+
+ReadConnectionPool::Reader* ReadConnectionPool::GetReaderFor(
+    const nsACString& aQuery) {
+  if (auto index = mAffinity.Lookup(aQuery)) {
+    return mReaders[*index].get();
+  }
+
+  // An unseen SQL string may need a reader beyond the ones cloned so far.
+  MaybeCloneReader();
+
+  if (mReaders.IsEmpty()) {
+    return nullptr;
+  }
+
+  // Assign the statement round-robin, so distinct queries spread evenly
+  // across the pool and each statement is only ever compiled on one reader.
+  uint32_t index = mNextReader++ % mReaders.Length();
+  mAffinity.InsertOrUpdate(aQuery, index);
+  return mReaders[index].get();
+}
+
+void ReadConnectionPool::MaybeCloneReader() {
+  if (mCloneFailed || mReaders.Length() + mPendingClones >= mMaxReaders) {
+    return;
+  }
+
+  nsresult rv = mWriter->AsyncClone(/* aReadOnly */ true, this);
+  if (NS_WARN_IF(NS_FAILED(rv))) {
+    mCloneFailed = true;
+    return;
+  }
+
+  mPendingClones++;
+}
+
+NS_IMETHODIMP
+ReadConnectionPool::Complete(nsresult aStatus, nsISupports* aValue) {
+  MOZ_ASSERT(NS_IsMainThread());
+  MOZ_ASSERT(mPendingClones > 0);
+
+  mPendingClones--;
+
+  nsCOMPtr<mozIStorageConnection> connection = do_QueryInterface(aValue);
+  if (NS_FAILED(aStatus) || !connection) {
+    mCloneFailed = true;
+    return NS_OK;
+  }
+
+  if (mClosed) {
+    // The pool was closed while the clone was in flight.
+    (void)connection->AsyncClose(nullptr);
+    return NS_OK;
+  }
+
+  mReaders.AppendElement(MakeUnique<Reader>(connection));
+  return NS_OK;
+}
+
+void ReadConnectionPool::Close() {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (mClosed) {
+    return;
+  }
+  mClosed = true;
+
+  mWriterStatements.FinalizeStatements();
+
+  for (const auto& reader : mReaders) {
+    reader->mStatements.FinalizeStatements();
+    (void)reader->mConnection->AsyncClose(nullptr);
+  }
+  mReaders.Clear();
+  mAffinity.Clear();
+}
+
+}  // namespace mozilla::storage
@@ -0,0 +1,137 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: sw=2 ts=2 et lcs=trail\:.,tab\:>~ :
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef mozilla_storage_ReadConnectionPool_h
+#define mozilla_storage_ReadConnectionPool_h
+
+#include "mozIStorageCompletionCallback.h"
+#include "mozIStorageConnection.h"
+#include "mozilla/UniquePtr.h"
+#include "mozilla/storage/StatementCache.h"
+#include "nsCOMPtr.h"
+#include "nsTArray.h"
+#include "nsTHashMap.h"
+
+namespace mozilla::storage {
+
+/**
+ * A pool of read-only clones of a writer connection, so that consumers can
+ * issue queries concurrently with writes instead of serializing everything
+ * behind the writer's single async execution thread.
+ *
+ * Each pooled reader is a read-only clone created through asyncClone(), thus
+ * it gets its own async execution thread, and with WAL journaling readers are
+ * not blocked by the writer.  Statements are handed out through per-reader
+ * statement caches with affinity: the same SQL string is always served by the
+ * same reader, so each statement is only compiled once per pool and a reader's
+ * page cache stays warm for the queries it owns.
+ *
+ * Readers are cloned lazily as distinct queries arrive, up to the limit given
+ * to the constructor.  Cloning is asynchronous; until a reader is available
+ * queries are served by a statement cache on the writer connection, preserving
+ * the current behavior.
+ *
+ * This class is main-thread only, like the async storage API it builds on.
+ * Close() must be called before closing the writer connection.
+ */
+class ReadConnectionPool final : public mozIStorageCompletionCallback {
+  using AsyncStatementCache = StatementCache<mozIStorageAsyncStatement>;
+
+ public:
+  NS_DECL_THREADSAFE_ISUPPORTS
+  NS_DECL_MOZISTORAGECOMPLETIONCALLBACK
+
+  /**
+   * @param aWriter
+   *        The connection to clone readers from.  The pool does not take part
+   *        in writes, the caller keeps using this connection for them.
+   * @param aMaxReaders
+   *        Upper bound on the number of read-only clones.
+   */
+  ReadConnectionPool(mozIStorageConnection* aWriter, uint32_t aMaxReaders);
+
+  /**
+   * Gets a cached asynchronous statement for aQuery on the pooled reader that
+   * owns this SQL string, cloning a new reader on demand.  The caller binds
+   * parameters and calls executeAsync() as usual; execution happens on the
+   * owning reader's async thread.
+   *
+   * @param aQuery
+   *        nsCString of SQL query.
+   * @returns The cached statement, or null upon error or after Close().
+   */
+  already_AddRefed<mozIStorageAsyncStatement> GetCachedStatement(
+      const nsACString& aQuery);
+
+  /**
+   * Finalizes all cached statements and asynchronously closes the pooled
+   * readers.  The writer connection is left untouched.  After this call
+   * GetCachedStatement() always returns null.
+   */
+  void Close();
+
+ private:
+  ~ReadConnectionPool();
+
+  /**
+   * A read-only clone along with its statement cache.  StatementCache keeps a
+   * reference to the nsCOMPtr, so both must live and die together.
+   */
+  struct Reader {
+    explicit Reader(mozIStorageConnection* aConnection)
+        : mConnection(aConnection), mStatements(mConnection) {}
+
+    nsCOMPtr<mozIStorageConnection> mConnection;
+    AsyncStatementCache mStatements;
+  };
+
+  /**
+   * Starts an asynchronous clone if the pool is not yet at capacity.
+   */
+  void MaybeCloneReader();
+
+  /**
+   * Returns the reader owning aQuery, assigning a reader round-robin on the
+   * first use of a SQL string.  Returns nullptr if no reader is ready yet.
+   */
+  Reader* GetReaderFor(const nsACString& aQuery);
+
+  nsCOMPtr<mozIStorageConnection> mWriter;
+  const uint32_t mMaxReaders;
+
+  nsTArray<UniquePtr<Reader>> mReaders;
+
+  /**
+   * Maps a SQL string to the index of the reader owning it in mReaders.
+   */
+  nsTHashMap<nsCStringHashKey, uint32_t> mAffinity;
+
+  /**
+   * The reader that will own the next unseen SQL string.
+   */
+  uint32_t mNextReader = 0;
+
+  /**
+   * The number of asyncClone() calls that have not completed yet.
+   */
+  uint32_t mPendingClones = 0;
+
+  /**
+   * Set when a clone fails, to avoid uselessly retrying over and over.
+   */
+  bool mCloneFailed = false;
+
+  bool mClosed = false;
+
+  /**
+   * Serves queries while no reader is available yet.
+   */
+  AsyncStatementCache mWriterStatements;
+};
+
+}  // namespace mozilla::storage
+
+#endif  // mozilla_storage_ReadConnectionPool_h
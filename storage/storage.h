@@ -18,6 +18,7 @@
 //// Native Language Helpers
 
 #include "mozStorageHelper.h"
+#include "mozilla/storage/ReadConnectionPool.h"
 #include "mozilla/storage/StatementCache.h"
 #include "mozilla/storage/Variant.h"
 
@@ -86,6 +86,9 @@ const DEFAULT_CHUNK_SIZE = 50;
 // Threshold used to evaluate whether the number of Places events from the last
 // recalculation is high enough to deserve a recalculation rate increase.
 const ACCELERATION_EVENTS_THRESHOLD = 250;
+// How long an origin prioritized through prioritizeOriginRecalculation() keeps
+// its priority, if it's not renewed in the meanwhile.
+const PRIORITY_ORIGIN_TIMEOUT_MS = 60000;
 
 /**
  * Recalculates and decays frecency scores in Places.
@@ -261,8 +264,18 @@ export class PlacesFrecencyRecalculator {
     lazy.logger.trace(
       `Recalculate ${chunkSize >= 0 ? chunkSize : "infinite"} frecency values`
     );
-    let affectedCount = 0;
     let hasRecalculatedAnything = false;
+
+    // First serve the priority lane, so that after a bulk import the ranking
+    // of the pages the user is actively interacting with is corrected before
+    // the rest of the backlog.
+    let affectedCount = await this.#recalculateSomePriorityFrecencies({
+      chunkSize,
+    });
+    let shouldRestartRecalculation = affectedCount >= chunkSize;
+    hasRecalculatedAnything = affectedCount > 0;
+
+    affectedCount = 0;
     let db = await lazy.PlacesUtils.promiseUnsafeWritableDBConnection();
     await db.executeTransaction(async function () {
       let affected = await db.executeCached(
@@ -278,8 +291,8 @@ export class PlacesFrecencyRecalculator {
       );
       affectedCount += affected.length;
     });
-    let shouldRestartRecalculation = affectedCount >= chunkSize;
-    hasRecalculatedAnything = affectedCount > 0;
+    shouldRestartRecalculation ||= affectedCount >= chunkSize;
+    hasRecalculatedAnything ||= affectedCount > 0;
     if (hasRecalculatedAnything) {
       PlacesObservers.notifyListeners([new PlacesRanking()]);
     }
@@ -359,6 +372,66 @@ export class PlacesFrecencyRecalculator {
     return affectedCount;
   }
 
+  /**
+   * Host prefix whose pages should be recalculated before the rest of the
+   * backlog, along with the time at which the priority expires.
+   */
+  #priorityHost = null;
+  #priorityHostExpiry = 0;
+
+  /**
+   * Gives recalculation priority to pages from origins matching the given
+   * host prefix. This is intended for consumers ranking results against user
+   * input, like the address bar, so that after a bulk history insertion the
+   * pages being shown to the user are recalculated first, rather than waiting
+   * for the whole backlog to be processed. The priority expires after
+   * PRIORITY_ORIGIN_TIMEOUT_MS, or when a new host prefix is prioritized.
+   *
+   * @param {string} host The host prefix the user is typing against.
+   */
+  prioritizeOriginRecalculation(host) {
+    if (!host) {
+      return;
+    }
+    this.#priorityHost = host;
+    this.#priorityHostExpiry = Date.now() + PRIORITY_ORIGIN_TIMEOUT_MS;
+    if (lazy.PlacesUtils.history.shouldStartFrecencyRecalculation) {
+      this.#task.arm();
+    }
+  }
+
+  async #recalculateSomePriorityFrecencies({ chunkSize }) {
+    if (!this.#priorityHost || Date.now() > this.#priorityHostExpiry) {
+      this.#priorityHost = null;
+      return 0;
+    }
+    lazy.logger.trace(
+      `Recalculate ${chunkSize} frecency values for host "${
+        this.#priorityHost
+      }"`
+    );
+    let affectedCount = 0;
+    let db = await lazy.PlacesUtils.promiseUnsafeWritableDBConnection();
+    await db.executeTransaction(async () => {
+      let affected = await db.executeCached(
+        `UPDATE moz_places
+        SET frecency = CALCULATE_FRECENCY(id)
+        WHERE id IN (
+          SELECT h.id FROM moz_places h
+          JOIN moz_origins o ON o.id = h.origin_id
+          WHERE h.recalc_frecency = 1
+            AND o.host BETWEEN :host AND :host || X'FFFF'
+          ORDER BY h.frecency DESC, h.visit_count DESC
+          LIMIT ${chunkSize}
+        )
+        RETURNING id`,
+        { host: this.#priorityHost }
+      );
+      affectedCount = affected.length;
+    });
+    return affectedCount;
+  }
+
   /**
    * Forces full recalculation of any outdated frecency values.
    * This exists for testing purposes; in tests we don't want to wait for
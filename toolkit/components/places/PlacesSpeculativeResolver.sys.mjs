@@ -0,0 +1,129 @@
+/* -*- indent-tabs-mode: nil; js-indent-level: 2 -*-
+ * vim: sw=2 ts=2 sts=2 expandtab
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/**
+ * This component pre-resolves the hosts of the top frecency origins in
+ * Places once the browser has gone idle after startup, so that the first
+ * navigation to a frequently visited site doesn't pay full DNS latency.
+ * Lookups are speculative and low priority: they only warm the DNS cache
+ * and never block or trigger anything else.
+ */
+
+import { XPCOMUtils } from "resource://gre/modules/XPCOMUtils.sys.mjs";
+
+const lazy = {};
+ChromeUtils.defineESModuleGetters(lazy, {
+  PlacesUtils: "resource://gre/modules/PlacesUtils.sys.mjs",
+  setTimeout: "resource://gre/modules/Timer.sys.mjs",
+});
+
+ChromeUtils.defineLazyGetter(lazy, "logger", function () {
+  return lazy.PlacesUtils.getLogger({ prefix: "SpeculativeResolver" });
+});
+
+XPCOMUtils.defineLazyPreferenceGetter(
+  lazy,
+  "enabled",
+  "places.speculativeResolve.enabled",
+  true
+);
+
+// Number of top frecency origins to pre-resolve.
+XPCOMUtils.defineLazyPreferenceGetter(
+  lazy,
+  "maxOrigins",
+  "places.speculativeResolve.maxOrigins",
+  20
+);
+
+// Delay after Places initialization before we even consider resolving, so we
+// stay well out of the way of startup work.
+const STARTUP_DELAY_MS = 10000;
+
+export class PlacesSpeculativeResolver {
+  classID = Components.ID("{ee336d93-6953-4bd4-88dd-2d1dfd3d1c1b}");
+
+  #started = false;
+
+  constructor() {
+    this.QueryInterface = ChromeUtils.generateQI([
+      "nsIObserver",
+      "nsISupportsWeakReference",
+    ]);
+
+    // Do not initialize during shutdown.
+    if (
+      Services.startup.isInOrBeyondShutdownPhase(
+        Ci.nsIAppStartup.SHUTDOWN_PHASE_APPSHUTDOWNCONFIRMED
+      )
+    ) {
+      return;
+    }
+
+    this.wrappedJSObject = this;
+
+    lazy.setTimeout(() => {
+      ChromeUtils.idleDispatch(() => {
+        this.resolveTopOrigins().catch(console.error);
+      });
+    }, STARTUP_DELAY_MS);
+  }
+
+  observe() {
+    // Nothing to do here; construction through the places-init-complete
+    // category is all the registration we need.
+  }
+
+  /**
+   * Queries the top frecency http(s) origins and kicks off a speculative,
+   * low priority DNS lookup for each of their hosts.
+   *
+   * @returns {Promise<number>} the number of lookups that were started.
+   *   Exposed through wrappedJSObject for tests.
+   */
+  async resolveTopOrigins() {
+    if (this.#started || !lazy.enabled || lazy.maxOrigins <= 0) {
+      return 0;
+    }
+    this.#started = true;
+
+    let db = await lazy.PlacesUtils.promiseDBConnection();
+    let rows = await db.executeCached(
+      `SELECT host FROM moz_origins
+       WHERE prefix IN ('http://', 'https://') AND frecency > 0
+       GROUP BY host
+       ORDER BY MAX(frecency) DESC
+       LIMIT :limit`,
+      { limit: lazy.maxOrigins }
+    );
+
+    let count = 0;
+    let listener = {
+      onLookupComplete() {},
+      QueryInterface: ChromeUtils.generateQI(["nsIDNSListener"]),
+    };
+    for (let row of rows) {
+      let host = row.getResultByName("host");
+      try {
+        Services.dns.asyncResolve(
+          host,
+          Ci.nsIDNSService.RESOLVE_TYPE_DEFAULT,
+          Ci.nsIDNSService.RESOLVE_SPECULATE |
+            Ci.nsIDNSService.RESOLVE_PRIORITY_LOW,
+          null,
+          listener,
+          null,
+          {}
+        );
+        count++;
+      } catch (ex) {
+        // Invalid hosts are not worth reporting.
+      }
+    }
+    lazy.logger.debug(`Started ${count} speculative DNS lookups`);
+    return count;
+  }
+}
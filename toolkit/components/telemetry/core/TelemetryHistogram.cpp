@@ -108,6 +108,13 @@ namespace TelemetryIPCAccumulator = mozilla::TelemetryIPCAccumulator;
 // were required to be protected by |gTelemetryHistogramMutex|.  To
 // break that cycle, we relax that requirement.  Unfortunately this
 // means that this file is not guaranteed race-free.
+//
+// As a separate, deliberate exception, the Accumulate() entry points check
+// the can-record and recording-enabled flags before acquiring
+// |gTelemetryHistogramMutex| and return early when a sample would be
+// rejected anyway.  Those flags are relaxed atomics (written only under
+// the mutex), so accumulation that is turned off never contends with the
+// code it instruments.
 
 // This is a StaticMutex rather than a plain Mutex (1) so that
 // it gets initialised in a thread-safe manner the first time
@@ -303,9 +310,14 @@ namespace {
 bool gTelemetryHistogramInitDone = false;
 
 // Whether we are collecting the base, opt-out, Histogram data.
-bool gTelemetryHistogramCanRecordBase = false;
+// These two flags are relaxed atomics so that the hot Accumulate() entry
+// points can reject samples without taking gTelemetryHistogramMutex; they
+// are only ever written under the mutex.
+mozilla::Atomic<bool, mozilla::MemoryOrdering::Relaxed>
+    gTelemetryHistogramCanRecordBase(false);
 // Whether we are collecting the extended, opt-in, Histogram data.
-bool gTelemetryHistogramCanRecordExtended = false;
+mozilla::Atomic<bool, mozilla::MemoryOrdering::Relaxed>
+    gTelemetryHistogramCanRecordExtended(false);
 
 // The storage for actual Histogram instances.
 // We use separate ones for plain and keyed histograms.
@@ -323,7 +335,9 @@ KeyedHistogram* gExpiredKeyedHistogram = nullptr;
 
 // This tracks whether recording is enabled for specific histograms.
 // To utilize C++ initialization rules, we invert the meaning to "disabled".
-bool gHistogramRecordingDisabled[HistogramCount] = {};
+// Relaxed atomics, for the same lock-free rejection as the flags above.
+mozilla::Atomic<bool, mozilla::MemoryOrdering::Relaxed>
+    gHistogramRecordingDisabled[HistogramCount];
 
 // This is for gHistogramInfos, gHistogramStringTable
 #include "TelemetryHistogramData.inc"
@@ -2517,6 +2531,13 @@ void TelemetryHistogram::Accumulate(HistogramID aID, uint32_t aSample) {
     return;
   }
 
+  // These are the same rejections the locked path performs first; doing them
+  // here on the atomic flags keeps instrumentation that is turned off from
+  // contending with the code it measures.
+  if (!internal_CanRecordBase() || !internal_IsRecordingEnabled(aID)) {
+    return;
+  }
+
   StaticMutexAutoLock locker(gTelemetryHistogramMutex);
   internal_Accumulate(locker, aID, aSample);
 }
@@ -2531,6 +2552,10 @@ void TelemetryHistogram::Accumulate(HistogramID aID,
   MOZ_ASSERT(!gHistogramInfos[aID].keyed,
              "Cannot accumulate into a keyed histogram. No key given.");
 
+  if (!internal_CanRecordBase() || !internal_IsRecordingEnabled(aID)) {
+    return;
+  }
+
   StaticMutexAutoLock locker(gTelemetryHistogramMutex);
   for (uint32_t sample : aSamples) {
     internal_Accumulate(locker, aID, sample);
@@ -2556,6 +2581,10 @@ void TelemetryHistogram::Accumulate(HistogramID aID, const nsCString& aKey,
     return;
   }
 
+  if (!internal_CanRecordBase() || !internal_IsRecordingEnabled(aID)) {
+    return;
+  }
+
   StaticMutexAutoLock locker(gTelemetryHistogramMutex);
   internal_Accumulate(locker, aID, aKey, aSample);
 }
@@ -2567,10 +2596,11 @@ void TelemetryHistogram::AccumulateCategorical(HistogramID aId,
     return;
   }
 
-  StaticMutexAutoLock locker(gTelemetryHistogramMutex);
-  if (!internal_CanRecordBase()) {
+  if (!internal_CanRecordBase() || !internal_IsRecordingEnabled(aId)) {
     return;
   }
+
+  StaticMutexAutoLock locker(gTelemetryHistogramMutex);
   uint32_t labelId = 0;
   if (NS_FAILED(gHistogramInfos[aId].label_id(label.get(), &labelId))) {
     return;
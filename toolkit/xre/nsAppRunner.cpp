@@ -183,6 +183,7 @@
 
 #ifdef XP_UNIX
 #  include <errno.h>
+#  include <fcntl.h>
 #  include <pwd.h>
 #  include <string.h>
 #  include <sys/resource.h>
@@ -3994,6 +3995,8 @@ static void SetupConsoleForBackgroundTask(
  * true.
  */
 int XREMain::XRE_mainInit(bool* aExitFlag) {
+  AUTO_PROFILER_LABEL("XREMain::XRE_mainInit", OTHER);
+
   if (!aExitFlag) return 1;
   *aExitFlag = false;
 
@@ -4511,6 +4514,33 @@ static void AnnotateLSBRelease(void*) {
 
 #endif  // defined(XP_LINUX) && !defined(ANDROID)
 
+#if defined(XP_LINUX) && !defined(ANDROID)
+
+static void ReadAheadPackagedFile(const char* aName, const nsCString& aGREDir) {
+  nsPrintfCString path("%s/%s", aGREDir.get(), aName);
+  int fd = open(path.get(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return;
+  }
+  // POSIX_FADV_WILLNEED queues an asynchronous sequential read of the whole
+  // file into the page cache.
+  posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+  close(fd);
+}
+
+// Cold startup is dominated by page faults against libxul and the packaged
+// omnijars.  On rotating disks demand paging is seek-bound, so prefetch the
+// files sequentially from a background thread; the faults that follow then
+// hit the page cache instead of the disk.
+static void ReadAheadFiles(const nsCString& aGREDir) {
+  ReadAheadPackagedFile("libxul.so", aGREDir);
+  ReadAheadPackagedFile("omni.ja", aGREDir);
+  // The application omnijar, for GRE layouts that ship one (Firefox).
+  ReadAheadPackagedFile("browser/omni.ja", aGREDir);
+}
+
+#endif  // defined(XP_LINUX) && !defined(ANDROID)
+
 #ifdef XP_WIN
 static void ReadAheadSystemDll(const wchar_t* dllName) {
   wchar_t dllPath[MAX_PATH];
@@ -4697,6 +4727,8 @@ bool XREMain::CheckLastStartupWasCrash() {
  * true.
  */
 int XREMain::XRE_mainStartup(bool* aExitFlag) {
+  AUTO_PROFILER_LABEL("XREMain::XRE_mainStartup", OTHER);
+
   nsresult rv;
 
   if (!aExitFlag) return 1;
@@ -5436,6 +5468,8 @@ void AddSandboxAnnotations() {
  * the calling of appStartup->Run().
  */
 nsresult XREMain::XRE_mainRun() {
+  AUTO_PROFILER_LABEL("XREMain::XRE_mainRun", OTHER);
+
   nsresult rv = NS_OK;
   NS_ASSERTION(mScopedXPCOM, "Scoped xpcom not initialized.");
 
@@ -5527,6 +5561,17 @@ nsresult XREMain::XRE_mainRun() {
             }));
       }
     }
+#elif defined(XP_LINUX) && !defined(ANDROID)
+    if (!PR_GetEnv("XRE_NO_DLL_READAHEAD")) {
+      nsCOMPtr<nsIFile> greDir = mDirProvider.GetGREDir();
+      nsAutoCString path;
+      rv = greDir->GetNativePath(path);
+      if (NS_SUCCEEDED(rv)) {
+        NS_DispatchBackgroundTask(NS_NewRunnableFunction(
+            "ReadAheadFiles",
+            [path = std::move(path)] { ReadAheadFiles(path); }));
+      }
+    }
 #endif
 
     if (gDoMigration) {
@@ -0,0 +1,115 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "PerfCounters.h"
+#include "mozilla/Logging.h"
+
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <linux/perf_event.h>
+
+static mozilla::LazyLogModule sPerfCountersLog("profiler.perfcounters");
+#define PERF_COUNTERS_LOG(...) \
+  MOZ_LOG(sPerfCountersLog, mozilla::LogLevel::Debug, (__VA_ARGS__));
+
+struct HwCounterDescriptor {
+  uint64_t mConfig;
+  const char* mLabel;
+  const char* mDescription;
+};
+
+constexpr HwCounterDescriptor kSupportedHwCounters[] = {
+    {PERF_COUNT_HW_INSTRUCTIONS, "Instructions",
+     "Instructions retired by threads of this process"},
+    {PERF_COUNT_HW_CACHE_MISSES, "LLC misses",
+     "Last-level cache misses from threads of this process"},
+    {PERF_COUNT_HW_BRANCH_MISSES, "Branch misses",
+     "Branch mispredictions from threads of this process"},
+};
+
+class HwPerfCount final : public BaseProfilerCount {
+ public:
+  HwPerfCount(uint64_t aConfig, const char* aLabel, const char* aDescription)
+      : BaseProfilerCount(aLabel, "CPU", aDescription),
+        mLastResult(0),
+        mPerfEventFd(-1) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(struct perf_event_attr);
+    attr.config = aConfig;
+    // Count the calling thread on every CPU and let new child threads
+    // inherit the counter.  Excluding kernel events keeps the syscall
+    // usable under the default kernel.perf_event_paranoid=2, which only
+    // allows user-space measurements of our own process.
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    long fd = syscall(__NR_perf_event_open, &attr, 0 /* this thread */,
+                      -1 /* all cpus */, -1, PERF_FLAG_FD_CLOEXEC);
+    if (fd < 0) {
+      PERF_COUNTERS_LOG("perf_event_open failed for %s: %s", aLabel,
+                        strerror(errno));
+      return;
+    }
+
+    PERF_COUNTERS_LOG("Created descriptor for event: %s", aLabel);
+    mPerfEventFd = static_cast<int>(fd);
+  }
+
+  ~HwPerfCount() {
+    if (ValidPerfEventFd()) {
+      ioctl(mPerfEventFd, PERF_EVENT_IOC_DISABLE, 0);
+      close(mPerfEventFd);
+    }
+  }
+
+  HwPerfCount(const HwPerfCount&) = delete;
+  HwPerfCount& operator=(const HwPerfCount&) = delete;
+
+  CountSample Sample() override {
+    CountSample result = {
+        .count = 0,
+        .number = 0,
+        .isSampleNew = false,
+    };
+
+    uint64_t value;
+    if (!ValidPerfEventFd() ||
+        read(mPerfEventFd, &value, sizeof(value)) != sizeof(value)) {
+      return result;
+    }
+
+    // The counter is cumulative; the front-end derives per-interval rates
+    // from deltas between samples.
+    result.count = static_cast<int64_t>(value);
+    result.isSampleNew = mLastResult != 0 && mLastResult != value;
+    mLastResult = value;
+
+    return result;
+  }
+
+  bool ValidPerfEventFd() { return mPerfEventFd >= 0; }
+
+ private:
+  uint64_t mLastResult;
+  int mPerfEventFd;
+};
+
+PerfCounters::PerfCounters() {
+  for (const auto& hwCounter : kSupportedHwCounters) {
+    auto counter = mozilla::MakeUnique<HwPerfCount>(
+        hwCounter.mConfig, hwCounter.mLabel, hwCounter.mDescription);
+    if (counter->ValidPerfEventFd() &&
+        !mCounters.emplaceBack(std::move(counter))) {
+      PERF_COUNTERS_LOG("Failed to store counter: %s", hwCounter.mLabel);
+    }
+  }
+}
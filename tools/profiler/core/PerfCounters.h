@@ -0,0 +1,38 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef TOOLS_PERFCOUNTERS_H_
+#define TOOLS_PERFCOUNTERS_H_
+
+#include "PlatformMacros.h"
+#include "mozilla/ProfilerCounts.h"
+#include "mozilla/UniquePtr.h"
+#include "mozilla/Vector.h"
+
+#if defined(GP_OS_linux) || defined(GP_OS_android)
+#  define HAVE_PERF_COUNTER_SUPPORT
+#endif
+
+// Hardware performance-monitoring counters (instructions retired, last-level
+// cache misses and branch mispredictions), read through perf_event_open and
+// sampled on each profiler sampling interval.  The counts cover the thread
+// that started the profiler and every thread it spawns afterwards; counting
+// our own process doesn't require lowering kernel.perf_event_paranoid.
+class PerfCounters {
+ public:
+#if defined(HAVE_PERF_COUNTER_SUPPORT)
+  explicit PerfCounters();
+#else
+  explicit PerfCounters() {};
+#endif
+  ~PerfCounters() = default;
+
+  using CountVector = mozilla::Vector<mozilla::UniquePtr<BaseProfilerCount>, 3>;
+  const CountVector& GetCounters() { return mCounters; }
+
+ private:
+  CountVector mCounters;
+};
+
+#endif /* ndef TOOLS_PERFCOUNTERS_H_ */
@@ -31,6 +31,7 @@
 #include "GeckoProfiler.h"
 #include "GeckoProfilerReporter.h"
 #include "PageInformation.h"
+#include "PerfCounters.h"
 #include "PowerCounters.h"
 #include "ProfileBuffer.h"
 #include "ProfiledThreadData.h"
@@ -447,6 +448,9 @@ static uint32_t AvailableFeatures() {
 #if !defined(HAVE_CPU_FREQ_SUPPORT)
   ProfilerFeature::ClearCPUFrequency(features);
 #endif
+#if !defined(HAVE_PERF_COUNTER_SUPPORT)
+  ProfilerFeature::ClearPerfCounters(features);
+#endif
 
   return features;
 }
@@ -1146,6 +1150,7 @@ class ActivePS {
                                     ? new ProcessCPUCounter(aLock)
                                     : nullptr),
         mMaybePowerCounters(nullptr),
+        mMaybePerfCounters(nullptr),
         mMaybeCPUFreq(nullptr),
         // The new sampler thread doesn't start sampling immediately because the
         // main loop within Run() is blocked until this function's caller
@@ -1202,6 +1207,13 @@ class ActivePS {
       }
     }
 
+    if (ProfilerFeature::HasPerfCounters(aFeatures)) {
+      mMaybePerfCounters = new PerfCounters();
+      for (const auto& perfCounter : mMaybePerfCounters->GetCounters()) {
+        locked_profiler_add_sampled_counter(aLock, perfCounter.get());
+      }
+    }
+
     if (ProfilerFeature::HasCPUFrequency(aFeatures)) {
       mMaybeCPUFreq = new ProfilerCPUFreq();
     }
@@ -1214,6 +1226,9 @@ class ActivePS {
     MOZ_ASSERT(
         !mMaybePowerCounters,
         "mMaybePowerCounters should have been deleted before ~ActivePS()");
+    MOZ_ASSERT(
+        !mMaybePerfCounters,
+        "mMaybePerfCounters should have been deleted before ~ActivePS()");
     MOZ_ASSERT(!mMaybeCPUFreq,
                "mMaybeCPUFreq should have been deleted before ~ActivePS()");
 #if defined(MOZ_MEMORY) && defined(MOZ_PROFILER_MEMORY)
@@ -1309,6 +1324,15 @@ class ActivePS {
       sInstance->mMaybePowerCounters = nullptr;
     }
 
+    if (sInstance->mMaybePerfCounters) {
+      for (const auto& perfCounter :
+           sInstance->mMaybePerfCounters->GetCounters()) {
+        locked_profiler_remove_sampled_counter(aLock, perfCounter.get());
+      }
+      delete sInstance->mMaybePerfCounters;
+      sInstance->mMaybePerfCounters = nullptr;
+    }
+
     if (sInstance->mMaybeCPUFreq) {
       delete sInstance->mMaybeCPUFreq;
       sInstance->mMaybeCPUFreq = nullptr;
@@ -1883,6 +1907,10 @@ class ActivePS {
   // Used to collect power use data, if the power feature is on.
   PowerCounters* mMaybePowerCounters;
 
+  // Used to collect hardware performance counters, if the perfcounters
+  // feature is on.
+  PerfCounters* mMaybePerfCounters;
+
   // Used to collect cpu frequency, if the CPU frequency feature is on.
   ProfilerCPUFreq* mMaybeCPUFreq;
 
@@ -23,6 +23,7 @@
 #include "nsISupportsPriority.h"
 #include "nsNetUtil.h"
 #include "nsString.h"
+#include "nsThreadUtils.h"
 #include "nsReadableUtils.h"
 #include "nsStreamUtils.h"
 #include "prtime.h"
@@ -59,6 +60,10 @@ static LazyLogModule gPrefetchLog("nsPrefetch");
 #define PARALLELISM_PREF "network.prefetch-next.parallelism"
 #define AGGRESSIVE_PREF "network.prefetch-next.aggressive"
 
+// Longest we'll wait for an idle period before processing the prefetch
+// queue anyway.
+#define PREFETCH_IDLE_TIMEOUT_MS 2000
+
 //-----------------------------------------------------------------------------
 // nsPrefetchNode <public>
 //-----------------------------------------------------------------------------
@@ -326,6 +331,7 @@ nsPrefetchService::nsPrefetchService()
     : mMaxParallelism(6),
       mStopCount(0),
       mPrefetchDisabled(true),
+      mIdleDispatchPending(false),
       mAggressive(false) {}
 
 nsPrefetchService::~nsPrefetchService() {
@@ -392,8 +398,7 @@ void nsPrefetchService::ProcessNextPrefetchURI() {
     if (mPrefetchQueue.empty()) {
       break;
     }
-    RefPtr<nsPrefetchNode> node = std::move(mPrefetchQueue.front());
-    mPrefetchQueue.pop_front();
+    RefPtr<nsPrefetchNode> node = DequeueHighestPriorityNode();
 
     LOG(("ProcessNextPrefetchURI [%s]\n",
          node->mURI->GetSpecOrDefault().get()));
@@ -482,6 +487,63 @@ void nsPrefetchService::EmptyPrefetchQueue() {
   }
 }
 
+RefPtr<nsPrefetchNode> nsPrefetchService::DequeueHighestPriorityNode() {
+  // A <link rel=prefetch> that is still in the composed document is a much
+  // stronger hint that the user will navigate to its target than one whose
+  // link has since been removed, so serve those first.  The queue is small,
+  // so a linear scan at dispatch time beats maintaining a heap and also
+  // reflects the current state of the source nodes rather than the state
+  // at enqueue time.
+  for (auto iter = mPrefetchQueue.begin(); iter != mPrefetchQueue.end();
+       ++iter) {
+    for (const nsWeakPtr& weakSource : (*iter)->mSources) {
+      nsCOMPtr<nsINode> source = do_QueryReferent(weakSource);
+      if (source && source->IsInComposedDoc()) {
+        RefPtr<nsPrefetchNode> node = std::move(*iter);
+        mPrefetchQueue.erase(iter);
+        return node;
+      }
+    }
+  }
+
+  RefPtr<nsPrefetchNode> node = std::move(mPrefetchQueue.front());
+  mPrefetchQueue.pop_front();
+  return node;
+}
+
+void nsPrefetchService::ScheduleIdleProcessing() {
+  if (mIdleDispatchPending || mPrefetchQueue.empty()) {
+    return;
+  }
+
+  // Admit the next batch of prefetches from an idle callback rather than
+  // synchronously from the DOCUMENT STOP notification, so that opening the
+  // connections doesn't contend with work the page scheduled for right
+  // after its load event.  The timeout bounds how long a busy event loop
+  // can starve the queue.
+  RefPtr<nsPrefetchService> self = this;
+  nsCOMPtr<nsIRunnable> runnable =
+      NS_NewRunnableFunction("nsPrefetchService::ProcessQueueOnIdle", [self]() {
+        self->mIdleDispatchPending = false;
+        if (self->mStopCount && !self->mAggressive) {
+          // A new load started before we went idle; its DOCUMENT STOP
+          // notification will reschedule us.
+          return;
+        }
+        while (!self->mPrefetchQueue.empty() &&
+               self->mCurrentNodes.Length() <
+                   static_cast<uint32_t>(self->mMaxParallelism)) {
+          self->ProcessNextPrefetchURI();
+        }
+      });
+  nsresult rv = NS_DispatchToCurrentThreadQueue(
+      runnable.forget(), PREFETCH_IDLE_TIMEOUT_MS,
+      mozilla::EventQueuePriority::Idle);
+  if (NS_SUCCEEDED(rv)) {
+    mIdleDispatchPending = true;
+  }
+}
+
 void nsPrefetchService::StartPrefetching() {
   //
   // at initialization time we might miss the first DOCUMENT START
@@ -496,10 +558,7 @@ void nsPrefetchService::StartPrefetching() {
   // STOP notifications.  we do this inorder to defer prefetching
   // until after all sub-frames have finished loading.
   if (!mStopCount) {
-    while (!mPrefetchQueue.empty() &&
-           mCurrentNodes.Length() < static_cast<uint32_t>(mMaxParallelism)) {
-      ProcessNextPrefetchURI();
-    }
+    ScheduleIdleProcessing();
   }
 }
 
@@ -660,9 +719,12 @@ nsresult nsPrefetchService::Prefetch(nsIURI* aURI,
 
   NotifyLoadRequested(enqueuedNode);
 
-  // if there are no pages loading, kick off the request immediately
-  if (!mStopCount || mAggressive) {
+  // in aggressive mode kick off the request immediately; otherwise, if no
+  // pages are loading, pick it up at the next idle period
+  if (mAggressive) {
     ProcessNextPrefetchURI();
+  } else if (!mStopCount) {
+    ScheduleIdleProcessing();
   }
 
   return NS_OK;
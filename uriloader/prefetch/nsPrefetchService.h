@@ -59,6 +59,15 @@ class nsPrefetchService final : public nsIPrefetchService,
                       nsINode* aSource, nsPrefetchNode** node);
   void EmptyPrefetchQueue();
 
+  // Removes and returns the queued node we predict the user needs soonest.
+  // The queue must not be empty.
+  RefPtr<nsPrefetchNode> DequeueHighestPriorityNode();
+
+  // Arranges for the queue to be processed from an idle callback, so that
+  // opening prefetch connections doesn't compete with work the page has
+  // scheduled right after load.
+  void ScheduleIdleProcessing();
+
   void StartPrefetching();
   void StopPrefetching();
   void StopCurrentPrefetchsPreloads(bool aPreload);
@@ -70,6 +79,7 @@ class nsPrefetchService final : public nsIPrefetchService,
   int32_t mMaxParallelism;
   int32_t mStopCount;
   bool mPrefetchDisabled;
+  bool mIdleDispatchPending;
 
   // In usual case prefetch does not start until all normal loads are done.
   // Aggressive mode ignores normal loads and just start prefetch ASAP.
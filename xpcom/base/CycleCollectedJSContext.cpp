@@ -76,7 +76,7 @@ CycleCollectedJSContext::~CycleCollectedJSContext() {
   if (!mJSContext) {
     return;
   }
-  mRecycledPromiseJob = nullptr;
+  mRecycledPromiseJobs.Clear();
 
   JS::SetHostCleanupFinalizationRegistryCallback(mJSContext, nullptr, nullptr);
 
@@ -252,7 +252,10 @@ class PromiseJobRunnable final : public CallbackObjectBase,
     mPropagateUserInputEventHandling = false;
 
     if (CycleCollectedJSContext* ccjs = CycleCollectedJSContext::Get()) {
-      ccjs->mRecycledPromiseJob = this;
+      if (ccjs->mRecycledPromiseJobs.Length() <
+          CycleCollectedJSContext::kMaxRecycledPromiseJobs) {
+        ccjs->mRecycledPromiseJobs.AppendElement(this);
+      }
     }
   }
 
@@ -379,8 +382,8 @@ bool CycleCollectedJSContext::enqueuePromiseJob(
 
   JS::RootedObject jobGlobal(aCx, JS::CurrentGlobalOrNull(aCx));
   RefPtr<PromiseJobRunnable> runnable;
-  if (mRecycledPromiseJob) {
-    runnable = mRecycledPromiseJob.forget();
+  if (!mRecycledPromiseJobs.IsEmpty()) {
+    runnable = mRecycledPromiseJobs.PopLastElement();
     runnable->Reinit(aPromise, aJob, jobGlobal, aAllocationSite, global,
                      schedulingState);
   } else {
@@ -798,6 +801,25 @@ bool SuppressedMicroTasks::Suppressed() {
   return false;
 }
 
+// Profiler marker reporting how many jobs a single microtask checkpoint
+// drained, so that promise storms show up in profiles.
+struct MicrotaskCheckpointMarker {
+  static constexpr Span<const char> MarkerTypeName() {
+    return MakeStringSpan("MicrotaskCheckpoint");
+  }
+  static void StreamJSONMarkerData(baseprofiler::SpliceableJSONWriter& aWriter,
+                                   uint32_t aJobCount) {
+    aWriter.IntProperty("jobs", aJobCount);
+  }
+  static MarkerSchema MarkerTypeDisplay() {
+    using MS = MarkerSchema;
+    MS schema{MS::Location::MarkerChart, MS::Location::MarkerTable};
+    schema.AddKeyLabelFormat("jobs", "Jobs", MS::Format::Integer);
+    schema.SetTableLabel("{marker.name} - {marker.data.jobs} jobs");
+    return schema;
+  }
+};
+
 bool CycleCollectedJSContext::PerformMicroTaskCheckPoint(bool aForce) {
   if (mPendingMicroTaskRunnables.empty() && mDebuggerMicroTaskQueue.empty()) {
     AfterProcessMicrotasks();
@@ -831,6 +853,7 @@ bool CycleCollectedJSContext::PerformMicroTaskCheckPoint(bool aForce) {
   AUTO_PROFILER_TRACING_MARKER("JS", "Perform microtasks", JS);
 
   bool didProcess = false;
+  uint32_t processedCount = 0;
   AutoSlowOperation aso;
 
   for (;;) {
@@ -867,6 +890,7 @@ bool CycleCollectedJSContext::PerformMicroTaskCheckPoint(bool aForce) {
         JS::JobQueueIsEmpty(Context());
       }
       didProcess = true;
+      ++processedCount;
 
       LogMicroTaskRunnable::Run log(runnable.get());
       runnable->Run(aso);
@@ -874,6 +898,11 @@ bool CycleCollectedJSContext::PerformMicroTaskCheckPoint(bool aForce) {
     }
   }
 
+  if (processedCount) {
+    PROFILER_MARKER("MicrotaskCheckpoint", JS, {}, MicrotaskCheckpointMarker,
+                    processedCount);
+  }
+
   // Put back the suppressed microtasks so that they will be run later.
   // Note, it is possible that we end up keeping these suppressed tasks around
   // for some time, but no longer than spinning the event loop nestedly
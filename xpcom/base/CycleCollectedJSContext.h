@@ -364,7 +364,13 @@ class CycleCollectedJSContext : dom::PerThreadAtomCache, private JS::JobQueue {
 
  private:
   friend class PromiseJobRunnable;
-  RefPtr<PromiseJobRunnable> mRecycledPromiseJob;
+
+  // A small cache of already-run PromiseJobRunnables, so that promise-heavy
+  // pages which enqueue many jobs between two checkpoints don't pay an
+  // allocation per job.
+  static constexpr size_t kMaxRecycledPromiseJobs = 8;
+  AutoTArray<RefPtr<PromiseJobRunnable>, kMaxRecycledPromiseJobs>
+      mRecycledPromiseJobs;
 
   // How many times the debugger has interrupted execution, possibly creating
   // microtask checkpoints in places that they would not normally occur.
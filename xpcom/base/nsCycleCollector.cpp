@@ -1287,6 +1287,10 @@ class GraphWalker {
 
  public:
   void Walk(PtrInfo* aPi);
+  // As Walk(), but reuses aQueue (which must be empty) for the traversal, so
+  // callers that flood from many roots in a row don't pay a deque allocation
+  // per root.
+  void Walk(PtrInfo* aPi, nsDeque<PtrInfo>& aQueue);
   void WalkFromRoots(CCGraph& aGraph);
   // copy-constructing the visitor should be cheap, and less
   // indirection than using a reference
@@ -1447,6 +1451,14 @@ MOZ_NEVER_INLINE void GraphWalker<Visitor>::Walk(PtrInfo* aPi) {
   DoWalk(queue);
 }
 
+template <class Visitor>
+MOZ_NEVER_INLINE void GraphWalker<Visitor>::Walk(PtrInfo* aPi,
+                                                 nsDeque<PtrInfo>& aQueue) {
+  MOZ_ASSERT(aQueue.GetSize() == 0, "Walk() needs an empty scratch queue");
+  CheckedPush(aQueue, aPi);
+  DoWalk(aQueue);
+}
+
 template <class Visitor>
 MOZ_NEVER_INLINE void GraphWalker<Visitor>::WalkFromRoots(CCGraph& aGraph) {
   nsDeque<PtrInfo> queue;
@@ -2915,9 +2927,9 @@ struct ScanBlackVisitor {
 };
 
 static void FloodBlackNode(uint32_t& aWhiteNodeCount, bool& aFailed,
-                           PtrInfo* aPi) {
+                           PtrInfo* aPi, nsDeque<PtrInfo>& aQueue) {
   GraphWalker<ScanBlackVisitor>(ScanBlackVisitor(aWhiteNodeCount, aFailed))
-      .Walk(aPi);
+      .Walk(aPi, aQueue);
   MOZ_ASSERT(aPi->mColor == black || !aPi->WasTraversed(),
              "FloodBlackNode should make aPi black");
 }
@@ -2927,6 +2939,7 @@ static void FloodBlackNode(uint32_t& aWhiteNodeCount, bool& aFailed,
 void nsCycleCollector::ScanWeakMaps() {
   bool anyChanged;
   bool failed = false;
+  nsDeque<PtrInfo> scratchQueue;
   do {
     anyChanged = false;
     for (uint32_t i = 0; i < mGraph.mWeakMaps.Length(); i++) {
@@ -2944,12 +2957,14 @@ void nsCycleCollector::ScanWeakMaps() {
       MOZ_ASSERT(vColor != grey, "Uncolored weak map value");
 
       if (mColor == black && kColor != black && kdColor == black) {
-        FloodBlackNode(mWhiteNodeCount, failed, wm->mKey);
+        FloodBlackNode(mWhiteNodeCount, failed, wm->mKey,
+                       scratchQueue);
         anyChanged = true;
       }
 
       if (mColor == black && kColor == black && vColor != black) {
-        FloodBlackNode(mWhiteNodeCount, failed, wm->mVal);
+        FloodBlackNode(mWhiteNodeCount, failed, wm->mVal,
+                       scratchQueue);
         anyChanged = true;
       }
     }
@@ -2990,7 +3005,7 @@ class PurpleScanBlackVisitor {
     if (pi->mColor == black) {
       return true;
     }
-    FloodBlackNode(mCount, mFailed, pi);
+    FloodBlackNode(mCount, mFailed, pi, mScratchQueue);
     return true;
   }
 
@@ -2999,6 +3014,7 @@ class PurpleScanBlackVisitor {
   RefPtr<nsCycleCollectorLogger> mLogger;
   uint32_t& mCount;
   bool& mFailed;
+  nsDeque<PtrInfo> mScratchQueue;
 };
 
 // Objects that have been stored somewhere since the start of incremental graph
@@ -3017,6 +3033,7 @@ void nsCycleCollector::ScanIncrementalRoots() {
   // buffer here, so these objects will be suspected and freed in the next CC
   // if they are garbage.
   bool failed = false;
+  nsDeque<PtrInfo> scratchQueue;
   PurpleScanBlackVisitor purpleScanBlackVisitor(mGraph, mLogger,
                                                 mWhiteNodeCount, failed);
   mPurpleBuf.VisitEntries(purpleScanBlackVisitor);
@@ -3086,7 +3103,7 @@ void nsCycleCollector::ScanIncrementalRoots() {
       mLogger->NoteIncrementalRoot((uint64_t)pi->mPointer);
     }
 
-    FloodBlackNode(mWhiteNodeCount, failed, pi);
+    FloodBlackNode(mWhiteNodeCount, failed, pi, scratchQueue);
   }
 
   timeLog.Checkpoint("ScanIncrementalRoots::fix nodes");
@@ -3138,11 +3155,14 @@ void nsCycleCollector::ScanWhiteNodes(bool aFullySynchGraphBuild) {
 // again. This pass may turn some white nodes to black.
 void nsCycleCollector::ScanBlackNodes() {
   bool failed = false;
+  // One flood per remaining grey node; share a single scratch queue across
+  // them so each flood doesn't allocate its own.
+  nsDeque<PtrInfo> scratchQueue;
   NodePool::Enumerator nodeEnum(mGraph.mNodes);
   while (!nodeEnum.IsDone()) {
     PtrInfo* pi = nodeEnum.GetNext();
     if (pi->mColor == grey && pi->WasTraversed()) {
-      FloodBlackNode(mWhiteNodeCount, failed, pi);
+      FloodBlackNode(mWhiteNodeCount, failed, pi, scratchQueue);
     }
   }
   NS_ASSERTION(!failed, "Ran out of memory in ScanBlackNodes");
@@ -2638,9 +2638,11 @@ size_t nsMemoryReporterManager::HeapAllocated(const jemalloc_stats_t& aStats) {
 NS_IMETHODIMP
 nsMemoryReporterManager::GetHeapAllocated(int64_t* aAmount) {
 #ifdef HAVE_JEMALLOC_STATS
-  jemalloc_stats_t stats;
-  jemalloc_stats(&stats);
-  *aAmount = HeapAllocated(stats);
+  // The lite stats only walk the arena list instead of every chunk of every
+  // arena, which keeps this attribute cheap enough for continuous polling.
+  jemalloc_stats_lite_t stats;
+  jemalloc_stats_lite(&stats);
+  *aAmount = stats.allocated_bytes;
   return NS_OK;
 #else
   *aAmount = 0;
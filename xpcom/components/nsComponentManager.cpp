@@ -603,6 +603,14 @@ nsresult nsComponentManagerImpl::GetInterface(const nsIID& aUuid,
 }
 
 Maybe<EntryWrapper> nsComponentManagerImpl::LookupByCID(const nsID& aCID) {
+  // The static module tables are immutable perfect-hash data, and a static
+  // CID entry always wins over a dynamically registered factory (see the
+  // locked overload), so a static hit doesn't need to touch mLock at all.
+  // Contract lookups can't take this shortcut: contract overrides flip bits
+  // in the invalidation bitmap, which is guarded by mLock.
+  if (const StaticModule* module = StaticComponents::LookupByCID(aCID)) {
+    return Some(EntryWrapper(module));
+  }
   return LookupByCID(MonitorAutoLock(mLock), aCID);
 }
 
@@ -324,20 +324,29 @@ MOZ_ALWAYS_INLINE auto PLDHashTable::SearchTable(const void* aKey,
   MOZ_ASSERT(mEntryStore.IsAllocated());
   NS_ASSERTION(!(aKeyHash & kCollisionFlag), "!(aKeyHash & kCollisionFlag)");
 
+  // Probe over the contiguous hash array only; entry addresses are
+  // materialized lazily, so probe misses never touch the entry storage and
+  // never pay the index-to-entry multiply.
+  auto hashes = reinterpret_cast<PLDHashNumber*>(mEntryStore.Get());
+  PLDHashMatchEntry matchEntry = mOps->matchEntry;
+
   // Compute the primary hash address.
   PLDHashNumber hash1 = Hash1(aKeyHash);
-  Slot slot = SlotForIndex(hash1);
+  PLDHashNumber storedHash = hashes[hash1];
 
   // Miss: return space for a new entry.
-  if (slot.IsFree()) {
-    return (Reason == ForAdd) ? aSuccess(slot) : aFailure();
+  if (storedHash == 0) {
+    if (Reason == ForAdd) {
+      Slot slot = SlotForIndex(hash1);
+      return aSuccess(slot);
+    }
+    return aFailure();
   }
 
   // Hit: return entry.
-  PLDHashMatchEntry matchEntry = mOps->matchEntry;
-  if (MatchSlotKeyhash(slot, aKeyHash)) {
-    PLDHashEntryHdr* e = slot.ToEntry();
-    if (matchEntry(e, aKey)) {
+  if ((storedHash & ~kCollisionFlag) == aKeyHash) {
+    Slot slot = SlotForIndex(hash1);
+    if (matchEntry(slot.ToEntry(), aKey)) {
       return aSuccess(slot);
     }
   }
@@ -347,33 +356,34 @@ MOZ_ALWAYS_INLINE auto PLDHashTable::SearchTable(const void* aKey,
   uint32_t sizeMask;
   Hash2(aKeyHash, hash2, sizeMask);
 
-  // Save the first removed entry slot so Add() can recycle it. (Only used
-  // if Reason==ForAdd.)
-  Maybe<Slot> firstRemoved;
+  // Save the first removed entry's index so Add() can recycle its slot.
+  // (Only used if Reason==ForAdd.)
+  Maybe<uint32_t> firstRemoved;
 
   for (;;) {
     if (Reason == ForAdd && !firstRemoved) {
-      if (MOZ_UNLIKELY(slot.IsRemoved())) {
-        firstRemoved.emplace(slot);
+      if (MOZ_UNLIKELY(storedHash == 1)) {
+        firstRemoved.emplace(hash1);
       } else {
-        slot.MarkColliding();
+        hashes[hash1] |= kCollisionFlag;
       }
     }
 
     hash1 -= hash2;
     hash1 &= sizeMask;
 
-    slot = SlotForIndex(hash1);
-    if (slot.IsFree()) {
+    storedHash = hashes[hash1];
+    if (storedHash == 0) {
       if (Reason != ForAdd) {
         return aFailure();
       }
-      return aSuccess(firstRemoved.refOr(slot));
+      Slot slot = SlotForIndex(firstRemoved.valueOr(hash1));
+      return aSuccess(slot);
     }
 
-    if (MatchSlotKeyhash(slot, aKeyHash)) {
-      PLDHashEntryHdr* e = slot.ToEntry();
-      if (matchEntry(e, aKey)) {
+    if ((storedHash & ~kCollisionFlag) == aKeyHash) {
+      Slot slot = SlotForIndex(hash1);
+      if (matchEntry(slot.ToEntry(), aKey)) {
         return aSuccess(slot);
       }
     }
@@ -395,13 +405,16 @@ MOZ_ALWAYS_INLINE auto PLDHashTable::FindFreeSlot(PLDHashNumber aKeyHash) const
   MOZ_ASSERT(mEntryStore.IsAllocated());
   NS_ASSERTION(!(aKeyHash & kCollisionFlag), "!(aKeyHash & kCollisionFlag)");
 
+  // As in SearchTable(), only the contiguous hash array is touched while
+  // probing.
+  auto hashes = reinterpret_cast<PLDHashNumber*>(mEntryStore.Get());
+
   // Compute the primary hash address.
   PLDHashNumber hash1 = Hash1(aKeyHash);
-  Slot slot = SlotForIndex(hash1);
 
   // Miss: return space for a new entry.
-  if (slot.IsFree()) {
-    return slot;
+  if (hashes[hash1] == 0) {
+    return SlotForIndex(hash1);
   }
 
   // Collision: double hash.
@@ -410,15 +423,14 @@ MOZ_ALWAYS_INLINE auto PLDHashTable::FindFreeSlot(PLDHashNumber aKeyHash) const
   Hash2(aKeyHash, hash2, sizeMask);
 
   for (;;) {
-    MOZ_ASSERT(!slot.IsRemoved());
-    slot.MarkColliding();
+    MOZ_ASSERT(Slot::IsLiveHash(hashes[hash1]));
+    hashes[hash1] |= kCollisionFlag;
 
     hash1 -= hash2;
     hash1 &= sizeMask;
 
-    slot = SlotForIndex(hash1);
-    if (slot.IsFree()) {
-      return slot;
+    if (hashes[hash1] == 0) {
+      return SlotForIndex(hash1);
     }
   }
 
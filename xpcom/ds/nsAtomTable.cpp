@@ -5,6 +5,7 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "mozilla/Assertions.h"
+#include "mozilla/Atomics.h"
 #include "mozilla/Attributes.h"
 #include "mozilla/HashFunctions.h"
 #include "mozilla/MemoryReporting.h"
@@ -184,6 +185,35 @@ struct AtomCache : public MruCache<AtomTableKey, nsAtom*, AtomCache> {
 static AtomCache sRecentlyUsedSmallMainThreadAtoms;
 static AtomCache sRecentlyUsedLargeMainThreadAtoms;
 
+// Worker-thread atomization (the HTML5 parser thread and the Stylo thread
+// pool) goes through Atomize() rather than AtomizeMainThread() and always
+// paid a subtable read-lock round trip, even for hot hits. Give every other
+// thread a small MRU cache of its own so the hit case touches no shared
+// state at all.
+//
+// Unlike the main-thread caches this one must hold strong references: the
+// atom GC runs on the main thread while other threads consult their caches,
+// so raw pointers here could dangle. The references pin at most the cache's
+// few dozen entries per thread; bumping sAtomGCEpoch on every GC makes each
+// thread drop its pins the next time it atomizes, so the following GC can
+// reclaim them.
+struct AtomRefCache
+    : public MruCache<AtomTableKey, RefPtr<nsAtom>, AtomRefCache> {
+  static HashNumber Hash(const AtomTableKey& aKey) { return aKey.mHash; }
+  static bool Match(const AtomTableKey& aKey, const RefPtr<nsAtom>& aVal) {
+    MOZ_ASSERT(aKey.mUTF16String);
+    // Unlike with raw pointer values, MruCache can't pre-filter empty slots
+    // for us here, so check for one ourselves.
+    return aVal && (aVal->hash() == aKey.mHash) &&
+           aVal->Equals(aKey.mUTF16String, aKey.mLength);
+  }
+
+  uint32_t mGCEpoch = 0;
+};
+
+static mozilla::Atomic<uint32_t, mozilla::Relaxed> sAtomGCEpoch;
+static thread_local AtomRefCache sRecentlyUsedThreadAtoms;
+
 // In order to reduce locking contention for concurrent atomization, we segment
 // the atom table into N subtables, each with a separate lock. If the hash
 // values we use to select the subtable are evenly distributed, this reduces the
@@ -223,6 +253,8 @@ class nsAtomTable {
                                    uint32_t aHash);
   already_AddRefed<nsAtom> Atomize(const nsACString& aUTF8String);
   already_AddRefed<nsAtom> AtomizeMainThread(const nsAString& aUTF16String);
+  already_AddRefed<nsAtom> AtomizeInSubTable(AtomTableKey& aKey,
+                                             const nsAString& aUTF16String);
   nsStaticAtom* GetStaticAtom(const nsAString& aUTF16String);
   void RegisterStaticAtoms(const nsStaticAtom* aAtoms, size_t aAtomsLen);
 
@@ -362,6 +394,10 @@ void nsAtomTable::GC(GCKind aKind) {
   MOZ_ASSERT(NS_IsMainThread());
   sRecentlyUsedSmallMainThreadAtoms.Clear();
   sRecentlyUsedLargeMainThreadAtoms.Clear();
+  // Tell the per-thread caches to drop their pinned atoms next time they're
+  // used, so anything they kept alive across this GC goes away on the next
+  // one.
+  sAtomGCEpoch++;
 
   // Note that this is effectively an incremental GC, since only one subtable
   // is locked at a time.
@@ -598,15 +634,40 @@ already_AddRefed<nsAtom> NS_Atomize(const char16_t* aUTF16String) {
 already_AddRefed<nsAtom> nsAtomTable::Atomize(const nsAString& aUTF16String,
                                               uint32_t aHash) {
   AtomTableKey key(aUTF16String.Data(), aUTF16String.Length(), aHash);
-  nsAtomSubTable& table = SelectSubTable(key);
+
+  if (!NS_IsMainThread()) {
+    AtomRefCache& cache = sRecentlyUsedThreadAtoms;
+    if (MOZ_UNLIKELY(cache.mGCEpoch != sAtomGCEpoch)) {
+      // A GC ran since we last looked; drop our pins so the next GC can
+      // reclaim anything we were keeping alive.
+      cache.Clear();
+      cache.mGCEpoch = sAtomGCEpoch;
+    }
+    auto p = cache.Lookup(key);
+    if (p) {
+      RefPtr<nsAtom> atom = p.Data();
+      return atom.forget();
+    }
+    RefPtr<nsAtom> atom = AtomizeInSubTable(key, aUTF16String);
+    p.Set(atom);
+    return atom.forget();
+  }
+
+  RefPtr<nsAtom> atom = AtomizeInSubTable(key, aUTF16String);
+  return atom.forget();
+}
+
+already_AddRefed<nsAtom> nsAtomTable::AtomizeInSubTable(
+    AtomTableKey& aKey, const nsAString& aUTF16String) {
+  nsAtomSubTable& table = SelectSubTable(aKey);
   {
     AutoReadLock lock(table.mLock);
-    if (AtomTableEntry* he = table.Search(key)) {
+    if (AtomTableEntry* he = table.Search(aKey)) {
       return do_AddRef(he->mAtom);
     }
   }
   AutoWriteLock lock(table.mLock);
-  AtomTableEntry* he = table.Add(key);
+  AtomTableEntry* he = table.Add(aKey);
 
   if (he->mAtom) {
     RefPtr<nsAtom> atom = he->mAtom;
@@ -614,7 +675,7 @@ already_AddRefed<nsAtom> nsAtomTable::Atomize(const nsAString& aUTF16String,
   }
 
   RefPtr<nsAtom> atom =
-      dont_AddRef(nsDynamicAtom::Create(aUTF16String, key.mHash));
+      dont_AddRef(nsDynamicAtom::Create(aUTF16String, aKey.mHash));
   he->mAtom = atom;
 
   return atom.forget();
@@ -30,6 +30,21 @@ void nsObserverList::GetObserverList(nsISimpleEnumerator** anEnumerator) {
   e.forget(anEnumerator);
 }
 
+void nsObserverList::FillObserverArray(
+    nsTArray<nsCOMPtr<nsIObserver>>& aArray) {
+  aArray.SetCapacity(mObservers.Length());
+
+  for (int32_t i = mObservers.Length() - 1; i >= 0; --i) {
+    nsCOMPtr<nsIObserver> observer = mObservers[i].GetValue();
+    if (observer) {
+      aArray.AppendElement(std::move(observer));
+    } else {
+      // the object has gone away, remove the weakref
+      mObservers.RemoveElementAt(i);
+    }
+  }
+}
+
 nsCOMArray<nsIObserver> nsObserverList::ReverseCloneObserverArray() {
   nsCOMArray<nsIObserver> array;
   array.SetCapacity(mObservers.Length());
@@ -65,10 +80,15 @@ void nsObserverList::AppendStrongObservers(nsCOMArray<nsIObserver>& aArray) {
 
 void nsObserverList::NotifyObservers(nsISupports* aSubject, const char* aTopic,
                                      const char16_t* someData) {
-  const nsCOMArray<nsIObserver> observers = ReverseCloneObserverArray();
-
-  for (int32_t i = 0; i < observers.Count(); ++i) {
-    observers[i]->Observe(aSubject, aTopic, someData);
+  // Iterate over a snapshot of the observer array so that observers can add
+  // and remove themselves during dispatch.  The snapshot lives on the stack
+  // for typical list sizes, so notifying a chatty topic doesn't pay a heap
+  // allocation per notification.
+  AutoTArray<nsCOMPtr<nsIObserver>, 8> observers;
+  FillObserverArray(observers);
+
+  for (const nsCOMPtr<nsIObserver>& observer : observers) {
+    observer->Observe(aSubject, aTopic, someData);
   }
 }
 
@@ -9,6 +9,8 @@
 
 #include "nsISupports.h"
 #include "nsCOMArray.h"
+#include "nsCOMPtr.h"
+#include "nsTArray.h"
 #include "nsIObserver.h"
 #include "nsHashKeys.h"
 #include "nsMaybeWeakPtr.h"
@@ -38,6 +40,10 @@ class nsObserverList : public nsCharPtrHashKey {
                        const char16_t* aSomeData);
   void GetObserverList(nsISimpleEnumerator** aEnumerator);
 
+  // Fill an array with the observers of this category.
+  // The array is filled in last-added-first order.
+  void FillObserverArray(nsTArray<nsCOMPtr<nsIObserver>>& aArray);
+
   // Clone an array with the observers of this category.
   // The array is filled in last-added-first order.
   nsCOMArray<nsIObserver> ReverseCloneObserverArray();
@@ -263,6 +263,52 @@ struct nsTArrayInfallibleAllocator : nsTArrayInfallibleAllocatorBase {
   static void SizeTooBig(size_t aSize) { NS_ABORT_OOM(aSize); }
 };
 
+// An allocator policy that carves element storage out of an arena instead of
+// the heap, for subsystems that build large numbers of short-lived arrays and
+// release them wholesale (e.g. per-paint or per-deserialization arenas).
+//
+// |ArenaProvider| supplies the arena through a static accessor:
+//
+//   struct MyArenaProvider {
+//     static mozilla::ArenaAllocator<4096, 8>& Arena();
+//   };
+//
+// The arena's alignment must be at least sizeof(size_t), both for the
+// allocation-size prefix stored below and so element storage gets malloc-like
+// alignment. Free() is a no-op; storage is reclaimed when the provider's arena
+// is cleared, which must not happen while any array using it is still alive.
+//
+// Arrays using this policy must not exchange buffers with heap-backed arrays
+// (see the comment above about nsTArray*Allocators sharing free()), so keep
+// them behind ArenaTArray below rather than mixing allocators by hand.
+template <typename ArenaProvider>
+struct nsTArrayArenaAllocator : nsTArrayInfallibleAllocatorBase {
+  static void* Malloc(size_t aSize) MOZ_NONNULL_RETURN {
+    // Arenas don't track allocation sizes, but Realloc() needs the old size
+    // to copy, so stash it in a prefix word.
+    auto* prefix = static_cast<size_t*>(
+        ArenaProvider::Arena().Allocate(aSize + sizeof(size_t)));
+    *prefix = aSize;
+    return prefix + 1;
+  }
+  static void* Realloc(void* aPtr, size_t aSize) MOZ_NONNULL_RETURN {
+    if (!aPtr) {
+      return Malloc(aSize);
+    }
+    const size_t oldSize = static_cast<size_t*>(aPtr)[-1];
+    if (aSize <= oldSize) {
+      // Shrinking: keep the buffer; the tail is dead arena space anyway.
+      return aPtr;
+    }
+    void* newPtr = Malloc(aSize);
+    memcpy(newPtr, aPtr, oldSize);
+    return newPtr;
+  }
+
+  static void Free(void*) {}
+  static void SizeTooBig(size_t aSize) { NS_ABORT_OOM(aSize); }
+};
+
 // nsTArray_base stores elements into the space allocated beyond
 // sizeof(*this).  This is done to minimize the size of the nsTArray
 // object when it is empty.
@@ -2963,6 +3009,69 @@ class MOZ_GSL_OWNER nsTArray
   }
 };
 
+// An infallible array whose element storage comes from the arena supplied by
+// |ArenaProvider| (see nsTArrayArenaAllocator). Destroying the array runs
+// element destructors but returns no memory; the storage is reclaimed when
+// the provider's arena is cleared. Don't SwapElements() with heap-backed
+// arrays: buffer ownership can't move between the arena and the heap.
+template <class E, class ArenaProvider>
+class MOZ_GSL_OWNER ArenaTArray
+    : public nsTArray_Impl<E, nsTArrayArenaAllocator<ArenaProvider>> {
+ public:
+  using ArenaAlloc = nsTArrayArenaAllocator<ArenaProvider>;
+  using base_type = nsTArray_Impl<E, ArenaAlloc>;
+  using self_type = ArenaTArray<E, ArenaProvider>;
+  using typename base_type::index_type;
+  using typename base_type::size_type;
+  using typename base_type::value_type;
+
+  ArenaTArray() = default;
+  explicit ArenaTArray(size_type aCapacity) : base_type(aCapacity) {}
+  ArenaTArray(self_type&& aOther) = default;
+  self_type& operator=(self_type&& aOther) = default;
+
+  using base_type::SetCapacity;
+  using base_type::SetLength;
+
+  template <class Item>
+  mozilla::NotNull<value_type*> AppendElement(Item&& aItem) {
+    return mozilla::WrapNotNullUnchecked(
+        this->template AppendElementInternal<ArenaAlloc>(
+            std::forward<Item>(aItem)));
+  }
+
+  mozilla::NotNull<value_type*> AppendElement() {
+    return mozilla::WrapNotNullUnchecked(
+        this->template AppendElementsInternal<ArenaAlloc>(1));
+  }
+
+  template <class Item>
+  mozilla::NotNull<value_type*> AppendElements(const Item* aArray,
+                                               size_type aArrayLen) {
+    return mozilla::WrapNotNullUnchecked(
+        this->template AppendElementsInternal<ArenaAlloc>(aArray, aArrayLen));
+  }
+
+  template <class Item>
+  mozilla::NotNull<value_type*> AppendElements(mozilla::Span<Item> aSpan) {
+    return mozilla::WrapNotNullUnchecked(
+        this->template AppendElementsInternal<ArenaAlloc>(aSpan.Elements(),
+                                                          aSpan.Length()));
+  }
+
+  mozilla::NotNull<value_type*> AppendElements(size_type aCount) {
+    return mozilla::WrapNotNullUnchecked(
+        this->template AppendElementsInternal<ArenaAlloc>(aCount));
+  }
+
+  template <class... Args>
+  mozilla::NotNull<value_type*> EmplaceBack(Args&&... aArgs) {
+    return mozilla::WrapNotNullUnchecked(
+        this->template EmplaceBackInternal<ArenaAlloc, Args...>(
+            std::forward<Args>(aArgs)...));
+  }
+};
+
 template <class E>
 class MOZ_GSL_OWNER CopyableTArray : public nsTArray<E> {
  public:
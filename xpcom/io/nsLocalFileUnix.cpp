@@ -257,13 +257,19 @@ nsDirEnumeratorUnix::GetNextFile(nsIFile** aResult) {
     return NS_OK;
   }
 
-  nsCOMPtr<nsIFile> file = new nsLocalFile();
+  RefPtr<nsLocalFile> file = new nsLocalFile();
 
   if (NS_FAILED(rv = file->InitWithNativePath(mParentPath)) ||
       NS_FAILED(rv = file->AppendNative(nsDependentCString(mEntry->d_name)))) {
     return rv;
   }
 
+#ifdef DT_UNKNOWN
+  // Let the new file answer type queries from the directory entry without
+  // paying for a stat() syscall per enumerated entry.
+  file->mDirEntryType = mEntry->d_type;
+#endif
+
   file.forget(aResult);
   return GetNextEntry();
 }
@@ -277,9 +283,10 @@ nsDirEnumeratorUnix::Close() {
   return NS_OK;
 }
 
-nsLocalFile::nsLocalFile() : mCachedStat() {}
+nsLocalFile::nsLocalFile() : mCachedStat(), mDirEntryType(0) {}
 
-nsLocalFile::nsLocalFile(const nsLocalFile& aOther) : mPath(aOther.mPath) {}
+nsLocalFile::nsLocalFile(const nsLocalFile& aOther)
+    : mPath(aOther.mPath), mDirEntryType(aOther.mDirEntryType) {}
 
 #ifdef MOZ_WIDGET_COCOA
 NS_IMPL_ISUPPORTS(nsLocalFile, nsILocalFileMac, nsIFile)
@@ -324,6 +331,7 @@ nsLocalFile::Clone(nsIFile** aFile) {
 
 NS_IMETHODIMP
 nsLocalFile::InitWithNativePath(const nsACString& aFilePath) {
+  ClearDirEntryType();
   if (!aFilePath.IsEmpty() && aFilePath.First() == '~') {
     if (aFilePath.Length() == 1 || aFilePath.CharAt(1) == '/') {
       // Home dir for the current user
@@ -549,6 +557,9 @@ nsresult nsLocalFile::CreateAndKeepOpen(uint32_t aType, int aFlags,
 #endif
     result = createFunc(mPath.get(), aFlags, aPermissions, aResult);
   }
+  if (result != -1) {
+    ClearDirEntryType();
+  }
   return NSRESULT_FOR_RETURN(result);
 }
 
@@ -625,6 +636,7 @@ nsLocalFile::AppendRelativeNativePath(const nsACString& aFragment) {
     mPath.Append('/');
   }
   mPath.Append(aFragment);
+  ClearDirEntryType();
 
   return NS_OK;
 }
@@ -646,6 +658,7 @@ nsLocalFile::Normalize() {
   }
 
   mPath = resolved_path;
+  ClearDirEntryType();
   return NS_OK;
 }
 
@@ -682,6 +695,7 @@ nsLocalFile::SetNativeLeafName(const nsACString& aLeafName) {
   nsACString::const_iterator begin, end;
   LocateNativeLeafName(begin, end);
   mPath.Replace(begin.get() - mPath.get(), Distance(begin, end), aLeafName);
+  ClearDirEntryType();
   return NS_OK;
 }
 
@@ -1263,6 +1277,7 @@ nsLocalFile::MoveToNative(nsIFile* aNewParent, const nsACString& aNewName) {
   if (NS_SUCCEEDED(rv)) {
     // Adjust this
     mPath = newPathName;
+    ClearDirEntryType();
   }
   return rv;
 }
@@ -1287,8 +1302,11 @@ nsLocalFile::Remove(bool aRecursive, uint32_t* aRemoveCount) {
 
   if (isSymLink || !S_ISDIR(mCachedStat.st_mode)) {
     rv = NSRESULT_FOR_RETURN(unlink(mPath.get()));
-    if (NS_SUCCEEDED(rv) && aRemoveCount) {
-      *aRemoveCount += 1;
+    if (NS_SUCCEEDED(rv)) {
+      ClearDirEntryType();
+      if (aRemoveCount) {
+        *aRemoveCount += 1;
+      }
     }
     return rv;
   }
@@ -1332,8 +1350,11 @@ nsLocalFile::Remove(bool aRecursive, uint32_t* aRemoveCount) {
   }
 
   rv = NSRESULT_FOR_RETURN(rmdir(mPath.get()));
-  if (NS_SUCCEEDED(rv) && aRemoveCount) {
-    *aRemoveCount += 1;
+  if (NS_SUCCEEDED(rv)) {
+    ClearDirEntryType();
+    if (aRemoveCount) {
+      *aRemoveCount += 1;
+    }
   }
   return rv;
 }
@@ -2034,6 +2055,13 @@ nsLocalFile::IsDirectory(bool* aResult) {
     return NS_ERROR_INVALID_ARG;
   }
   *aResult = false;
+#ifdef DT_UNKNOWN
+  // DT_LNK (and friends) can't answer this query, which follows symlinks.
+  if (mDirEntryType == DT_DIR || mDirEntryType == DT_REG) {
+    *aResult = mDirEntryType == DT_DIR;
+    return NS_OK;
+  }
+#endif
   ENSURE_STAT_CACHE();
   *aResult = S_ISDIR(mCachedStat.st_mode);
   return NS_OK;
@@ -2045,6 +2073,13 @@ nsLocalFile::IsFile(bool* aResult) {
     return NS_ERROR_INVALID_ARG;
   }
   *aResult = false;
+#ifdef DT_UNKNOWN
+  // DT_LNK (and friends) can't answer this query, which follows symlinks.
+  if (mDirEntryType == DT_DIR || mDirEntryType == DT_REG) {
+    *aResult = mDirEntryType == DT_REG;
+    return NS_OK;
+  }
+#endif
   ENSURE_STAT_CACHE();
   *aResult = S_ISREG(mCachedStat.st_mode);
   return NS_OK;
@@ -2068,6 +2103,14 @@ nsLocalFile::IsSymlink(bool* aResult) {
   }
   CHECK_mPath();
 
+#ifdef DT_UNKNOWN
+  // d_type describes the entry itself, matching lstat() semantics.
+  if (mDirEntryType != DT_UNKNOWN) {
+    *aResult = mDirEntryType == DT_LNK;
+    return NS_OK;
+  }
+#endif
+
   struct STAT symStat;
   if (LSTAT(mPath.get(), &symStat) == -1) {
     return NSRESULT_FOR_ERRNO();
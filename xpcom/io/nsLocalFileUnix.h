@@ -60,11 +60,23 @@ class nsLocalFile final
   ~nsLocalFile() = default;
 
  protected:
+  friend class nsDirEnumeratorUnix;
+
   // This stat cache holds the *last stat* - it does not invalidate.
   // Call "FillStatCache" whenever you want to stat our file.
   struct STAT mCachedStat;
   nsCString mPath;
 
+  // The DT_* file type reported by readdir() when this object was created
+  // by nsDirEnumeratorUnix, or DT_UNKNOWN (0) otherwise.  This lets type
+  // queries on freshly enumerated entries avoid a stat() syscall each,
+  // which adds up when enumerating large directories (cache, session
+  // store) on slow disks.  Reset whenever mPath is changed or the file
+  // is created or removed.
+  uint8_t mDirEntryType;
+
+  void ClearDirEntryType() { mDirEntryType = 0; }
+
   void LocateNativeLeafName(nsACString::const_iterator&,
                             nsACString::const_iterator&);
 
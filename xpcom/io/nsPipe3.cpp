@@ -412,6 +412,12 @@ class nsPipe final {
   ReentrantMonitor mReentrantMonitor;
   nsSegmentedBuffer mBuffer MOZ_GUARDED_BY(mReentrantMonitor);
 
+  // The most recently retired segment.  A pipe in steady state retires one
+  // segment for every segment it appends, so keeping a single segment around
+  // lets the writer take ownership of it directly instead of paying a
+  // free()/malloc() pair for every segment of data moved through the pipe.
+  mozilla::UniqueFreePtr<char> mRecycledSegment MOZ_GUARDED_BY(mReentrantMonitor);
+
   // The maximum number of segments to allow to be buffered in advance
   // of the fastest reader.  This is collection of segments is called
   // the "advance buffer".
@@ -714,9 +720,15 @@ SegmentChangeResult nsPipe::AdvanceReadSegment(
       mInputList[i]->ReadState().mSegment -= 1;
     }
 
-    // done with this segment
-    aEvents.FreeSegment(mBuffer.PopFirstSegment());
-    LOG(("III deleting first segment\n"));
+    // done with this segment; hold on to it for the writer if we aren't
+    // already caching a retired segment.
+    if (mRecycledSegment) {
+      aEvents.FreeSegment(mBuffer.PopFirstSegment());
+      LOG(("III deleting first segment\n"));
+    } else {
+      mRecycledSegment = mBuffer.PopFirstSegment();
+      LOG(("III recycling first segment\n"));
+    }
   }
 
   if (mWriteSegment < aReadState.mSegment) {
@@ -833,8 +845,9 @@ nsresult nsPipe::GetWriteSegment(char*& aSegment, uint32_t& aSegmentLen) {
     }
 
     // The nsSegmentedBuffer is configured to be "infinite", so this
-    // should never return nullptr here.
-    char* seg = mBuffer.AppendNewSegment();
+    // should never return nullptr here.  Hand back the cached retired
+    // segment, if any, to avoid allocating a fresh one.
+    char* seg = mBuffer.AppendNewSegment(std::move(mRecycledSegment));
     if (!seg) {
       return NS_ERROR_OUT_OF_MEMORY;
     }
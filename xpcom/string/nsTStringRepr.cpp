@@ -8,11 +8,33 @@
 
 #include "double-conversion/string-to-double.h"
 #include "mozilla/FloatingPoint.h"
+#include "mozilla/SIMD.h"
 #include "nsError.h"
 #include "nsString.h"
 
 namespace mozilla::detail {
 
+// Typed wrappers over the runtime-dispatched SIMD kernels in mozglue so the
+// templated code below can stay character-type agnostic.
+static const char* CharSearch(const char* aData, char aChar, size_t aLength) {
+  return SIMD::memchr8(aData, aChar, aLength);
+}
+
+static const char16_t* CharSearch(const char16_t* aData, char16_t aChar,
+                                  size_t aLength) {
+  return SIMD::memchr16(aData, aChar, aLength);
+}
+
+static const char* TwoCharSearch(const char* aData, char aChar1, char aChar2,
+                                 size_t aLength) {
+  return SIMD::memchr2x8(aData, aChar1, aChar2, aLength);
+}
+
+static const char16_t* TwoCharSearch(const char16_t* aData, char16_t aChar1,
+                                     char16_t aChar2, size_t aLength) {
+  return SIMD::memchr2x16(aData, aChar1, aChar2, aLength);
+}
+
 template <typename T>
 typename nsTStringRepr<T>::char_type nsTStringRepr<T>::First() const {
   MOZ_RELEASE_ASSERT(this->mLength > 0, "|First()| called on an empty string");
@@ -27,8 +49,12 @@ typename nsTStringRepr<T>::char_type nsTStringRepr<T>::Last() const {
 
 template <typename T>
 bool nsTStringRepr<T>::Equals(const self_type& aStr) const {
+  // For plain equality we don't need the ordering that char_traits::compare
+  // provides, so compare raw bytes and let memcmp's vectorized implementation
+  // do the work.
   return this->mLength == aStr.mLength &&
-         char_traits::compare(this->mData, aStr.mData, this->mLength) == 0;
+         memcmp(this->mData, aStr.mData, this->mLength * sizeof(char_type)) ==
+             0;
 }
 
 template <typename T>
@@ -113,8 +139,40 @@ bool nsTStringRepr<T>::LowerCaseEqualsASCII(const char* aData) const {
 template <typename T>
 int32_t nsTStringRepr<T>::Find(const string_view& aString,
                                index_type aOffset) const {
-  auto idx = View().find(aString, aOffset);
-  return idx == string_view::npos ? kNotFound : idx;
+  size_type patLen = aString.length();
+  if (patLen == 0) {
+    return aOffset <= this->mLength ? int32_t(aOffset) : kNotFound;
+  }
+  if (aOffset > this->mLength || this->mLength - aOffset < patLen) {
+    return kNotFound;
+  }
+  if (patLen == 1) {
+    return FindChar(aString[0], aOffset);
+  }
+
+  // Use the two-character SIMD kernel to find candidate positions for the
+  // first two pattern characters, then verify the remainder. This mirrors the
+  // StringMatch fast path in js/src/builtin/String.cpp.
+  const char_type* pat = aString.data();
+  const char_type* text = this->mData;
+  size_type i = aOffset;
+  // The last position a match can start at.
+  size_type n = this->mLength - patLen + 1;
+  while (i < n) {
+    // memchr2xN searches for two characters at a time, so the final window
+    // must include the character after the last valid start position. This
+    // never runs past the end because patLen >= 2.
+    const char_type* pos = TwoCharSearch(text + i, pat[0], pat[1], n - i + 1);
+    if (!pos) {
+      return kNotFound;
+    }
+    i = size_type(pos - text);
+    if (char_traits::compare(text + i + 2, pat + 2, patLen - 2) == 0) {
+      return int32_t(i);
+    }
+    i += 1;
+  }
+  return kNotFound;
 }
 
 template <typename T>
@@ -145,13 +203,24 @@ int32_t nsTStringRepr<T>::RFind(const string_view& aString) const {
 template <typename T>
 typename nsTStringRepr<T>::size_type nsTStringRepr<T>::CountChar(
     char_type aChar) const {
-  return std::count(BeginReading(), EndReading(), aChar);
+  size_type count = 0;
+  const char_type* cur = this->mData;
+  const char_type* end = this->mData + this->mLength;
+  while ((cur = CharSearch(cur, aChar, end - cur))) {
+    ++count;
+    ++cur;
+  }
+  return count;
 }
 
 template <typename T>
 int32_t nsTStringRepr<T>::FindChar(char_type aChar, index_type aOffset) const {
-  auto idx = View().find(aChar, aOffset);
-  return idx == string_view::npos ? kNotFound : idx;
+  if (aOffset >= this->mLength) {
+    return kNotFound;
+  }
+  const char_type* found =
+      CharSearch(this->mData + aOffset, aChar, this->mLength - aOffset);
+  return found ? int32_t(found - this->mData) : kNotFound;
 }
 
 template <typename T>
@@ -11,6 +11,7 @@
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/Printf.h"
 #include "mozilla/ResultExtensions.h"
+#include "mozilla/SIMD.h"
 
 #include <iterator>
 #include "fmt/format.h"
@@ -1093,12 +1094,60 @@ void nsTSubstring<T>::StripTaggedASCII(const ASCIIMaskArray& aToStrip) {
   this->mLength = to - this->mData;
 }
 
+// Typed wrappers over the runtime-dispatched SIMD kernels in mozglue, so
+// StripCRLF below can stay character-type agnostic. SIMD::memchr2x8 matches
+// the two-character sequence "\r\n", not either character, so probe for each
+// separately and take the earlier hit, narrowing the second search to the
+// prefix before the first one.
+static const char* FindCROrLF(const char* aData, size_t aLength) {
+  const char* cr = mozilla::SIMD::memchr8(aData, '\r', aLength);
+  const char* lf =
+      mozilla::SIMD::memchr8(aData, '\n', cr ? size_t(cr - aData) : aLength);
+  return lf ? lf : cr;
+}
+
+static const char16_t* FindCROrLF(const char16_t* aData, size_t aLength) {
+  const char16_t* cr = mozilla::SIMD::memchr16(aData, u'\r', aLength);
+  const char16_t* lf =
+      mozilla::SIMD::memchr16(aData, u'\n', cr ? size_t(cr - aData) : aLength);
+  return lf ? lf : cr;
+}
+
 template <typename T>
 void nsTSubstring<T>::StripCRLF() {
-  // Expanding this call to copy the code from StripTaggedASCII
-  // instead of just calling it does somewhat help with performance
-  // but it is not worth it given the duplicated code.
-  StripTaggedASCII(mozilla::ASCIIMask::MaskCRLF());
+  // This is hot for newline normalization of large pasted or parsed text, so
+  // rather than the per-character mask test in StripTaggedASCII, scan with the
+  // SIMD kernels: hop from newline to newline and bulk-move the clean runs in
+  // between. This also avoids forcing a mutable copy of a shared buffer when
+  // there is nothing to strip at all.
+  const char_type* first = FindCROrLF(this->mData, this->mLength);
+  if (!first) {
+    return;
+  }
+
+  size_t firstOffset = first - this->mData;
+  if (!EnsureMutable()) {
+    AllocFailed(this->mLength);
+  }
+
+  char_type* to = this->mData + firstOffset;
+  const char_type* from = to;
+  const char_type* end = this->mData + this->mLength;
+  while (from < end) {
+    while (from < end &&
+           (*from == char_type('\r') || *from == char_type('\n'))) {
+      ++from;
+    }
+    const char_type* runEnd = FindCROrLF(from, end - from);
+    if (!runEnd) {
+      runEnd = end;
+    }
+    memmove(to, from, (runEnd - from) * sizeof(char_type));
+    to += runEnd - from;
+    from = runEnd;
+  }
+  *to = char_type(0);  // add the null
+  this->mLength = to - this->mData;
 }
 
 // An adapter type for a `nsTSubstring<T>` to provide a std::string-like
@@ -0,0 +1,91 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "mozilla/MPMCQueue.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+using mozilla::MPMCQueue;
+
+namespace TestMPMCQueue {
+
+TEST(MPMCQueue, SingleThreaded)
+{
+  MPMCQueue<int, 8> queue;
+  int value;
+
+  EXPECT_FALSE(queue.Pop(value));
+  EXPECT_TRUE(queue.IsProbablyEmpty());
+
+  for (int i = 0; i < 8; i++) {
+    EXPECT_TRUE(queue.Push(int(i)));
+  }
+  // Full now.
+  EXPECT_FALSE(queue.Push(8));
+
+  for (int i = 0; i < 8; i++) {
+    EXPECT_TRUE(queue.Pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.Pop(value));
+
+  // Wrap around a few times to exercise the sequence counters.
+  for (int i = 0; i < 100; i++) {
+    EXPECT_TRUE(queue.Push(int(i)));
+    EXPECT_TRUE(queue.Pop(value));
+    EXPECT_EQ(value, i);
+  }
+}
+
+TEST(MPMCQueue, ManyProducersManyConsumers)
+{
+  static constexpr uint32_t kProducers = 4;
+  static constexpr uint32_t kConsumers = 4;
+  static constexpr uint32_t kPerProducer = 100000;
+
+  MPMCQueue<uint32_t, 256> queue;
+  std::atomic<uint64_t> sum{0};
+  std::atomic<uint32_t> popped{0};
+
+  std::vector<std::thread> threads;
+  for (uint32_t p = 0; p < kProducers; p++) {
+    threads.emplace_back([&queue] {
+      for (uint32_t i = 1; i <= kPerProducer; i++) {
+        uint32_t value = i;
+        while (!queue.Push(std::move(value))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (uint32_t c = 0; c < kConsumers; c++) {
+    threads.emplace_back([&queue, &sum, &popped] {
+      uint32_t value;
+      while (popped.load() < kProducers * kPerProducer) {
+        if (queue.Pop(value)) {
+          sum += value;
+          popped++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(popped.load(), kProducers * kPerProducer);
+  EXPECT_EQ(sum.load(), uint64_t(kProducers) * kPerProducer *
+                            (uint64_t(kPerProducer) + 1) / 2);
+
+  uint32_t leftover;
+  EXPECT_FALSE(queue.Pop(leftover));
+}
+
+}  // namespace TestMPMCQueue
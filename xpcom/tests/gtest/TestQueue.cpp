@@ -183,4 +183,27 @@ TEST(Queue, PushPopSequence)
   }
 }
 
+TEST(Queue, Iterator)
+{
+  // Exercise iteration at every push/pop phase so the circular head page,
+  // page boundaries, and the partially-filled tail page are all covered.
+  for (uint32_t push = 0; push < 32; ++push) {
+    for (uint32_t pop = 0; pop <= push; ++pop) {
+      Queue<uint32_t, 8> queue;
+      uint32_t inSerial = 0;
+      uint32_t outSerial = 0;
+      DoPushPopSequence(queue, inSerial, outSerial, push, pop);
+
+      uint32_t expected = outSerial;
+      for (uint32_t value : queue) {
+        EXPECT_EQ(value, expected++);
+      }
+      EXPECT_EQ(expected, inSerial);
+    }
+  }
+
+  Queue<uint32_t, 8> empty;
+  EXPECT_TRUE(empty.begin() == empty.end());
+}
+
 }  // namespace TestQueue
@@ -1969,6 +1969,18 @@ void StripCRLFHelper() {
   s.StripCRLF();
   EXPECT_TRUE(s.EqualsLiteral("abcabcabc"));
 
+  s.AssignLiteral("a\nb");
+  s.StripCRLF();
+  EXPECT_TRUE(s.EqualsLiteral("ab"));
+
+  s.AssignLiteral("a\rb");
+  s.StripCRLF();
+  EXPECT_TRUE(s.EqualsLiteral("ab"));
+
+  s.AssignLiteral("a\r\nb");
+  s.StripCRLF();
+  EXPECT_TRUE(s.EqualsLiteral("ab"));
+
   s.AssignLiteral("   \n\rabcabcabc\r\n");
   s.StripCRLF();
   EXPECT_TRUE(s.EqualsLiteral("   abcabcabc"));
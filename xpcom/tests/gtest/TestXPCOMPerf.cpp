@@ -0,0 +1,177 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h"  // For MOZ_GTEST_BENCH_F
+
+#include "mozilla/SpinEventLoopUntil.h"
+#include "nsAtom.h"
+#include "nsString.h"
+#include "nsTArray.h"
+#include "nsTHashMap.h"
+#include "nsThreadUtils.h"
+
+#ifdef MOZ_MEMORY
+#  include "mozmemory.h"
+#endif
+
+// Microbenchmarks over the xpcom core data structures (nsTArray,
+// PLDHashTable via nsTHashMap, nsTSubstring, the main-thread event queue)
+// with workloads shaped like the Gecko hot paths that regress most often:
+// atomization storms, incremental string building and hashtable churn.
+// Timings are reported through MozGTestBench in PERFHERDER_DATA form; the
+// churn scenarios additionally report the mozjemalloc allocated-bytes delta
+// in the same form so allocation regressions are visible without a
+// profiler.
+
+namespace mozilla {
+
+#ifdef MOZ_MEMORY
+static size_t AllocatedBytes() {
+  jemalloc_stats_t stats;
+  jemalloc_stats(&stats);
+  return stats.allocated;
+}
+
+// Report an allocation measurement in the same PERFHERDER_DATA form that
+// MozGTestBench uses for timings, so both series are picked up by the same
+// tooling. Deltas can be negative when a scenario frees more than it
+// allocates; clamp to zero as perfherder values are magnitudes.
+static void ReportAllocDelta(const char* aName, size_t aBefore,
+                             size_t aAfter) {
+#  if !defined(DEBUG) && !defined(MOZ_ASAN)
+  size_t delta = aAfter > aBefore ? aAfter - aBefore : 0;
+  printf(
+      "PERFHERDER_DATA: {\"framework\": {\"name\": \"platform_microbench\"}, "
+      "\"suites\": [{\"name\": \"XPCOMPerf\", \"subtests\": "
+      "[{\"name\": \"%s\", \"value\": %zu, \"unit\": \"bytes\", "
+      "\"lowerIsBetter\": true, \"shouldAlert\": false}]}]}\n",
+      aName, delta);
+#  endif
+}
+#endif  // MOZ_MEMORY
+
+class XPCOMPerf : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // A vocabulary of distinct keys reused by the atomization and hashtable
+    // scenarios. Realistic keys are short and share prefixes (attribute and
+    // property names do), so build them that way rather than as random
+    // blobs.
+    static const char* const kPrefixes[] = {"data-", "aria-", "moz",
+                                            "on",    "item",  "field"};
+    mKeys.SetCapacity(kNumKeys);
+    for (size_t i = 0; i < kNumKeys; ++i) {
+      nsCString key(kPrefixes[i % std::size(kPrefixes)]);
+      key.AppendInt(static_cast<uint64_t>(i));
+      mKeys.AppendElement(std::move(key));
+    }
+  }
+
+  static constexpr size_t kNumKeys = 4096;
+  nsTArray<nsCString> mKeys;
+};
+
+// nsTArray: sequential append followed by erase-from-front churn, the
+// pattern observer arrays and pending-item lists hit.
+MOZ_GTEST_BENCH_F(XPCOMPerf, TArrayAppendEraseChurn, [this] {
+  for (int round = 0; round < 50; ++round) {
+    nsTArray<uint64_t> array;
+    for (uint64_t i = 0; i < 10000; ++i) {
+      array.AppendElement(i);
+    }
+    while (array.Length() > 1) {
+      array.RemoveElementAt(0);
+      array.RemoveLastElement();
+    }
+  }
+});
+
+// PLDHashTable (through nsTHashMap): interleaved insert, hit and miss
+// lookups, and removal of half the keys, repeated so the table grows and
+// shrinks across its load-factor thresholds.
+MOZ_GTEST_BENCH_F(XPCOMPerf, HashtableChurn, [this] {
+#ifdef MOZ_MEMORY
+  size_t before = AllocatedBytes();
+#endif
+  uint64_t checksum = 0;
+  for (int round = 0; round < 20; ++round) {
+    nsTHashMap<nsCStringHashKey, uint32_t> map;
+    for (size_t i = 0; i < kNumKeys; ++i) {
+      map.InsertOrUpdate(mKeys[i], static_cast<uint32_t>(i));
+    }
+    for (size_t i = 0; i < kNumKeys; ++i) {
+      if (auto entry = map.Lookup(mKeys[i])) {
+        checksum += *entry;
+      }
+    }
+    for (size_t i = 0; i < kNumKeys; i += 2) {
+      map.Remove(mKeys[i]);
+    }
+    checksum += map.Count();
+  }
+  ASSERT_NE(checksum, uint64_t(0));
+#ifdef MOZ_MEMORY
+  ReportAllocDelta("HashtableChurnAllocated", before, AllocatedBytes());
+#endif
+});
+
+// nsTSubstring: building a document-sized string from many small appends,
+// the serializer and markup-generation pattern.
+MOZ_GTEST_BENCH_F(XPCOMPerf, StringIncrementalAppend, [this] {
+  for (int round = 0; round < 20; ++round) {
+    nsAutoCString out;
+    for (size_t i = 0; i < kNumKeys; ++i) {
+      out.AppendLiteral("<item name=\"");
+      out.Append(mKeys[i]);
+      out.AppendLiteral("\" index=\"");
+      out.AppendInt(static_cast<uint64_t>(i));
+      out.AppendLiteral("\"/>");
+    }
+    ASSERT_FALSE(out.IsEmpty());
+  }
+});
+
+// Atomization storm: atomize a large vocabulary, as parsing a big document
+// with many distinct attribute names does, then drop every reference so
+// the next round re-creates the dynamic atoms.
+MOZ_GTEST_BENCH_F(XPCOMPerf, AtomizationStorm, [this] {
+#ifdef MOZ_MEMORY
+  size_t before = AllocatedBytes();
+#endif
+  for (int round = 0; round < 10; ++round) {
+    nsTArray<RefPtr<nsAtom>> atoms;
+    atoms.SetCapacity(kNumKeys);
+    for (size_t i = 0; i < kNumKeys; ++i) {
+      atoms.AppendElement(NS_Atomize(mKeys[i]));
+    }
+    // Re-atomizing an existing atom is the hit path; do one pass of it
+    // before the vocabulary is dropped.
+    for (size_t i = 0; i < kNumKeys; ++i) {
+      RefPtr<nsAtom> hit = NS_Atomize(mKeys[i]);
+      ASSERT_EQ(hit, atoms[i]);
+    }
+  }
+#ifdef MOZ_MEMORY
+  ReportAllocDelta("AtomizationStormAllocated", before, AllocatedBytes());
+#endif
+});
+
+// Main-thread event queue: dispatch-and-drain throughput for small
+// runnables, the shape of coalesced notification storms.
+MOZ_GTEST_BENCH_F(XPCOMPerf, EventQueueDispatchDrain, [this] {
+  constexpr uint32_t kNumEvents = 10000;
+  uint32_t processed = 0;
+  for (uint32_t i = 0; i < kNumEvents; ++i) {
+    MOZ_ALWAYS_SUCCEEDS(NS_DispatchToMainThread(NS_NewRunnableFunction(
+        "XPCOMPerf::EventQueueDispatchDrain", [&processed] { ++processed; })));
+  }
+  MOZ_ALWAYS_TRUE(SpinEventLoopUntil(
+      "xpcom:XPCOMPerf.EventQueueDispatchDrain"_ns,
+      [&processed] { return processed == kNumEvents; }));
+});
+
+}  // namespace mozilla
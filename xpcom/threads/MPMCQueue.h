@@ -0,0 +1,129 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef mozilla_MPMCQueue_h
+#define mozilla_MPMCQueue_h
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "mozilla/Assertions.h"
+
+namespace mozilla {
+
+// A bounded, lock-free multi-producer multi-consumer FIFO, after Dmitry
+// Vyukov's bounded MPMC queue. Each slot carries a sequence counter that
+// encodes whether it is ready for a producer or a consumer, so producers and
+// consumers only contend on their respective position counters and never
+// block one another.
+//
+// Push() and Pop() fail (returning false) when the queue is full or empty
+// respectively; callers are expected to fall back to their slow path rather
+// than spin. There is deliberately no blocking support here - parking and
+// wakeup policy belongs to the consumer (see nsThreadPool for an example of
+// pairing this with a condvar for idle threads).
+//
+// |Capacity| must be a power of two.
+template <typename T, size_t Capacity>
+class MPMCQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+
+ public:
+  MPMCQueue() : mEnqueuePos(0), mDequeuePos(0) {
+    for (size_t i = 0; i < Capacity; i++) {
+      mSlots[i].mSequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~MPMCQueue() {
+    // Destroy anything still queued.
+    T value;
+    while (Pop(value)) {
+    }
+  }
+
+  MPMCQueue(const MPMCQueue&) = delete;
+  MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+  // Attempts to enqueue a value. Returns false if the queue is full.
+  bool Push(T&& aValue) {
+    Slot* slot;
+    size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      slot = &mSlots[pos & kMask];
+      size_t seq = slot->mSequence.load(std::memory_order_acquire);
+      intptr_t diff = intptr_t(seq) - intptr_t(pos);
+      if (diff == 0) {
+        if (mEnqueuePos.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // The slot is still occupied by a value a consumer hasn't taken yet:
+        // the queue is full.
+        return false;
+      } else {
+        pos = mEnqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    slot->mValue = std::move(aValue);
+    slot->mSequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Attempts to dequeue a value. Returns false if the queue is empty.
+  bool Pop(T& aValue) {
+    Slot* slot;
+    size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      slot = &mSlots[pos & kMask];
+      size_t seq = slot->mSequence.load(std::memory_order_acquire);
+      intptr_t diff = intptr_t(seq) - intptr_t(pos + 1);
+      if (diff == 0) {
+        if (mDequeuePos.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = mDequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+    aValue = std::move(slot->mValue);
+    slot->mValue = T();
+    slot->mSequence.store(pos + Capacity, std::memory_order_release);
+    return true;
+  }
+
+  // Best-effort emptiness check; only meaningful as a hint.
+  bool IsProbablyEmpty() const {
+    size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+    const Slot& slot = mSlots[pos & kMask];
+    size_t seq = slot.mSequence.load(std::memory_order_acquire);
+    return intptr_t(seq) - intptr_t(pos + 1) < 0;
+  }
+
+ private:
+  static constexpr size_t kMask = Capacity - 1;
+
+  struct Slot {
+    std::atomic<size_t> mSequence;
+    T mValue;
+  };
+
+  // Keep the producer and consumer counters on separate cache lines from
+  // each other and from the slot array.
+  alignas(64) Slot mSlots[Capacity];
+  alignas(64) std::atomic<size_t> mEnqueuePos;
+  alignas(64) std::atomic<size_t> mDequeuePos;
+};
+
+}  // namespace mozilla
+
+#endif  // mozilla_MPMCQueue_h
@@ -47,6 +47,8 @@ namespace mozilla {
 //
 template <class T, size_t RequestedItemsPerPage = 256>
 class Queue {
+  struct Page;
+
  public:
   Queue() = default;
 
@@ -169,6 +171,71 @@ class Queue {
 
   size_t Count() const { return mCount; }
 
+  // A forward iterator over the elements of the queue, from the element
+  // which would be popped first to the one pushed last.  Any modification
+  // of the queue invalidates all outstanding iterators.
+  class Iterator {
+   public:
+    T& operator*() const { return mPage->mEvents[mOffset]; }
+    T* operator->() const { return &mPage->mEvents[mOffset]; }
+
+    Iterator& operator++() {
+      MOZ_ASSERT(mRemaining);
+      --mRemaining;
+      if (!mRemaining) {
+        // Reached the end; there may be no further page to point at.
+        mPage = nullptr;
+        mOffset = 0;
+        return *this;
+      }
+      if (mHeadRemaining) {
+        // The head page is circular, and is followed by linear pages.
+        --mHeadRemaining;
+        if (mHeadRemaining) {
+          mOffset = (mOffset + 1) % ItemsPerPage;
+        } else {
+          mPage = mPage->mNext;
+          mOffset = 0;
+        }
+        return *this;
+      }
+      ++mOffset;
+      if (mOffset == ItemsPerPage) {
+        mPage = mPage->mNext;
+        mOffset = 0;
+      }
+      return *this;
+    }
+
+    // Only iterators over the same queue may be compared.
+    bool operator==(const Iterator& aOther) const {
+      return mRemaining == aOther.mRemaining;
+    }
+    bool operator!=(const Iterator& aOther) const {
+      return !(*this == aOther);
+    }
+
+   private:
+    friend class Queue;
+
+    Iterator(Page* aPage, uint16_t aOffset, uint32_t aRemaining,
+             uint16_t aHeadRemaining)
+        : mPage(aPage),
+          mOffset(aOffset),
+          mRemaining(aRemaining),
+          mHeadRemaining(aHeadRemaining) {}
+
+    Page* mPage;
+    uint16_t mOffset;
+    uint32_t mRemaining;  // Elements left to visit, including the current one.
+    uint16_t mHeadRemaining;
+  };
+
+  Iterator begin() {
+    return IsEmpty() ? end() : Iterator(mHead, mOffsetHead, mCount, mHeadLength);
+  }
+  Iterator end() { return Iterator(nullptr, 0, 0, 0); }
+
   size_t ShallowSizeOfExcludingThis(MallocSizeOf aMallocSizeOf) const {
     size_t n = 0;
     if (mHead) {
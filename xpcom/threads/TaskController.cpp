@@ -18,6 +18,7 @@
 #include "mozilla/InputTaskManager.h"
 #include "mozilla/VsyncTaskManager.h"
 #include "mozilla/IOInterposer.h"
+#include "mozilla/MathAlgorithms.h"
 #include "mozilla/Perfetto.h"
 #include "mozilla/StaticPtr.h"
 #include "mozilla/SchedulerGroup.h"
@@ -492,6 +493,60 @@ void TaskController::AddTask(already_AddRefed<Task>&& aTask) {
 
   MutexAutoLock lock(mGraphMutex);
 
+  MaybeInterruptTask(AddTaskLocked(std::move(task), lock), lock);
+}
+
+void TaskController::AddTasks(nsTArray<RefPtr<Task>>&& aTasks) {
+  nsTArray<RefPtr<Task>> tasks(std::move(aTasks));
+  if (tasks.IsEmpty()) {
+    return;
+  }
+
+  bool anyThreadable = false;
+  for (const RefPtr<Task>& task : tasks) {
+    if (task->GetKind() == Task::Kind::OffMainThreadOnly) {
+      anyThreadable = true;
+      break;
+    }
+  }
+
+  if (anyThreadable) {
+    MutexAutoLock lock(mPoolInitializationMutex);
+    if (!mThreadPoolInitialized) {
+      InitializeThreadPool();
+    }
+  }
+
+  MutexAutoLock lock(mGraphMutex);
+
+  // Insert everything first, then do the scheduling follow-up once per kind
+  // for the highest priority task we added. Interrupt decisions only depend
+  // on the highest priority newcomer, so the per-task wakeup work AddTask()
+  // does would be redundant here.
+  Task* highestMainThread = nullptr;
+  Task* highestThreadable = nullptr;
+  for (RefPtr<Task>& task : tasks) {
+    Task* inserted = AddTaskLocked(std::move(task), lock);
+    Task*& highest = inserted->GetKind() == Task::Kind::MainThreadOnly
+                         ? highestMainThread
+                         : highestThreadable;
+    if (!highest || highest->GetPriority() < inserted->GetPriority()) {
+      highest = inserted;
+    }
+  }
+
+  MaybeInterruptTask(highestMainThread, lock);
+  if (highestThreadable) {
+    // Put every idle thread to work before considering interrupts.
+    DispatchThreadableTasks(lock);
+    MaybeInterruptTask(highestThreadable, lock);
+  }
+}
+
+Task* TaskController::AddTaskLocked(RefPtr<Task>&& aTask,
+                                    const MutexAutoLock& aProofOfLock) {
+  RefPtr<Task> task(std::move(aTask));
+
   if (TaskManager* manager = task->GetManager()) {
     if (manager->mTaskCount == 0) {
       mTaskManagers.insert(manager);
@@ -541,7 +596,7 @@ void TaskController::AddTask(already_AddRefed<Task>&& aTask) {
   (*insertion.first)->mIterator = insertion.first;
   MOZ_ASSERT(insertion.second);
 
-  MaybeInterruptTask(*insertion.first, lock);
+  return insertion.first->get();
 }
 
 void TaskController::DispatchThreadableTasks(
@@ -1316,6 +1371,11 @@ bool TaskController::DoExecuteNextTaskOnlyMainThreadInternal(
         }
 
         mPerformanceCounterState->RunnableDidRun(name, std::move(snapshot));
+
+#ifdef MOZ_COLLECTING_RUNNABLE_TELEMETRY
+        RecordMainThreadTaskLatency(name, task->mInsertionTime, now,
+                                    TimeStamp::Now());
+#endif
       }
 
       // Task itself should keep manager alive.
@@ -1363,6 +1423,58 @@ bool TaskController::DoExecuteNextTaskOnlyMainThreadInternal(
   return false;
 }
 
+#ifdef MOZ_COLLECTING_RUNNABLE_TELEMETRY
+static size_t LatencyBucketIndex(const TimeDuration& aLatency) {
+  double us = aLatency.ToMicroseconds();
+  if (us <= 1.0) {
+    return 0;
+  }
+  return std::min(size_t(CeilingLog2(uint64_t(us))),
+                  TaskController::TaskLatencyHistogram::kBucketCount - 1);
+}
+
+void TaskController::RecordMainThreadTaskLatency(
+    const nsACString& aName, const TimeStamp& aInsertionTime,
+    const TimeStamp& aStartTime, const TimeStamp& aEndTime) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  constexpr auto kAnonymousTaskName = "Anonymous"_ns;
+  const nsACString& key = aName.IsEmpty()
+                              ? static_cast<const nsACString&>(kAnonymousTaskName)
+                              : aName;
+  TaskLatencyHistogram* histogram =
+      mMainThreadTaskLatencies
+          .LookupOrInsertWith(
+              key, [] { return MakeUnique<TaskLatencyHistogram>(); })
+          .get();
+
+  histogram->mCount++;
+
+  if (!aInsertionTime.IsNull()) {
+    TimeDuration queueTime = aStartTime - aInsertionTime;
+    histogram->mQueueTimeBuckets[LatencyBucketIndex(queueTime)]++;
+    histogram->mTotalQueueTime += queueTime;
+    histogram->mMaxQueueTime = std::max(histogram->mMaxQueueTime, queueTime);
+  }
+
+  TimeDuration runTime = aEndTime - aStartTime;
+  histogram->mRunTimeBuckets[LatencyBucketIndex(runTime)]++;
+  histogram->mTotalRunTime += runTime;
+  histogram->mMaxRunTime = std::max(histogram->mMaxRunTime, runTime);
+}
+
+void TaskController::EnumerateMainThreadTaskLatencies(
+    const std::function<void(const nsACString& aName,
+                             const TaskLatencyHistogram& aHistogram)>&
+        aCallback) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  for (const auto& entry : mMainThreadTaskLatencies) {
+    aCallback(entry.GetKey(), *entry.GetData());
+  }
+}
+#endif
+
 Task* TaskController::GetFinalDependency(Task* aTask) {
   Task* nextTask;
 
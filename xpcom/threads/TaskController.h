@@ -16,10 +16,14 @@
 #include "mozilla/TimeStamp.h"
 #include "mozilla/EventQueue.h"
 #include "mozilla/UniquePtr.h"
+#include "nsClassHashtable.h"
+#include "nsHashKeys.h"
 #include "nsISupportsImpl.h"
+#include "nsTArray.h"
 #include "nsThreadUtils.h"  // for MOZ_COLLECTING_RUNNABLE_TELEMETRY
 
 #include <atomic>
+#include <functional>
 #include <vector>
 #include <set>
 #include <stack>
@@ -325,6 +329,13 @@ class TaskController {
   // This may be called on any thread.
   void AddTask(already_AddRefed<Task>&& aTask);
 
+  // Adds a batch of tasks to the TaskController graph, taking the graph lock
+  // only once. Use this when posting many tasks at the same time; it avoids
+  // the per-task lock/wake cycle that AddTask() pays, which becomes the
+  // bottleneck when many threads post tasks concurrently.
+  // This may be called on any thread. The array is consumed.
+  void AddTasks(nsTArray<RefPtr<Task>>&& aTasks);
+
   // This wait function is the theoretical function you would need if our main
   // thread needs to also process OS messages or something along those lines.
   void WaitForTaskOrMessage();
@@ -358,6 +369,34 @@ class TaskController {
   static int32_t GetPoolThreadCount();
   static size_t GetThreadStackSize();
 
+#ifdef MOZ_COLLECTING_RUNNABLE_TELEMETRY
+  // Cheap always-on record of how long each named main thread task waited in
+  // the queue and how long it ran, bucketed exponentially.  This allows
+  // answering "which runnable is starving the main thread" from a live
+  // process without attaching the profiler.
+  struct TaskLatencyHistogram {
+    // Buckets are indexed by CeilingLog2 of the latency in microseconds, so
+    // bucket N counts latencies up to 2^N microseconds.  The top bucket
+    // absorbs everything from ~34 seconds up.
+    static constexpr size_t kBucketCount = 26;
+
+    uint64_t mCount = 0;
+    uint32_t mQueueTimeBuckets[kBucketCount] = {};
+    uint32_t mRunTimeBuckets[kBucketCount] = {};
+    TimeDuration mTotalQueueTime;
+    TimeDuration mTotalRunTime;
+    TimeDuration mMaxQueueTime;
+    TimeDuration mMaxRunTime;
+  };
+
+  // Enumerate the recorded histograms, keyed by runnable name.  Main thread
+  // only; the data is owned and mutated by the main thread without a lock.
+  void EnumerateMainThreadTaskLatencies(
+      const std::function<void(const nsACString& aName,
+                               const TaskLatencyHistogram& aHistogram)>&
+          aCallback);
+#endif
+
 #ifdef MOZ_MEMORY
   // To be called once during startup.
   static void SetupIdleMemoryCleanup();
@@ -386,6 +425,18 @@ class TaskController {
   bool DoExecuteNextTaskOnlyMainThreadInternal(
       const MutexAutoLock& aProofOfLock);
 
+  // Inserts a task into the graph without any scheduling follow-up; the
+  // caller is responsible for calling MaybeInterruptTask() afterwards.
+  // Returns the inserted task.
+  Task* AddTaskLocked(RefPtr<Task>&& aTask, const MutexAutoLock& aProofOfLock);
+
+#ifdef MOZ_COLLECTING_RUNNABLE_TELEMETRY
+  void RecordMainThreadTaskLatency(const nsACString& aName,
+                                   const TimeStamp& aInsertionTime,
+                                   const TimeStamp& aStartTime,
+                                   const TimeStamp& aEndTime);
+#endif
+
   Task* GetFinalDependency(Task* aTask);
   void MaybeInterruptTask(Task* aTask, const MutexAutoLock& aProofOfLock);
   Task* GetHighestPriorityMTTask();
@@ -480,6 +531,13 @@ class TaskController {
   // Set once when MainThread is created, never changed, only accessed from
   // DoExecuteNextTaskOnlyMainThreadInternal()
   PerformanceCounterState* mPerformanceCounterState = nullptr;
+
+#ifdef MOZ_COLLECTING_RUNNABLE_TELEMETRY
+  // Latency histograms for named main thread tasks.
+  // Accessed only on MainThread
+  nsClassHashtable<nsCStringHashKey, TaskLatencyHistogram>
+      mMainThreadTaskLatencies;
+#endif
 };
 
 }  // namespace mozilla
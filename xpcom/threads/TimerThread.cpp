@@ -641,22 +641,37 @@ void TimerThread::VerifyTimerListConsistency() const {
       lastNonCanceledTimerIndex = timerIndex;
     }
   }
+
+  // The cached timeouts must be sorted even across canceled entries; the
+  // binary searches in ComputeTimerInsertionIndex() and
+  // RemoveTimerInternal() depend on it.
+  for (size_t timerIndex = 1; timerIndex < timerCount; ++timerIndex) {
+    MOZ_ASSERT(mTimers[timerIndex - 1].Timeout() <=
+               mTimers[timerIndex].Timeout());
+  }
 }
 #endif
 
 size_t TimerThread::ComputeTimerInsertionIndex(const TimeStamp& timeout) const {
   mMonitor.AssertCurrentThreadOwns();
 
-  const size_t timerCount = mTimers.Length();
-
-  size_t firstGtIndex = 0;
-  while (firstGtIndex < timerCount &&
-         (!mTimers[firstGtIndex].Value() ||
-          mTimers[firstGtIndex].Timeout() <= timeout)) {
-    ++firstGtIndex;
+  // Every entry keeps its cached timeout in sorted order, canceled entries
+  // included (overwrites in AddTimerInternal only ever replace a cached
+  // timeout with a value that still fits between its neighbors), so the
+  // upper bound can be found with a binary search instead of a walk of the
+  // whole list. This is what keeps insertion flat-cost with tens of
+  // thousands of pending timers.
+  size_t lo = 0;
+  size_t hi = mTimers.Length();
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (mTimers[mid].Timeout() <= timeout) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
   }
-
-  return firstGtIndex;
+  return lo;
 }
 
 TimeStamp TimerThread::ComputeWakeupTimeFromTimers() const {
@@ -1238,9 +1253,25 @@ bool TimerThread::RemoveTimerInternal(nsTimerImpl& aTimer) {
     return false;
   }
   AUTO_TIMERS_STATS(TimerThread_RemoveTimerInternal_in_list);
-  for (auto& entry : mTimers) {
-    if (entry.Value() == &aTimer) {
-      entry.Forget();
+  // While a timer is in the list its mTimeout matches the entry's cached
+  // timeout (mTimeout is only updated after removal), and the cached
+  // timeouts are sorted, so binary search for the start of the run of equal
+  // timeouts and only scan that run.
+  const TimeStamp& timeout = aTimer.mTimeout;
+  const size_t timerCount = mTimers.Length();
+  size_t lo = 0;
+  size_t hi = timerCount;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (mTimers[mid].Timeout() < timeout) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  for (size_t i = lo; i < timerCount && mTimers[i].Timeout() == timeout; ++i) {
+    if (mTimers[i].Value() == &aTimer) {
+      mTimers[i].Forget();
       return true;
     }
   }
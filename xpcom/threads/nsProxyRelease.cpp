@@ -5,13 +5,127 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "nsProxyRelease.h"
+
+#include "mozilla/StaticMutex.h"
+#include "mozilla/TimeStamp.h"
+#include "nsTArray.h"
 #include "nsThreadUtils.h"
 
+namespace {
+
+using mozilla::StaticMutex;
+using mozilla::StaticMutexAutoLock;
+using mozilla::TimeDuration;
+using mozilla::TimeStamp;
+
+// Proxied releases bound for the main thread are coalesced into a shared
+// queue drained by a single runnable, rather than posting one runnable per
+// released object.  Teardown storms (e.g. closing a tab with many media
+// elements) otherwise flood the main-thread queue with thousands of tiny
+// events, which delays input handling.  The queue is drained in dispatch
+// order, so releases of the same object stay ordered, and the drain yields
+// back to the event loop once it exceeds its time budget.
+
+// How long a single drain may run before the remaining releases are
+// deferred to a fresh runnable.
+constexpr uint32_t kMainThreadReleaseBudgetMs = 4;
+
+StaticMutex sMainThreadReleaseQueueLock;
+
+// The doomed objects, in dispatch order.  The queue owns one reference to
+// each element; those references were transferred in by the caller.
+nsTArray<nsISupports*>* sMainThreadReleaseQueue
+    MOZ_GUARDED_BY(sMainThreadReleaseQueueLock) = nullptr;
+
+// Whether a drain runnable is dispatched but not yet finished.
+bool sMainThreadReleaseDrainPending
+    MOZ_GUARDED_BY(sMainThreadReleaseQueueLock) = false;
+
+void DrainMainThreadReleaseQueue() {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  const TimeStamp deadline =
+      TimeStamp::Now() +
+      TimeDuration::FromMilliseconds(kMainThreadReleaseBudgetMs);
+
+  while (true) {
+    AutoTArray<nsISupports*, 64> batch;
+    {
+      StaticMutexAutoLock lock(sMainThreadReleaseQueueLock);
+      if (!sMainThreadReleaseQueue || sMainThreadReleaseQueue->IsEmpty()) {
+        sMainThreadReleaseDrainPending = false;
+        return;
+      }
+      batch.SwapElements(*sMainThreadReleaseQueue);
+    }
+
+    // Release without holding the lock; a release may re-enter the proxy
+    // release machinery and queue further objects.
+    for (size_t i = 0; i < batch.Length(); ++i) {
+      NS_IF_RELEASE(batch[i]);
+
+      if (TimeStamp::Now() >= deadline && i + 1 < batch.Length()) {
+        // Out of budget.  Put the remainder back at the head of the queue,
+        // ahead of anything queued while we were draining, and pick it up
+        // again in a later event-loop iteration.
+        StaticMutexAutoLock lock(sMainThreadReleaseQueueLock);
+        sMainThreadReleaseQueue->InsertElementsAt(0, batch.Elements() + i + 1,
+                                                  batch.Length() - (i + 1));
+        nsresult rv = NS_DispatchToMainThread(NS_NewRunnableFunction(
+            "DrainMainThreadReleaseQueue", &DrainMainThreadReleaseQueue));
+        if (NS_FAILED(rv)) {
+          NS_WARNING("failed to redispatch proxy release drain, leaking!");
+        }
+        return;
+      }
+    }
+  }
+}
+
+// Takes over the caller's reference to aDoomed and releases it on the main
+// thread in a later event-loop iteration.
+void QueueMainThreadRelease(nsISupports* aDoomed) {
+  bool needDispatch;
+  {
+    StaticMutexAutoLock lock(sMainThreadReleaseQueueLock);
+    if (!sMainThreadReleaseQueue) {
+      sMainThreadReleaseQueue = new nsTArray<nsISupports*>();
+    }
+    sMainThreadReleaseQueue->AppendElement(aDoomed);
+    needDispatch = !sMainThreadReleaseDrainPending;
+    sMainThreadReleaseDrainPending = true;
+  }
+
+  if (needDispatch) {
+    nsresult rv = NS_DispatchToMainThread(NS_NewRunnableFunction(
+        "DrainMainThreadReleaseQueue", &DrainMainThreadReleaseQueue));
+    if (NS_FAILED(rv)) {
+      NS_WARNING("failed to post proxy release drain, leaking!");
+      // It is better to leak the queued objects than risk crashing as a
+      // result of deleting them on the wrong thread.
+    }
+  }
+}
+
+}  // namespace
+
 namespace detail {
 
 /* static */ nsresult ProxyReleaseChooser<true>::ProxyReleaseISupports(
     const char* aName, nsIEventTarget* aTarget, nsISupports* aDoomed,
     bool aAlwaysProxy) {
+  // Releases targeting the main thread itself go through the coalescing
+  // queue.  Other targets (thread pools, labelled queues) keep a dedicated
+  // runnable, since they each impose their own ordering.
+  if (aDoomed && aTarget == mozilla::GetMainThreadSerialEventTarget()) {
+    if (!aAlwaysProxy && NS_IsMainThread()) {
+      nsCOMPtr<nsISupports> doomed = dont_AddRef(aDoomed);
+      return NS_OK;
+    }
+    QueueMainThreadRelease(aDoomed);
+    return NS_OK;
+  }
+
   return ::detail::ProxyRelease<nsISupports>(
       aName, aTarget, dont_AddRef(aDoomed), aAlwaysProxy);
 }
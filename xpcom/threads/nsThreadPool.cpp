@@ -21,6 +21,7 @@
 #include "mozilla/StickyTimeDuration.h"
 #include "nsThreadSyncDispatch.h"
 
+#include <atomic>
 #include <mutex>
 
 using namespace mozilla;
@@ -65,7 +66,8 @@ nsThreadPool::nsThreadPool()
       mQoSPriority(nsIThread::QOS_PRIORITY_NORMAL),
       mStackSize(nsIThreadManager::DEFAULT_STACK_SIZE),
       mShutdown(false),
-      mIsAPoolThreadFree(true) {
+      mIsAPoolThreadFree(true),
+      mInboxDrained(false) {
   LOG(("THRD-P(%p) constructor!!!\n", this));
 }
 
@@ -144,6 +146,69 @@ nsresult nsThreadPool::PutEvent(nsIRunnable* aEvent) {
 
 nsresult nsThreadPool::PutEvent(already_AddRefed<nsIRunnable> aEvent,
                                 uint32_t aFlags) {
+  // Fast path: when the pool is saturated - every thread exists and none is
+  // idle - queueing the event is all there is to do, so push it onto the
+  // lock-free inbox instead of fighting over mMutex. This is the state a
+  // pool fanning out thousands of small runnables per second lives in.
+  if (aFlags == 0 && !mShutdown && !mIsAPoolThreadFree &&
+      mIdleThreadCount == 0) {
+    nsCOMPtr<nsIRunnable> event(aEvent);
+    LogRunnable::LogDispatch(event);
+    if (mInbox.Push(std::move(event))) {
+      // Pairs with a thread registering itself as idle and then re-checking
+      // the inbox before parking (see Run()): after this fence, either we
+      // observe the thread as idle and wake it, or it observes our push.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (MOZ_UNLIKELY(mShutdown)) {
+        // Shutdown began after the unlocked check above, so every worker may
+        // already have exited even though our push landed. Resolve the race
+        // under the lock: until ShutdownWithTimeout() has drained the inbox
+        // the event is guaranteed to be run, either by a worker or by the
+        // drain, so the dispatch stands. After the drain nothing will ever
+        // pop the inbox again, so empty it ourselves and refuse the
+        // dispatch, as the locked path below would have.
+        MutexAutoLock lock(mMutex);
+        if (!mInboxDrained) {
+          return NS_OK;
+        }
+        nsCOMPtr<nsIRunnable> lateEvent;
+        while (mInbox.Pop(lateEvent)) {
+          NS_WARNING("Discarding event dispatched after thread pool shutdown");
+          lateEvent = nullptr;
+        }
+        return NS_ERROR_NOT_AVAILABLE;
+      }
+      if (MOZ_UNLIKELY(mIsAPoolThreadFree)) {
+        // A worker published its exit between our unlocked check above and
+        // the push, and its final inbox pop may have preceded the push, so
+        // no thread may be left to service the event. Its own post-exit
+        // re-check (see the end of Run()) pairs with the fence above: either
+        // the exiting worker sees our push and re-dispatches it, or we see
+        // its mIsAPoolThreadFree store here and reclaim an event ourselves,
+        // handing it to the locked path below, which can spawn a
+        // replacement thread. Reclaiming nothing means someone else already
+        // took responsibility for every pushed event.
+        if (!mInbox.Pop(event)) {
+          return NS_OK;
+        }
+        aEvent = event.forget();
+      } else {
+        if (mIdleThreadCount != 0) {
+          MutexAutoLock lock(mMutex);
+          if (auto* mruThread = mMRUIdleThreads.getFirst()) {
+            mruThread->remove();
+            mIdleThreadCount--;
+            mruThread->mEventsAvailable.Notify();
+          }
+        }
+        return NS_OK;
+      }
+    } else {
+      // Inbox full; take the slow path below.
+      aEvent = event.forget();
+    }
+  }
+
   // Avoid spawning a new thread while holding the event queue lock...
 
   bool spawnThread = false;
@@ -180,6 +245,7 @@ nsresult nsThreadPool::PutEvent(already_AddRefed<nsIRunnable> aEvent,
       // from the idle list, so that future dispatches try
       // to wake other threads.
       mruThread->remove();
+      mIdleThreadCount--;
       mruThread->mEventsAvailable.Notify();
 #ifdef DEBUG
       mruThread->mNotifiedSince = TimeStamp::Now();
@@ -367,6 +433,10 @@ nsThreadPool::Run() {
       }
 
       event = mEvents.GetEvent(lock, &lastEventDelay);
+      if (!event && mInbox.Pop(event)) {
+        // Inbox events don't carry queuing timestamps; report no delay.
+        lastEventDelay = TimeDuration();
+      }
       if (!event) {
         TimeStamp now = TimeStamp::Now();
         uint32_t cnt = mMRUIdleThreads.length() + ((wasIdle) ? 0 : 1);
@@ -383,10 +453,12 @@ nsThreadPool::Run() {
             idleEntry.mIdleSince = now;
             wasIdle = true;
             mMRUIdleThreads.insertFront(&idleEntry);
+            mIdleThreadCount++;
           } else if ((now - idleEntry.mIdleSince) < currentTimeout) {
             // Continue to stay idle without touching mIdleSince.
             if (!idleEntry.isInList()) {
               mMRUIdleThreads.insertFront(&idleEntry);
+              mIdleThreadCount++;
             }
           } else {
             // We reached our timeout.
@@ -398,6 +470,7 @@ nsThreadPool::Run() {
           wasIdle = false;
           if (idleEntry.isInList()) {
             idleEntry.remove();
+            mIdleThreadCount--;
           }
 
           shutdownThreadOnExit = mThreads.RemoveObject(current);
@@ -421,7 +494,14 @@ nsThreadPool::Run() {
 #ifdef DEBUG
           idleEntry.mLastWaitDelay = delta;
 #endif
-          idleEntry.mEventsAvailable.Wait(delta);
+          // Pairs with the fence in PutEvent()'s inbox fast path: we
+          // registered as idle above (mIdleThreadCount), so re-check the
+          // inbox before parking; a racing producer either sees us idle and
+          // notifies, or we see its push here.
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          if (mInbox.IsProbablyEmpty()) {
+            idleEntry.mEventsAvailable.Wait(delta);
+          }
           LOG(("THRD-P(%p) done waiting\n", this));
         }
       } else {
@@ -429,6 +509,7 @@ nsThreadPool::Run() {
         wasIdle = false;
         if (idleEntry.isInList()) {
           idleEntry.remove();
+          mIdleThreadCount--;
         }
       }
       // Release our lock.
@@ -459,6 +540,25 @@ nsThreadPool::Run() {
     }
   } while (!exitThread);
 
+  // A producer can push to the inbox concurrently with the idle-timeout exit
+  // above: it may have sampled mIsAPoolThreadFree before we published our
+  // exit, and its push may have landed after our final inbox pop. Pairs with
+  // the fence in PutEvent()'s fast path: either we see such a push here and
+  // re-dispatch it (the locked path can now spawn a replacement thread), or
+  // the producer sees our mIsAPoolThreadFree store after its fence and
+  // reclaims the event itself. During shutdown the drain in
+  // ShutdownWithTimeout() owns the inbox instead.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!mShutdown) {
+    nsCOMPtr<nsIRunnable> orphan;
+    while (mInbox.Pop(orphan)) {
+      if (NS_FAILED(PutEvent(do_AddRef(orphan), 0))) {
+        NS_WARNING("Discarding event dispatched after thread pool shutdown");
+      }
+      orphan = nullptr;
+    }
+  }
+
   if (listener) {
     listener->OnThreadShuttingDown();
   }
@@ -591,6 +691,24 @@ nsThreadPool::ShutdownWithTimeout(int32_t aTimeoutMs) {
   }
   onCompletion->Cancel();
 
+  // The lock-free inbox can still hold events whose push raced with the
+  // workers exiting; Dispatch() already acknowledged them with NS_OK, so run
+  // them here rather than dropping them on the floor. Setting mInboxDrained
+  // first hands responsibility for any later racing push back to the
+  // dispatcher (see the shutdown re-check in PutEvent()).
+  {
+    MutexAutoLock lock(mMutex);
+    mInboxDrained = true;
+  }
+  nsCOMPtr<nsIRunnable> event;
+  while (mInbox.Pop(event)) {
+    NS_WARNING("Running event dispatched to thread pool during shutdown");
+    LogRunnable::Run log(event);
+    event->Run();
+    // To cover the event's destructor code in the LogRunnable span
+    event = nullptr;
+  }
+
   return NS_OK;
 }
 
@@ -18,6 +18,7 @@
 #include "mozilla/CondVar.h"
 #include "mozilla/EventQueue.h"
 #include "mozilla/LinkedList.h"
+#include "mozilla/MPMCQueue.h"
 #include "mozilla/Mutex.h"
 
 class nsIThread;
@@ -63,6 +64,18 @@ class nsThreadPool final : public mozilla::Runnable, public nsIThreadPool {
   nsCOMPtr<nsIThreadPoolListener> mListener MOZ_GUARDED_BY(mMutex);
   mozilla::Atomic<bool, mozilla::Relaxed> mShutdown;
   mozilla::Atomic<bool, mozilla::Relaxed> mIsAPoolThreadFree;
+  // Lock-free fast-path inbox, used by PutEvent() when the pool is saturated
+  // (no idle thread to wake and no room to spawn one), which is exactly when
+  // mMutex is most contended. Worker threads drain it under mMutex whenever
+  // mEvents is empty. See the comments in PutEvent() and Run().
+  mozilla::MPMCQueue<nsCOMPtr<nsIRunnable>, 1024> mInbox;
+  // Whether ShutdownWithTimeout() has finished draining mInbox. Once set,
+  // nothing will ever pop the inbox again, so a PutEvent() whose push raced
+  // with shutdown must clean up after itself (see the re-check there).
+  bool mInboxDrained MOZ_GUARDED_BY(mMutex);
+  // Number of entries in mMRUIdleThreads, readable without mMutex so
+  // PutEvent() can decide whether the inbox fast path is safe.
+  mozilla::Atomic<uint32_t> mIdleThreadCount;
   // set once before we start threads
   nsCString mName MOZ_GUARDED_BY(mMutex);
   nsThreadPoolNaming mThreadNaming;  // all data inside this is atomic